@@ -0,0 +1,19 @@
+#include "Skinning.hlsli"
+#include "VertexCompression.hlsli"
+#include "Lambert.hlsli"
+
+VS_OUT main(
+	float4 position		: POSITION,
+	float2 texcoord		: TEXCOORD,
+	float2 normal		: NORMAL)
+{
+	VS_OUT vout = (VS_OUT)0;
+
+	// XLjOȂbV͂OԂɃ[hs񂪓Ă
+	position = mul(position, boneTransforms[0]);
+	vout.vertex = mul(position, viewProjection);
+	vout.texcoord = texcoord;
+	vout.normal = mul(float4(DecodeNormal(normal), 0), boneTransforms[0]).xyz;
+
+	return vout;
+}
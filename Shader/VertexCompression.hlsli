@@ -0,0 +1,20 @@
+// ʑ̃GR[hPʃxNgɓWJ
+float3 DecodeOctahedral(float2 e)
+{
+	float3 v = float3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+	float t = saturate(-v.z);
+	v.xy += (v.xy >= 0.0) ? -t : t;
+	return normalize(v);
+}
+
+// @WJiR16G16_SNORMj
+float3 DecodeNormal(float2 normal)
+{
+	return DecodeOctahedral(normal);
+}
+
+// ڐWJiR10G10B10A2_UNORMAw͏]@̌j
+float4 DecodeTangent(float4 tangent)
+{
+	return float4(DecodeOctahedral(tangent.xy * 2.0 - 1.0), tangent.w > 0.5 ? 1.0 : -1.0);
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include "Profiler.h"
+#include "AnimationBlendTree.h"
+
+// C[ǉ
+int AnimationBlendTree::AddLayer(BlendMode mode, int clipCount)
+{
+	Layer& layer = layers.emplace_back();
+	layer.mode = mode;
+	layer.clips.resize(clipCount);
+	return static_cast<int>(layers.size()) - 1;
+}
+
+// Nbvݒ
+void AnimationBlendTree::SetClip(int layerIndex, int clipIndex, int animationIndex, float time, float weight)
+{
+	Clip& clip = layers.at(layerIndex).clips.at(clipIndex);
+	clip.animationIndex = animationIndex;
+	clip.time = time;
+	clip.weight = weight;
+}
+
+// {[}XNݒ
+void AnimationBlendTree::SetBoneMask(int layerIndex, const Model* model, int rootNodeIndex)
+{
+	Layer& layer = layers.at(layerIndex);
+	layer.nodeIndices.clear();
+	if (rootNodeIndex < 0) return;
+
+	// wm[hqǂ
+	const std::vector<Model::Node>& nodes = model->GetNodes();
+	std::vector<const Model::Node*> stack = { &nodes.at(rootNodeIndex) };
+	while (!stack.empty())
+	{
+		const Model::Node* node = stack.back();
+		stack.pop_back();
+		layer.nodeIndices.emplace_back(static_cast<int>(node - nodes.data()));
+		for (const Model::Node* child : node->children)
+		{
+			stack.emplace_back(child);
+		}
+	}
+
+	// m[hɕׂăɂǂ
+	std::sort(layer.nodeIndices.begin(), layer.nodeIndices.end());
+}
+
+// pvZ
+void AnimationBlendTree::Evaluate(const Model* model, std::vector<Model::NodePose>& nodePoses)
+{
+	PROFILE_FUNCTION();
+
+	const int nodeCount = static_cast<int>(model->GetNodes().size());
+	if (static_cast<int>(nodePoses.size()) != nodeCount)
+	{
+		model->GetNodePoses(nodePoses);
+	}
+
+	for (Layer& layer : layers)
+	{
+		if (layer.weight <= 0.0f) continue;
+
+		// vZNbv
+		bool active = false;
+		for (Clip& clip : layer.clips)
+		{
+			if (clip.animationIndex < 0 || clip.weight <= 0.0f) continue;
+			active = true;
+
+			// ZC[͐擪t[pɂ
+			// gbNȂvf͊l̂܂܎cAvZ̃Nbvpln߂
+			if (layer.mode == BlendMode::Additive && clip.referenceAnimationIndex != clip.animationIndex)
+			{
+				clip.referenceAnimationIndex = clip.animationIndex;
+				clip.referencePoses.assign(nodeCount, Model::NodePose());
+				model->ComputeAnimation(clip.animationIndex, 0.0f, clip.referencePoses);
+			}
+		}
+		if (!active) continue;
+
+		// {[}XÑm[ĥ݌vZ
+		if (layer.nodeIndices.empty())
+		{
+			for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+			{
+				ComputeLayerPose(model, layer, nodeIndex, nodePoses[nodeIndex]);
+			}
+		}
+		else
+		{
+			for (int nodeIndex : layer.nodeIndices)
+			{
+				ComputeLayerPose(model, layer, nodeIndex, nodePoses[nodeIndex]);
+			}
+		}
+	}
+}
+
+// C[̎wm[h̎pvZ
+void AnimationBlendTree::ComputeLayerPose(const Model* model, Layer& layer, int nodeIndex, Model::NodePose& pose)
+{
+	DirectX::XMVECTOR BasePosition = DirectX::XMLoadFloat3(&pose.position);
+	DirectX::XMVECTOR BaseRotation = DirectX::XMLoadFloat4(&pose.rotation);
+	DirectX::XMVECTOR BaseScale = DirectX::XMLoadFloat3(&pose.scale);
+
+	DirectX::XMVECTOR Position = DirectX::XMVectorZero();
+	DirectX::XMVECTOR Rotation = DirectX::XMVectorZero();
+	DirectX::XMVECTOR Scale = DirectX::XMVectorZero();
+	DirectX::XMVECTOR FirstRotation = DirectX::XMQuaternionIdentity();
+	float totalWeight = 0.0f;
+
+	for (Clip& clip : layer.clips)
+	{
+		if (clip.animationIndex < 0 || clip.weight <= 0.0f) continue;
+
+		// J[\̓NbvɕێiAj[V؂ւ烊Zbgj
+		Model::AnimationCursor& cursor = clip.cursor;
+		if (cursor.animationIndex != clip.animationIndex || cursor.nodeCursors.size() != model->GetNodes().size())
+		{
+			cursor.animationIndex = clip.animationIndex;
+			cursor.nodeCursors.assign(model->GetNodes().size(), Model::NodeAnimCursor());
+		}
+
+		// gbNȂvf́A㏑C[ł͉̃C[̎pgAZC[ł͊pƓlɂč𖳂
+		Model::NodePose clipPose = layer.mode == BlendMode::Additive ? clip.referencePoses[nodeIndex] : pose;
+		model->ComputeAnimation(clip.animationIndex, nodeIndex, clip.time, clipPose, cursor.nodeCursors[nodeIndex]);
+
+		DirectX::XMVECTOR P = DirectX::XMLoadFloat3(&clipPose.position);
+		DirectX::XMVECTOR R = DirectX::XMLoadFloat4(&clipPose.rotation);
+		DirectX::XMVECTOR S = DirectX::XMLoadFloat3(&clipPose.scale);
+
+		// ZC[͊p̍ɂ
+		if (layer.mode == BlendMode::Additive)
+		{
+			const Model::NodePose& reference = clip.referencePoses[nodeIndex];
+			P = DirectX::XMVectorSubtract(P, DirectX::XMLoadFloat3(&reference.position));
+			S = DirectX::XMVectorSubtract(S, DirectX::XMLoadFloat3(&reference.scale));
+			R = DirectX::XMQuaternionMultiply(R, DirectX::XMQuaternionInverse(DirectX::XMLoadFloat4(&reference.rotation)));
+		}
+
+		// ŏ̃NbvƓɑĂd݂𑫂
+		if (totalWeight == 0.0f)
+		{
+			FirstRotation = layer.mode == BlendMode::Additive ? DirectX::XMQuaternionIdentity() : R;
+		}
+		if (DirectX::XMVectorGetX(DirectX::XMVector4Dot(FirstRotation, R)) < 0.0f)
+		{
+			R = DirectX::XMVectorNegate(R);
+		}
+		DirectX::XMVECTOR Weight = DirectX::XMVectorReplicate(clip.weight);
+		Position = DirectX::XMVectorMultiplyAdd(P, Weight, Position);
+		Rotation = DirectX::XMVectorMultiplyAdd(R, Weight, Rotation);
+		Scale = DirectX::XMVectorMultiplyAdd(S, Weight, Scale);
+		totalWeight += clip.weight;
+	}
+	if (totalWeight <= 0.0f) return;
+
+	if (layer.mode == BlendMode::Override)
+	{
+		// d݂̍vŐK
+		DirectX::XMVECTOR InverseWeight = DirectX::XMVectorReplicate(1.0f / totalWeight);
+		Model::NodePose layerPose;
+		DirectX::XMStoreFloat3(&layerPose.position, DirectX::XMVectorMultiply(Position, InverseWeight));
+		DirectX::XMStoreFloat4(&layerPose.rotation, DirectX::XMQuaternionNormalize(Rotation));
+		DirectX::XMStoreFloat3(&layerPose.scale, DirectX::XMVectorMultiply(Scale, InverseWeight));
+
+		if (layer.weight >= 1.0f)
+		{
+			pose = layerPose;
+		}
+		else
+		{
+			BlendPose(pose, layerPose, layer.weight, pose);
+		}
+	}
+	else
+	{
+		// d݂̍v1ɖȂ͍ȂƂĈ
+		if (totalWeight < 1.0f)
+		{
+			Rotation = DirectX::XMVectorMultiplyAdd(DirectX::XMQuaternionIdentity(), DirectX::XMVectorReplicate(1.0f - totalWeight), Rotation);
+		}
+		Rotation = DirectX::XMQuaternionNormalize(Rotation);
+		Rotation = DirectX::XMQuaternionNormalize(DirectX::XMVectorLerp(DirectX::XMQuaternionIdentity(), Rotation, layer.weight));
+
+		DirectX::XMVECTOR LayerWeight = DirectX::XMVectorReplicate(layer.weight);
+		DirectX::XMStoreFloat3(&pose.position, DirectX::XMVectorMultiplyAdd(Position, LayerWeight, BasePosition));
+		DirectX::XMStoreFloat4(&pose.rotation, DirectX::XMQuaternionMultiply(Rotation, BaseRotation));
+		DirectX::XMStoreFloat3(&pose.scale, DirectX::XMVectorMultiplyAdd(Scale, LayerWeight, BaseScale));
+	}
+}
+
+// Q̎p̃uh
+void AnimationBlendTree::BlendPose(const Model::NodePose& pose0, const Model::NodePose& pose1, float rate, Model::NodePose& result)
+{
+	DirectX::XMVECTOR R0 = DirectX::XMLoadFloat4(&pose0.rotation);
+	DirectX::XMVECTOR R1 = DirectX::XMLoadFloat4(&pose1.rotation);
+	if (DirectX::XMVectorGetX(DirectX::XMVector4Dot(R0, R1)) < 0.0f)
+	{
+		R1 = DirectX::XMVectorNegate(R1);
+	}
+	DirectX::XMVECTOR P = DirectX::XMVectorLerp(DirectX::XMLoadFloat3(&pose0.position), DirectX::XMLoadFloat3(&pose1.position), rate);
+	DirectX::XMVECTOR R = DirectX::XMQuaternionNormalize(DirectX::XMVectorLerp(R0, R1, rate));
+	DirectX::XMVECTOR S = DirectX::XMVectorLerp(DirectX::XMLoadFloat3(&pose0.scale), DirectX::XMLoadFloat3(&pose1.scale), rate);
+	DirectX::XMStoreFloat3(&result.position, P);
+	DirectX::XMStoreFloat4(&result.rotation, R);
+	DirectX::XMStoreFloat3(&result.scale, S);
+}
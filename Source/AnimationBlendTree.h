@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include "Model.h"
+
+// Aj[Vuhc[iC[ɕNbvdݕtŃuhÃC[ɏd˂j
+class AnimationBlendTree
+{
+public:
+	// C[̍@
+	enum class BlendMode
+	{
+		Override,		// ̃C[̎pC[̏d݂Œu
+		Additive,		// Nbv擪t[̍̃C[̎pɉ
+	};
+
+	// Nbviweight0ȉ̃Nbv͌vZȂj
+	struct Clip
+	{
+		int								animationIndex = -1;
+		float							time = 0;
+		float							weight = 0;
+
+		Model::AnimationCursor			cursor;
+		std::vector<Model::NodePose>	referencePoses;			// ZC[̊pi擪t[j
+		int								referenceAnimationIndex = -1;
+	};
+
+	// C[
+	struct Layer
+	{
+		BlendMode						mode = BlendMode::Override;
+		float							weight = 1.0f;
+		std::vector<int>				nodeIndices;			// {[}XNivZm[hȀꍇ͑Sm[hj
+		std::vector<Clip>				clips;
+	};
+
+	AnimationBlendTree() = default;
+	~AnimationBlendTree() = default;
+
+	// C[ǉiǉɉd˂j
+	int AddLayer(BlendMode mode, int clipCount);
+
+	// C[擾
+	Layer& GetLayer(int layerIndex) { return layers.at(layerIndex); }
+	const Layer& GetLayer(int layerIndex) const { return layers.at(layerIndex); }
+	int GetLayerCount() const { return static_cast<int>(layers.size()); }
+
+	// Nbvݒ
+	void SetClip(int layerIndex, int clipIndex, int animationIndex, float time, float weight);
+
+	// {[}XNݒiwm[hƂ̎q̂݌vZA-1̏ꍇ͑Sm[hj
+	void SetBoneMask(int layerIndex, const Model* model, int rootNodeIndex);
+
+	// pvZinodePoses̖vZ̃m[h͌ĂяoO̒lێj
+	void Evaluate(const Model* model, std::vector<Model::NodePose>& nodePoses);
+
+	// Q̎p̃uhi]𑵂͕K`ԁj
+	static void BlendPose(const Model::NodePose& pose0, const Model::NodePose& pose1, float rate, Model::NodePose& result);
+
+private:
+	// C[̎wm[h̎pvZiposeɉ̃C[̎pnAʂ󂯎j
+	static void ComputeLayerPose(const Model* model, Layer& layer, int nodeIndex, Model::NodePose& pose);
+
+private:
+	std::vector<Layer>					layers;
+};
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cmath>
+#include "Misc.h"
+#include "Profiler.h"
+#include "AnimationBlendTree.h"
+#include "AnimationPoseCache.h"
+#include "AnimationLOD.h"
+
+// RXgN^
+AnimationLOD::AnimationLOD()
+{
+	// ߋ͖t[SAȂقǊԈď𗎂Ƃ
+	levels =
+	{
+		{  0.0f, 1, 0, true,  true,  true  },
+		{ 10.0f, 2, 0, true,  false, true  },
+		{ 20.0f, 4, 2, true,  false, false },
+		{ 40.0f, 8, 3, false, false, false },
+	};
+}
+
+// xݒ
+void AnimationLOD::SetLevels(const std::vector<Level>& levels)
+{
+	_ASSERT_EXPR_A(!levels.empty(), "animation LOD needs at least one level");
+	this->levels = levels;
+	nodeIndices.clear();
+}
+
+// 烌x߂
+int AnimationLOD::ComputeLevel(float distance, int currentLevel) const
+{
+	int level = 0;
+	for (int i = 1; i < static_cast<int>(levels.size()); ++i)
+	{
+		// ߂xɖ߂ƂEOɂ炷
+		float threshold = levels[i].distance - (i <= currentLevel ? hysteresis : 0.0f);
+		if (distance >= threshold) level = i;
+	}
+	return level;
+}
+
+// LODɉAj[VvZ
+void AnimationLOD::ComputeAnimation(Instance& instance, const Model* model, int animationIndex, float time, float elapsedTime,
+	std::vector<Model::NodePose>& nodePoses, AnimationPoseCache* poseCache)
+{
+	const Level& level = levels.at(instance.level);
+	const std::vector<int>& indices = GetNodeIndices(model, instance.level);
+	const int interval = (std::max)(1, level.updateInterval);
+	const int phase = (frame + instance.frameOffset) % interval;
+
+	if (nodePoses.size() != model->GetNodes().size())
+	{
+		model->GetNodePoses(nodePoses);
+	}
+
+	// Aj[V؂ւꍇAÕTvOԊu󂢂ꍇA炵t[ꍇɃTvO
+	const bool animationChanged = instance.animationIndex != animationIndex || instance.toPoses.size() != nodePoses.size();
+	if (animationChanged || phase == 0 || instance.framesSinceUpdate >= instance.framesToUpdate)
+	{
+		if (animationChanged)
+		{
+			instance.animationIndex = animationIndex;
+			model->GetNodePoses(instance.toPoses);
+			instance.fromPoses = instance.toPoses;
+			SampleAnimation(instance, model, indices, time, poseCache);
+		}
+
+		instance.framesToUpdate = interval - phase;
+		instance.framesSinceUpdate = 0;
+		if (level.interpolate && instance.framesToUpdate > 1)
+		{
+			// O񋁂߂pi̎Ԃ̎pj玟̃TvOt[̎p֕Ԃ
+			const float secondsLength = model->GetAnimations().at(animationIndex).secondsLength;
+			float nextTime = time + instance.framesToUpdate * elapsedTime;
+			if (secondsLength > 0.0f) nextTime = fmodf(nextTime, secondsLength);
+
+			instance.fromPoses.swap(instance.toPoses);
+			SampleAnimation(instance, model, indices, nextTime, poseCache);
+		}
+		else if (!animationChanged)
+		{
+			SampleAnimation(instance, model, indices, time, poseCache);
+		}
+
+		if (!level.interpolate || instance.framesToUpdate <= 1)
+		{
+			for (int nodeIndex : indices)
+			{
+				nodePoses[nodeIndex] = instance.toPoses[nodeIndex];
+			}
+		}
+	}
+
+	// Ԃ̃t[ԂiԂȂꍇ͑O̎pێj
+	if (level.interpolate && instance.framesToUpdate > 1)
+	{
+		const float rate = static_cast<float>(instance.framesSinceUpdate) / instance.framesToUpdate;
+		for (int nodeIndex : indices)
+		{
+			AnimationBlendTree::BlendPose(instance.fromPoses[nodeIndex], instance.toPoses[nodeIndex], rate, nodePoses[nodeIndex]);
+		}
+	}
+	++instance.framesSinceUpdate;
+}
+
+// CX^X̎pTvO
+void AnimationLOD::SampleAnimation(Instance& instance, const Model* model, const std::vector<int>& nodeIndices, float time, AnimationPoseCache* poseCache)
+{
+	PROFILE_FUNCTION();
+
+	if (poseCache != nullptr)
+	{
+		// ̃CX^XƋLpKvȃm[ho
+		AnimationPoseCache::PoseSpan pose = poseCache->GetPose(model, instance.animationIndex, time);
+		for (int nodeIndex : nodeIndices)
+		{
+			instance.toPoses[nodeIndex] = pose[nodeIndex];
+		}
+		return;
+	}
+
+	Model::AnimationCursor& cursor = instance.cursor;
+	if (cursor.animationIndex != instance.animationIndex || cursor.nodeCursors.size() != instance.toPoses.size())
+	{
+		cursor.animationIndex = instance.animationIndex;
+		cursor.nodeCursors.assign(instance.toPoses.size(), Model::NodeAnimCursor());
+	}
+	for (int nodeIndex : nodeIndices)
+	{
+		model->ComputeAnimation(instance.animationIndex, nodeIndex, time, instance.toPoses[nodeIndex], cursor.nodeCursors[nodeIndex]);
+	}
+}
+
+// xŌvZm[hꗗ
+const std::vector<int>& AnimationLOD::GetNodeIndices(const Model* model, int level)
+{
+	// \zς݂Ȃ猟sis͂Ŕj
+	auto it = nodeIndices.find(model->GetResource().get());
+	if (it != nodeIndices.end() && it->second.size() == levels.size())
+	{
+		return it->second.at(level);
+	}
+
+	// [̒iie͎qOɕł̂ŋtɂǂΎqɌ܂j
+	const std::vector<Model::Node>& nodes = model->GetNodes();
+	std::vector<int> heights(nodes.size(), 0);
+	for (int nodeIndex = static_cast<int>(nodes.size()) - 1; nodeIndex >= 0; --nodeIndex)
+	{
+		int parentIndex = nodes[nodeIndex].parentIndex;
+		if (parentIndex >= 0)
+		{
+			heights[parentIndex] = (std::max)(heights[parentIndex], heights[nodeIndex] + 1);
+		}
+	}
+
+	std::vector<std::vector<int>>& levelNodeIndices = nodeIndices[model->GetResource().get()];
+	levelNodeIndices.resize(levels.size());
+	for (size_t i = 0; i < levels.size(); ++i)
+	{
+		std::vector<int>& indices = levelNodeIndices[i];
+		indices.clear();
+		for (int nodeIndex = 0; nodeIndex < static_cast<int>(nodes.size()); ++nodeIndex)
+		{
+			if (heights[nodeIndex] >= levels[i].skipLeafDepth)
+			{
+				indices.emplace_back(nodeIndex);
+			}
+		}
+	}
+	return levelNodeIndices.at(level);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Model.h"
+
+class AnimationPoseCache;
+
+// Aj[VLODiJ̋ōXVpxƌvZm[hE炷j
+class AnimationLOD
+{
+public:
+	// x̐ݒȉɕׂj
+	struct Level
+	{
+		float	distance = 0;			// ̋ȏœKp
+		int		updateInterval = 1;		// TvOԊuit[j
+		int		skipLeafDepth = 0;		// [琔ČvZȗm[h̒iiwȂǁj
+		bool	interpolate = true;		// TvOȂt[O̎pŕԂ邩iȂꍇ͎pێj
+		bool	physicsBones = true;	// ȟvZ
+		bool	ik = true;				// bNAbgEIK
+	};
+
+	// CX^X̏
+	struct Instance
+	{
+		int								level = 0;
+		int								frameOffset = 0;		// CX^XɍXVt[炷
+		int								framesSinceUpdate = 0;
+		int								framesToUpdate = 0;		// OTvO玟̃TvO܂ł̃t[
+		int								animationIndex = -1;
+		std::vector<Model::NodePose>	fromPoses;				// OTvOp
+		std::vector<Model::NodePose>	toPoses;				// ̃TvOt[̎p
+		Model::AnimationCursor			cursor;
+	};
+
+	AnimationLOD();
+	~AnimationLOD() = default;
+
+	// t[Jn
+	void BeginFrame() { ++frame; }
+
+	// xݒ
+	void SetLevels(const std::vector<Level>& levels);
+	const std::vector<Level>& GetLevels() const { return levels; }
+	int GetLevelCount() const { return static_cast<int>(levels.size()); }
+	const Level& GetLevel(int level) const { return levels.at(level); }
+
+	// 烌x߂iEt߂Ő؂ւ葱Ȃ悤ɋ߂Âhysteresisx点j
+	int ComputeLevel(float distance, int currentLevel) const;
+
+	// CX^X̃xXV
+	void UpdateLevel(Instance& instance, float distance) const { instance.level = ComputeLevel(distance, instance.level); }
+
+	// LODɉAj[VvZi[vĐOj
+	// TvOt[͎̃TvOt[̎Ԃ̎p߁AԂ̃t[͕Ԃ
+	// ȗm[hƍXVȂt[nodePosesȂ߁ACX^Xɓzn
+	void ComputeAnimation(Instance& instance, const Model* model, int animationIndex, float time, float elapsedTime,
+		std::vector<Model::NodePose>& nodePoses, AnimationPoseCache* poseCache = nullptr);
+
+	// xŌvZm[hꗗim[hA\[Xɏɍ\z邽ߕsOɈxĂłƁj
+	const std::vector<int>& GetNodeIndices(const Model* model, int level);
+
+private:
+	// CX^X̎pTvO
+	void SampleAnimation(Instance& instance, const Model* model, const std::vector<int>& nodeIndices, float time, AnimationPoseCache* poseCache);
+
+private:
+	std::vector<Level>			levels;
+	float						hysteresis = 1.0f;
+	int							frame = 0;
+	std::unordered_map<const ModelResource*, std::vector<std::vector<int>>>	nodeIndices;	// \[XEx
+};
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include "JobSystem.h"
+#include "Misc.h"
+#include "Profiler.h"
+#include "AnimationPoseCache.h"
+
+// L[̃nbVl
+size_t AnimationPoseCache::KeyHash::operator()(const Key& key) const
+{
+	uint32_t timeBits;
+	memcpy(&timeBits, &key.time, sizeof(timeBits));
+
+	size_t hash = std::hash<const void*>()(key.resource);
+	hash ^= static_cast<size_t>(key.animationIndex) * 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+	hash ^= static_cast<size_t>(timeBits) * 0xC2B2AE3D27D4EB4Full + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+// t[Jn
+void AnimationPoseCache::BeginFrame()
+{
+	_ASSERT_EXPR_A(pendingRequests.empty(), "pose requests were not sampled");
+	entries.clear();
+	requestCount = 0;
+}
+
+// p擾
+AnimationPoseCache::PoseSpan AnimationPoseCache::GetPose(const Model* model, int animationIndex, float time, int quantizeStep)
+{
+	int handle = Request(model, animationIndex, time, quantizeStep);
+	SampleRequests();
+	return GetPose(handle);
+}
+
+// pv
+int AnimationPoseCache::Request(const Model* model, int animationIndex, float time, int quantizeStep)
+{
+	++requestCount;
+
+	// {Ԋu̔{Ɋۂ߂iԊu͂Qׂ̂{Ȃ̂őeԂׂ͍Ԃ̈ꕔɂȂAĂLłj
+	const ModelResource* resource = model->GetResource().get();
+	const Model::Animation& animation = resource->GetAnimations().at(animationIndex);
+	if (quantizeStep > 0)
+	{
+		const float interval = quantizePolicy.sampleInterval * quantizeStep;
+		const int tick = static_cast<int>(std::floor(time / interval + 0.5f)) * quantizeStep;
+		time = (std::min)(tick * quantizePolicy.sampleInterval, animation.secondsLength);
+	}
+
+	// vς݂Ȃ炻̃ubNԂ
+	Key key = { resource, animationIndex, time };
+	auto it = entries.find(key);
+	if (it != entries.end())
+	{
+		return it->second;
+	}
+
+	// ubN̊mۂ͂ōsATvÕ͎ubNɂ
+	const int blockIndex = static_cast<int>(entries.size());
+	if (blockIndex == static_cast<int>(poseBlocks.size()))
+	{
+		poseBlocks.emplace_back();
+	}
+	poseBlocks[blockIndex].resize(resource->GetNodes().size());
+	entries.emplace(key, blockIndex);
+	pendingRequests.push_back({ model, animationIndex, time, blockIndex });
+	return blockIndex;
+}
+
+// vZ̗v܂Ƃ߂ăTvO
+void AnimationPoseCache::SampleRequests()
+{
+	if (pendingRequests.empty()) return;
+
+	PROFILE_SCOPE("AnimationPoseCache::Sample");
+	JobSystem::Instance().ParallelFor(static_cast<int>(pendingRequests.size()), 1, [this](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			const PendingRequest& request = pendingRequests[i];
+			std::vector<Model::NodePose>& nodePoses = poseBlocks[request.blockIndex];
+
+			// gbNȂm[h͏pɂ
+			const std::vector<ModelResource::Node>& resourceNodes = request.model->GetResource()->GetNodes();
+			for (size_t nodeIndex = 0; nodeIndex < resourceNodes.size(); ++nodeIndex)
+			{
+				nodePoses[nodeIndex].position = resourceNodes[nodeIndex].position;
+				nodePoses[nodeIndex].rotation = resourceNodes[nodeIndex].rotation;
+				nodePoses[nodeIndex].scale = resourceNodes[nodeIndex].scale;
+			}
+			request.model->ComputeAnimation(request.animationIndex, request.time, nodePoses);
+		}
+	});
+	pendingRequests.clear();
+}
+
+// vp̎擾
+AnimationPoseCache::PoseSpan AnimationPoseCache::GetPose(int handle) const
+{
+	// ubN̒g͊O̔z񂪐LтĂړȂ
+	const std::vector<Model::NodePose>& nodePoses = poseBlocks.at(handle);
+	return { nodePoses.data(), nodePoses.size() };
+}
+
+// ʎqԊu߂
+int AnimationPoseCache::ComputeQuantizeStep(float distance) const
+{
+	if (distance < quantizePolicy.nearDistance) return 0;
+
+	int step = 1;
+	float threshold = quantizePolicy.nearDistance + quantizePolicy.doubleDistance;
+	while (distance >= threshold && step * 2 <= quantizePolicy.maxStep)
+	{
+		step *= 2;
+		threshold += quantizePolicy.doubleDistance;
+	}
+	return step;
+}
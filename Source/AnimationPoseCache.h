@@ -0,0 +1,91 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Model.h"
+
+// Aj[VpLbVi\[XENbvEԂ̎pt[łP񂾂vZċLj
+class AnimationPoseCache
+{
+public:
+	AnimationPoseCache() = default;
+	~AnimationPoseCache() = default;
+
+	// ǂݎp̎pziBeginFrame܂ŗLj
+	struct PoseSpan
+	{
+		const Model::NodePose*	data = nullptr;
+		size_t					size = 0;
+
+		const Model::NodePose* begin() const { return data; }
+		const Model::NodePose* end() const { return data + size; }
+		const Model::NodePose& operator[](size_t index) const { return data[index]; }
+		bool empty() const { return size == 0; }
+	};
+
+	// Ԃ̗ʎqݒiCX^XقǑeԊu̎Ԃɂ܂Ƃ߂ċL₷j
+	struct QuantizePolicy
+	{
+		float	sampleInterval = 1.0f / 60;		// ʎq̊{Ԋuibj
+		float	nearDistance = 10;				// ߂CX^X͗ʎqȂ
+		float	doubleDistance = 10;			// ̋ɊԊu{ɂ
+		int		maxStep = 8;					// őԊui{Ԋu̔{AQׂ̂j
+	};
+
+	// t[JniOt[̎pjÄ͍ėpj
+	void BeginFrame();
+
+	// p擾iquantizeStep1ȏ̏ꍇ͊{Ԋu~quantizeStep̎ԂɊۂ߂j
+	// \[XQƂ郂fŋLAɗvf̐ݒiʎqAj[V̗LjŌvZ
+	PoseSpan GetPose(const Model* model, int animationIndex, float time, int quantizeStep = 0);
+
+	// vZpFvɂ܂Ƃ߂ĂWuVXeŃTvOAnhŎ擾
+	// RequestSampleRequests̓CXbhĂсASampleRequestsGetPose(handle)͂ǂ̃XbhłĂׂ
+	int Request(const Model* model, int animationIndex, float time, int quantizeStep = 0);
+	void SampleRequests();
+	PoseSpan GetPose(int handle) const;
+
+	// ʎqԊu߂i0̏ꍇ͗ʎqȂj
+	int ComputeQuantizeStep(float distance) const;
+
+	// ʎqݒ
+	void SetQuantizePolicy(const QuantizePolicy& policy) { quantizePolicy = policy; }
+	const QuantizePolicy& GetQuantizePolicy() const { return quantizePolicy; }
+
+	// t[̗vƌvZ
+	int GetRequestCount() const { return requestCount; }
+	int GetSampleCount() const { return static_cast<int>(entries.size()); }
+
+private:
+	struct Key
+	{
+		const ModelResource*	resource = nullptr;
+		int						animationIndex = -1;
+		float					time = 0;
+
+		bool operator==(const Key& other) const
+		{
+			return resource == other.resource && animationIndex == other.animationIndex && time == other.time;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct PendingRequest
+	{
+		const Model*			model = nullptr;
+		int						animationIndex = -1;
+		float					time = 0;
+		int						blockIndex = -1;
+	};
+
+private:
+	QuantizePolicy							quantizePolicy;
+	std::unordered_map<Key, int, KeyHash>	entries;			// L[pubNԍ
+	std::vector<std::vector<Model::NodePose>>	poseBlocks;		// t[܂ōėp
+	std::vector<PendingRequest>				pendingRequests;	// vZ̗v
+	int										requestCount = 0;
+};
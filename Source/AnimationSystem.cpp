@@ -0,0 +1,156 @@
+#include <algorithm>
+#include "Misc.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "AnimationBlendTree.h"
+#include "AnimationSystem.h"
+
+// CX^Xo^
+int AnimationSystem::AddInstance(Model* model)
+{
+	const int handle = static_cast<int>(instances.size());
+	Instance& instance = instances.emplace_back();
+	instance.model = model;
+	model->GetNodePoses(instance.nodePoses);
+
+	// LODŊԈꍇɑSCX^Xt[ōXVȂ悤ɂ炷
+	instance.lod.frameOffset = handle;
+	return handle;
+}
+
+// XV
+void AnimationSystem::Update(float elapsedTime)
+{
+	PROFILE_FUNCTION();
+
+	JobSystem& jobSystem = JobSystem::Instance();
+	const int instanceCount = static_cast<int>(instances.size());
+	Benchmark benchmark;
+
+	// Xe[WsiSCX^X𕪊ĕɌvZASďI܂ő҂j
+	auto runStage = [&](Stage stage, const char* name, auto function)
+	{
+		PROFILE_SCOPE(name);
+		benchmark.begin();
+		jobSystem.ParallelFor(instanceCount, grainSize, [&](int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				function(instances[i]);
+			}
+		});
+		stageTimes[static_cast<int>(stage)] += benchmark.end() * 1000.0f;
+	};
+	std::fill(std::begin(stageTimes), std::end(stageTimes), 0.0f);
+
+	// Lf[^̏̓CXbhōς܂AvZ͓ǂݎ肾ɂ
+	benchmark.begin();
+	if (lod != nullptr)
+	{
+		lod->BeginFrame();
+		for (Instance& instance : instances)
+		{
+			lod->UpdateLevel(instance.lod, instance.distance);
+			lod->GetNodeIndices(instance.model, instance.lod.level);
+		}
+	}
+	else if (poseCache != nullptr)
+	{
+		// pLbV͗v܂Ƃ߂ĂTvOɍs
+		poseCache->BeginFrame();
+		for (Instance& instance : instances)
+		{
+			instance.poseHandle = -1;
+			if (instance.animationIndex < 0) continue;
+			int quantizeStep = quantizePoseCache ? poseCache->ComputeQuantizeStep(instance.distance) : 0;
+			instance.poseHandle = poseCache->Request(instance.model, instance.animationIndex, instance.time, quantizeStep);
+		}
+		poseCache->SampleRequests();
+	}
+	stageTimes[static_cast<int>(Stage::Sample)] = benchmark.end() * 1000.0f;
+
+	runStage(Stage::Sample, "AnimationSystem::Sample", [this, elapsedTime](Instance& instance) { SampleStage(instance, elapsedTime); });
+	runStage(Stage::Blend, "AnimationSystem::Blend", [this](Instance& instance) { BlendStage(instance); });
+	runStage(Stage::Hierarchy, "AnimationSystem::Hierarchy", [this](Instance& instance) { HierarchyStage(instance); });
+	runStage(Stage::PostProcess, "AnimationSystem::PostProcess", [this](Instance& instance) { PostProcessStage(instance); });
+	runStage(Stage::Palette, "AnimationSystem::Palette", [this](Instance& instance) { PaletteStage(instance); });
+}
+
+// TvOXe[W
+void AnimationSystem::SampleStage(Instance& instance, float elapsedTime)
+{
+	if (instance.animationIndex < 0) return;
+
+	const Model* model = instance.model;
+	if (lod != nullptr)
+	{
+		lod->ComputeAnimation(instance.lod, model, instance.animationIndex, instance.time, elapsedTime, instance.nodePoses);
+	}
+	else if (instance.poseHandle >= 0)
+	{
+		AnimationPoseCache::PoseSpan pose = poseCache->GetPose(instance.poseHandle);
+		instance.nodePoses.assign(pose.begin(), pose.end());
+	}
+	else
+	{
+		model->ComputeAnimation(instance.animationIndex, instance.time, instance.nodePoses, instance.cursor);
+	}
+
+	// uh̃Nbv
+	if (instance.blendAnimationIndex >= 0 && instance.blendRate > 0.0f)
+	{
+		if (instance.blendPoses.size() != instance.nodePoses.size())
+		{
+			instance.blendPoses = instance.nodePoses;
+		}
+		model->ComputeAnimation(instance.blendAnimationIndex, instance.blendTime, instance.blendPoses, instance.blendCursor);
+	}
+}
+
+// uhXe[W
+void AnimationSystem::BlendStage(Instance& instance)
+{
+	if (instance.animationIndex < 0) return;
+
+	// LOD͑O̎pp߁ATvOp͏ɕʂ̔zփuh
+	if (instance.blendAnimationIndex >= 0 && instance.blendRate > 0.0f)
+	{
+		instance.blendedPoses.resize(instance.nodePoses.size());
+		for (size_t nodeIndex = 0; nodeIndex < instance.nodePoses.size(); ++nodeIndex)
+		{
+			AnimationBlendTree::BlendPose(instance.nodePoses[nodeIndex], instance.blendPoses[nodeIndex], instance.blendRate, instance.blendedPoses[nodeIndex]);
+		}
+		instance.model->SetNodePoses(instance.blendedPoses);
+	}
+	else
+	{
+		instance.model->SetNodePoses(instance.nodePoses);
+	}
+}
+
+// KwsvZXe[W
+void AnimationSystem::HierarchyStage(Instance& instance)
+{
+	instance.model->UpdateTransform(instance.worldTransform);
+}
+
+// IKEh̃Xe[W
+void AnimationSystem::PostProcessStage(Instance& instance)
+{
+	if (!instance.postProcess) return;
+
+	if (lod != nullptr)
+	{
+		const AnimationLOD::Level& level = lod->GetLevel(instance.lod.level);
+		if (!level.ik && !level.physicsBones) return;
+	}
+	instance.postProcess(instance);
+}
+
+// XLjOpbgXe[W
+void AnimationSystem::PaletteStage(Instance& instance)
+{
+	if (!paletteEnabled) return;
+
+	instance.model->ComputeSkinningPalette(instance.palette);
+}
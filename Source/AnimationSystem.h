@@ -0,0 +1,102 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <DirectXMath.h>
+#include "Model.h"
+#include "AnimationLOD.h"
+#include "AnimationPoseCache.h"
+
+// Aj[VVXeio^CX^X̎pvZXLjOpbg܂łXe[WɃWuVXeŕvZj
+class AnimationSystem
+{
+public:
+	// vZXe[WiÕXe[WSCX^XIĂ玟̃Xe[Wn߂j
+	enum class Stage
+	{
+		Sample,			// NbṽTvO
+		Blend,			// Q̃NbṽuhƎp̔f
+		Hierarchy,		// KwsvZ
+		PostProcess,	// IKEh́i[hsgߊKwsvŽɍsj
+		Palette,		// XLjOpbgvZ
+
+		EnumCount
+	};
+
+	// CX^Xi͂UpdatȇOɐݒ肵Ao͂UpdatěɎQƂj
+	// eXe[W͎̃CX^Xɂ݁ÃCX^X͎QƂȂ
+	struct Instance
+	{
+		// 
+		Model*							model = nullptr;
+		DirectX::XMFLOAT4X4				worldTransform = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		int								animationIndex = -1;
+		float							time = 0;
+		int								blendAnimationIndex = -1;	// uh̃Nbvi-1ŃuhȂj
+		float							blendTime = 0;
+		float							blendRate = 0;
+		float							distance = 0;				// LODƎԂ̗ʎqɎgJ̋
+		std::function<void(Instance&)>	postProcess;				// IKEh́iLODŗȏꍇ͌Ă΂Ȃj
+
+		// óiŏIIȎpƍs̓f̃m[hɔfj
+		std::vector<Model::NodePose>		nodePoses;			// TvOp
+		std::vector<DirectX::XMFLOAT4X4>	palette;			// ModelRendererɓnĕ`悷
+
+		// Ɨ̈
+		std::vector<Model::NodePose>		blendPoses;
+		std::vector<Model::NodePose>		blendedPoses;
+		Model::AnimationCursor				cursor;
+		Model::AnimationCursor				blendCursor;
+		AnimationLOD::Instance				lod;
+		int									poseHandle = -1;
+	};
+
+	AnimationSystem() = default;
+	~AnimationSystem() = default;
+
+	// CX^Xo^i߂l̃nhŎQƂj
+	int AddInstance(Model* model);
+
+	// CX^XS폜
+	void Clear() { instances.clear(); }
+
+	// CX^X擾
+	Instance& GetInstance(int handle) { return instances.at(handle); }
+	const Instance& GetInstance(int handle) const { return instances.at(handle); }
+	int GetInstanceCount() const { return static_cast<int>(instances.size()); }
+
+	// LODݒinullptrŖALȏꍇ͎pLbVg킸ɃCX^XɃTvOj
+	void SetLOD(AnimationLOD* lod) { this->lod = lod; }
+
+	// pLbVݒinullptrŖj
+	void SetPoseCache(AnimationPoseCache* poseCache, bool quantize) { this->poseCache = poseCache; quantizePoseCache = quantize; }
+
+	// XLjOpbgvZ邩iɂꍇ͕`掞ɌvZj
+	void SetPaletteEnabled(bool enabled) { paletteEnabled = enabled; }
+
+	// PWuŏCX^X
+	void SetGrainSize(int grainSize) { this->grainSize = grainSize; }
+
+	// XV
+	void Update(float elapsedTime);
+
+	// Xe[W̌vZԁi~bj
+	float GetStageTime(Stage stage) const { return stageTimes[static_cast<int>(stage)]; }
+
+private:
+	// Xe[WvZ
+	void SampleStage(Instance& instance, float elapsedTime);
+	void BlendStage(Instance& instance);
+	void HierarchyStage(Instance& instance);
+	void PostProcessStage(Instance& instance);
+	void PaletteStage(Instance& instance);
+
+private:
+	std::vector<Instance>		instances;
+	AnimationLOD*				lod = nullptr;
+	AnimationPoseCache*			poseCache = nullptr;
+	bool						quantizePoseCache = false;
+	bool						paletteEnabled = true;
+	int							grainSize = 8;
+	float						stageTimes[static_cast<int>(Stage::EnumCount)] = {};
+};
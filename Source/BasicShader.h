@@ -23,8 +23,10 @@ private:
 		DirectX::XMFLOAT4		materialColor;
 	};
 
-	Microsoft::WRL::ComPtr<ID3D11VertexShader>		vertexShader;
+	static const int VertexFormatCount = static_cast<int>(ModelResource::VertexFormat::EnumCount);
+
+	Microsoft::WRL::ComPtr<ID3D11VertexShader>		vertexShaders[VertexFormatCount];
 	Microsoft::WRL::ComPtr<ID3D11PixelShader>		pixelShader;
-	Microsoft::WRL::ComPtr<ID3D11InputLayout>		inputLayout;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout>		inputLayouts[VertexFormatCount];
 	Microsoft::WRL::ComPtr<ID3D11Buffer>			meshConstantBuffer;
 };
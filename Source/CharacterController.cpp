@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cmath>
+#include "Profiler.h"
+#include "CharacterController.h"
+
+// ړƂ݂Ȃŏ
+static const float MinMoveDistance = 0.0001f;
+
+// ړ
+unsigned int CharacterController::Move(const CollisionWorld& world, const DirectX::XMFLOAT3& displacement)
+{
+	PROFILE_FUNCTION();
+
+	const bool wasGrounded = grounded;
+
+	MoveState state;
+	state.position = position;
+
+	// Öړɒn`ꍇȂǂ̂߂荞݂
+	Depenetrate(world, state);
+
+	// ړ
+	DirectX::XMFLOAT3 horizontal = { displacement.x, 0, displacement.z };
+	if (horizontal.x * horizontal.x + horizontal.z * horizontal.z > MinMoveDistance * MinMoveDistance)
+	{
+		MoveHorizontal(world, state, horizontal, wasGrounded);
+	}
+
+	// cړ
+	DirectX::XMFLOAT3 vertical = { 0, displacement.y, 0 };
+	SlideMove(world, state, vertical, true);
+
+	// OڒnĂč񕂂ꍇ͒nʂɋz
+	// X[vKiۂɕȂ悤ɂ邽
+	if (wasGrounded && !state.grounded && displacement.y <= 0.0f)
+	{
+		SnapToGround(world, state);
+	}
+
+	// ړ̂߂荞݂
+	Depenetrate(world, state);
+
+	position = state.position;
+	groundNormal = state.grounded ? state.groundNormal : DirectX::XMFLOAT3(0, 1, 0);
+	collisionFlags = state.collisionFlags;
+	grounded = state.grounded;
+	return collisionFlags;
+}
+
+// ړ
+void CharacterController::MoveHorizontal(const CollisionWorld& world, MoveState& state, const DirectX::XMFLOAT3& move, bool wasGrounded) const
+{
+	// ̂܂܈ړ
+	MoveState slideState = state;
+	SlideMove(world, slideState, move, false);
+
+	// ڒnɑʂɓꍇ͒iz邩
+	if (!wasGrounded || settings.stepOffset <= 0.0f || (slideState.collisionFlags & CollisionSides) == 0)
+	{
+		state = slideState;
+		return;
+	}
+
+	MoveState stepState = state;
+	CollisionWorld::HitResult hit;
+
+	// VɓȂ܂Ŏグ
+	const DirectX::XMFLOAT3 up = { 0, 1, 0 };
+	float stepHeight = settings.stepOffset;
+	if (CapsuleCast(world, stepState.position, up, stepHeight + settings.skinWidth, hit))
+	{
+		stepHeight = (std::max)(hit.distance - settings.skinWidth, 0.0f);
+	}
+	stepState.position.y += stepHeight;
+
+	// グňړ
+	SlideMove(world, stepState, move, false);
+
+	// グ낷
+	const DirectX::XMFLOAT3 down = { 0, -1, 0 };
+	if (CapsuleCast(world, stepState.position, down, stepHeight + settings.skinWidth, hit))
+	{
+		// ȉʂnʂƂ݂ȂȂꍇ͏zȂ
+		if (!IsWalkable(hit.normal))
+		{
+			state = slideState;
+			return;
+		}
+		stepState.position.y -= (std::max)(hit.distance - settings.skinWidth, 0.0f);
+		ClassifyHit(stepState, hit.normal);
+	}
+	else
+	{
+		stepState.position.y -= stepHeight;
+	}
+
+	// ɒړł̗p
+	auto horizontalDistanceSq = [&](const MoveState& s)
+	{
+		float x = s.position.x - state.position.x;
+		float z = s.position.z - state.position.z;
+		return x * x + z * z;
+	};
+	state = horizontalDistanceSq(stepState) > horizontalDistanceSq(slideState) ? stepState : slideState;
+}
+
+// ړ
+void CharacterController::SlideMove(const CollisionWorld& world, MoveState& state, const DirectX::XMFLOAT3& move, bool vertical) const
+{
+	DirectX::XMVECTOR Position = DirectX::XMLoadFloat3(&state.position);
+	DirectX::XMVECTOR Move = DirectX::XMLoadFloat3(&move);
+
+	for (int i = 0; i < settings.maxSlideIterations; ++i)
+	{
+		// LXgʂZo
+		float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Move));
+		if (distance < MinMoveDistance) break;
+
+		DirectX::XMVECTOR Direction = DirectX::XMVectorScale(Move, 1.0f / distance);
+		DirectX::XMFLOAT3 origin, direction;
+		DirectX::XMStoreFloat3(&origin, Position);
+		DirectX::XMStoreFloat3(&direction, Direction);
+
+		// ǂ菭OŎ~܂Ăق̂ŏLXgʂ𑝂₷
+		CollisionWorld::HitResult hit;
+		if (!CapsuleCast(world, origin, direction, distance + settings.skinWidth, hit))
+		{
+			// Ȃ̂ŕʂɈړ
+			Position = DirectX::XMVectorAdd(Position, Move);
+			break;
+		}
+
+		// LXgʂ𑝂₵O܂ňړ
+		float travel = (std::max)(hit.distance - settings.skinWidth, 0.0f);
+		DirectX::XMVECTOR Vec = DirectX::XMVectorScale(Direction, travel);
+		Position = DirectX::XMVectorAdd(Position, Vec);
+
+		ClassifyHit(state, hit.normal);
+		bool walkable = IsWalkable(hit.normal);
+
+		// ̏cړŒnʂɒnꍇ͊Ȃ
+		if (vertical && walkable && move.y < 0.0f) break;
+
+		// 菈
+		{
+			// ړʂ炷
+			Move = DirectX::XMVectorSubtract(Move, Vec);
+
+			// ړǂɉ悤ړxNgZo
+			DirectX::XMVECTOR HitNormal = DirectX::XMLoadFloat3(&hit.normal);
+			float dot = DirectX::XMVectorGetX(DirectX::XMVector3Dot(Move, HitNormal));
+			Move = DirectX::XMVectorSubtract(Move, DirectX::XMVectorScale(HitNormal, dot));
+
+			// nʂƂ݂ȂȂΖʂǂ͉ړœoȂ悤ɂ
+			if (!vertical && !walkable && DirectX::XMVectorGetY(Move) > 0.0f)
+			{
+				Move = DirectX::XMVectorSetY(Move, 0.0f);
+			}
+		}
+	}
+
+	DirectX::XMStoreFloat3(&state.position, Position);
+}
+
+// nʂւ̋z
+void CharacterController::SnapToGround(const CollisionWorld& world, MoveState& state) const
+{
+	const DirectX::XMFLOAT3 down = { 0, -1, 0 };
+	CollisionWorld::HitResult hit;
+	if (!CapsuleCast(world, state.position, down, settings.groundSnapDistance + settings.skinWidth, hit)) return;
+	if (!IsWalkable(hit.normal)) return;
+
+	state.position.y -= (std::max)(hit.distance - settings.skinWidth, 0.0f);
+	ClassifyHit(state, hit.normal);
+}
+
+// ߂荞݉
+void CharacterController::Depenetrate(const CollisionWorld& world, MoveState& state) const
+{
+	float spacing;
+	const int sphereCount = GetSphereCount(spacing);
+
+	CollisionWorld::Contact contacts[MaxContacts];
+	for (int iteration = 0; iteration < settings.maxDepenetrationIterations; ++iteration)
+	{
+		// SĂ̋̒ōł[߂荞łڐG߂
+		CollisionWorld::Contact deepest;
+		for (int i = 0; i < sphereCount; ++i)
+		{
+			DirectX::XMFLOAT3 center = state.position;
+			center.y += settings.radius + spacing * i;
+
+			int contactCount = world.OverlapSphere(center, settings.radius, contacts, MaxContacts);
+			for (int j = 0; j < contactCount; ++j)
+			{
+				if (contacts[j].depth > deepest.depth)
+				{
+					deepest = contacts[j];
+				}
+			}
+		}
+		if (deepest.depth <= 0.0f) break;
+
+		// ߂荞ݗʂɌԂĉoAoōēx肷
+		float push = deepest.depth + settings.skinWidth;
+		state.position.x += deepest.normal.x * push;
+		state.position.y += deepest.normal.y * push;
+		state.position.z += deepest.normal.z * push;
+		ClassifyHit(state, deepest.normal);
+	}
+}
+
+// JvZLXg
+bool CharacterController::CapsuleCast(
+	const CollisionWorld& world,
+	const DirectX::XMFLOAT3& position,
+	const DirectX::XMFLOAT3& direction,
+	float distance,
+	CollisionWorld::HitResult& hit) const
+{
+	float spacing;
+	const int sphereCount = GetSphereCount(spacing);
+
+	// ^Ɛ^̃LXg͐擪̋肷΂悢
+	int first = 0;
+	int last = sphereCount - 1;
+	if (direction.y <= -0.999f) last = first;
+	else if (direction.y >= 0.999f) first = last;
+
+	bool result = false;
+	float nearestDistance = distance;
+	for (int i = first; i <= last; ++i)
+	{
+		DirectX::XMFLOAT3 origin = position;
+		origin.y += settings.radius + spacing * i;
+
+		CollisionWorld::HitResult sphereHit;
+		if (world.SphereCast(origin, direction, settings.radius, nearestDistance, sphereHit) && sphereHit.distance < nearestDistance)
+		{
+			nearestDistance = sphereHit.distance;
+			hit = sphereHit;
+			result = true;
+		}
+	}
+	return result;
+}
+
+// Փ˂𔻒
+void CharacterController::ClassifyHit(MoveState& state, const DirectX::XMFLOAT3& normal) const
+{
+	if (IsWalkable(normal))
+	{
+		state.collisionFlags |= CollisionBelow;
+		state.grounded = true;
+		state.groundNormal = normal;
+	}
+	else if (normal.y < 0.0f)
+	{
+		state.collisionFlags |= CollisionAbove;
+	}
+	else
+	{
+		state.collisionFlags |= CollisionSides;
+	}
+}
+
+// nʂƂ݂ȂX΂
+bool CharacterController::IsWalkable(const DirectX::XMFLOAT3& normal) const
+{
+	return normal.y >= cosf(DirectX::XMConvertToRadians(settings.slopeLimit));
+}
+
+// JvZ\鋅̐ƊԊu
+int CharacterController::GetSphereCount(float& spacing) const
+{
+	// ̊Ԋu𔼌aȉɂāÅԂ̂т𔼌a14%ȉɗ}i̐ɒBꍇ͊ԊuLj
+	float length = (std::max)(settings.height - settings.radius * 2.0f, 0.0f);
+	if (length <= 0.0f || settings.radius <= 0.0f)
+	{
+		spacing = 0.0f;
+		return 1;
+	}
+	int count = 1 + static_cast<int>(std::ceil(length / settings.radius));
+	count = (std::min)(count, MaxCapsuleSpheres);
+	spacing = length / static_cast<float>(count - 1);
+	return count;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include "CollisionWorld.h"
+
+// LN^[Rg[[iYɗĂJvZՓ˔胏[hɉĈړj
+// ɎgƗ̈͌Œ蒷Ŏ߁AړœImۂ͍sȂ
+class CharacterController
+{
+public:
+	// Փ˂iMove̖߂lj
+	static const unsigned int CollisionNone = 0;
+	static const unsigned int CollisionSides = (1 << 0);	// 
+	static const unsigned int CollisionAbove = (1 << 1);	// V
+	static const unsigned int CollisionBelow = (1 << 2);	// n
+
+	struct Settings
+	{
+		float	radius = 0.5f;
+		float	height = 2.0f;					// JvZŜ̍iâQ{ȏj
+		float	skinWidth = 0.01f;				// n`Ƃ̊Ԃɋ󂯂錄
+		float	stepOffset = 0.3f;				// zi̍
+		float	slopeLimit = 45.0f;				// nʂƂ݂ȂX΂̏ixj
+		float	groundSnapDistance = 0.2f;		// ڒnɒnʂ֋z鋗
+		int		maxSlideIterations = 3;
+		int		maxDepenetrationIterations = 4;
+	};
+
+	CharacterController() = default;
+	~CharacterController() = default;
+
+	// ݒ
+	void SetSettings(const Settings& settings) { this->settings = settings; }
+	const Settings& GetSettings() const { return settings; }
+
+	// ̈ʒu
+	void SetPosition(const DirectX::XMFLOAT3& position) { this->position = position; }
+	const DirectX::XMFLOAT3& GetPosition() const { return position; }
+
+	// ړiړ͒izȂ犊点Acړ͒nʂɒn~߂j
+	unsigned int Move(const CollisionWorld& world, const DirectX::XMFLOAT3& displacement);
+
+	// ڒnĂ邩
+	bool IsGrounded() const { return grounded; }
+
+	// ڒnĂnʂ̖@
+	const DirectX::XMFLOAT3& GetGroundNormal() const { return groundNormal; }
+
+	// ÖړŏՓ˂
+	unsigned int GetCollisionFlags() const { return collisionFlags; }
+
+private:
+	// ړ̏ԁiiz͎sĂ̗p邽ߏԂƕj
+	struct MoveState
+	{
+		DirectX::XMFLOAT3	position;
+		DirectX::XMFLOAT3	groundNormal = { 0, 1, 0 };
+		unsigned int		collisionFlags = CollisionNone;
+		bool				grounded = false;
+	};
+
+	// ړiiɓꍇ͎グĈړAړł̗pj
+	void MoveHorizontal(const CollisionWorld& world, MoveState& state, const DirectX::XMFLOAT3& move, bool wasGrounded) const;
+
+	// ړ
+	void SlideMove(const CollisionWorld& world, MoveState& state, const DirectX::XMFLOAT3& move, bool vertical) const;
+
+	// nʂւ̋z
+	void SnapToGround(const CollisionWorld& world, MoveState& state) const;
+
+	// ߂荞݉
+	void Depenetrate(const CollisionWorld& world, MoveState& state) const;
+
+	// JvZLXgiJvZ̎ɕׂŃLXgAł߂_߂j
+	bool CapsuleCast(
+		const CollisionWorld& world,
+		const DirectX::XMFLOAT3& position,
+		const DirectX::XMFLOAT3& direction,
+		float distance,
+		CollisionWorld::HitResult& hit) const;
+
+	// Փ˂ʂ̖@Փ˂𔻒肵AnʂȂڒnԂɂ
+	void ClassifyHit(MoveState& state, const DirectX::XMFLOAT3& normal) const;
+
+	// nʂƂ݂ȂX΂
+	bool IsWalkable(const DirectX::XMFLOAT3& normal) const;
+
+	// JvZ\鋅̐ƊԊu
+	int GetSphereCount(float& spacing) const;
+
+private:
+	static const int	MaxCapsuleSpheres = 8;
+	static const int	MaxContacts = 16;
+
+	Settings			settings;
+	DirectX::XMFLOAT3	position = { 0, 0, 0 };
+	DirectX::XMFLOAT3	groundNormal = { 0, 1, 0 };
+	unsigned int		collisionFlags = CollisionNone;
+	bool				grounded = false;
+};
@@ -0,0 +1,426 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <windows.h>
+#include <shellapi.h>
+#include <DirectXCollision.h>
+#include <SphereCast.h>
+#include "JobSystem.h"
+#include "Model.h"
+#include "TriangleBVH.h"
+#include "TriangleGrid.h"
+#include "StaticCollisionMesh.h"
+#include "RaycastBatch.h"
+#include "CollisionTest.h"
+#include "Scene/CharacterControlScene.h"
+
+// ƈvƂ݂ȂEʒǔ덷
+static const float Tolerance = 1.0e-4f;
+
+// svL^
+static void AddError(std::vector<std::string>& errors, const char* name, int queryIndex)
+{
+	char message[256];
+	snprintf(message, sizeof(message), "%s mismatch (query %d)", name, queryIndex);
+	errors.emplace_back(message);
+}
+
+// ̗LƋv邩
+static bool MatchHit(bool expectedHit, float expectedDistance, bool hit, float distance)
+{
+	return expectedHit == hit && (!hit || fabsf(expectedDistance - distance) < Tolerance);
+}
+
+// Wv邩
+static bool MatchPosition(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b)
+{
+	return fabsf(a.x - b.x) < Tolerance && fabsf(a.y - b.y) < Tolerance && fabsf(a.z - b.z) < Tolerance;
+}
+
+// ł̃CLXg
+static bool BruteForceRaycast(const TriangleBVH& bvh, const DirectX::XMFLOAT3& start, const DirectX::XMFLOAT3& end, float& distance)
+{
+	DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&start);
+	DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&end), Start);
+	DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(Vec);
+	distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+	bool hit = false;
+	for (int i = 0; i < bvh.GetTriangleCount(); ++i)
+	{
+		const TriangleBVH::Triangle& triangle = bvh.GetTriangle(i);
+		DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&triangle.positions[0]);
+		DirectX::XMVECTOR B = DirectX::XMLoadFloat3(&triangle.positions[1]);
+		DirectX::XMVECTOR C = DirectX::XMLoadFloat3(&triangle.positions[2]);
+		float dist;
+		if (DirectX::TriangleTests::Intersects(Start, Direction, A, B, C, dist) && dist < distance)
+		{
+			distance = dist;
+			hit = true;
+		}
+	}
+	return hit;
+}
+
+// R}hCɃeXgw肪邩
+bool CollisionTest::IsRequested(const wchar_t* commandLine)
+{
+	return commandLine != nullptr && wcsstr(commandLine, L"-collisiontest") != nullptr;
+}
+
+// R}hCs
+int CollisionTest::RunCommandLine(const wchar_t* commandLine)
+{
+	// UTF-8ɕϊ
+	std::vector<std::string> args;
+	{
+		int argc = 0;
+		LPWSTR* argv = CommandLineToArgvW(commandLine, &argc);
+		for (int i = 0; i < argc; ++i)
+		{
+			char arg[MAX_PATH];
+			WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, arg, sizeof(arg), nullptr, nullptr);
+			args.emplace_back(arg);
+		}
+		LocalFree(argv);
+	}
+
+	// 
+	std::string stageFilename = "Data/Model/Stage/ExampleStage.glb";
+	std::string outputFilename = "CollisionTest.txt";
+	for (size_t i = 0; i + 1 < args.size(); ++i)
+	{
+		const std::string& option = args[i];
+		const std::string& value = args[i + 1];
+		if (option == "-stage") stageFilename = value;
+		else if (option == "-out") outputFilename = value;
+		else continue;
+		++i;
+	}
+
+	// ob`̓WuVXeŕ
+	JobSystem::Instance().Initialize();
+	std::vector<std::string> errors;
+	int checkCount = Run(stageFilename.c_str(), errors);
+	JobSystem::Instance().Finalize();
+
+	// ʏóit@CƁAR\[Nꂽꍇ̓R\[j
+	std::string text = stageFilename + " : " + std::to_string(checkCount) + " checks, " + std::to_string(errors.size()) + " mismatches\n";
+	for (const std::string& error : errors)
+	{
+		text += error + "\n";
+	}
+	std::ofstream stream(outputFilename);
+	stream << text;
+	OutputDebugStringA(text.c_str());
+	if (AttachConsole(ATTACH_PARENT_PROCESS))
+	{
+		DWORD written;
+		WriteConsoleA(GetStdHandle(STD_OUTPUT_HANDLE), text.c_str(), static_cast<DWORD>(text.size()), &written, nullptr);
+		FreeConsole();
+	}
+
+	return checkCount > 0 && errors.empty() ? 0 : 1;
+}
+
+// eXgs
+int CollisionTest::Run(const char* stageFilename, std::vector<std::string>& errors)
+{
+	// Xe[WiGPU\[X炸ɓǂݍށj
+	std::shared_ptr<Model> stage = std::make_shared<Model>(nullptr, stageFilename);
+	DirectX::XMFLOAT4X4 identity;
+	DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+	stage->UpdateTransform(identity);
+
+	TriangleBVH bvh;
+	bvh.Build(stage.get());
+	if (bvh.GetTriangleCount() == 0)
+	{
+		errors.emplace_back(std::string("no triangles in ") + stageFilename);
+		return 0;
+	}
+
+	std::vector<TriangleBVH::Triangle> triangles;
+	triangles.reserve(bvh.GetTriangleCount());
+	for (int i = 0; i < bvh.GetTriangleCount(); ++i)
+	{
+		triangles.emplace_back(bvh.GetTriangle(i));
+	}
+	TriangleGrid grid;
+	grid.Build(triangles, 2.0f);
+
+	StaticCollisionMesh collisionMesh;
+	collisionMesh.Build(stage.get());
+
+	Target target;
+	target.bvh = &bvh;
+	target.grid = &grid;
+	target.collisionMesh = &collisionMesh;
+
+	int checkCount = 0;
+	checkCount += VerifyRaycast(target, errors);
+	checkCount += VerifySpherePush(target, errors);
+	checkCount += VerifySphereCast(target, errors);
+	return checkCount;
+}
+
+// CLXg
+int CollisionTest::VerifyRaycast(const Target& target, std::vector<std::string>& errors)
+{
+	const TriangleBVH& bvh = *target.bvh;
+	const TriangleBVH::Node& root = bvh.GetNodes().front();
+	const DirectX::XMFLOAT3& volumeMin = root.boundsMin;
+	const DirectX::XMFLOAT3& volumeMax = root.boundsMax;
+
+	// ^ォ̃CA΂߂̃CÃCXe[WŜɊiqɕׂ
+	std::vector<DirectX::XMFLOAT3> starts, ends;
+	const int division = 32;
+	const float sizeX = volumeMax.x - volumeMin.x;
+	const float sizeZ = volumeMax.z - volumeMin.z;
+	const float centerY = (volumeMin.y + volumeMax.y) * 0.5f;
+	for (int z = 0; z <= division; ++z)
+	{
+		for (int x = 0; x <= division; ++x)
+		{
+			float px = volumeMin.x + sizeX * x / division;
+			float pz = volumeMin.z + sizeZ * z / division;
+			starts.push_back({ px, volumeMax.y + 1.0f, pz });
+			ends.push_back({ px, volumeMin.y - 1.0f, pz });
+			starts.push_back({ px, volumeMax.y + 1.0f, pz });
+			ends.push_back({ px + sizeX * 0.25f, volumeMin.y - 1.0f, pz - sizeZ * 0.25f });
+			starts.push_back({ px, centerY, pz });
+			ends.push_back({ px + 5.0f, centerY, pz + 3.0f });
+		}
+	}
+	const int rayCount = static_cast<int>(starts.size());
+
+	// P{̔
+	std::vector<char> expectedHits(rayCount);
+	std::vector<float> expectedDistances(rayCount);
+	for (int i = 0; i < rayCount; ++i)
+	{
+		expectedHits[i] = BruteForceRaycast(bvh, starts[i], ends[i], expectedDistances[i]) ? 1 : 0;
+
+		TriangleBVH::HitResult hit;
+		bool result = bvh.RayCast(starts[i], ends[i], hit);
+		if (!MatchHit(expectedHits[i] != 0, expectedDistances[i], result, hit.distance)) AddError(errors, "TriangleBVH::RayCast", i);
+
+		TriangleGrid::HitResult gridHit;
+		result = target.grid->RayCast(starts[i], ends[i], gridHit);
+		if (!MatchHit(expectedHits[i] != 0, expectedDistances[i], result, gridHit.distance)) AddError(errors, "TriangleGrid::RayCast", i);
+
+		StaticCollisionMesh::HitResult meshHit;
+		result = target.collisionMesh->RayCast(starts[i], ends[i], meshHit);
+		if (!MatchHit(expectedHits[i] != 0, expectedDistances[i], result, meshHit.distance)) AddError(errors, "StaticCollisionMesh::RayCast", i);
+	}
+
+	// S{̃pPbgł̔i̗L߂ꍇ͋ƍȂj
+	for (int first = 0; first < rayCount; first += TriangleBlocks::BlockSize)
+	{
+		const int count = (std::min)(TriangleBlocks::BlockSize, rayCount - first);
+		for (bool anyHit : { false, true })
+		{
+			TriangleBVH::HitResult hits[TriangleBlocks::BlockSize];
+			bool results[TriangleBlocks::BlockSize];
+			bvh.RayCastPacket(&starts[first], &ends[first], count, hits, results, anyHit);
+			for (int i = 0; i < count; ++i)
+			{
+				const int index = first + i;
+				if (!MatchHit(expectedHits[index] != 0, expectedDistances[index], results[i], anyHit ? expectedDistances[index] : hits[i].distance))
+				{
+					AddError(errors, anyHit ? "TriangleBVH::RayCastPacket(any)" : "TriangleBVH::RayCastPacket", index);
+				}
+			}
+
+			target.collisionMesh->RayCastPacket(&starts[first], &ends[first], count, hits, results, anyHit);
+			for (int i = 0; i < count; ++i)
+			{
+				const int index = first + i;
+				if (!MatchHit(expectedHits[index] != 0, expectedDistances[index], results[i], anyHit ? expectedDistances[index] : hits[i].distance))
+				{
+					AddError(errors, anyHit ? "StaticCollisionMesh::RayCastPacket(any)" : "StaticCollisionMesh::RayCastPacket", index);
+				}
+			}
+		}
+	}
+
+	// ob`ł̔
+	RaycastBatch batch;
+	for (int i = 0; i < rayCount; ++i)
+	{
+		batch.AddRay(starts[i], ends[i]);
+	}
+	batch.Execute(bvh);
+	for (int i = 0; i < rayCount; ++i)
+	{
+		bool hit = batch.IsHit(i);
+		if (!MatchHit(expectedHits[i] != 0, expectedDistances[i], hit, hit ? batch.GetHit(i).distance : 0.0f)) AddError(errors, "RaycastBatch::Execute(TriangleBVH)", i);
+	}
+	batch.Execute(*target.collisionMesh);
+	for (int i = 0; i < rayCount; ++i)
+	{
+		bool hit = batch.IsHit(i);
+		if (!MatchHit(expectedHits[i] != 0, expectedDistances[i], hit, hit ? batch.GetHit(i).distance : 0.0f)) AddError(errors, "RaycastBatch::Execute(StaticCollisionMesh)", i);
+	}
+
+	return rayCount * 7;
+}
+
+// ̉o
+int CollisionTest::VerifySpherePush(const Target& target, std::vector<std::string>& errors)
+{
+	using HitResult = CharacterControlScene::HitResult;
+
+	const TriangleBVH& bvh = *target.bvh;
+	const TriangleBVH::Node& root = bvh.GetNodes().front();
+	const DirectX::XMFLOAT3& volumeMin = root.boundsMin;
+	const DirectX::XMFLOAT3& volumeMax = root.boundsMax;
+	const float radius = 0.5f;
+
+	// nʂɂ߂荞܂ƁAXe[W̃_Ȉʒű
+	std::vector<DirectX::XMFLOAT3> centers;
+	const int division = 32;
+	for (int z = 0; z <= division; ++z)
+	{
+		for (int x = 0; x <= division; ++x)
+		{
+			float px = volumeMin.x + (volumeMax.x - volumeMin.x) * x / division;
+			float pz = volumeMin.z + (volumeMax.z - volumeMin.z) * z / division;
+			TriangleBVH::HitResult hit;
+			if (bvh.RayCast({ px, volumeMax.y + 1.0f, pz }, { px, volumeMin.y - 1.0f, pz }, hit))
+			{
+				centers.push_back({ hit.position.x, hit.position.y + radius * 0.5f, hit.position.z });
+			}
+		}
+	}
+	std::mt19937 random(0x5EED);
+	std::uniform_real_distribution<float> randomX(volumeMin.x, volumeMax.x);
+	std::uniform_real_distribution<float> randomY(volumeMin.y, volumeMax.y);
+	std::uniform_real_distribution<float> randomZ(volumeMin.z, volumeMax.z);
+	for (int i = 0; i < 1024; ++i)
+	{
+		centers.push_back({ randomX(random), randomY(random), randomZ(random) });
+	}
+
+	// ł͑SOp`ɔ肵AoꂽʒuŎ̎Op`𔻒肷
+	std::vector<HitResult> expectedHits, hits;
+	const int sphereCount = static_cast<int>(centers.size());
+	for (int i = 0; i < sphereCount; ++i)
+	{
+		expectedHits.clear();
+		DirectX::XMFLOAT3 center = centers[i];
+		for (int triangleIndex = 0; triangleIndex < bvh.GetTriangleCount(); ++triangleIndex)
+		{
+			const TriangleBVH::Triangle& triangle = bvh.GetTriangle(triangleIndex);
+			HitResult hit;
+			if (CharacterControlScene::SphereIntersectTriangle(center, radius,
+				triangle.positions[0], triangle.positions[1], triangle.positions[2],
+				hit.position, hit.normal))
+			{
+				expectedHits.emplace_back(hit);
+				center = hit.position;
+			}
+		}
+
+		auto matchHits = [&]()
+		{
+			if (hits.size() != expectedHits.size()) return false;
+			for (size_t j = 0; j < hits.size(); ++j)
+			{
+				if (!MatchPosition(hits[j].position, expectedHits[j].position)) return false;
+				if (!MatchPosition(hits[j].normal, expectedHits[j].normal)) return false;
+			}
+			return true;
+		};
+
+		CharacterControlScene::SphereIntersectModel(centers[i], radius, bvh, hits);
+		if (!matchHits()) AddError(errors, "SphereIntersectModel(TriangleBVH)", i);
+
+		CharacterControlScene::SphereIntersectModel(centers[i], radius, *target.collisionMesh, hits);
+		if (!matchHits()) AddError(errors, "SphereIntersectModel(StaticCollisionMesh)", i);
+
+		// ̎Op`ŌOp`ׂĊ܂ł邩
+		std::vector<int> candidates;
+		bvh.QuerySphere(centers[i], radius, candidates);
+		DirectX::BoundingSphere sphere;
+		sphere.Center = centers[i];
+		sphere.Radius = radius;
+		for (int triangleIndex = 0; triangleIndex < bvh.GetTriangleCount(); ++triangleIndex)
+		{
+			const TriangleBVH::Triangle& triangle = bvh.GetTriangle(triangleIndex);
+			DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&triangle.positions[0]);
+			DirectX::XMVECTOR B = DirectX::XMLoadFloat3(&triangle.positions[1]);
+			DirectX::XMVECTOR C = DirectX::XMLoadFloat3(&triangle.positions[2]);
+			if (sphere.Intersects(A, B, C) && !std::binary_search(candidates.begin(), candidates.end(), triangleIndex))
+			{
+				AddError(errors, "TriangleBVH::QuerySphere", i);
+				break;
+			}
+		}
+	}
+
+	return sphereCount * 3;
+}
+
+// XtBALXg
+int CollisionTest::VerifySphereCast(const Target& target, std::vector<std::string>& errors)
+{
+	const TriangleBVH& bvh = *target.bvh;
+	const TriangleBVH::Node& root = bvh.GetNodes().front();
+	const DirectX::XMFLOAT3& volumeMin = root.boundsMin;
+	const DirectX::XMFLOAT3& volumeMax = root.boundsMax;
+	const float radius = 0.5f;
+
+	// Xe[ŴQ_Ԃړ鋅
+	std::mt19937 random(0xCA57);
+	std::uniform_real_distribution<float> randomX(volumeMin.x, volumeMax.x);
+	std::uniform_real_distribution<float> randomY(volumeMin.y, volumeMax.y);
+	std::uniform_real_distribution<float> randomZ(volumeMin.z, volumeMax.z);
+	const int castCount = 1024;
+	for (int i = 0; i < castCount; ++i)
+	{
+		DirectX::XMFLOAT3 start = { randomX(random), randomY(random), randomZ(random) };
+		DirectX::XMFLOAT3 end = { randomX(random), randomY(random), randomZ(random) };
+
+		// ̃LXginʂւ̒nj
+		if (i % 2 == 0)
+		{
+			end = { start.x, volumeMin.y - 1.0f, start.z };
+		}
+
+		DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&start);
+		DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&end), Start);
+		DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(Vec);
+		float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+		DirectX::XMVECTOR End = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(Direction, distance));
+		DirectX::XMFLOAT3 direction;
+		DirectX::XMStoreFloat3(&direction, Direction);
+
+		// 
+		bool expectedHit = false;
+		float expectedDistance = distance;
+		for (int triangleIndex = 0; triangleIndex < bvh.GetTriangleCount(); ++triangleIndex)
+		{
+			const TriangleBVH::Triangle& triangle = bvh.GetTriangle(triangleIndex);
+			DirectX::XMVECTOR Positions[3] =
+			{
+				DirectX::XMLoadFloat3(&triangle.positions[0]),
+				DirectX::XMLoadFloat3(&triangle.positions[1]),
+				DirectX::XMLoadFloat3(&triangle.positions[2]),
+			};
+			SphereCastResult result;
+			if (IntersectSphereCastVsTriangle(Start, End, radius, Positions, &result) && result.distance < expectedDistance)
+			{
+				expectedDistance = result.distance;
+				expectedHit = true;
+			}
+		}
+
+		TriangleBVH::HitResult hit;
+		bool result = bvh.SphereCast(start, direction, radius, distance, hit);
+		if (!MatchHit(expectedHit, expectedDistance, result, hit.distance)) AddError(errors, "TriangleBVH::SphereCast", i);
+	}
+
+	return castCount;
+}
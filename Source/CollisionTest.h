@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class TriangleBVH;
+class TriangleGrid;
+class StaticCollisionMesh;
+
+// Փ˔eXgiXe[WőƏƍj
+// EChEƃfoCX炸Ɏs邽߁A[XrhłmFł
+class CollisionTest
+{
+public:
+	// R}hCɃeXgw肪邩
+	static bool IsRequested(const wchar_t* commandLine);
+
+	// R}hCsi-collisiontest [-stage t@C] [-out t@C]Asv1Ԃj
+	static int RunCommandLine(const wchar_t* commandLine);
+
+	// eXgsisv̓eerrorsɒǉAƍԂj
+	static int Run(const char* stageFilename, std::vector<std::string>& errors);
+
+private:
+	// Ώ
+	struct Target
+	{
+		const TriangleBVH*			bvh;
+		const TriangleGrid*			grid;
+		const StaticCollisionMesh*	collisionMesh;
+	};
+
+	// CLXgiBVHAObhAÓIՓ˔胁bVApPbgAob`j
+	static int VerifyRaycast(const Target& target, std::vector<std::string>& errors);
+
+	// ̉oiCharacterControlScene::SphereIntersectModelj
+	static int VerifySpherePush(const Target& target, std::vector<std::string>& errors);
+
+	// XtBALXg
+	static int VerifySphereCast(const Target& target, std::vector<std::string>& errors);
+};
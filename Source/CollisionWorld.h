@@ -0,0 +1,42 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+// Փ˔胏[hiLN^[Rg[[n`𔻒肷鑋A@ɍ킹Ďւj
+// ̃Rg[[ɌĂяo邽߁A֐œԂȂ
+class CollisionWorld
+{
+public:
+	// XtBALXg
+	struct HitResult
+	{
+		DirectX::XMFLOAT3	position;			// Փˎ̋̒S
+		DirectX::XMFLOAT3	normal;				// Փ˂ʂ̖@
+		float				distance = 0.0f;	// n_Փˎ̋̒S܂ł̋
+	};
+
+	// ƒn`̐ڐG
+	struct Contact
+	{
+		DirectX::XMFLOAT3	normal;				// n`狅̒S։o
+		float				depth = 0.0f;		// ߂荞ݗ
+	};
+
+	CollisionWorld() = default;
+	virtual ~CollisionWorld() = default;
+
+	// XtBALXgił߂_߂Adirection͐Kς݁j
+	virtual bool SphereCast(
+		const DirectX::XMFLOAT3& origin,
+		const DirectX::XMFLOAT3& direction,
+		float radius,
+		float distance,
+		HitResult& hit) const = 0;
+
+	// ƐڐGĂn`WiڐGmaxContacts𒴂ꍇ͂߂荞݂̐[̂cAi[Ԃj
+	virtual int OverlapSphere(
+		const DirectX::XMFLOAT3& center,
+		float radius,
+		Contact contacts[],
+		int maxContacts) const = 0;
+};
@@ -5,6 +5,9 @@
 #include "Framework.h"
 #include "Graphics.h"
 #include "ImGuiRenderer.h"
+#include "Input.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 #include "Scene/ModelViewerScene.h"
 #include "Scene/WeightedCollisionScene.h"
 #include "Scene/RaceRankingScene.h"
@@ -21,6 +24,11 @@
 #include "Scene/PhysicsBoneScene.h"
 #include "Scene/CCDIKScene.h"
 #include "Scene/CharacterControlScene.h"
+#include "Scene/AnimationBenchmarkScene.h"
+#include "Scene/ModelLoadBenchmarkScene.h"
+#include "Scene/JobSystemScene.h"
+#include "Scene/BlendTreeScene.h"
+#include "Scene/CrowdAnimationScene.h"
 
 // Ԋuݒ
 static const int syncInterval = 1;
@@ -31,9 +39,15 @@ Framework::Framework(HWND hWnd)
 {
 	hDC = GetDC(hWnd);
 
+	// vt@C̃CXbhݒ
+	Profiler::Instance().SetThreadName("Main");
+
 	// OtBbNX
 	Graphics::Instance().Initialize(hWnd);
 
+	// WuVXe
+	JobSystem::Instance().Initialize();
+
 	// IMGUI
 	ImGuiRenderer::Initialize(hWnd, Graphics::Instance().GetDevice(), Graphics::Instance().GetDeviceContext());
 
@@ -62,12 +76,22 @@ Framework::~Framework()
 	// IMGUII
 	ImGuiRenderer::Finalize();
 
+	// WuVXeI
+	JobSystem::Instance().Finalize();
+
 	ReleaseDC(hWnd, hDC);
 }
 
 // XV
 void Framework::Update(float elapsedTime)
 {
+	// vt@Ct[Jn
+	Profiler::Instance().BeginFrame();
+	PROFILE_FUNCTION();
+
+	// ͍XV
+	Input::Instance().Update();
+
 	// IMGUIt[Jn	
 	ImGuiRenderer::NewFrame();
 
@@ -78,6 +102,8 @@ void Framework::Update(float elapsedTime)
 // `揈
 void Framework::Render(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
 
 	// ʃNA
@@ -87,13 +113,19 @@ void Framework::Render(float elapsedTime)
 	Graphics::Instance().SetRenderTargets();
 
 	// V[`揈
-	scene->Render(elapsedTime);
+	{
+		PROFILE_SCOPE("Scene::Render");
+		scene->Render(elapsedTime);
+	}
 
 	// V[GUI`揈
 	scene->DrawGUI();
 
 	// V[؂ւGUI
 	SceneSelectGUI();
+
+	// vt@CGUI
+	Profiler::Instance().DrawGUI();
 #if 0
 	// IMGUIfEChE`iIMGUI@\eXgpj
 	ImGui::ShowDemoWindow();
@@ -102,7 +134,10 @@ void Framework::Render(float elapsedTime)
 	ImGuiRenderer::Render(dc);
 
 	// ʕ\
-	Graphics::Instance().Present(syncInterval);
+	{
+		PROFILE_SCOPE("Present");
+		Graphics::Instance().Present(syncInterval);
+	}
 }
 
 template<class T>
@@ -141,6 +176,11 @@ void Framework::SceneSelectGUI()
 		ChangeSceneButtonGUI<PhysicsRopeScene>(u8"12.h̏([v)");
 		ChangeSceneButtonGUI<PhysicsBoneScene>(u8"13.h̏({[)");
 		ChangeSceneButtonGUI<CCDIKScene>(u8"14.3{ȏ̃{[IK");
+		ChangeSceneButtonGUI<AnimationBenchmarkScene>(u8"15.Aj[Vx`}[N");
+		ChangeSceneButtonGUI<ModelLoadBenchmarkScene>(u8"16.fǂݍ݃x`}[N");
+		ChangeSceneButtonGUI<JobSystemScene>(u8"17.WuVXe");
+		ChangeSceneButtonGUI<BlendTreeScene>(u8"18.uhc[");
+		ChangeSceneButtonGUI<CrowdAnimationScene>(u8"19.QOAj[V");
 		ChangeSceneButtonGUI<CharacterControlScene>(u8"99.LN^[");
 	}
 	ImGui::End();
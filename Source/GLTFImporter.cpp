@@ -1,4 +1,5 @@
 #include <fstream>
+#include <functional>
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -43,14 +44,14 @@ GLTFImporter::GLTFImporter(const char* filename)
 // m[hf[^ǂݍ
 void GLTFImporter::LoadNodes(NodeList& nodes)
 {
-	Model::Node& node = nodes.emplace_back();
+	ModelResource::Node& node = nodes.emplace_back();
 	node.name = filepath.filename().stem().string();
 
 	nodes.resize(gltfModel.nodes.size());
 	for (size_t gltfNodeIndex = 0; gltfNodeIndex < nodes.size(); ++gltfNodeIndex)
 	{
 		const tinygltf::Node& gltfNode = gltfModel.nodes.at(gltfNodeIndex);
-		Model::Node& node = nodes.at(gltfNodeIndex);
+		ModelResource::Node& node = nodes.at(gltfNodeIndex);
 
 		// f[^擾
 		node.name = gltfNode.name;
@@ -92,7 +93,7 @@ void GLTFImporter::LoadNodes(NodeList& nodes)
 }
 
 // bVf[^ǂݍ
-void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
+void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes, bool compressVertices)
 {
 	for (int gltfNodeIndex = 0; gltfNodeIndex < gltfModel.nodes.size(); ++gltfNodeIndex)
 	{
@@ -103,7 +104,7 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 				
 		for (const tinygltf::Primitive& gltfPrimitive : gltfMesh.primitives)
 		{
-			Model::Mesh& mesh = meshes.emplace_back();
+			ModelResource::Mesh& mesh = meshes.emplace_back();
 			mesh.nodeIndex = gltfNodeIndex;
 			mesh.materialIndex = gltfPrimitive.material;
 
@@ -116,7 +117,7 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 
 				for (int i = 0; i < gltfAccessor.count; ++i)
 				{
-					Model::Bone& bone = mesh.bones.emplace_back();
+					ModelResource::Bone& bone = mesh.bones.emplace_back();
 					const DirectX::XMFLOAT4X4* offsetTransforms = reinterpret_cast<const DirectX::XMFLOAT4X4*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
 					bone.offsetTransform = offsetTransforms[i];
 					bone.nodeIndex = gltfSkin.joints.at(i);
@@ -353,6 +354,9 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 
 			// Wnϊ
 			ConvertMeshAxisSystem(mesh);
+
+			// _tH[}bgI
+			mesh.vertexFormat = ModelResource::SelectVertexFormat(mesh, compressVertices);
 		}
 	}
 
@@ -366,7 +370,7 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 
 	for (const tinygltf::Material& gltfMaterial : gltfModel.materials)
 	{
-		Model::Material& material = materials.emplace_back();
+		ModelResource::Material& material = materials.emplace_back();
 		material.name = gltfMaterial.name;
 		material.baseColor.x = static_cast<float>(gltfMaterial.pbrMetallicRoughness.baseColorFactor.at(0));
 		material.baseColor.y = static_cast<float>(gltfMaterial.pbrMetallicRoughness.baseColorFactor.at(1));
@@ -381,15 +385,15 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 		material.alphaCutoff = static_cast<float>(gltfMaterial.alphaCutoff);
 		if (gltfMaterial.alphaMode == "BLEND")
 		{
-			material.alphaMode = Model::AlphaMode::Blend;
+			material.alphaMode = ModelResource::AlphaMode::Blend;
 		}
 		else if (gltfMaterial.alphaMode == "MASK")
 		{
-			material.alphaMode = Model::AlphaMode::Mask;
+			material.alphaMode = ModelResource::AlphaMode::Mask;
 		}
 		else
 		{
-			material.alphaMode = Model::AlphaMode::Opaque;
+			material.alphaMode = ModelResource::AlphaMode::Opaque;
 		}
 
 		auto loadTexture = [&](int gltfTextureIndex, const char* textureType, std::string& textureFilename, ID3D11ShaderResourceView** srv)
@@ -451,6 +455,11 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 						textureFilePath = material.name + "_" + textureType + "." + extension;
 					}
 					textureFilePath = "Textures" / textureFilePath.filename();
+					if (gltfImage.bufferView < 0)
+					{
+						// jAȉ摜f[^.pngŏo
+						textureFilePath = textureFilePath.replace_extension(".png");
+					}
 
 					// ߍ݃eNX`o͂fBNgmF
 					std::filesystem::path outputDirPath(dirpath / textureFilePath.parent_path());
@@ -474,8 +483,6 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 						}
 						else
 						{
-							// jAȉ摜f[^.pngŏo
-							textureFilePath = textureFilePath.replace_extension(".png");
 							stbi_write_png(
 								outputFilePath.string().c_str(),
 								static_cast<int>(gltfImage.width),
@@ -508,7 +515,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 
 	for (const tinygltf::Animation& gltfAnimation : gltfModel.animations)
 	{
-		Model::Animation& animation = animations.emplace_back();
+		ModelResource::Animation& animation = animations.emplace_back();
 		animation.name = gltfAnimation.name;
 		animation.nodeAnims.resize(nodes.size());
 		animation.secondsLength = 0;
@@ -518,7 +525,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 		for (const tinygltf::AnimationChannel& gltfAnimationChannel : gltfAnimation.channels)
 		{
 			// m[hAj[Vf[^ǂݎJn
-			Model::NodeAnim& nodeAnim = animation.nodeAnims.at(gltfAnimationChannel.target_node);
+			ModelResource::NodeAnim& nodeAnim = animation.nodeAnims.at(gltfAnimationChannel.target_node);
 			const tinygltf::AnimationSampler& gltfAnimationSampler = gltfAnimation.samplers.at(gltfAnimationChannel.sampler);
 			const tinygltf::Accessor& gltfInputAccessor = gltfModel.accessors.at(gltfAnimationSampler.input);
 			const tinygltf::Accessor& gltfOutputAccessor = gltfModel.accessors.at(gltfAnimationSampler.output);
@@ -535,7 +542,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 				const DirectX::XMFLOAT3* gltfKeyframeValues = reinterpret_cast<const DirectX::XMFLOAT3*>(gltfModel.buffers.at(gltfOutputBufferView.buffer).data.data() + gltfOutputBufferView.byteOffset + gltfOutputAccessor.byteOffset);
 				for (int i = 0; i < gltfInputAccessor.count; ++i)
 				{
-					Model::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
+					ModelResource::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
 					keyframe.seconds = gltfKeyframeTimes[i];
 					keyframe.value = gltfKeyframeValues[i];
 				}
@@ -567,7 +574,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 					float frame = gltfKeyframeTimes[i] * sampleRate;
 					if (fabs(std::round(frame) - frame) > 0.001) continue;
 
-					Model::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
+					ModelResource::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
 					keyframe.seconds = gltfKeyframeTimes[i];
 					keyframe.value = gltfKeyframeValues[i];
 				}
@@ -595,7 +602,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 				const DirectX::XMFLOAT3* gltfKeyframeValues = reinterpret_cast<const DirectX::XMFLOAT3*>(gltfModel.buffers.at(gltfOutputBufferView.buffer).data.data() + gltfOutputBufferView.byteOffset + gltfOutputAccessor.byteOffset);
 				for (int i = 0; i < gltfInputAccessor.count; ++i)
 				{
-					Model::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
+					ModelResource::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
 					keyframe.seconds = gltfKeyframeTimes[i];
 					keyframe.value = gltfKeyframeValues[i];
 				}
@@ -620,17 +627,17 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 		}
 
 		// 擪L[t[̎Ԃ0Ȃꍇ̂Œ
-		for (Model::NodeAnim& nodeAnim : animation.nodeAnims)
+		for (ModelResource::NodeAnim& nodeAnim : animation.nodeAnims)
 		{
-			for (Model::VectorKeyframe& keyframe : nodeAnim.positionKeyframes)
+			for (ModelResource::VectorKeyframe& keyframe : nodeAnim.positionKeyframes)
 			{
 				keyframe.seconds -= minTime;
 			}
-			for (Model::QuaternionKeyframe& keyframe : nodeAnim.rotationKeyframes)
+			for (ModelResource::QuaternionKeyframe& keyframe : nodeAnim.rotationKeyframes)
 			{
 				keyframe.seconds -= minTime;
 			}
-			for (Model::VectorKeyframe& keyframe : nodeAnim.scaleKeyframes)
+			for (ModelResource::VectorKeyframe& keyframe : nodeAnim.scaleKeyframes)
 			{
 				keyframe.seconds -= minTime;
 			}
@@ -644,49 +651,189 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 		// Aj[VȂm[hɑ΂ďp̃L[t[ǉ
 		for (size_t nodeIndex = 0; nodeIndex < animation.nodeAnims.size(); ++nodeIndex)
 		{
-			const Model::Node& node = nodes.at(nodeIndex);
-			Model::NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
+			const ModelResource::Node& node = nodes.at(nodeIndex);
+			ModelResource::NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
 			// ړ
 			if (nodeAnim.positionKeyframes.size() == 0)
 			{
-				Model::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
+				ModelResource::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
 				keyframe.seconds = 0.0f;
 				keyframe.value = node.position;
 			}
 			if (nodeAnim.positionKeyframes.size() == 1)
 			{
-				Model::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
+				ModelResource::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
 				keyframe.seconds = animation.secondsLength;
 				keyframe.value = nodeAnim.positionKeyframes.at(0).value;
 			}
 			// ]
 			if (nodeAnim.rotationKeyframes.size() == 0)
 			{
-				Model::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
+				ModelResource::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
 				keyframe.seconds = 0.0f;
 				keyframe.value = node.rotation;
 			}
 			if (nodeAnim.rotationKeyframes.size() == 1)
 			{
-				Model::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
+				ModelResource::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
 				keyframe.seconds = animation.secondsLength;
 				keyframe.value = nodeAnim.rotationKeyframes.at(0).value;
 			}
 			// XP[
 			if (nodeAnim.scaleKeyframes.size() == 0)
 			{
-				Model::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
+				ModelResource::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
 				keyframe.seconds = 0.0f;
 				keyframe.value = node.scale;
 			}
 			if (nodeAnim.scaleKeyframes.size() == 1)
 			{
-				Model::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
+				ModelResource::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
 				keyframe.seconds = animation.secondsLength;
 				keyframe.value = nodeAnim.scaleKeyframes.at(0).value;
 			}
 		}
+
+		// ԂŕłL[t[팸
+		ReduceKeyframes(animation, nodes);
+	}
+}
+
+// L[t[팸̋e덷ifԁj
+static const float KeyframePositionTolerance = 0.0005f;								// ʒu덷ifԂ̒PʁA0.5mmj
+static const float KeyframeAngularTolerance = DirectX::XMConvertToRadians(0.1f);	// px덷iWAj
+static const float KeyframeMinimumExtent = 0.1f;									// [m[hłXL̒_͂̋܂łƂ݂Ȃ
+
+// L[t[擪×~ɍ팸icomputeError(O, , Ԃ̃L[)e덷ȉȂԂ̃L[Ȃj
+template<class Keyframe, class ErrorFunction>
+static void ReduceKeyframeTrack(std::vector<Keyframe>& keyframes, float tolerance, ErrorFunction computeError)
+{
+	if (keyframes.size() <= 2) return;
+
+	std::vector<Keyframe> reduced;
+	reduced.emplace_back(keyframes.front());
+	size_t anchor = 0;
+	for (size_t end = 2; end < keyframes.size(); ++end)
+	{
+		// ̃L[͐`ɕԂ邽߁A덷̓L[̎ōőɂȂ
+		for (size_t i = anchor + 1; i < end; ++i)
+		{
+			if (computeError(keyframes[anchor], keyframes[end], keyframes[i]) > tolerance)
+			{
+				anchor = end - 1;
+				reduced.emplace_back(keyframes[anchor]);
+				break;
+			}
+		}
+	}
+	reduced.emplace_back(keyframes.back());
+	keyframes.swap(reduced);
+}
+
+// L[t[팸
+void GLTFImporter::ReduceKeyframes(ModelResource::Animation& animation, const NodeList& nodes)
+{
+	const int nodeCount = static_cast<int>(nodes.size());
+
+	// p̃fԍsƊKw̐[
+	std::vector<DirectX::XMFLOAT4X4> globalTransforms(nodeCount);
+	std::vector<int> depths(nodeCount, -1);
+	int maxDepth = 1;
+	std::function<void(int)> computeGlobalTransform = [&](int nodeIndex)
+	{
+		if (depths[nodeIndex] >= 0) return;
+
+		const ModelResource::Node& node = nodes.at(nodeIndex);
+		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
+		DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
+		DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
+		DirectX::XMMATRIX GlobalTransform = S * R * T;
+		depths[nodeIndex] = 1;
+		if (node.parentIndex >= 0)
+		{
+			computeGlobalTransform(node.parentIndex);
+			GlobalTransform = GlobalTransform * DirectX::XMLoadFloat4x4(&globalTransforms[node.parentIndex]);
+			depths[nodeIndex] = depths[node.parentIndex] + 1;
+		}
+		DirectX::XMStoreFloat4x4(&globalTransforms[nodeIndex], GlobalTransform);
+		maxDepth = (std::max)(maxDepth, depths[nodeIndex]);
+	};
+	for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		computeGlobalTransform(nodeIndex);
 	}
+
+	// m[hłq܂ł̋ĩm[h̉]XP[̌덷͂̋{Ŏqɓ`j
+	std::vector<float> extents(nodeCount, KeyframeMinimumExtent);
+	for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		DirectX::XMVECTOR Position = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(&globalTransforms[nodeIndex]._41));
+		for (int ancestorIndex = nodes.at(nodeIndex).parentIndex; ancestorIndex >= 0; ancestorIndex = nodes.at(ancestorIndex).parentIndex)
+		{
+			DirectX::XMVECTOR AncestorPosition = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(&globalTransforms[ancestorIndex]._41));
+			float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(Position, AncestorPosition)));
+			extents[ancestorIndex] = (std::max)(extents[ancestorIndex], distance + KeyframeMinimumExtent);
+		}
+	}
+
+	// 덷̌vZ
+	auto computeVectorError = [](const ModelResource::VectorKeyframe& k0, const ModelResource::VectorKeyframe& k1, const ModelResource::VectorKeyframe& k)
+	{
+		float rate = (k.seconds - k0.seconds) / (k1.seconds - k0.seconds);
+		DirectX::XMVECTOR V = DirectX::XMVectorLerp(DirectX::XMLoadFloat3(&k0.value), DirectX::XMLoadFloat3(&k1.value), rate);
+		return DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(V, DirectX::XMLoadFloat3(&k.value))));
+	};
+	auto computeQuaternionError = [](const ModelResource::QuaternionKeyframe& k0, const ModelResource::QuaternionKeyframe& k1, const ModelResource::QuaternionKeyframe& k)
+	{
+		float rate = (k.seconds - k0.seconds) / (k1.seconds - k0.seconds);
+		DirectX::XMVECTOR Q = DirectX::XMQuaternionSlerp(DirectX::XMLoadFloat4(&k0.value), DirectX::XMLoadFloat4(&k1.value), rate);
+		float dot = fabsf(DirectX::XMVectorGetX(DirectX::XMQuaternionDot(Q, DirectX::XMLoadFloat4(&k.value))));
+		return 2.0f * acosf((std::min)(dot, 1.0f));
+	};
+
+	size_t keyframeCountBefore = 0, keyframeCountAfter = 0;
+	size_t memoryBefore = 0, memoryAfter = 0;
+	auto computeMemory = [](const ModelResource::NodeAnim& nodeAnim)
+	{
+		return (nodeAnim.positionKeyframes.size() + nodeAnim.scaleKeyframes.size()) * sizeof(ModelResource::VectorKeyframe)
+			+ nodeAnim.rotationKeyframes.size() * sizeof(ModelResource::QuaternionKeyframe);
+	};
+	auto computeKeyframeCount = [](const ModelResource::NodeAnim& nodeAnim)
+	{
+		return nodeAnim.positionKeyframes.size() + nodeAnim.rotationKeyframes.size() + nodeAnim.scaleKeyframes.size();
+	};
+
+	for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		ModelResource::NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
+		keyframeCountBefore += computeKeyframeCount(nodeAnim);
+		memoryBefore += computeMemory(nodeAnim);
+
+		// č덷͎qŐςݏdȂ邽߁Ae덷Kw̐[œ
+		const int parentIndex = nodes.at(nodeIndex).parentIndex;
+		float parentScale = 1.0f;
+		if (parentIndex >= 0)
+		{
+			DirectX::XMMATRIX ParentTransform = DirectX::XMLoadFloat4x4(&globalTransforms[parentIndex]);
+			parentScale = DirectX::XMVectorGetX(DirectX::XMVector3Length(ParentTransform.r[0]));
+		}
+		const float positionTolerance = KeyframePositionTolerance / maxDepth / (std::max)(parentScale, FLT_EPSILON);
+		const float angularTolerance = (std::min)(KeyframeAngularTolerance, KeyframePositionTolerance / extents[nodeIndex]) / maxDepth;
+		const float scaleTolerance = KeyframePositionTolerance / extents[nodeIndex] / maxDepth;
+
+		ReduceKeyframeTrack(nodeAnim.positionKeyframes, positionTolerance, computeVectorError);
+		ReduceKeyframeTrack(nodeAnim.rotationKeyframes, angularTolerance, computeQuaternionError);
+		ReduceKeyframeTrack(nodeAnim.scaleKeyframes, scaleTolerance, computeVectorError);
+
+		keyframeCountAfter += computeKeyframeCount(nodeAnim);
+		memoryAfter += computeMemory(nodeAnim);
+	}
+
+	// Nbv̍팸ʂo
+	char message[256];
+	snprintf(message, sizeof(message), "Keyframe reduction [%s] keys %zu -> %zu, memory %.1f KB -> %.1f KB\n",
+		animation.name.c_str(), keyframeCountBefore, keyframeCountAfter, memoryBefore / 1024.0f, memoryAfter / 1024.0f);
+	OutputDebugStringA(message);
 }
 
 // gltfVector3  XMFLOAT3
@@ -759,15 +906,15 @@ void GLTFImporter::ConvertMatrixAxisSystem(DirectX::XMFLOAT4X4& m)
 	m._41 = -m._41;
 }
 
-void GLTFImporter::ConvertNodeAxisSystem(Model::Node& node)
+void GLTFImporter::ConvertNodeAxisSystem(ModelResource::Node& node)
 {
 	ConvertPositionAxisSystem(node.position);
 	ConvertRotationAxisSystem(node.rotation);
 }
 
-void GLTFImporter::ConvertMeshAxisSystem(Model::Mesh& mesh)
+void GLTFImporter::ConvertMeshAxisSystem(ModelResource::Mesh& mesh)
 {
-	for (Model::Vertex& v : mesh.vertices)
+	for (ModelResource::Vertex& v : mesh.vertices)
 	{
 		ConvertPositionAxisSystem(v.position);
 		ConvertPositionAxisSystem(v.normal);
@@ -782,21 +929,21 @@ void GLTFImporter::ConvertMeshAxisSystem(Model::Mesh& mesh)
 		p[2] = temp;
 	}
 
-	for (Model::Bone& bone : mesh.bones)
+	for (ModelResource::Bone& bone : mesh.bones)
 	{
 		ConvertMatrixAxisSystem(bone.offsetTransform);
 	}
 }
 
-void GLTFImporter::ConvertAnimationAxisSystem(Model::Animation& animation)
+void GLTFImporter::ConvertAnimationAxisSystem(ModelResource::Animation& animation)
 {
-	for (Model::NodeAnim& nodeAnim : animation.nodeAnims)
+	for (ModelResource::NodeAnim& nodeAnim : animation.nodeAnims)
 	{
-		for (Model::VectorKeyframe& keyframe : nodeAnim.positionKeyframes)
+		for (ModelResource::VectorKeyframe& keyframe : nodeAnim.positionKeyframes)
 		{
 			ConvertPositionAxisSystem(keyframe.value);
 		}
-		for (Model::QuaternionKeyframe& keyframe : nodeAnim.rotationKeyframes)
+		for (ModelResource::QuaternionKeyframe& keyframe : nodeAnim.rotationKeyframes)
 		{
 			ConvertRotationAxisSystem(keyframe.value);
 		}
@@ -804,7 +951,7 @@ void GLTFImporter::ConvertAnimationAxisSystem(Model::Animation& animation)
 }
 
 // ^WFgvZ
-void GLTFImporter::ComputeTangents(std::vector<Model::Vertex>& vertices, const std::vector<uint32_t>& indices)
+void GLTFImporter::ComputeTangents(std::vector<ModelResource::Vertex>& vertices, const std::vector<uint32_t>& indices)
 {
 	size_t vertexCount = vertices.size();
 	std::unique_ptr<DirectX::XMFLOAT3[]> tan1 = std::make_unique<DirectX::XMFLOAT3[]>(vertexCount);
@@ -817,9 +964,9 @@ void GLTFImporter::ComputeTangents(std::vector<Model::Vertex>& vertices, const s
 		const uint32_t i2 = indices[i + 1];
 		const uint32_t i3 = indices[i + 2];
 
-		const Model::Vertex& v1 = vertices[i1];
-		const Model::Vertex& v2 = vertices[i2];
-		const Model::Vertex& v3 = vertices[i3];
+		const ModelResource::Vertex& v1 = vertices[i1];
+		const ModelResource::Vertex& v2 = vertices[i2];
+		const ModelResource::Vertex& v3 = vertices[i3];
 
 		const float x1 = v2.position.x - v1.position.x;
 		const float x2 = v3.position.x - v1.position.x;
@@ -844,7 +991,7 @@ void GLTFImporter::ComputeTangents(std::vector<Model::Vertex>& vertices, const s
 
 	for (size_t i = 0; i < vertexCount; ++i)
 	{
-		Model::Vertex& v = vertices[i];
+		ModelResource::Vertex& v = vertices[i];
 
 		DirectX::XMVECTOR N = DirectX::XMLoadFloat3(&v.normal);
 		DirectX::XMVECTOR T1 = DirectX::XMLoadFloat3(&tan1[i]);
@@ -3,15 +3,18 @@
 #include <map>
 #include <filesystem>
 #include <tiny_gltf.h>
-#include "Model.h"
+#include "ModelResource.h"
 
 class GLTFImporter
 {
 private:
-	using MeshList = std::vector<Model::Mesh>;
-	using MaterialList = std::vector<Model::Material>;
-	using NodeList = std::vector<Model::Node>;
-	using AnimationList = std::vector<Model::Animation>;
+	// ^WFgvZv
+	friend class MicroBenchmark;
+
+	using MeshList = std::vector<ModelResource::Mesh>;
+	using MaterialList = std::vector<ModelResource::Material>;
+	using NodeList = std::vector<ModelResource::Node>;
+	using AnimationList = std::vector<ModelResource::Animation>;
 
 public:
 	GLTFImporter(const char* filename);
@@ -19,8 +22,8 @@ public:
 	// m[hf[^ǂݍ
 	void LoadNodes(NodeList& nodes);
 
-	// bVf[^ǂݍ
-	void LoadMeshes(MeshList& meshes, const NodeList& nodes);
+	// bVf[^ǂݍ݁icompressVerticestruȅꍇ̓bVƂɈk_tH[}bgIj
+	void LoadMeshes(MeshList& meshes, const NodeList& nodes, bool compressVertices = false);
 
 	// }eAf[^ǂݍ
 	void LoadMaterials(MaterialList& materials, ID3D11Device* device = nullptr);
@@ -43,12 +46,15 @@ private:
 	static void ConvertPositionAxisSystem(DirectX::XMFLOAT4& v);
 	static void ConvertRotationAxisSystem(DirectX::XMFLOAT4& q);
 	static void ConvertMatrixAxisSystem(DirectX::XMFLOAT4X4& m);
-	static void ConvertNodeAxisSystem(Model::Node& node);
-	static void ConvertMeshAxisSystem(Model::Mesh& mesh);
-	static void ConvertAnimationAxisSystem(Model::Animation& animation);
+	static void ConvertNodeAxisSystem(ModelResource::Node& node);
+	static void ConvertMeshAxisSystem(ModelResource::Mesh& mesh);
+	static void ConvertAnimationAxisSystem(ModelResource::Animation& animation);
+
+	// L[t[팸iԂŋe덷ɕłL[Ȃj
+	static void ReduceKeyframes(ModelResource::Animation& animation, const NodeList& nodes);
 
 	// ^WFgvZ
-	static void ComputeTangents(std::vector<Model::Vertex>& vertices, const std::vector<uint32_t>& indices);
+	static void ComputeTangents(std::vector<ModelResource::Vertex>& vertices, const std::vector<uint32_t>& indices);
 
 private:
 	std::filesystem::path			filepath;
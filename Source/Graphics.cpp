@@ -132,6 +132,14 @@ void Graphics::Initialize(HWND hWnd)
 
 }
 
+// wbhX
+void Graphics::InitializeHeadless(float screenWidth, float screenHeight)
+{
+	this->hWnd = nullptr;
+	this->screenWidth = screenWidth;
+	this->screenHeight = screenHeight;
+}
+
 // NA
 void Graphics::Clear(float r, float g, float b, float a)
 {
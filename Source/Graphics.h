@@ -26,6 +26,12 @@ public:
 	// 
 	void Initialize(HWND hWnd);
 
+	// wbhXifoCX쐬ʃTCŶݐݒ肷AGetDevice()nullptrԂj
+	void InitializeHeadless(float screenWidth, float screenHeight);
+
+	// wbhX
+	bool IsHeadless() const { return device == nullptr; }
+
 	// NA
 	void Clear(float r, float g, float b, float a);
 
@@ -0,0 +1,322 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <windows.h>
+#include <shellapi.h>
+#include "Misc.h"
+#include "Graphics.h"
+#include "ImGuiRenderer.h"
+#include "Input.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "HeadlessBenchmark.h"
+#include "Scene/CharacterControlScene.h"
+#include "Scene/SphereCastMoveScene.h"
+#include "Scene/WeightedCollisionScene.h"
+#include "Scene/RootMotionScene.h"
+#include "Scene/SpaceDivisionRaycastScene.h"
+#include "Scene/SphereVsTriangleCollisionScene.h"
+#include "Scene/LookAtScene.h"
+#include "Scene/TwoBoneIKScene.h"
+#include "Scene/CCDIKScene.h"
+#include "Scene/PhysicsRopeScene.h"
+#include "Scene/PhysicsBoneScene.h"
+#include "Scene/BlendTreeScene.h"
+#include "Scene/CrowdAnimationScene.h"
+
+// wbhX̉ʃTCYiJ̃AXyNgɎgj
+static const float HeadlessScreenWidth = 1280.0f;
+static const float HeadlessScreenHeight = 720.0f;
+
+// vs
+HeadlessBenchmark::Result HeadlessBenchmark::Run(const SceneFactory& factory, const Settings& settings)
+{
+	Input& input = Input::Instance();
+	Benchmark benchmark;
+	Result result;
+
+	// V[\z
+	benchmark.begin();
+	std::unique_ptr<Scene> scene = factory();
+	result.loadTime = benchmark.end() * 1000.0f;
+
+	// ŒoߎԂŃt[i߂i񂵂̃t[XNvg̃t[ԍɊ܂߂j
+	std::vector<float> frameTimes;
+	frameTimes.reserve(settings.frameCount);
+	input.SetScripted(true);
+	const int totalFrameCount = settings.warmupFrameCount + settings.frameCount;
+	for (int frame = 0; frame < totalFrameCount; ++frame)
+	{
+		input.Update();
+		for (const KeyInput& keyInput : settings.script)
+		{
+			if (frame == keyInput.beginFrame) input.SetKey(keyInput.key, true);
+			if (frame == keyInput.endFrame) input.SetKey(keyInput.key, false);
+		}
+
+		Profiler::Instance().BeginFrame();
+		ImGuiRenderer::NewFrame(settings.elapsedTime);
+
+		benchmark.begin();
+		scene->Update(settings.elapsedTime);
+		float frameTime = benchmark.end() * 1000.0f;
+
+		ImGuiRenderer::Render(nullptr);
+
+		if (frame >= settings.warmupFrameCount)
+		{
+			frameTimes.emplace_back(frameTime);
+		}
+	}
+	input.SetScripted(false);
+
+	// Wv
+	result.frameCount = static_cast<int>(frameTimes.size());
+	if (frameTimes.empty()) return result;
+
+	double total = 0;
+	for (float frameTime : frameTimes)
+	{
+		total += frameTime;
+	}
+	std::sort(frameTimes.begin(), frameTimes.end());
+	result.average = static_cast<float>(total / frameTimes.size());
+	result.median = ComputePercentile(frameTimes, 50.0f);
+	result.percentile90 = ComputePercentile(frameTimes, 90.0f);
+	result.percentile99 = ComputePercentile(frameTimes, 99.0f);
+	result.max = frameTimes.back();
+	return result;
+}
+
+// p[Z^CZoiŋߖTʖ@j
+float HeadlessBenchmark::ComputePercentile(const std::vector<float>& sortedTimes, float percentile)
+{
+	if (sortedTimes.empty()) return 0.0f;
+
+	const int count = static_cast<int>(sortedTimes.size());
+	int rank = static_cast<int>(std::ceil(percentile / 100.0f * count));
+	return sortedTimes[std::clamp(rank - 1, 0, count - 1)];
+}
+
+// R}hCɃx`}[Nw肪邩
+bool HeadlessBenchmark::IsRequested(const wchar_t* commandLine)
+{
+	return commandLine != nullptr && wcsstr(commandLine, L"-benchmark") != nullptr;
+}
+
+// R}hCs
+int HeadlessBenchmark::RunCommandLine(const wchar_t* commandLine)
+{
+	// UTF-8ɕϊ
+	std::vector<std::string> args;
+	{
+		int argc = 0;
+		LPWSTR* argv = CommandLineToArgvW(commandLine, &argc);
+		for (int i = 0; i < argc; ++i)
+		{
+			char arg[MAX_PATH];
+			WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, arg, sizeof(arg), nullptr, nullptr);
+			args.emplace_back(arg);
+		}
+		LocalFree(argv);
+	}
+
+	// 
+	Settings settings;
+	std::string sceneName = "all";
+	std::string scriptFilename;
+	std::string outputFilename = "Benchmark.txt";
+	std::string traceFilename;
+	for (size_t i = 0; i + 1 < args.size(); ++i)
+	{
+		const std::string& option = args[i];
+		const std::string& value = args[i + 1];
+		if (option == "-benchmark") sceneName = value;
+		else if (option == "-frames") settings.frameCount = std::stoi(value);
+		else if (option == "-warmup") settings.warmupFrameCount = std::stoi(value);
+		else if (option == "-dt") settings.elapsedTime = std::stof(value);
+		else if (option == "-script") scriptFilename = value;
+		else if (option == "-out") outputFilename = value;
+		else if (option == "-trace") traceFilename = value;
+		else continue;
+		++i;
+	}
+	if (!scriptFilename.empty() && !LoadScript(scriptFilename.c_str(), settings.script))
+	{
+		_ASSERT_EXPR_A(false, ("failed to load benchmark script " + scriptFilename).c_str());
+		return 1;
+	}
+
+	// wbhXifGPU\[X炸ɓǂݍ܂j
+	Graphics::Instance().InitializeHeadless(HeadlessScreenWidth, HeadlessScreenHeight);
+	ImGuiRenderer::InitializeHeadless(HeadlessScreenWidth, HeadlessScreenHeight);
+	JobSystem::Instance().Initialize();
+	Profiler::Instance().SetThreadName("Main");
+	Profiler::Instance().SetEnabled(!traceFilename.empty());
+
+	// v
+	std::ostringstream report;
+	report << "frames=" << settings.frameCount << " warmup=" << settings.warmupFrameCount << " dt=" << settings.elapsedTime << "\n";
+	report << "scene                          load(ms)   avg(ms)   p50(ms)   p90(ms)   p99(ms)   max(ms)\n";
+	int runCount = 0;
+	for (const SceneEntry& entry : GetSceneEntries())
+	{
+		if (sceneName != "all" && sceneName != entry.name) continue;
+
+		// XNvgw肪Ȃ΃V[̊̓͂g
+		Settings sceneSettings = settings;
+		if (scriptFilename.empty())
+		{
+			sceneSettings.script = entry.script;
+		}
+		Result result = Run(entry.factory, sceneSettings);
+
+		char line[256];
+		snprintf(line, sizeof(line), "%-30s %9.2f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+			entry.name, result.loadTime, result.average, result.median, result.percentile90, result.percentile99, result.max);
+		report << line;
+		++runCount;
+	}
+	if (runCount == 0)
+	{
+		report << "unknown scene : " << sceneName << "\n";
+	}
+
+	if (!traceFilename.empty())
+	{
+		Profiler::Instance().ExportChromeTrace(traceFilename.c_str());
+	}
+
+	// I
+	JobSystem::Instance().Finalize();
+	ImGuiRenderer::Finalize();
+
+	// ʏóit@CƁAR\[Nꂽꍇ̓R\[j
+	const std::string text = report.str();
+	std::ofstream stream(outputFilename);
+	stream << text;
+	OutputDebugStringA(text.c_str());
+	if (AttachConsole(ATTACH_PARENT_PROCESS))
+	{
+		DWORD written;
+		WriteConsoleA(GetStdHandle(STD_OUTPUT_HANDLE), text.c_str(), static_cast<DWORD>(text.size()), &written, nullptr);
+		FreeConsole();
+	}
+
+	return runCount > 0 ? 0 : 1;
+}
+
+// XNvgǂݍ
+bool HeadlessBenchmark::LoadScript(const char* filename, std::vector<KeyInput>& script)
+{
+	std::ifstream stream(filename);
+	if (!stream) return false;
+
+	script.clear();
+	std::string line;
+	while (std::getline(stream, line))
+	{
+		line = line.substr(0, line.find('#'));
+
+		std::istringstream iss(line);
+		KeyInput keyInput;
+		std::string keyName;
+		if (!(iss >> keyInput.beginFrame >> keyInput.endFrame >> keyName)) continue;
+
+		keyInput.key = ParseKey(keyName);
+		if (keyInput.key == 0) return false;
+		script.emplace_back(keyInput);
+	}
+	return true;
+}
+
+// L[L[R[hɕϊ
+int HeadlessBenchmark::ParseKey(const std::string& name)
+{
+	if (name == "UP") return VK_UP;
+	if (name == "DOWN") return VK_DOWN;
+	if (name == "LEFT") return VK_LEFT;
+	if (name == "RIGHT") return VK_RIGHT;
+	if (name == "SPACE") return VK_SPACE;
+	if (name.size() == 1)
+	{
+		char c = name[0];
+		if (c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+		if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return c;
+	}
+	return 0;
+}
+
+// vΏۃV[ꗗ擾
+const std::vector<HeadlessBenchmark::SceneEntry>& HeadlessBenchmark::GetSceneEntries()
+{
+	// `揈g킸ɍXVłV[̂݁it[ԍ͋񂵂̃t[܂ށj
+	static const std::vector<SceneEntry> entries =
+	{
+		{ "CharacterControl", []() { return std::make_unique<CharacterControlScene>(); },
+			{
+				{  60, 240, 'W' },			// Oi
+				{ 150, 240, 'D' },			// ΂߈ړ
+				{ 270, 276, VK_SPACE },		// Wv
+				{ 330, 336, 'Z' },			// R{U
+				{ 350, 356, 'Z' },
+				{ 370, 376, 'Z' },
+				{ 420, 540, 'J' },			// J]
+				{ 420, 600, 'S' },			// 
+				{ 540, 600, 'A' },
+			}
+		},
+		{ "SphereCastMove", []() { return std::make_unique<SphereCastMoveScene>(); },
+			{
+				{  60, 240, VK_UP },
+				{ 180, 300, VK_RIGHT },
+				{ 300, 480, VK_DOWN },
+				{ 420, 600, VK_LEFT },
+			}
+		},
+		{ "WeightedCollision", []() { return std::make_unique<WeightedCollisionScene>(); },
+			{
+				{  60, 300, 'W' },
+				{  60, 300, VK_UP },
+				{ 300, 600, 'D' },
+				{ 300, 600, VK_LEFT },
+			}
+		},
+		{ "RootMotion", []() { return std::make_unique<RootMotionScene>(); },
+			{
+				{  60, 240, VK_UP },
+				{ 240, 360, VK_RIGHT },
+				{ 360, 480, VK_DOWN },
+				{ 480, 600, VK_LEFT },
+			}
+		},
+		{ "SpaceDivisionRaycast", []() { return std::make_unique<SpaceDivisionRaycastScene>(); },
+			{
+				{  60, 360, VK_UP },
+				{ 360, 600, VK_RIGHT },
+			}
+		},
+		{ "SphereVsTriangleCollision", []() { return std::make_unique<SphereVsTriangleCollisionScene>(); },
+			{
+				{  60, 240, VK_UP },
+				{ 240, 360, 'Z' },
+				{ 360, 480, VK_LEFT },
+				{ 480, 600, 'X' },
+			}
+		},
+		{ "LookAt", []() { return std::make_unique<LookAtScene>(); }, {} },
+		{ "TwoBoneIK", []() { return std::make_unique<TwoBoneIKScene>(); },
+			{
+				{ 300, 600, VK_SPACE },
+			}
+		},
+		{ "CCDIK", []() { return std::make_unique<CCDIKScene>(); }, {} },
+		{ "PhysicsRope", []() { return std::make_unique<PhysicsRopeScene>(); }, {} },
+		{ "PhysicsBone", []() { return std::make_unique<PhysicsBoneScene>(); }, {} },
+		{ "BlendTree", []() { return std::make_unique<BlendTreeScene>(); }, {} },
+		{ "CrowdAnimation", []() { return std::make_unique<CrowdAnimationScene>(); }, {} },
+	};
+	return entries;
+}
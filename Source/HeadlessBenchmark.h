@@ -0,0 +1,73 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Scene.h"
+
+// wbhXx`}[NiEChEƃfoCX炸ɃV[XVŒt[Ōvj
+class HeadlessBenchmark
+{
+public:
+	// XNvǵibeginFrameȏendFramẽt[keyj
+	struct KeyInput
+	{
+		int		beginFrame = 0;
+		int		endFrame = 0;
+		int		key = 0;
+	};
+
+	// vݒ
+	struct Settings
+	{
+		int						frameCount = 600;			// vt[
+		int						warmupFrameCount = 60;		// vOɋ񂵂t[
+		float					elapsedTime = 1.0f / 60.0f;	// Œoߎ
+		std::vector<KeyInput>	script;
+	};
+
+	// vʁiԂ̓~bj
+	struct Result
+	{
+		int		frameCount = 0;
+		float	loadTime = 0;
+		float	average = 0;
+		float	median = 0;
+		float	percentile90 = 0;
+		float	percentile99 = 0;
+		float	max = 0;
+	};
+
+	using SceneFactory = std::function<std::unique_ptr<Scene>()>;
+
+	// vsi͌ĂяoŃwbhXĂj
+	static Result Run(const SceneFactory& factory, const Settings& settings);
+
+	// R}hCsi-benchmark <V[|all> [-frames N] [-warmup N] [-dt b] [-script t@C] [-out t@C] [-trace t@C]j
+	static int RunCommandLine(const wchar_t* commandLine);
+
+	// R}hCɃx`}[Nw肪邩
+	static bool IsRequested(const wchar_t* commandLine);
+
+	// XNvgǂݍ݁iPsɁuJnt[ It[ L[vA#ȍ~̓Rgj
+	static bool LoadScript(const char* filename, std::vector<KeyInput>& script);
+
+	// p[Z^CZoisortedTimes͏j
+	static float ComputePercentile(const std::vector<float>& sortedTimes, float percentile);
+
+private:
+	// vΏۃV[
+	struct SceneEntry
+	{
+		const char*				name;
+		SceneFactory			factory;
+		std::vector<KeyInput>	script;
+	};
+
+	// vΏۃV[ꗗ擾
+	static const std::vector<SceneEntry>& GetSceneEntries();
+
+	// L[L[R[hɕϊ
+	static int ParseKey(const std::string& name);
+};
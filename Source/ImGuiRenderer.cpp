@@ -5,6 +5,9 @@
 
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
+// obNGhȂœ삵Ă邩
+static bool headless = false;
+
 // 
 void ImGuiRenderer::Initialize(HWND hWnd, ID3D11Device* device, ID3D11DeviceContext* dc)
 {
@@ -59,19 +62,47 @@ void ImGuiRenderer::Initialize(HWND hWnd, ID3D11Device* device, ID3D11DeviceCont
 	IM_ASSERT(font != NULL);
 }
 
+// wbhX
+void ImGuiRenderer::InitializeHeadless(float displayWidth, float displayHeight)
+{
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = nullptr;
+	io.DisplaySize = ImVec2(displayWidth, displayHeight);
+
+	// tHgeNX`͎gȂA\zς݂łȂƃt[JnłȂ
+	unsigned char* pixels;
+	int width, height;
+	io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+	headless = true;
+}
+
 // I
 void ImGuiRenderer::Finalize()
 {
-	ImGui_ImplDX11_Shutdown();
-	ImGui_ImplWin32_Shutdown();
+	if (!headless)
+	{
+		ImGui_ImplDX11_Shutdown();
+		ImGui_ImplWin32_Shutdown();
+	}
 	ImGui::DestroyContext();
+	headless = false;
 }
 
 // t[Jn
-void ImGuiRenderer::NewFrame()
+void ImGuiRenderer::NewFrame(float elapsedTime)
 {
-	ImGui_ImplDX11_NewFrame();
-	ImGui_ImplWin32_NewFrame();
+	if (headless)
+	{
+		ImGui::GetIO().DeltaTime = elapsedTime > 0.0f ? elapsedTime : 1.0f / 60.0f;
+	}
+	else
+	{
+		ImGui_ImplDX11_NewFrame();
+		ImGui_ImplWin32_NewFrame();
+	}
 
 	ImGui::NewFrame();
 
@@ -120,6 +151,12 @@ void ImGuiRenderer::NewFrame()
 // `
 void ImGuiRenderer::Render(ID3D11DeviceContext* context)
 {
+	if (headless)
+	{
+		ImGui::EndFrame();
+		return;
+	}
+
 	// Rendering
 	ImGui::Render();
 
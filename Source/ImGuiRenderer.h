@@ -8,14 +8,17 @@ class ImGuiRenderer
 public:
 	// 
 	static void Initialize(HWND hWnd, ID3D11Device* device, ID3D11DeviceContext* dc);
+
+	// wbhXi`obNGhg킸AV[XVIMGUIĂяo󂯕t邾̃ReLXgj
+	static void InitializeHeadless(float displayWidth, float displayHeight);
 	
 	// I
 	static void Finalize();
 
 	// t[Jn
-	static void NewFrame();
+	static void NewFrame(float elapsedTime = 0.0f);
 
-	// `s
+	// `siwbhX̓t[邾j
 	static void Render(ID3D11DeviceContext* context);
 
 	// WIN32bZ[Wnh[
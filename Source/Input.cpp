@@ -0,0 +1,34 @@
+#include <cstring>
+#include <windows.h>
+#include "Input.h"
+
+// XV
+void Input::Update()
+{
+	std::memcpy(previousKeys, currentKeys, sizeof(currentKeys));
+
+	// XNvg͒͑Ot[̏ԂpASetKeyŏ㏑Ă炤
+	if (scripted) return;
+
+	for (int key = 0; key < KeyCount; ++key)
+	{
+		currentKeys[key] = (GetAsyncKeyState(key) & 0x8000) != 0;
+	}
+}
+
+// XNvg͐ݒ
+void Input::SetScripted(bool scripted)
+{
+	this->scripted = scripted;
+	std::memset(currentKeys, 0, sizeof(currentKeys));
+	std::memset(previousKeys, 0, sizeof(previousKeys));
+}
+
+// L[Ԑݒ
+void Input::SetKey(int key, bool pressed)
+{
+	if (IsValidKey(key))
+	{
+		currentKeys[key] = pressed;
+	}
+}
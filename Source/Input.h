@@ -0,0 +1,45 @@
+#pragma once
+
+// L[́iL[{[h܂̓XNvg̓͂t[Pʂŕێj
+class Input
+{
+private:
+	Input() = default;
+	~Input() = default;
+
+public:
+	// CX^X擾
+	static Input& Instance()
+	{
+		static Input instance;
+		return instance;
+	}
+
+	// XVit[JnɌĂԁj
+	void Update();
+
+	// XNvg͐ݒiLȊԂ̓L[{[hQƂASetKeyŐݒ肳ꂽԂgj
+	void SetScripted(bool scripted);
+
+	// XNvg͂
+	bool IsScripted() const { return scripted; }
+
+	// L[ԐݒiXNvg͗pj
+	void SetKey(int key, bool pressed);
+
+	// L[Ă邩
+	bool IsKeyPressed(int key) const { return IsValidKey(key) && currentKeys[key]; }
+
+	// L[̃t[ŉꂽ
+	bool IsKeyTriggered(int key) const { return IsValidKey(key) && currentKeys[key] && !previousKeys[key]; }
+
+private:
+	static const int KeyCount = 256;
+
+	static bool IsValidKey(int key) { return key >= 0 && key < KeyCount; }
+
+private:
+	bool	currentKeys[KeyCount] = {};
+	bool	previousKeys[KeyCount] = {};
+	bool	scripted = false;
+};
@@ -0,0 +1,183 @@
+#include <string>
+#include "Misc.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+// s̃XbhgL[ԍiCXbhƃ[J[ȊÕXbh0ԁj
+static thread_local int currentQueueIndex = 0;
+
+// 
+void JobSystem::Initialize(int threadCount)
+{
+	Finalize();
+
+	if (threadCount <= 0)
+	{
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+		if (threadCount <= 0) threadCount = 1;
+	}
+
+	// L[̓CXbh̕쐬
+	queues.resize(threadCount);
+	for (std::unique_ptr<JobQueue>& queue : queues)
+	{
+		queue = std::make_unique<JobQueue>();
+	}
+
+	// [J[XbhN
+	running = true;
+	for (int queueIndex = 1; queueIndex < threadCount; ++queueIndex)
+	{
+		threads.emplace_back(&JobSystem::WorkerMain, this, queueIndex);
+	}
+}
+
+// I
+void JobSystem::Finalize()
+{
+	if (!running && threads.empty())
+	{
+		queues.clear();
+		return;
+	}
+
+	// cĂWusĂ烏[J[~߂
+	Job job;
+	while (PopJob(0, job))
+	{
+		Execute(job);
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		running = false;
+	}
+	sleepCondition.notify_all();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	threads.clear();
+	queues.clear();
+	_ASSERT_EXPR(pendingJobCount == 0, L"job system finalized with pending jobs");
+}
+
+// Wuo^
+void JobSystem::Run(std::function<void()> function, Counter* counter)
+{
+	// O͌ĂяoŎs
+	if (queues.empty())
+	{
+		function();
+		return;
+	}
+
+	if (counter != nullptr)
+	{
+		counter->value.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// s̃Xbh̃L[ɐς
+	JobQueue& queue = *queues.at(currentQueueIndex);
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		Job& job = queue.jobs.emplace_back();
+		job.function = std::move(function);
+		job.counter = counter;
+	}
+	pendingJobCount.fetch_add(1, std::memory_order_release);
+
+	// ҋ@̃[J[NibNŋN̎肱ڂhj
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_one();
+}
+
+// JE^[ɂȂ܂őҋ@
+void JobSystem::Wait(Counter& counter)
+{
+	while (!counter.IsDone())
+	{
+		Job job;
+		if (PopJob(currentQueueIndex, job))
+		{
+			Execute(job);
+		}
+		else
+		{
+			// ̃Xbhs̃Wů҂
+			std::this_thread::yield();
+		}
+	}
+}
+
+// [J[Xbh
+void JobSystem::WorkerMain(int queueIndex)
+{
+	currentQueueIndex = queueIndex;
+
+	// vt@Cɕ\Xbh
+	std::string threadName = "Worker " + std::to_string(queueIndex);
+	Profiler::Instance().SetThreadName(threadName.c_str());
+
+	for (;;)
+	{
+		Job job;
+		if (PopJob(queueIndex, job))
+		{
+			Execute(job);
+			continue;
+		}
+
+		// Wuo^܂Ŗ
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this]() { return !running || pendingJobCount.load(std::memory_order_acquire) > 0; });
+		if (!running) break;
+	}
+}
+
+// Wu擾
+bool JobSystem::PopJob(int queueIndex, Job& job)
+{
+	const int queueCount = static_cast<int>(queues.size());
+	if (queueCount == 0) return false;
+
+	// ̃L[͍Ōɐς񂾃WuoiLbVɎcĂf[^gj
+	{
+		JobQueue& queue = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			pendingJobCount.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// ̃L[͍łÂWu𓐂ށi傫ȒPʂ̎dcĂ邱Ƃj
+	for (int i = 1; i < queueCount; ++i)
+	{
+		JobQueue& queue = *queues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			pendingJobCount.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+// Wus
+void JobSystem::Execute(Job& job)
+{
+	PROFILE_SCOPE("Job");
+	job.function();
+	if (job.counter != nullptr)
+	{
+		job.counter->value.fetch_sub(1, std::memory_order_release);
+	}
+}
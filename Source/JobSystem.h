@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WuVXei[J[̃L[d𓐂ݍXPW[j
+class JobSystem
+{
+private:
+	JobSystem() = default;
+	~JobSystem() { Finalize(); }
+
+public:
+	// WuJE^io^WuIƃ[ɖ߂j
+	class Counter
+	{
+	public:
+		Counter() = default;
+		Counter(const Counter&) = delete;
+		Counter& operator=(const Counter&) = delete;
+
+		// SWu
+		bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+		std::atomic<int>	value{ 0 };
+	};
+
+	// CX^X擾
+	static JobSystem& Instance()
+	{
+		static JobSystem instance;
+		return instance;
+	}
+
+	// ithreadCount̓CXbh܂ރXbhA0̏ꍇ͘_RAj
+	void Initialize(int threadCount = 0);
+
+	// I
+	void Finalize();
+
+	// Xbh擾iCXbh܂ށj
+	int GetThreadCount() const { return static_cast<int>(queues.size()); }
+
+	// Wuo^icounterw肵ꍇ͊ɌZj
+	void Run(std::function<void()> function, Counter* counter = nullptr);
+
+	// JE^[ɂȂ܂őҋ@i҂ĂԂ͑̃Wusj
+	void Wait(Counter& counter);
+
+	// ͈͂𕪊ĕsifunction(begin, end)grainSizeĂсASďI܂ő҂j
+	template<class Function>
+	void ParallelFor(int count, int grainSize, Function function)
+	{
+		if (count <= 0) return;
+		if (grainSize < 1) grainSize = 1;
+
+		// قǂ̗ʂȂ΂̂܂܎s
+		if (count <= grainSize || queues.size() <= 1)
+		{
+			function(0, count);
+			return;
+		}
+
+		Counter counter;
+		for (int begin = grainSize; begin < count; begin += grainSize)
+		{
+			int end = (begin + grainSize < count) ? begin + grainSize : count;
+			Run([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+
+		// 擪͈̔͂͌ĂяoŎs
+		function(0, grainSize);
+		Wait(counter);
+	}
+
+private:
+	struct Job
+	{
+		std::function<void()>	function;
+		Counter*				counter = nullptr;
+	};
+
+	// [J[̃WuL[i͖Ã[J[͐擪oj
+	struct JobQueue
+	{
+		std::mutex			mutex;
+		std::deque<Job>		jobs;
+	};
+
+	// [J[Xbh
+	void WorkerMain(int queueIndex);
+
+	// Wu擾ĩL[Ȃ瑼̃L[瓐ށj
+	bool PopJob(int queueIndex, Job& job);
+
+	// Wus
+	static void Execute(Job& job);
+
+private:
+	std::vector<std::unique_ptr<JobQueue>>	queues;		// 0Ԃ̓CXbh
+	std::vector<std::thread>				threads;
+	std::mutex								sleepMutex;
+	std::condition_variable					sleepCondition;
+	std::atomic<int>						pendingJobCount{ 0 };
+	std::atomic<bool>						running{ false };
+};
@@ -4,14 +4,25 @@
 
 LambertShader::LambertShader(ID3D11Device* device)
 {
-	// _VF[_[
-	GpuResourceUtils::LoadVertexShader(
-		device,
+	// _VF[_[i_tH[}bgƁj
+	const char* vertexShaderFilenames[VertexFormatCount] =
+	{
 		"Data/Shader/LambertVS.cso",
-		Model::InputElementDescs.data(),
-		static_cast<UINT>(Model::InputElementDescs.size()),
-		inputLayout.GetAddressOf(),
-		vertexShader.GetAddressOf());
+		"Data/Shader/LambertCompressedVS.cso",
+		"Data/Shader/LambertCompressedStaticVS.cso",
+	};
+	for (int i = 0; i < VertexFormatCount; ++i)
+	{
+		const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs =
+			ModelResource::GetInputElementDescs(static_cast<ModelResource::VertexFormat>(i));
+		GpuResourceUtils::LoadVertexShader(
+			device,
+			vertexShaderFilenames[i],
+			inputElementDescs.data(),
+			static_cast<UINT>(inputElementDescs.size()),
+			inputLayouts[i].GetAddressOf(),
+			vertexShaders[i].GetAddressOf());
+	}
 
 	// sNZVF[_[
 	GpuResourceUtils::LoadPixelShader(
@@ -31,9 +42,7 @@ void LambertShader::Begin(const RenderContext& rc)
 {
 	ID3D11DeviceContext* dc = rc.deviceContext;
 
-	// VF[_[ݒ
-	dc->IASetInputLayout(inputLayout.Get());
-	dc->VSSetShader(vertexShader.Get(), nullptr, 0);
+	// VF[_[ݒi̓CAEgƒ_VF[_[̓bVƂɐݒj
 	dc->PSSetShader(pixelShader.Get(), nullptr, 0);
 
 	// 萔obt@ݒ
@@ -49,6 +58,11 @@ void LambertShader::Update(const RenderContext& rc, const Model::Mesh& mesh)
 {
 	ID3D11DeviceContext* dc = rc.deviceContext;
 
+	// _tH[}bgɍ킹VF[_[ݒ
+	int vertexFormat = static_cast<int>(mesh.vertexFormat);
+	dc->IASetInputLayout(inputLayouts[vertexFormat].Get());
+	dc->VSSetShader(vertexShaders[vertexFormat].Get(), nullptr, 0);
+
 	// bVp萔obt@XV
 	CbMesh cbMesh{};
 	cbMesh.materialColor = mesh.material->baseColor;
@@ -4,6 +4,9 @@
 #include <tchar.h>
 
 #include "Framework.h"
+#include "HeadlessBenchmark.h"
+#include "CollisionTest.h"
+#include "MicroBenchmark.h"
 
 const LONG SCREEN_WIDTH = 1280;
 const LONG SCREEN_HEIGHT = 720;
@@ -20,6 +23,24 @@ INT WINAPI wWinMain(HINSTANCE instance, HINSTANCE prev_instance, LPWSTR cmd_line
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 	//_CrtSetBreakAlloc(237);
 #endif
+	// }CNx`}[NiEChE炸ɌvJSONoj
+	if (MicroBenchmark::IsRequested(cmd_line))
+	{
+		return MicroBenchmark::RunCommandLine(cmd_line);
+	}
+
+	// Փ˔eXgiEChE炸ɑƏƍďIj
+	if (CollisionTest::IsRequested(cmd_line))
+	{
+		return CollisionTest::RunCommandLine(cmd_line);
+	}
+
+	// wbhXx`}[NiEChE炸ɌvďIj
+	if (HeadlessBenchmark::IsRequested(cmd_line))
+	{
+		return HeadlessBenchmark::RunCommandLine(cmd_line);
+	}
+
 	WNDCLASSEX wcex;
 	wcex.cbSize = sizeof(WNDCLASSEX);
 	wcex.style = CS_HREDRAW | CS_VREDRAW;
@@ -0,0 +1,596 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <intrin.h>
+#include <windows.h>
+#include <shellapi.h>
+#include <SphereCast.h>
+#include "Misc.h"
+#include "AnimationPoseCache.h"
+#include "GLTFImporter.h"
+#include "Model.h"
+#include "RootMotion.h"
+#include "TriangleBVH.h"
+#include "StaticCollisionMesh.h"
+#include "RaycastBatch.h"
+#include "TriangleBVHCollisionWorld.h"
+#include "CharacterController.h"
+#include "MicroBenchmark.h"
+#include "Scene/CharacterControlScene.h"
+
+// œKŌvZȂ悤Ɍʂo
+static volatile float benchmarkSink = 0.0f;
+
+// R}hCɃ}CNx`}[Nw肪邩
+bool MicroBenchmark::IsRequested(const wchar_t* commandLine)
+{
+	return commandLine != nullptr && wcsstr(commandLine, L"-microbenchmark") != nullptr;
+}
+
+// R}hCs
+int MicroBenchmark::RunCommandLine(const wchar_t* commandLine)
+{
+	// UTF-8ɕϊ
+	std::vector<std::string> args;
+	{
+		int argc = 0;
+		LPWSTR* argv = CommandLineToArgvW(commandLine, &argc);
+		for (int i = 0; i < argc; ++i)
+		{
+			char arg[MAX_PATH];
+			WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, arg, sizeof(arg), nullptr, nullptr);
+			args.emplace_back(arg);
+		}
+		LocalFree(argv);
+	}
+
+	// 
+	std::string filter;
+	std::string outputFilename = "MicroBenchmark.json";
+	double minSeconds = 0.5;
+	for (size_t i = 0; i + 1 < args.size(); ++i)
+	{
+		const std::string& option = args[i];
+		const std::string& value = args[i + 1];
+		if (option == "-filter") filter = value;
+		else if (option == "-time") minSeconds = std::stod(value);
+		else if (option == "-out") outputFilename = value;
+		else continue;
+		++i;
+	}
+
+	// v
+	std::vector<Case> cases;
+	CreateCases(cases);
+
+	std::vector<Result> results;
+	for (const Case& benchmarkCase : cases)
+	{
+		if (!filter.empty() && benchmarkCase.name.find(filter) == std::string::npos) continue;
+
+		const Result& result = results.emplace_back(Measure(benchmarkCase, minSeconds));
+
+		char line[256];
+		snprintf(line, sizeof(line), "%-48s %12.1f ns/op %14.0f items/s\n",
+			result.name.c_str(), result.nanosecondsPerOperation, result.itemsPerSecond);
+		OutputDebugStringA(line);
+	}
+
+	WriteJson(outputFilename.c_str(), results);
+	return results.empty() ? 1 : 0;
+}
+
+// v
+MicroBenchmark::Result MicroBenchmark::Measure(const Case& benchmarkCase, double minSeconds)
+{
+	const int sampleCount = 5;
+	Benchmark benchmark;
+
+	// LbV߂APTvڕWԂɓ͂s񐔂߂
+	int64_t operationCount = 1;
+	for (;;)
+	{
+		benchmark.begin();
+		benchmarkCase.function(operationCount);
+		double seconds = benchmark.end();
+		if (seconds >= minSeconds / sampleCount || operationCount >= (1LL << 40)) break;
+
+		int64_t scale = seconds > 0.0 ? static_cast<int64_t>(minSeconds / sampleCount / seconds * 1.2) + 1 : 10;
+		operationCount *= std::clamp<int64_t>(scale, 2, 10);
+	}
+
+	// l̃Tv̗pi荞݂Ȃǂ̊Ol̉e}j
+	std::vector<double> samples;
+	for (int i = 0; i < sampleCount; ++i)
+	{
+		benchmark.begin();
+		benchmarkCase.function(operationCount);
+		samples.emplace_back(benchmark.end());
+	}
+	std::sort(samples.begin(), samples.end());
+	double seconds = samples[sampleCount / 2];
+
+	Result result;
+	result.name = benchmarkCase.name;
+	result.operationCount = operationCount;
+	result.itemsPerOperation = benchmarkCase.itemsPerOperation;
+	result.nanosecondsPerOperation = seconds * 1e9 / operationCount;
+	result.itemsPerSecond = operationCount * benchmarkCase.itemsPerOperation / seconds;
+	return result;
+}
+
+// vP[X쐬
+void MicroBenchmark::CreateCases(std::vector<Case>& cases)
+{
+	using HitResult = CharacterControlScene::HitResult;
+
+	// ͂͌ŒV[h̗ƃ|Wg̃fAsɓɂ
+	std::mt19937 random(0x5EED);
+	const int queryCount = 1024;
+
+	// LN^[iGPU\[X炸ɓǂݍށj
+	std::shared_ptr<ModelResource> characterResource = std::make_shared<ModelResource>(nullptr, "Data/Model/RPG-Character/RPG-Character.glb");
+	std::shared_ptr<Model> character = std::make_shared<Model>(characterResource);
+	std::shared_ptr<Model> compressedCharacter = std::make_shared<Model>(characterResource);
+	character->SetCompressedAnimationEnabled(false);
+	const int nodeCount = static_cast<int>(character->GetNodes().size());
+	const int animationIndex = 0;
+	const float animationLength = character->GetAnimations().at(animationIndex).secondsLength;
+
+	// Xe[W
+	std::shared_ptr<Model> stage = std::make_shared<Model>(nullptr, "Data/Model/Greybox/Greybox.glb");
+	DirectX::XMFLOAT4X4 identity;
+	DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+	stage->UpdateTransform(identity);
+	std::shared_ptr<TriangleBVH> bvh = std::make_shared<TriangleBVH>();
+	bvh->Build(stage.get());
+	std::shared_ptr<StaticCollisionMesh> collisionMesh = std::make_shared<StaticCollisionMesh>();
+	collisionMesh->Build(stage.get());
+
+	// Xe[WŜAABB
+	DirectX::XMFLOAT3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+	DirectX::XMFLOAT3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (int i = 0; i < bvh->GetTriangleCount(); ++i)
+	{
+		for (const DirectX::XMFLOAT3& p : bvh->GetTriangle(i).positions)
+		{
+			boundsMin = { (std::min)(boundsMin.x, p.x), (std::min)(boundsMin.y, p.y), (std::min)(boundsMin.z, p.z) };
+			boundsMax = { (std::max)(boundsMax.x, p.x), (std::max)(boundsMax.y, p.y), (std::max)(boundsMax.z, p.z) };
+		}
+	}
+	std::uniform_real_distribution<float> randomX(boundsMin.x, boundsMax.x);
+	std::uniform_real_distribution<float> randomY(boundsMin.y, boundsMax.y);
+	std::uniform_real_distribution<float> randomZ(boundsMin.z, boundsMax.z);
+
+	// CiXe[ŴQ_ԁjƋiXe[W̓_j
+	std::vector<DirectX::XMFLOAT3> rayStarts(queryCount), rayEnds(queryCount), sphereCenters(queryCount);
+	for (int i = 0; i < queryCount; ++i)
+	{
+		rayStarts[i] = { randomX(random), randomY(random), randomZ(random) };
+		rayEnds[i] = { randomX(random), randomY(random), randomZ(random) };
+		sphereCenters[i] = { randomX(random), randomY(random), randomZ(random) };
+	}
+	const float sphereRadius = 0.5f;
+
+	// Op`P̂̔pɁAOp`̋߂ɒuƃXtBALXg
+	struct TriangleQuery
+	{
+		DirectX::XMFLOAT3	positions[3];
+		DirectX::XMFLOAT3	start;
+		DirectX::XMFLOAT3	end;
+	};
+	std::vector<TriangleQuery> triangleQueries(queryCount);
+	{
+		std::uniform_int_distribution<int> randomTriangle(0, bvh->GetTriangleCount() - 1);
+		std::uniform_real_distribution<float> randomOffset(-1.0f, 1.0f);
+		for (TriangleQuery& query : triangleQueries)
+		{
+			const TriangleBVH::Triangle& triangle = bvh->GetTriangle(randomTriangle(random));
+			std::copy(std::begin(triangle.positions), std::end(triangle.positions), query.positions);
+			DirectX::XMVECTOR Center = DirectX::XMVectorScale(DirectX::XMVectorAdd(DirectX::XMVectorAdd(
+				DirectX::XMLoadFloat3(&triangle.positions[0]),
+				DirectX::XMLoadFloat3(&triangle.positions[1])),
+				DirectX::XMLoadFloat3(&triangle.positions[2])), 1.0f / 3.0f);
+			DirectX::XMVECTOR Offset = DirectX::XMVectorSet(randomOffset(random), randomOffset(random), randomOffset(random), 0);
+			DirectX::XMStoreFloat3(&query.start, DirectX::XMVectorAdd(Center, Offset));
+			DirectX::XMStoreFloat3(&query.end, DirectX::XMVectorSubtract(Center, Offset));
+		}
+	}
+
+	// Aj[VvZiPőSm[h̎p߂j
+	cases.push_back({ "Model::ComputeAnimation", nodeCount,
+		[character, animationIndex, animationLength, nodePoses = std::vector<Model::NodePose>()](int64_t count) mutable
+		{
+			float time = 0.0f;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				character->ComputeAnimation(animationIndex, time, nodePoses);
+				time += 1.0f / 60.0f;
+				if (time >= animationLength) time -= animationLength;
+			}
+			benchmarkSink = nodePoses.front().rotation.x;
+		} });
+
+	// J[\𗘗pAj[VvZ
+	cases.push_back({ "Model::ComputeAnimation(cursor)", nodeCount,
+		[character, animationIndex, animationLength, nodePoses = std::vector<Model::NodePose>(), cursor = Model::AnimationCursor()](int64_t count) mutable
+		{
+			float time = 0.0f;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				character->ComputeAnimation(animationIndex, time, nodePoses, cursor);
+				time += 1.0f / 60.0f;
+				if (time >= animationLength) time -= animationLength;
+			}
+			benchmarkSink = nodePoses.front().rotation.x;
+		} });
+
+	// ʎqAj[V𗘗pAj[VvZ
+	cases.push_back({ "Model::ComputeAnimation(compressed)", nodeCount,
+		[compressedCharacter, animationIndex, animationLength, nodePoses = std::vector<Model::NodePose>(), cursor = Model::AnimationCursor()](int64_t count) mutable
+		{
+			float time = 0.0f;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				compressedCharacter->ComputeAnimation(animationIndex, time, nodePoses, cursor);
+				time += 1.0f / 60.0f;
+				if (time >= animationLength) time -= animationLength;
+			}
+			benchmarkSink = nodePoses.front().rotation.x;
+		} });
+
+	// pLbVi100̂4ʂ̍ĐʒuLPt[j
+	{
+		std::shared_ptr<AnimationPoseCache> poseCache = std::make_shared<AnimationPoseCache>();
+		const int crowdCount = 100;
+		cases.push_back({ "AnimationPoseCache::GetPose", crowdCount,
+			[character, poseCache, animationIndex, animationLength, crowdCount](int64_t count)
+			{
+				float time = 0.0f;
+				float sum = 0.0f;
+				for (int64_t i = 0; i < count; ++i)
+				{
+					poseCache->BeginFrame();
+					for (int instance = 0; instance < crowdCount; ++instance)
+					{
+						float instanceTime = fmodf(time + animationLength * (instance % 4) * 0.25f, animationLength);
+						sum += poseCache->GetPose(character.get(), animationIndex, instanceTime)[0].rotation.x;
+					}
+					time += 1.0f / 60.0f;
+					if (time >= animationLength) time -= animationLength;
+				}
+				benchmarkSink = sum;
+			} });
+	}
+
+	// [g[VvZiOvZݐσJ[u̎QƁj
+	{
+		std::shared_ptr<RootMotion> rootMotion = std::make_shared<RootMotion>(character.get(), character->GetNodeIndex("B_Pelvis"), false, true, false);
+		cases.push_back({ "RootMotion::Compute", 1,
+			[rootMotion, animationIndex, animationLength](int64_t count)
+			{
+				DirectX::XMFLOAT3 translation, position;
+				float time = 0.0f;
+				for (int64_t i = 0; i < count; ++i)
+				{
+					float oldTime = time;
+					time += 1.0f / 60.0f;
+					if (time >= animationLength) time -= animationLength;
+					rootMotion->Compute(animationIndex, oldTime, time, translation, position);
+				}
+				benchmarkSink = translation.x + position.y;
+			} });
+	}
+
+	// gXtH[XVip؂ւđSm[hČvZj
+	{
+		std::vector<Model::NodePose> poses[2];
+		character->ComputeAnimation(animationIndex, animationLength * 0.25f, poses[0]);
+		character->ComputeAnimation(animationIndex, animationLength * 0.75f, poses[1]);
+		cases.push_back({ "Model::UpdateTransform", nodeCount,
+			[character, poses, identity](int64_t count)
+			{
+				for (int64_t i = 0; i < count; ++i)
+				{
+					character->SetNodePoses(poses[i & 1]);
+					character->UpdateTransform(identity);
+				}
+				benchmarkSink = character->GetNodes().back().worldTransform._41;
+			} });
+	}
+
+	// ^WFgvZił傫bVj
+	{
+		const ModelResource::Mesh* largestMesh = &characterResource->GetMeshes().front();
+		for (const ModelResource::Mesh& mesh : characterResource->GetMeshes())
+		{
+			if (mesh.indices.size() > largestMesh->indices.size()) largestMesh = &mesh;
+		}
+		cases.push_back({ "GLTFImporter::ComputeTangents", static_cast<int>(largestMesh->indices.size() / 3),
+			[vertices = largestMesh->vertices, indices = largestMesh->indices](int64_t count) mutable
+			{
+				for (int64_t i = 0; i < count; ++i)
+				{
+					GLTFImporter::ComputeTangents(vertices, indices);
+				}
+				benchmarkSink = vertices.front().tangent.x;
+			} });
+	}
+
+	// ƎOp`
+	cases.push_back({ "CharacterControlScene::SphereIntersectTriangle", queryCount,
+		[triangleQueries, sphereRadius](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (const TriangleQuery& query : triangleQueries)
+				{
+					DirectX::XMFLOAT3 hitPosition, hitNormal;
+					if (CharacterControlScene::SphereIntersectTriangle(query.start, sphereRadius,
+						query.positions[0], query.positions[1], query.positions[2], hitPosition, hitNormal))
+					{
+						hitCount++;
+					}
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// XtBALXgƎOp`
+	cases.push_back({ "IntersectSphereCastVsTriangle", queryCount,
+		[triangleQueries, sphereRadius](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (const TriangleQuery& query : triangleQueries)
+				{
+					DirectX::XMVECTOR Positions[3] =
+					{
+						DirectX::XMLoadFloat3(&query.positions[0]),
+						DirectX::XMLoadFloat3(&query.positions[1]),
+						DirectX::XMLoadFloat3(&query.positions[2]),
+					};
+					SphereCastResult result;
+					if (IntersectSphereCastVsTriangle(DirectX::XMLoadFloat3(&query.start), DirectX::XMLoadFloat3(&query.end), sphereRadius, Positions, &result))
+					{
+						hitCount++;
+					}
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// XtBALXgBVHiXe[ŴQ_Ԃړ鋅j
+	cases.push_back({ "TriangleBVH::SphereCast", queryCount,
+		[bvh, rayStarts, rayEnds, sphereRadius](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (int j = 0; j < static_cast<int>(rayStarts.size()); ++j)
+				{
+					DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&rayEnds[j]), DirectX::XMLoadFloat3(&rayStarts[j]));
+					DirectX::XMFLOAT3 direction;
+					DirectX::XMStoreFloat3(&direction, DirectX::XMVector3Normalize(Vec));
+					float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+
+					TriangleBVH::HitResult hit;
+					if (bvh->SphereCast(rayStarts[j], direction, sphereRadius, distance, hit)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// LN^[Rg[[iXe[W̊e_烌C̏I_֌ĂPt[ړj
+	{
+		auto collisionWorld = std::make_shared<TriangleBVHCollisionWorld>();
+		collisionWorld->SetBVH(bvh.get());
+
+		std::vector<DirectX::XMFLOAT3> displacements(queryCount);
+		for (int i = 0; i < queryCount; ++i)
+		{
+			DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&rayEnds[i]), DirectX::XMLoadFloat3(&rayStarts[i]));
+			DirectX::XMStoreFloat3(&displacements[i], DirectX::XMVectorScale(DirectX::XMVector3Normalize(Vec), 0.1f));
+			displacements[i].y -= 0.05f;
+		}
+
+		cases.push_back({ "CharacterController::Move", queryCount,
+			[bvh, collisionWorld, rayStarts, displacements, controllers = std::vector<CharacterController>(queryCount)](int64_t count) mutable
+			{
+				int hitCount = 0;
+				for (int64_t i = 0; i < count; ++i)
+				{
+					for (int j = 0; j < static_cast<int>(controllers.size()); ++j)
+					{
+						controllers[j].SetPosition(rayStarts[j]);
+						if (controllers[j].Move(*collisionWorld, displacements[j]) != CharacterController::CollisionNone) hitCount++;
+					}
+				}
+				benchmarkSink = static_cast<float>(hitCount);
+			} });
+	}
+
+	// CƃfiSOp`j
+	cases.push_back({ "CharacterControlScene::RayIntersectModel(Model)", queryCount,
+		[stage, rayStarts, rayEnds](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (int j = 0; j < static_cast<int>(rayStarts.size()); ++j)
+				{
+					HitResult hit;
+					if (CharacterControlScene::RayIntersectModel(rayStarts[j], rayEnds[j], stage.get(), hit)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// CBVH
+	cases.push_back({ "CharacterControlScene::RayIntersectModel(BVH)", queryCount,
+		[bvh, rayStarts, rayEnds](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (int j = 0; j < static_cast<int>(rayStarts.size()); ++j)
+				{
+					HitResult hit;
+					if (CharacterControlScene::RayIntersectModel(rayStarts[j], rayEnds[j], *bvh, hit)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// CƐÓIՓ˔胁bV
+	cases.push_back({ "CharacterControlScene::RayIntersectModel(StaticCollisionMesh)", queryCount,
+		[collisionMesh, rayStarts, rayEnds](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (int j = 0; j < static_cast<int>(rayStarts.size()); ++j)
+				{
+					HitResult hit;
+					if (CharacterControlScene::RayIntersectModel(rayStarts[j], rayEnds[j], *collisionMesh, hit)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// S{̃pPbgŐÓIՓ˔胁bV
+	cases.push_back({ "StaticCollisionMesh::RayCastPacket", queryCount,
+		[collisionMesh, rayStarts, rayEnds](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (int j = 0; j + TriangleBlocks::BlockSize <= static_cast<int>(rayStarts.size()); j += TriangleBlocks::BlockSize)
+				{
+					StaticCollisionMesh::HitResult hits[TriangleBlocks::BlockSize];
+					bool results[TriangleBlocks::BlockSize];
+					collisionMesh->RayCastPacket(&rayStarts[j], &rayEnds[j], TriangleBlocks::BlockSize, hits, results);
+					for (bool result : results)
+					{
+						if (result) hitCount++;
+					}
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// ob`ł܂Ƃ߂ĐÓIՓ˔胁bVipPbgꍇ̓WuVXeŕj
+	cases.push_back({ "RaycastBatch::Execute", queryCount,
+		[collisionMesh, rayStarts, rayEnds, batch = std::make_shared<RaycastBatch>()](int64_t count)
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				batch->Clear();
+				for (int j = 0; j < static_cast<int>(rayStarts.size()); ++j)
+				{
+					batch->AddRay(rayStarts[j], rayEnds[j]);
+				}
+				batch->Execute(*collisionMesh);
+				for (int j = 0; j < batch->GetRayCount(); ++j)
+				{
+					if (batch->IsHit(j)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// ƃfiSOp`j
+	cases.push_back({ "CharacterControlScene::SphereIntersectModel(Model)", queryCount,
+		[stage, sphereCenters, sphereRadius, hits = std::vector<HitResult>()](int64_t count) mutable
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (const DirectX::XMFLOAT3& center : sphereCenters)
+				{
+					if (CharacterControlScene::SphereIntersectModel(center, sphereRadius, stage.get(), hits)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// ƐÓIՓ˔胁bV
+	cases.push_back({ "CharacterControlScene::SphereIntersectModel(StaticCollisionMesh)", queryCount,
+		[collisionMesh, sphereCenters, sphereRadius, hits = std::vector<HitResult>()](int64_t count) mutable
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (const DirectX::XMFLOAT3& center : sphereCenters)
+				{
+					if (CharacterControlScene::SphereIntersectModel(center, sphereRadius, *collisionMesh, hits)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+
+	// BVH
+	cases.push_back({ "CharacterControlScene::SphereIntersectModel(BVH)", queryCount,
+		[bvh, sphereCenters, sphereRadius, hits = std::vector<HitResult>()](int64_t count) mutable
+		{
+			int hitCount = 0;
+			for (int64_t i = 0; i < count; ++i)
+			{
+				for (const DirectX::XMFLOAT3& center : sphereCenters)
+				{
+					if (CharacterControlScene::SphereIntersectModel(center, sphereRadius, *bvh, hits)) hitCount++;
+				}
+			}
+			benchmarkSink = static_cast<float>(hitCount);
+		} });
+}
+
+// JSONo
+void MicroBenchmark::WriteJson(const char* filename, const std::vector<Result>& results)
+{
+	FILE* fp = nullptr;
+	if (fopen_s(&fp, filename, "w") != 0 || fp == nullptr)
+	{
+		_ASSERT_EXPR_A(false, (std::string("failed to write ") + filename).c_str());
+		return;
+	}
+
+	// }VԂŔrł悤CPUƃXbho͂
+	char cpuName[49] = {};
+	{
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 0x80000000);
+		if (static_cast<unsigned int>(cpuInfo[0]) >= 0x80000004)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				__cpuid(reinterpret_cast<int*>(cpuName + i * 16), 0x80000002 + i);
+			}
+		}
+	}
+
+	fprintf(fp, "{\n");
+	fprintf(fp, "  \"cpu\": \"%s\",\n", cpuName);
+	fprintf(fp, "  \"threads\": %u,\n", std::thread::hardware_concurrency());
+	fprintf(fp, "  \"benchmarks\": [\n");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& result = results.at(i);
+		fprintf(fp, "    { \"name\": \"%s\", \"operations\": %lld, \"items_per_op\": %d, \"ns_per_op\": %.3f, \"items_per_second\": %.1f }%s\n",
+			result.name.c_str(),
+			static_cast<long long>(result.operationCount),
+			result.itemsPerOperation,
+			result.nanosecondsPerOperation,
+			result.itemsPerSecond,
+			i + 1 < results.size() ? "," : "");
+	}
+	fprintf(fp, "  ]\n");
+	fprintf(fp, "}\n");
+	fclose(fp);
+}
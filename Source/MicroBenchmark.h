@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// }CNx`}[NiZE`󔻒J[lŒ͂ŌvAJSONŏo͂j
+class MicroBenchmark
+{
+public:
+	// v
+	struct Result
+	{
+		std::string		name;
+		int64_t			operationCount = 0;			// vɎgs񐔁iPTvj
+		int				itemsPerOperation = 1;		// P̎sŏvfim[hAOp`ACȂǁj
+		double			nanosecondsPerOperation = 0;
+		double			itemsPerSecond = 0;
+	};
+
+	// R}hCɃ}CNx`}[Nw肪邩
+	static bool IsRequested(const wchar_t* commandLine);
+
+	// R}hCsi-microbenchmark [-filter Öꕔ] [-time b] [-out t@C]j
+	static int RunCommandLine(const wchar_t* commandLine);
+
+private:
+	// vP[XifunctionoperationCount̎ssj
+	struct Case
+	{
+		std::string								name;
+		int										itemsPerOperation = 1;
+		std::function<void(int64_t)>			function;
+	};
+
+	// viTv̎s񐔂𒲐Al̗pj
+	static Result Measure(const Case& benchmarkCase, double minSeconds);
+
+	// vP[X쐬
+	static void CreateCases(std::vector<Case>& cases);
+
+	// JSONo
+	static void WriteJson(const char* filename, const std::vector<Result>& results);
+};
@@ -1,521 +1,473 @@
-#include <filesystem>
-#include <fstream>
-#include <cereal/cereal.hpp>
-#include <cereal/archives/binary.hpp>
-#include <cereal/types/string.hpp>
-#include <cereal/types/vector.hpp>
+#include <algorithm>
+#include <cstring>
 #include "Misc.h"
-#include "GLTFImporter.h"
-#include "GpuResourceUtils.h"
 #include "Model.h"
 
-const std::vector<D3D11_INPUT_ELEMENT_DESC> Model::InputElementDescs =
-{
-	{ "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "NORMAL",       0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "TANGENT",      0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "TEXCOORD",     0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "BONE_WEIGHTS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "BONE_INDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT,  0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-};
-
-namespace DirectX
-{
-	template<class Archive>
-	void serialize(Archive& archive, XMUINT4& v)
-	{
-		archive(
-			cereal::make_nvp("x", v.x),
-			cereal::make_nvp("y", v.y),
-			cereal::make_nvp("z", v.z),
-			cereal::make_nvp("w", v.w)
-		);
-	}
-
-	template<class Archive>
-	void serialize(Archive& archive, XMFLOAT2& v)
-	{
-		archive(
-			cereal::make_nvp("x", v.x),
-			cereal::make_nvp("y", v.y)
-		);
-	}
-
-	template<class Archive>
-	void serialize(Archive& archive, XMFLOAT3& v)
-	{
-		archive(
-			cereal::make_nvp("x", v.x),
-			cereal::make_nvp("y", v.y),
-			cereal::make_nvp("z", v.z)
-		);
-	}
-
-	template<class Archive>
-	void serialize(Archive& archive, XMFLOAT4& v)
-	{
-		archive(
-			cereal::make_nvp("x", v.x),
-			cereal::make_nvp("y", v.y),
-			cereal::make_nvp("z", v.z),
-			cereal::make_nvp("w", v.w)
-		);
-	}
-
-	template<class Archive>
-	void serialize(Archive& archive, XMFLOAT4X4& m)
-	{
-		archive(
-			cereal::make_nvp("_11", m._11),
-			cereal::make_nvp("_12", m._12),
-			cereal::make_nvp("_13", m._13),
-			cereal::make_nvp("_14", m._14),
-			cereal::make_nvp("_21", m._21),
-			cereal::make_nvp("_22", m._22),
-			cereal::make_nvp("_23", m._23),
-			cereal::make_nvp("_24", m._24),
-			cereal::make_nvp("_31", m._31),
-			cereal::make_nvp("_32", m._32),
-			cereal::make_nvp("_33", m._33),
-			cereal::make_nvp("_34", m._34),
-			cereal::make_nvp("_41", m._41),
-			cereal::make_nvp("_42", m._42),
-			cereal::make_nvp("_43", m._43),
-			cereal::make_nvp("_44", m._44)
-		);
-	}
-}
-
-template<class Archive>
-void Model::Node::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(name),
-		CEREAL_NVP(parentIndex),
-		CEREAL_NVP(position),
-		CEREAL_NVP(rotation),
-		CEREAL_NVP(scale)
-	);
-}
-
-template<class Archive>
-void Model::Material::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(name),
-		CEREAL_NVP(baseTextureFileName),
-		CEREAL_NVP(normalTextureFileName),
-		CEREAL_NVP(emissiveTextureFileName),
-		CEREAL_NVP(occlusionTextureFileName),
-		CEREAL_NVP(metalnessRoughnessTextureFileName),
-		CEREAL_NVP(baseColor),
-		CEREAL_NVP(emissiveColor),
-		CEREAL_NVP(metalness),
-		CEREAL_NVP(roughness),
-		CEREAL_NVP(occlusionStrength),
-		CEREAL_NVP(alphaCutoff),
-		CEREAL_NVP(alphaMode)
-	);
-}
-
-template<class Archive>
-void Model::Vertex::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(position),
-		CEREAL_NVP(boneWeight),
-		CEREAL_NVP(boneIndex),
-		CEREAL_NVP(texcoord),
-		CEREAL_NVP(normal),
-		CEREAL_NVP(tangent)
-	);
-}
-
-template<class Archive>
-void Model::Bone::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(nodeIndex),
-		CEREAL_NVP(offsetTransform)
-	);
-}
-
-template<class Archive>
-void Model::Mesh::serialize(Archive& archive)
+// RXgN^
+Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
+	: Model(ModelResource::Load(device, filename, sampleRate))
 {
-	archive(
-		CEREAL_NVP(vertices),
-		CEREAL_NVP(indices),
-		CEREAL_NVP(bones),
-		CEREAL_NVP(nodeIndex),
-		CEREAL_NVP(materialIndex)
-	);
 }
 
-template<class Archive>
-void Model::VectorKeyframe::serialize(Archive& archive)
+// RXgN^
+Model::Model(std::shared_ptr<ModelResource> resource)
+	: resource(resource)
+	, hierarchy(resource->GetNodes())
 {
-	archive(
-		CEREAL_NVP(seconds),
-		CEREAL_NVP(value)
-	);
-}
+	// \[X̏pm[h쐬
+	const std::vector<ModelResource::Node>& resourceNodes = resource->GetNodes();
+	nodes.resize(resourceNodes.size());
+	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+	{
+		const ModelResource::Node& resourceNode = resourceNodes.at(nodeIndex);
+		Node& node = nodes.at(nodeIndex);
 
-template<class Archive>
-void Model::QuaternionKeyframe::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(seconds),
-		CEREAL_NVP(value)
-	);
-}
+		node.name = resourceNode.name.c_str();
+		node.parentIndex = resourceNode.parentIndex;
+		node.position = resourceNode.position;
+		node.rotation = resourceNode.rotation;
+		node.scale = resourceNode.scale;
 
-template<class Archive>
-void Model::NodeAnim::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(positionKeyframes),
-		CEREAL_NVP(rotationKeyframes),
-		CEREAL_NVP(scaleKeyframes)
-	);
-}
+		// eq֌W\zie͎qOɕłOōXVj
+		_ASSERT_EXPR_A(node.parentIndex < static_cast<int>(nodeIndex), "parent node must precede its children");
+		node.parent = node.parentIndex >= 0 ? &nodes.at(node.parentIndex) : nullptr;
+		if (node.parent != nullptr)
+		{
+			node.parent->children.emplace_back(&node);
+		}
+	}
 
-template<class Archive>
-void Model::Animation::serialize(Archive& archive)
-{
-	archive(
-		CEREAL_NVP(name),
-		CEREAL_NVP(secondsLength),
-		CEREAL_NVP(nodeAnims)
-	);
+	// s񏉊
+	DirectX::XMFLOAT4X4 worldTransform;
+	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
+	UpdateTransform(worldTransform);
 }
 
-// RXgN^
-Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
+// gXtH[XV
+void Model::UpdateTransform(const DirectX::XMFLOAT4X4& worldTransform)
 {
-	std::filesystem::path filepath(filename);
-	std::filesystem::path dirpath(filepath.parent_path());
-
-	std::filesystem::path extension = filepath.extension();
-
-	// Ǝ`̃ft@C̑݊mF
-	filepath.replace_extension(".cereal");
-	if (std::filesystem::exists(filepath))
+	// [hs񂪕ςĂȂΎpςm[hXV΂悢
+	if (memcmp(&this->worldTransform, &worldTransform, sizeof(worldTransform)) != 0)
 	{
-		// Ǝ`̃ft@C̓ǂݍ
-		Deserialize(filepath.string().c_str());
+		this->worldTransform = worldTransform;
+		worldTransformDirty = true;
 	}
-	else if (extension == ".gltf" || extension == ".glb")
-	{
-		// ėpft@C̓ǂݍ
-		GLTFImporter importer(filename);
-
-		// }eAf[^ǂݎ
-		importer.LoadMaterials(materials, device);
-
-		// m[hf[^ǂݎ
-		importer.LoadNodes(nodes);
 
-		// bVf[^ǂݎ
-		importer.LoadMeshes(meshes, nodes);
-
-		// Aj[Vf[^ǂݎ
-		importer.LoadAnimations(animations, nodes, sampleRate);
-
-		// Ǝ`̃ft@Cۑ
-		//Serialize(filepath.string().c_str());
-	}
-	else
+	// Î~Ă郂f̓m[h𑖍ɍς܂
+	if (!poseDirty && !worldTransformDirty)
 	{
-		_ASSERT_EXPR_A(false, "found not model file");
+		return;
 	}
 
-	// }eA\z
-	for (Material& material : materials)
+	// e͎qOɕł̂Ő擪珇ɐe̕ύXq֓`
+	size_t dirtyCount = 0;
+	if (poseDirty)
 	{
-		if (material.baseMap == nullptr)
+		for (Node& node : nodes)
 		{
-			if (material.baseTextureFileName.empty())
-			{
-				// _~[eNX`쐬
-				HRESULT hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFFFFFF,
-					material.baseMap.GetAddressOf());
-				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-			}
-			else
-			{
-				// x[XeNX`ǂݍ
-				std::filesystem::path diffuseTexturePath(dirpath / material.baseTextureFileName);
-				HRESULT hr = GpuResourceUtils::LoadTexture(device, diffuseTexturePath.string().c_str(),
-					material.baseMap.GetAddressOf());
-				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-			}
+			node.dirty = node.dirty || (node.parent != nullptr && node.parent->dirty);
+			if (node.dirty) ++dirtyCount;
 		}
+	}
 
-		if (material.normalMap == nullptr)
+	if (dirtyCount * 2 >= nodes.size() && dirtyCount > 0)
+	{
+		// Aj[VĐȂǑ唼̃m[hςꍇ͂܂Ƃ߂ČvZ
+		ComputeHierarchyTransform();
+	}
+	else
+	{
+		DirectX::XMMATRIX ParentWorldTransform = DirectX::XMLoadFloat4x4(&worldTransform);
+		for (Node& node : nodes)
 		{
-			if (material.normalTextureFileName.empty())
+			if (node.dirty)
 			{
-				// @_~[eNX`쐬
-				HRESULT hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFF7F7F,
-					material.normalMap.GetAddressOf());
-				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+				ComputeNodeTransform(node, ParentWorldTransform);
 			}
-			else
+			else if (worldTransformDirty)
 			{
-				// @eNX`ǂݍ
-				std::filesystem::path texturePath(dirpath / material.normalTextureFileName);
-				HRESULT hr = GpuResourceUtils::LoadTexture(device, texturePath.string().c_str(),
-					material.normalMap.GetAddressOf());
-				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+				// [hs񂾂ςꍇ̓O[osg
+				DirectX::XMMATRIX GlobalTransform = DirectX::XMLoadFloat4x4(&node.globalTransform);
+				DirectX::XMStoreFloat4x4(&node.worldTransform, GlobalTransform * ParentWorldTransform);
 			}
 		}
 	}
 
-	// m[h\z
-	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+	// qւ̓`ÎŃtO낷
+	if (dirtyCount > 0)
 	{
-		Node& node = nodes.at(nodeIndex);
-
-		// eq֌W\z
-		node.parent = node.parentIndex >= 0 ? &nodes.at(node.parentIndex) : nullptr;
-		if (node.parent != nullptr)
+		for (Node& node : nodes)
 		{
-			node.parent->children.emplace_back(&node);
+			node.dirty = false;
 		}
 	}
+	poseDirty = false;
+	worldTransformDirty = false;
+}
+
+// wm[hȉ̃gXtH[XV
+void Model::UpdateSubtree(int nodeIndex)
+{
+	ComputeSubtreeTransform(nodes.at(nodeIndex), DirectX::XMLoadFloat4x4(&worldTransform));
+}
 
-	// bV\z
-	for (Mesh& mesh : meshes)
+// m[h̍svZ
+void Model::ComputeNodeTransform(Node& node, DirectX::FXMMATRIX ParentWorldTransform)
+{
+	// [JsZo
+	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
+	DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
+	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
+	DirectX::XMMATRIX LocalTransform = S * R * T;
+
+	// O[osZo
+	DirectX::XMMATRIX ParentGlobalTransform;
+	if (node.parent != nullptr)
+	{
+		ParentGlobalTransform = DirectX::XMLoadFloat4x4(&node.parent->globalTransform);
+	}
+	else
 	{
-		// Qƃ}eAݒ
-		mesh.material = &materials.at(mesh.materialIndex);
+		ParentGlobalTransform = DirectX::XMMatrixIdentity();
+	}
+	DirectX::XMMATRIX GlobalTransform = LocalTransform * ParentGlobalTransform;
 
-		// Qƃm[hݒ
-		mesh.node = &nodes.at(mesh.nodeIndex);
+	// [hsZo
+	DirectX::XMMATRIX WorldTransform = GlobalTransform * ParentWorldTransform;
 
-		// _obt@
-		{
-			D3D11_BUFFER_DESC bufferDesc = {};
-			D3D11_SUBRESOURCE_DATA subresourceData = {};
-
-			bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * mesh.vertices.size());
-			bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-			bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-			bufferDesc.CPUAccessFlags = 0;
-			bufferDesc.MiscFlags = 0;
-			bufferDesc.StructureByteStride = 0;
-			subresourceData.pSysMem = mesh.vertices.data();
-			subresourceData.SysMemPitch = 0;
-			subresourceData.SysMemSlicePitch = 0;
-
-			HRESULT hr = device->CreateBuffer(&bufferDesc, &subresourceData, mesh.vertexBuffer.GetAddressOf());
-			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-		}
+	// vZʂi[
+	DirectX::XMStoreFloat4x4(&node.localTransform, LocalTransform);
+	DirectX::XMStoreFloat4x4(&node.globalTransform, GlobalTransform);
+	DirectX::XMStoreFloat4x4(&node.worldTransform, WorldTransform);
+}
 
-		// CfbNXobt@
-		{
-			D3D11_BUFFER_DESC bufferDesc = {};
-			D3D11_SUBRESOURCE_DATA subresourceData = {};
-
-			bufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * mesh.indices.size());
-			bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-			bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-			bufferDesc.CPUAccessFlags = 0;
-			bufferDesc.MiscFlags = 0;
-			bufferDesc.StructureByteStride = 0;
-			subresourceData.pSysMem = mesh.indices.data();
-			subresourceData.SysMemPitch = 0;
-			subresourceData.SysMemSlicePitch = 0;
-			HRESULT hr = device->CreateBuffer(&bufferDesc, &subresourceData, mesh.indexBuffer.GetAddressOf());
-			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-		}
+// wm[hȉ̍svZ
+void Model::ComputeSubtreeTransform(Node& node, DirectX::FXMMATRIX ParentWorldTransform)
+{
+	ComputeNodeTransform(node, ParentWorldTransform);
+	node.dirty = false;
 
-		// {[\z
-		for (Bone& bone : mesh.bones)
-		{
-			// Qƃm[hݒ
-			bone.node = &nodes.at(bone.nodeIndex);
-		}
+	for (Node* child : node.children)
+	{
+		ComputeSubtreeTransform(*child, ParentWorldTransform);
 	}
-
-	// s񏉊
-	DirectX::XMFLOAT4X4 worldTransform;
-	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
-	UpdateTransform(worldTransform);
 }
 
-// Aj[Vǉǂݍ
-void Model::AppendAnimations(const char* filename)
+// Sm[h̍sm[hKwł܂Ƃ߂ČvZ
+void Model::ComputeHierarchyTransform()
 {
-	std::filesystem::path filepath(filename);
-	std::filesystem::path dirpath(filepath.parent_path());
-
-	if (filepath.extension() == ".gltf" ||
-		filepath.extension() == ".glb")
+	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
 	{
-		// ėpft@C̓ǂݍ
-		GLTFImporter importer(filename);
-
-		// Aj[Vf[^ǂݎ
-		importer.LoadAnimations(animations, nodes);
+		const Node& node = nodes[nodeIndex];
+		hierarchy.SetPose(static_cast<int>(nodeIndex), node.position, node.rotation, node.scale);
 	}
-	else
+
+	hierarchy.Evaluate(worldTransform);
+
+	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
 	{
-		_ASSERT_EXPR_A(false, "found not model file");
+		Node& node = nodes[nodeIndex];
+		hierarchy.GetLocalTransform(static_cast<int>(nodeIndex), node.localTransform);
+		hierarchy.GetGlobalTransform(static_cast<int>(nodeIndex), node.globalTransform);
+		hierarchy.GetWorldTransform(static_cast<int>(nodeIndex), node.worldTransform);
 	}
 }
 
-// Aj[VCfbNX擾
-int Model::GetAnimationIndex(const char* name) const
+// w莞ԂރL[t[̃CfbNXi͈͊Ȍꍇ-1j
+template<class Keyframe>
+static int FindKeyframeIndex(const std::vector<Keyframe>& keyframes, float time, int hint)
 {
-	for (size_t animationIndex = 0; animationIndex < animations.size(); ++animationIndex)
+	const int count = static_cast<int>(keyframes.size());
+	if (count < 2) return -1;
+	if (time < keyframes.front().seconds || time > keyframes.back().seconds) return -1;
+
+	// ÕL[t[珇ĐĂꍇׂ͗𒲂ׂ邾Ō
+	if (hint >= 0 && hint < count - 1 && keyframes[hint].seconds <= time)
 	{
-		if (animations.at(animationIndex).name == name)
-		{
-			return static_cast<int>(animationIndex);
-		}
+		if (time <= keyframes[hint + 1].seconds) return hint;
+		if (hint + 2 < count && time <= keyframes[hint + 2].seconds) return hint + 1;
 	}
-	return -1;
+
+	// V[N⃋[vꍇ͓񕪒T
+	auto it = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+		[](float t, const Keyframe& keyframe) { return t < keyframe.seconds; });
+	int index = static_cast<int>(it - keyframes.begin()) - 1;
+	return (std::min)(index, count - 2);
 }
 
-// m[hCfbNX擾
-int Model::GetNodeIndex(const char* name) const
+// Aj[VvZ
+void Model::ComputeAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose) const
 {
-	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+	NodeAnimCursor cursor;
+	ComputeAnimation(animationIndex, nodeIndex, time, nodePose, cursor);
+}
+
+// Aj[VvZ
+void Model::ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses) const
+{
+	if (nodePoses.size() != nodes.size())
 	{
-		if (nodes.at(nodeIndex).name == name)
-		{
-			return static_cast<int>(nodeIndex);
-		}
+		nodePoses.resize(nodes.size());
+	}
+	for (size_t nodeIndex = 0; nodeIndex < nodePoses.size(); ++nodeIndex)
+	{
+		ComputeAnimation(animationIndex, static_cast<int>(nodeIndex), time, nodePoses.at(nodeIndex));
 	}
-	return -1;
 }
 
-// gXtH[XV
-void Model::UpdateTransform(const DirectX::XMFLOAT4X4& worldTransform)
+// ʎqgbN̎w莞ԂރL[i͈͊Ȍꍇ-1ArateɕԗԂj
+static int FindCompressedKeyIndex(const ModelResource::CompressedTrack& track, const uint16_t* frames, float frame, int hint, float& rate)
 {
-	DirectX::XMMATRIX ParentWorldTransform = DirectX::XMLoadFloat4x4(&worldTransform);
+	const int count = track.keyCount;
+	if (count < 2) return -1;
 
-	for (Node& node : nodes)
+	// ϓTvÕgbN̓t[ԍL[܂
+	if (track.frameOffset == ModelResource::CompressedTrack::UniformFrames)
 	{
-		// [JsZo
-		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
-		DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
-		DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
-		DirectX::XMMATRIX LocalTransform = S * R * T;
+		float localFrame = frame - track.firstFrame;
+		if (localFrame < 0 || localFrame > count - 1) return -1;
+		int index = (std::min)(static_cast<int>(localFrame), count - 2);
+		rate = localFrame - index;
+		return index;
+	}
 
-		// O[osZo
-		DirectX::XMMATRIX ParentGlobalTransform;
-		if (node.parent != nullptr)
-		{
-			ParentGlobalTransform = DirectX::XMLoadFloat4x4(&node.parent->globalTransform);
-		}
-		else
-		{
-			ParentGlobalTransform = DirectX::XMMatrixIdentity();
-		}
-		DirectX::XMMATRIX GlobalTransform = LocalTransform * ParentGlobalTransform;
+	const uint16_t* keyFrames = frames + track.frameOffset;
+	if (frame < keyFrames[0] || frame > keyFrames[count - 1]) return -1;
 
-		// [hsZo
-		DirectX::XMMATRIX WorldTransform = GlobalTransform * ParentWorldTransform;
+	// ÕL[珇ĐĂꍇׂ͗𒲂ׂ邾Ō
+	int index = -1;
+	if (hint >= 0 && hint < count - 1 && keyFrames[hint] <= frame)
+	{
+		if (frame <= keyFrames[hint + 1]) index = hint;
+		else if (hint + 2 < count && frame <= keyFrames[hint + 2]) index = hint + 1;
+	}
 
-		// vZʂi[
-		DirectX::XMStoreFloat4x4(&node.localTransform, LocalTransform);
-		DirectX::XMStoreFloat4x4(&node.globalTransform, GlobalTransform);
-		DirectX::XMStoreFloat4x4(&node.worldTransform, WorldTransform);
+	// V[N⃋[vꍇ͓񕪒T
+	if (index < 0)
+	{
+		const uint16_t* it = std::upper_bound(keyFrames, keyFrames + count, frame,
+			[](float f, uint16_t keyFrame) { return f < keyFrame; });
+		index = (std::min)(static_cast<int>(it - keyFrames) - 1, count - 2);
 	}
+	// t[ԍւ̊ۂ߂œɂȂL[͌̃L[g
+	const int span = keyFrames[index + 1] - keyFrames[index];
+	rate = span > 0 ? (frame - keyFrames[index]) / span : 1.0f;
+	return index;
 }
 
-void Model::ComputeAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose) const
+// ʎqxNg̕
+static DirectX::XMVECTOR DecompressVector(const ModelResource::CompressedVectorTrack& track, const uint16_t* key)
+{
+	DirectX::XMVECTOR Quantized = DirectX::XMVectorSet(key[0], key[1], key[2], 0);
+	return DirectX::XMVectorMultiplyAdd(Quantized, DirectX::XMLoadFloat3(&track.rangeStep), DirectX::XMLoadFloat3(&track.rangeMin));
+}
+
+// 48rbgʎq]̕
+static DirectX::XMVECTOR DecompressQuaternion(const uint16_t* key)
 {
-	const Animation& animation = animations.at(animationIndex);
+	const uint64_t packed = key[0] | (static_cast<uint64_t>(key[1]) << 16) | (static_cast<uint64_t>(key[2]) << 32);
+
+	// i[R}1/2ɖ߂AȂő听Pʒ狁߂
+	const float range = 0.70710678f;
+	DirectX::XMVECTOR Quantized = DirectX::XMVectorSet(
+		static_cast<float>((packed >> 30) & 0x7FFF),
+		static_cast<float>((packed >> 15) & 0x7FFF),
+		static_cast<float>(packed & 0x7FFF),
+		0);
+	DirectX::XMVECTOR V = DirectX::XMVectorMultiplyAdd(Quantized, DirectX::XMVectorReplicate(range * 2.0f / 32767.0f), DirectX::XMVectorReplicate(-range));
+	DirectX::XMVECTOR Largest = DirectX::XMVectorSqrt(DirectX::XMVectorMax(DirectX::XMVectorSubtract(DirectX::g_XMOne, DirectX::XMVector3Dot(V, V)), DirectX::XMVectorZero()));
+	V = DirectX::XMVectorSelect(Largest, V, DirectX::g_XMSelect1110);
+
+	// ő听̈ʒuɕבւiVWɍő听j
+	switch (packed >> 45)
+	{
+	case 0: return DirectX::XMVectorSwizzle<3, 0, 1, 2>(V);
+	case 1: return DirectX::XMVectorSwizzle<0, 3, 1, 2>(V);
+	case 2: return DirectX::XMVectorSwizzle<0, 1, 3, 2>(V);
+	default: return V;
+	}
+}
+
+// ʎqAj[VvZ
+void Model::ComputeCompressedAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose, NodeAnimCursor& cursor) const
+{
+	const ModelResource::CompressedAnimation& animation = resource->GetCompressedAnimations().at(animationIndex);
+	const ModelResource::CompressedNodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
+	const uint16_t* keys = animation.keys.data();
+	const uint16_t* frames = animation.frames.data();
+	const float frame = time * animation.framesPerSecond;
+	float rate = 0;
+
+	// ʒu
+	int index = FindCompressedKeyIndex(nodeAnim.position, frames, frame, cursor.positionIndex, rate);
+	if (index >= 0)
+	{
+		cursor.positionIndex = index;
+		const uint16_t* key = keys + nodeAnim.position.keyOffset + index * 3;
+		DirectX::XMVECTOR V0 = DecompressVector(nodeAnim.position, key);
+		DirectX::XMVECTOR V1 = DecompressVector(nodeAnim.position, key + 3);
+		DirectX::XMStoreFloat3(&nodePose.position, DirectX::XMVectorLerp(V0, V1, rate));
+	}
+	// ]
+	index = FindCompressedKeyIndex(nodeAnim.rotation, frames, frame, cursor.rotationIndex, rate);
+	if (index >= 0)
+	{
+		cursor.rotationIndex = index;
+		const uint16_t* key = keys + nodeAnim.rotation.keyOffset + index * 3;
+		DirectX::XMVECTOR Q0 = DecompressQuaternion(key);
+		DirectX::XMVECTOR Q1 = DecompressQuaternion(key + 3);
+		DirectX::XMStoreFloat4(&nodePose.rotation, DirectX::XMQuaternionSlerp(Q0, Q1, rate));
+	}
+	// XP[
+	index = FindCompressedKeyIndex(nodeAnim.scale, frames, frame, cursor.scaleIndex, rate);
+	if (index >= 0)
+	{
+		cursor.scaleIndex = index;
+		const uint16_t* key = keys + nodeAnim.scale.keyOffset + index * 3;
+		DirectX::XMVECTOR V0 = DecompressVector(nodeAnim.scale, key);
+		DirectX::XMVECTOR V1 = DecompressVector(nodeAnim.scale, key + 3);
+		DirectX::XMStoreFloat3(&nodePose.scale, DirectX::XMVectorLerp(V0, V1, rate));
+	}
+}
+
+// J[\𗘗pAj[VvZ
+void Model::ComputeAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose, NodeAnimCursor& cursor) const
+{
+	// ʎqłȂAj[V͌̃L[t[ŌvZ
+	if (compressedAnimationEnabled && resource->GetCompressedAnimations().at(animationIndex).valid)
+	{
+		ComputeCompressedAnimation(animationIndex, nodeIndex, time, nodePose, cursor);
+		return;
+	}
+
+	const Animation& animation = resource->GetAnimations().at(animationIndex);
 	const NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
 
 	// ʒu
-	for (size_t index = 0; index < nodeAnim.positionKeyframes.size() - 1; ++index)
+	int index = FindKeyframeIndex(nodeAnim.positionKeyframes, time, cursor.positionIndex);
+	if (index >= 0)
 	{
-		// ݂̎Ԃǂ̃L[t[̊Ԃɂ邩肷
-		const VectorKeyframe& keyframe0 = nodeAnim.positionKeyframes.at(index);
-		const VectorKeyframe& keyframe1 = nodeAnim.positionKeyframes.at(index + 1);
-		if (time >= keyframe0.seconds && time <= keyframe1.seconds)
-		{
-			// ĐԂƃL[t[̎Ԃ⊮Zo
-			float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
-
-			// ÕL[t[Ǝ̃L[t[̎p⊮
-			DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
-			DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
-			DirectX::XMVECTOR V = DirectX::XMVectorLerp(V0, V1, rate);
-			// vZʂm[hɊi[
-			DirectX::XMStoreFloat3(&nodePose.position, V);
-		}
+		cursor.positionIndex = index;
+		const VectorKeyframe& keyframe0 = nodeAnim.positionKeyframes[index];
+		const VectorKeyframe& keyframe1 = nodeAnim.positionKeyframes[index + 1];
+
+		// ĐԂƃL[t[̎Ԃ⊮Zo
+		float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
+
+		// ÕL[t[Ǝ̃L[t[̎p⊮
+		DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
+		DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
+		DirectX::XMVECTOR V = DirectX::XMVectorLerp(V0, V1, rate);
+		// vZʂm[hɊi[
+		DirectX::XMStoreFloat3(&nodePose.position, V);
 	}
 	// ]
-	for (size_t index = 0; index < nodeAnim.rotationKeyframes.size() - 1; ++index)
+	index = FindKeyframeIndex(nodeAnim.rotationKeyframes, time, cursor.rotationIndex);
+	if (index >= 0)
 	{
-		// ݂̎Ԃǂ̃L[t[̊Ԃɂ邩肷
-		const QuaternionKeyframe& keyframe0 = nodeAnim.rotationKeyframes.at(index);
-		const QuaternionKeyframe& keyframe1 = nodeAnim.rotationKeyframes.at(index + 1);
-		if (time >= keyframe0.seconds && time <= keyframe1.seconds)
-		{
-			// ĐԂƃL[t[̎Ԃ⊮Zo
-			float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
-
-			// ÕL[t[Ǝ̃L[t[̎p⊮
-			DirectX::XMVECTOR Q0 = DirectX::XMLoadFloat4(&keyframe0.value);
-			DirectX::XMVECTOR Q1 = DirectX::XMLoadFloat4(&keyframe1.value);
-			DirectX::XMVECTOR Q = DirectX::XMQuaternionSlerp(Q0, Q1, rate);
-			// vZʂm[hɊi[
-			DirectX::XMStoreFloat4(&nodePose.rotation, Q);
-		}
+		cursor.rotationIndex = index;
+		const QuaternionKeyframe& keyframe0 = nodeAnim.rotationKeyframes[index];
+		const QuaternionKeyframe& keyframe1 = nodeAnim.rotationKeyframes[index + 1];
+
+		// ĐԂƃL[t[̎Ԃ⊮Zo
+		float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
+
+		// ÕL[t[Ǝ̃L[t[̎p⊮
+		DirectX::XMVECTOR Q0 = DirectX::XMLoadFloat4(&keyframe0.value);
+		DirectX::XMVECTOR Q1 = DirectX::XMLoadFloat4(&keyframe1.value);
+		DirectX::XMVECTOR Q = DirectX::XMQuaternionSlerp(Q0, Q1, rate);
+		// vZʂm[hɊi[
+		DirectX::XMStoreFloat4(&nodePose.rotation, Q);
 	}
 	// XP[
-	for (size_t index = 0; index < nodeAnim.scaleKeyframes.size() - 1; ++index)
+	index = FindKeyframeIndex(nodeAnim.scaleKeyframes, time, cursor.scaleIndex);
+	if (index >= 0)
 	{
-		// ݂̎Ԃǂ̃L[t[̊Ԃɂ邩肷
-		const VectorKeyframe& keyframe0 = nodeAnim.scaleKeyframes.at(index);
-		const VectorKeyframe& keyframe1 = nodeAnim.scaleKeyframes.at(index + 1);
-		if (time >= keyframe0.seconds && time <= keyframe1.seconds)
-		{
-			// ĐԂƃL[t[̎Ԃ⊮Zo
-			float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
-
-			// ÕL[t[Ǝ̃L[t[̎p⊮
-			DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
-			DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
-			DirectX::XMVECTOR V = DirectX::XMVectorLerp(V0, V1, rate);
-			// vZʂm[hɊi[
-			DirectX::XMStoreFloat3(&nodePose.scale, V);
-		}
+		cursor.scaleIndex = index;
+		const VectorKeyframe& keyframe0 = nodeAnim.scaleKeyframes[index];
+		const VectorKeyframe& keyframe1 = nodeAnim.scaleKeyframes[index + 1];
+
+		// ĐԂƃL[t[̎Ԃ⊮Zo
+		float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
+
+		// ÕL[t[Ǝ̃L[t[̎p⊮
+		DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
+		DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
+		DirectX::XMVECTOR V = DirectX::XMVectorLerp(V0, V1, rate);
+		// vZʂm[hɊi[
+		DirectX::XMStoreFloat3(&nodePose.scale, V);
 	}
 }
 
-// Aj[VvZ
-void Model::ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses) const
+// J[\𗘗pAj[VvZ
+void Model::ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses, AnimationCursor& cursor) const
 {
 	if (nodePoses.size() != nodes.size())
 	{
 		nodePoses.resize(nodes.size());
 	}
+	// Aj[V؂ւꍇ̓J[\Zbg
+	if (cursor.animationIndex != animationIndex || cursor.nodeCursors.size() != nodes.size())
+	{
+		cursor.animationIndex = animationIndex;
+		cursor.nodeCursors.assign(nodes.size(), NodeAnimCursor());
+	}
 	for (size_t nodeIndex = 0; nodeIndex < nodePoses.size(); ++nodeIndex)
 	{
-		ComputeAnimation(animationIndex, static_cast<int>(nodeIndex), time, nodePoses.at(nodeIndex));
+		ComputeAnimation(animationIndex, static_cast<int>(nodeIndex), time, nodePoses.at(nodeIndex), cursor.nodeCursors.at(nodeIndex));
+	}
+}
+
+// XLjOpbgvZ
+void Model::ComputeSkinningPalette(std::vector<DirectX::XMFLOAT4X4>& palette) const
+{
+	const std::vector<Bone>& paletteBones = resource->GetPaletteBones();
+	if (palette.size() != paletteBones.size())
+	{
+		palette.resize(paletteBones.size());
+	}
+	for (size_t i = 0; i < paletteBones.size(); ++i)
+	{
+		const Bone& bone = paletteBones[i];
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&nodes[bone.nodeIndex].worldTransform);
+		DirectX::XMMATRIX OffsetTransform = DirectX::XMLoadFloat4x4(&bone.offsetTransform);
+		DirectX::XMStoreFloat4x4(&palette[i], OffsetTransform * WorldTransform);
 	}
 }
 
 // m[h|[Yݒ
-void Model::SetNodePoses(const std::vector<NodePose>& nodePoses)
+void Model::SetNodePoses(const NodePose* nodePoses, size_t count)
 {
+	_ASSERT_EXPR_A(count >= nodes.size(), "node pose count mismatch");
 	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
 	{
-		const NodePose& pose = nodePoses.at(nodeIndex);
-		Node& node = nodes.at(nodeIndex);
+		SetNodePose(static_cast<int>(nodeIndex), nodePoses[nodeIndex]);
+	}
+}
 
-		node.position = pose.position;
-		node.rotation = pose.rotation;
-		node.scale = pose.scale;
+// m[h|[Yݒip܂ꂽꍇ͍ČvZȂj
+void Model::SetNodePose(int nodeIndex, const NodePose& nodePose)
+{
+	Node& node = nodes.at(nodeIndex);
+	if (memcmp(&node.position, &nodePose.position, sizeof(nodePose.position)) == 0 &&
+		memcmp(&node.rotation, &nodePose.rotation, sizeof(nodePose.rotation)) == 0 &&
+		memcmp(&node.scale, &nodePose.scale, sizeof(nodePose.scale)) == 0)
+	{
+		return;
 	}
+
+	node.position = nodePose.position;
+	node.rotation = nodePose.rotation;
+	node.scale = nodePose.scale;
+	node.dirty = true;
+	poseDirty = true;
+}
+
+// m[h̎pύXʒm
+void Model::MarkDirty(int nodeIndex)
+{
+	nodes.at(nodeIndex).dirty = true;
+	poseDirty = true;
 }
 
 // m[h|[Y擾
@@ -535,55 +487,3 @@ void Model::GetNodePoses(std::vector<NodePose>& nodePoses) const
 		pose.scale = node.scale;
 	}
 }
-
-// VACY
-void Model::Serialize(const char* filename)
-{
-	std::ofstream ostream(filename, std::ios::binary);
-	if (ostream.is_open())
-	{
-		cereal::BinaryOutputArchive archive(ostream);
-
-		try
-		{
-			archive(
-				CEREAL_NVP(nodes),
-				CEREAL_NVP(materials),
-				CEREAL_NVP(meshes),
-				CEREAL_NVP(animations)
-			);
-		}
-		catch (...)
-		{
-			_ASSERT_EXPR_A(false, "Model serialize failed.");
-		}
-	}
-}
-
-// fVACY
-void Model::Deserialize(const char* filename)
-{
-	std::ifstream istream(filename, std::ios::binary);
-	if (istream.is_open())
-	{
-		cereal::BinaryInputArchive archive(istream);
-
-		try
-		{
-			archive(
-				CEREAL_NVP(nodes),
-				CEREAL_NVP(materials),
-				CEREAL_NVP(meshes),
-				CEREAL_NVP(animations)
-			);
-		}
-		catch (...)
-		{
-			_ASSERT_EXPR_A(false, "Model deserialize failed.");
-		}
-	}
-	else
-	{
-		_ASSERT_EXPR_A(false, "Model File not found.");
-	}
-}
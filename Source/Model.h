@@ -1,21 +1,36 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <DirectXMath.h>
 #include <wrl.h>
 #include <d3d11.h>
+#include "ModelResource.h"
+#include "NodeHierarchy.h"
 
+// fiL\[XQƂACX^X̎pƃgXtH[ێj
 class Model
 {
 public:
 	Model(ID3D11Device* device, const char* filename, float sampleRate = 60);
-
-	static const std::vector<D3D11_INPUT_ELEMENT_DESC> InputElementDescs;
+	Model(std::shared_ptr<ModelResource> resource);
+	Model(const Model&) = delete;
+	Model& operator=(const Model&) = delete;
+
+	using AlphaMode = ModelResource::AlphaMode;
+	using Material = ModelResource::Material;
+	using Vertex = ModelResource::Vertex;
+	using Bone = ModelResource::Bone;
+	using Mesh = ModelResource::Mesh;
+	using VectorKeyframe = ModelResource::VectorKeyframe;
+	using QuaternionKeyframe = ModelResource::QuaternionKeyframe;
+	using NodeAnim = ModelResource::NodeAnim;
+	using Animation = ModelResource::Animation;
 
 	struct Node
 	{
-		std::string			name;
+		const char*			name = nullptr;		// \[X̃m[hQƂ
 		int					parentIndex = -1;
 		DirectX::XMFLOAT3	position = { 0, 0, 0 };
 		DirectX::XMFLOAT4	rotation = { 0, 0, 0, 1 };
@@ -28,141 +43,45 @@ public:
 		Node*				parent = nullptr; 
 		std::vector<Node*>	children;
 
-		template<class Archive>
-		void serialize(Archive& archive);
-	};
-
-	enum class AlphaMode
-	{
-		Opaque,
-		Mask,
-		Blend
-	};
-
-	struct Material
-	{
-		std::string			name;
-		std::string			baseTextureFileName;
-		std::string			normalTextureFileName;
-		std::string			emissiveTextureFileName;
-		std::string			occlusionTextureFileName;
-		std::string			metalnessRoughnessTextureFileName;
-		DirectX::XMFLOAT4	baseColor = { 1, 1, 1, 1 };
-		DirectX::XMFLOAT3	emissiveColor = { 1, 1, 1 };
-		float				metalness = 0.0f;
-		float				roughness = 0.0f;
-		float				occlusionStrength = 0.0f;
-		float				alphaCutoff = 0.5f;
-		AlphaMode			alphaMode = AlphaMode::Opaque;
-
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	baseMap;
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	normalMap;
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	emissiveMap;
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	occlusionMap;
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	metalnessRoughnessMap;
-
-		template<class Archive>
-		void serialize(Archive& archive);
-	};
-
-	struct Vertex
-	{
-		DirectX::XMFLOAT3		position = { 0, 0, 0 };
-		DirectX::XMFLOAT3		normal = { 0, 0, 0 };
-		DirectX::XMFLOAT4		tangent = { 0, 0, 0, 1 };
-		DirectX::XMFLOAT2		texcoord = { 0, 0 };
-		DirectX::XMFLOAT4		boneWeight = { 1, 0, 0, 0 };
-		DirectX::XMUINT4		boneIndex = { 0, 0, 0, 0 };
-
-		template<class Archive>
-		void serialize(Archive& archive);
-	};
-
-	struct Bone
-	{
-		int						nodeIndex;
-		DirectX::XMFLOAT4X4		offsetTransform;
-		Node*					node = nullptr;
-
-		template<class Archive>
-		void serialize(Archive& archive);
-	};
-
-	struct Mesh
-	{
-		std::vector<Vertex>		vertices;
-		std::vector<uint32_t>	indices;
-		std::vector<Bone>		bones;
-		int			nodeIndex = 0;
-		int			materialIndex = 0;
-		Material*	material = nullptr;
-		Node*		node = nullptr;
-		Microsoft::WRL::ComPtr<ID3D11Buffer>	vertexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer>	indexBuffer;
-
-		template<class Archive>
-		void serialize(Archive& archive);
+		bool				dirty = true;		// ̍XVōsČvZip𒼐ڏꍇMarkDirtyĂԁj
 	};
 
-	struct VectorKeyframe
-	{
-		float					seconds;
-		DirectX::XMFLOAT3		value;
-
-		template<class Archive>
-		void serialize(Archive& archive);
-	};
-
-	struct QuaternionKeyframe
-	{
-		float					seconds;
-		DirectX::XMFLOAT4		value;
-
-		template<class Archive>
-		void serialize(Archive& archive);
-	};
-
-	struct NodeAnim
+	struct NodePose
 	{
-		std::vector<VectorKeyframe>		positionKeyframes;
-		std::vector<QuaternionKeyframe>	rotationKeyframes;
-		std::vector<VectorKeyframe>		scaleKeyframes;
-
-		template<class Archive>
-		void serialize(Archive& archive);
+		DirectX::XMFLOAT3	position = { 0, 0, 0 };
+		DirectX::XMFLOAT4	rotation = { 0, 0, 0, 1 };
+		DirectX::XMFLOAT3	scale = { 1, 1, 1 };
 	};
 
-	struct Animation
+	// m[hAj[VĐJ[\igbNɑOQƂL[t[ʒuێj
+	struct NodeAnimCursor
 	{
-		std::string					name;
-		float						secondsLength;
-		std::vector<NodeAnim>		nodeAnims;
-
-		template<class Archive>
-		void serialize(Archive& archive);
+		int					positionIndex = 0;
+		int					rotationIndex = 0;
+		int					scaleIndex = 0;
 	};
 
-	struct NodePose
+	// Aj[VĐJ[\iCX^Xɕێj
+	struct AnimationCursor
 	{
-		DirectX::XMFLOAT3	position = { 0, 0, 0 };
-		DirectX::XMFLOAT4	rotation = { 0, 0, 0, 1 };
-		DirectX::XMFLOAT3	scale = { 1, 1, 1 };
+		int							animationIndex = -1;
+		std::vector<NodeAnimCursor>	nodeCursors;
 	};
 
-	// Aj[Vǉǂݍ
-	void AppendAnimations(const char* filename);
+	// f\[X擾
+	const std::shared_ptr<ModelResource>& GetResource() const { return resource; }
 
 	// }eAf[^擾
-	const std::vector<Material>& GetMaterials() const { return materials; }
+	const std::vector<Material>& GetMaterials() const { return resource->GetMaterials(); }
 
 	// bVf[^擾
-	const std::vector<Mesh>& GetMeshes() const { return meshes; }
+	const std::vector<Mesh>& GetMeshes() const { return resource->GetMeshes(); }
 
 	// Aj[Vf[^擾
-	const std::vector<Animation>& GetAnimations() const { return animations; }
+	const std::vector<Animation>& GetAnimations() const { return resource->GetAnimations(); }
 
 	// Aj[VCfbNX擾
-	int GetAnimationIndex(const char* name) const;
+	int GetAnimationIndex(const char* name) const { return resource->GetAnimationIndex(name); }
 
 	// m[hf[^擾
 	const std::vector<Node>& GetNodes() const { return nodes; }
@@ -172,32 +91,62 @@ public:
 	Node* GetRootNode() { return nodes.data(); }
 
 	// m[hCfbNX擾
-	int GetNodeIndex(const char* name) const;
+	int GetNodeIndex(const char* name) const { return resource->GetNodeIndex(name); }
 
-	// gXtH[XV
+	// gXtH[XVipςm[hƂ̎qČvZA唼ςꍇ͊KwŜSIMDŌvZj
+	// p[hsςĂȂ΃m[h𑖍ɖ߂
 	void UpdateTransform(const DirectX::XMFLOAT4X4& worldTransform);
 
+	// wm[hȉ̃gXtH[XViIKȂǂňꕔ̃m[hύXꍇj
+	void UpdateSubtree(int nodeIndex);
+	void UpdateSubtree(const Node* node) { UpdateSubtree(static_cast<int>(node - nodes.data())); }
+
 	// Aj[VvZ
 	void ComputeAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose) const;
 	void ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses) const;
 
+	// J[\𗘗pAj[VvZiĐ̓L[t[O(1)ɂȂj
+	void ComputeAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose, NodeAnimCursor& cursor) const;
+	void ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses, AnimationCursor& cursor) const;
+
+	// ʎqAj[VgݒiŖALɂƗʎq덷܂ގpɂȂj
+	void SetCompressedAnimationEnabled(bool enabled) { compressedAnimationEnabled = enabled; }
+	bool IsCompressedAnimationEnabled() const { return compressedAnimationEnabled; }
+
+	// XLjOpbgvZi\[X̃pbg{[ɃItZbgs~[hs߂j
+	void ComputeSkinningPalette(std::vector<DirectX::XMFLOAT4X4>& palette) const;
+
 	// m[h|[Yݒ
-	void SetNodePoses(const std::vector<NodePose>& nodePoses);
+	void SetNodePoses(const std::vector<NodePose>& nodePoses) { SetNodePoses(nodePoses.data(), nodePoses.size()); }
+	void SetNodePoses(const NodePose* nodePoses, size_t count);
+	void SetNodePose(int nodeIndex, const NodePose& nodePose);
+
+	// m[h̎p𒼐ڏƂʒmiUpdateSubtreeōČvZꍇ͕svj
+	void MarkDirty(int nodeIndex);
+	void MarkDirty(const Node* node) { MarkDirty(static_cast<int>(node - nodes.data())); }
 
 	// m[h|[Y擾
 	void GetNodePoses(std::vector<NodePose>& nodePoses) const;
 
 private:
-	// VACY
-	void Serialize(const char* filename);
+	// m[h̍svZ
+	void ComputeNodeTransform(Node& node, DirectX::FXMMATRIX ParentWorldTransform);
 
-	// fVACY
-	void Deserialize(const char* filename);
+	// wm[hȉ̍svZ
+	void ComputeSubtreeTransform(Node& node, DirectX::FXMMATRIX ParentWorldTransform);
 
-private:
+	// Sm[h̍sm[hKwł܂Ƃ߂ČvZ
+	void ComputeHierarchyTransform();
 
-	std::vector<Material>	materials;
-	std::vector<Mesh>		meshes;
-	std::vector<Node>		nodes;
-	std::vector<Animation>	animations;
-};
\ No newline at end of file
+	// ʎqAj[VvZ
+	void ComputeCompressedAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose, NodeAnimCursor& cursor) const;
+
+private:
+	std::shared_ptr<ModelResource>	resource;
+	std::vector<Node>				nodes;
+	NodeHierarchy					hierarchy;
+	DirectX::XMFLOAT4X4				worldTransform = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+	bool							worldTransformDirty = true;
+	bool							poseDirty = true;			// ꂩ̃m[hdirtyĂ
+	bool							compressedAnimationEnabled = false;
+};
@@ -1,7 +1,9 @@
 #include <algorithm>
+#include <cstring>
 #include "Misc.h"
 #include "GpuResourceUtils.h"
 #include "ModelRenderer.h"
+#include "Profiler.h"
 #include "BasicShader.h"
 #include "LambertShader.h"
 
@@ -14,11 +16,19 @@ ModelRenderer::ModelRenderer(ID3D11Device* device)
 		sizeof(CbScene),
 		sceneConstantBuffer.GetAddressOf());
 
-	// XPgp萔obt@
-	GpuResourceUtils::CreateConstantBuffer(
-		device,
-		sizeof(CbSkeleton),
-		skeletonConstantBuffer.GetAddressOf());
+	// XPgp萔obt@igp{[ނCPU݉\ɂj
+	{
+		D3D11_BUFFER_DESC desc{};
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		desc.MiscFlags = 0;
+		desc.ByteWidth = sizeof(CbSkeleton);
+		desc.StructureByteStride = 0;
+
+		HRESULT hr = device->CreateBuffer(&desc, 0, skeletonConstantBuffer.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
 
 	// VF[_[
 	shaders[static_cast<int>(ShaderId::Basic)] = std::make_unique<BasicShader>(device);
@@ -33,9 +43,20 @@ void ModelRenderer::Draw(ShaderId shaderId, std::shared_ptr<Model> model)
 	drawInfo.model = model;
 }
 
+// `ivZς݂̃XLjOpbgj
+void ModelRenderer::Draw(ShaderId shaderId, std::shared_ptr<Model> model, const DirectX::XMFLOAT4X4* palette)
+{
+	DrawInfo& drawInfo = drawInfos.emplace_back();
+	drawInfo.shaderId = shaderId;
+	drawInfo.model = model;
+	drawInfo.palette = palette;
+}
+
 // `s
 void ModelRenderer::Render(const RenderContext& rc)
 {
+	PROFILE_FUNCTION();
+
 	ID3D11DeviceContext* dc = rc.deviceContext;
 
 	// V[p萔obt@XV
@@ -85,34 +106,58 @@ void ModelRenderer::Render(const RenderContext& rc)
 	dc->OMSetDepthStencilState(rc.renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
 	dc->RSSetState(rc.renderState->GetRasterizerState(RasterizerState::SolidCullBack));
 
-	// bV`֐
-	auto drawMesh = [&](const Model::Mesh& mesh, Shader* shader)
+	// XLjOpbgvZifo^ĂĂP񂾂vZAvZς݂̏ꍇ͂gj
+	int paletteCount = 0;
+	for (size_t i = 0; i < drawInfos.size(); ++i)
 	{
-		// _obt@ݒ
-		UINT stride = sizeof(Model::Vertex);
-		UINT offset = 0;
-		dc->IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &stride, &offset);
-		dc->IASetIndexBuffer(mesh.indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-		dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		DrawInfo& drawInfo = drawInfos.at(i);
+		drawInfo.paletteIndex = -1;
+		if (drawInfo.palette != nullptr) continue;
 
-		// XPgp萔obt@XV
-		CbSkeleton cbSkeleton{};
-		if (mesh.bones.size() > 0)
+		for (size_t j = 0; j < i; ++j)
+		{
+			if (drawInfos.at(j).palette == nullptr && drawInfos.at(j).model == drawInfo.model)
+			{
+				drawInfo.paletteIndex = drawInfos.at(j).paletteIndex;
+				break;
+			}
+		}
+		if (drawInfo.paletteIndex < 0)
 		{
-			for (size_t i = 0; i < mesh.bones.size(); ++i)
+			drawInfo.paletteIndex = paletteCount++;
+			if (static_cast<int>(palettes.size()) < paletteCount)
 			{
-				const Model::Bone& bone = mesh.bones.at(i);
-				DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&bone.node->worldTransform);
-				DirectX::XMMATRIX OffsetTransform = DirectX::XMLoadFloat4x4(&bone.offsetTransform);
-				DirectX::XMMATRIX BoneTransform = OffsetTransform * WorldTransform;
-				DirectX::XMStoreFloat4x4(&cbSkeleton.boneTransforms[i], BoneTransform);
+				palettes.resize(paletteCount);
 			}
+			drawInfo.model->ComputeSkinningPalette(palettes.at(drawInfo.paletteIndex));
 		}
-		else
+	}
+
+	// bV`֐
+	const DirectX::XMFLOAT4X4* uploadedBoneTransforms = nullptr;
+	auto drawMesh = [&](const Model::Mesh& mesh, const DirectX::XMFLOAT4X4* palette, Shader* shader)
+	{
+		// _obt@ݒ
+		ID3D11Buffer* vertexBuffers[] = { mesh.vertexBuffer.Get(), mesh.attributeBuffer.Get() };
+		UINT strides[2];
+		UINT offsets[2] = { 0, 0 };
+		UINT streamCount = ModelResource::GetVertexStrides(mesh.vertexFormat, strides);
+		dc->IASetVertexBuffers(0, streamCount, vertexBuffers, strides, offsets);
+		dc->IASetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat, 0);
+		dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+		// XPgp萔obt@XViXLL郁bVꍇ͏܂Ȃj
+		const DirectX::XMFLOAT4X4* boneTransforms = palette + mesh.paletteOffset;
+		if (boneTransforms != uploadedBoneTransforms)
 		{
-			cbSkeleton.boneTransforms[0] = mesh.node->worldTransform;
+			_ASSERT_EXPR(mesh.paletteCount <= _countof(CbSkeleton::boneTransforms), L"too many bones");
+			D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+			HRESULT hr = dc->Map(skeletonConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+			memcpy(mappedSubresource.pData, boneTransforms, sizeof(DirectX::XMFLOAT4X4) * mesh.paletteCount);
+			dc->Unmap(skeletonConstantBuffer.Get(), 0);
+			uploadedBoneTransforms = boneTransforms;
 		}
-		dc->UpdateSubresource(skeletonConstantBuffer.Get(), 0, 0, &cbSkeleton, 0, 0);
 
 		// XV
 		shader->Update(rc, mesh);
@@ -133,19 +178,25 @@ void ModelRenderer::Render(const RenderContext& rc)
 		Shader* shader = shaders[static_cast<int>(drawInfo.shaderId)].get();
 		shader->Begin(rc);
 
-		for (const Model::Mesh& mesh : drawInfo.model->GetMeshes())
+		const Model* model = drawInfo.model.get();
+		const DirectX::XMFLOAT4X4* palette = drawInfo.palette != nullptr ? drawInfo.palette : palettes.at(drawInfo.paletteIndex).data();
+		for (const Model::Mesh& mesh : model->GetMeshes())
 		{
 			// bVo^
 			if (mesh.material->alphaMode == Model::AlphaMode::Blend ||
 				(mesh.material->baseColor.w > 0.01f && mesh.material->baseColor.w < 0.99f))
 			{
 				TransparencyDrawInfo& transparencyDrawInfo = transparencyDrawInfos.emplace_back();
+				transparencyDrawInfo.shaderId = drawInfo.shaderId;
+				transparencyDrawInfo.model = model;
 				transparencyDrawInfo.mesh = &mesh;
+				transparencyDrawInfo.palette = palette;
 				// JƂ̋Zo
+				const DirectX::XMFLOAT4X4& worldTransform = model->GetNodes().at(mesh.nodeIndex).worldTransform;
 				DirectX::XMVECTOR Position = DirectX::XMVectorSet(
-					mesh.node->worldTransform._41,
-					mesh.node->worldTransform._42,
-					mesh.node->worldTransform._43,
+					worldTransform._41,
+					worldTransform._42,
+					worldTransform._43,
 					0.0f);
 				DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(Position, CameraPosition);
 				transparencyDrawInfo.distance = DirectX::XMVectorGetX(DirectX::XMVector3Dot(CameraFront, Vec));
@@ -154,7 +205,7 @@ void ModelRenderer::Render(const RenderContext& rc)
 			}
 
 			// `
-			drawMesh(mesh, shader);
+			drawMesh(mesh, palette, shader);
 		}
 
 		shader->End(rc);
@@ -178,7 +229,7 @@ void ModelRenderer::Render(const RenderContext& rc)
 
 		shader->Begin(rc);
 
-		drawMesh(*transparencyDrawInfo.mesh, shader);
+		drawMesh(*transparencyDrawInfo.mesh, transparencyDrawInfo.palette, shader);
 
 		shader->End(rc);
 	}
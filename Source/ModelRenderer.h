@@ -25,6 +25,9 @@ public:
 	// `
 	void Draw(ShaderId shaderId, std::shared_ptr<Model> model);
 
+	// vZς݂̃XLjOpbgŕ`ipbg͕`s܂ŏȂj
+	void Draw(ShaderId shaderId, std::shared_ptr<Model> model, const DirectX::XMFLOAT4X4* palette);
+
 	// `s
 	void Render(const RenderContext& rc);
 
@@ -37,6 +40,7 @@ private:
 		DirectX::XMFLOAT4		cameraPosition;
 	};
 
+	// gp{[
 	struct CbSkeleton
 	{
 		DirectX::XMFLOAT4X4		boneTransforms[256];
@@ -46,18 +50,23 @@ private:
 	{
 		ShaderId				shaderId;
 		std::shared_ptr<Model>	model;
+		const DirectX::XMFLOAT4X4*	palette = nullptr;		// vZς݂̃pbg
+		int						paletteIndex = -1;
 	};
 
 	struct TransparencyDrawInfo
 	{
 		ShaderId				shaderId;
+		const Model*			model;
 		const Model::Mesh*		mesh;
+		const DirectX::XMFLOAT4X4*	palette;
 		float					distance;
 	};
 
 	std::unique_ptr<Shader>					shaders[static_cast<int>(ShaderId::EnumCount)];
 	std::vector<DrawInfo>					drawInfos;
 	std::vector<TransparencyDrawInfo>		transparencyDrawInfos;
+	std::vector<std::vector<DirectX::XMFLOAT4X4>>	palettes;		// f̃XLjOpbgit[ԂŎg񂷁j
 
 	Microsoft::WRL::ComPtr<ID3D11Buffer>	sceneConstantBuffer;
 	Microsoft::WRL::ComPtr<ID3D11Buffer>	skeletonConstantBuffer;
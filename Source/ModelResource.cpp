@@ -0,0 +1,1299 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <cereal/cereal.hpp>
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include "Misc.h"
+#include "GLTFImporter.h"
+#include "GpuResourceUtils.h"
+#include "ModelResource.h"
+#include "VertexCompression.h"
+
+const std::vector<D3D11_INPUT_ELEMENT_DESC> ModelResource::InputElementDescs =
+{
+	{ "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "NORMAL",       0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TANGENT",      0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TEXCOORD",     0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "BONE_WEIGHTS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "BONE_INDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT,  0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+};
+
+const std::vector<D3D11_INPUT_ELEMENT_DESC> ModelResource::CompressedInputElementDescs =
+{
+	{ "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TANGENT",      0, DXGI_FORMAT_R10G10B10A2_UNORM,  1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "BONE_WEIGHTS", 0, DXGI_FORMAT_R8G8B8A8_UNORM,     1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "BONE_INDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+};
+
+const std::vector<D3D11_INPUT_ELEMENT_DESC> ModelResource::CompressedStaticInputElementDescs =
+{
+	{ "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TANGENT",      0, DXGI_FORMAT_R10G10B10A2_UNORM,  1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+};
+
+namespace DirectX
+{
+	template<class Archive>
+	void serialize(Archive& archive, XMUINT4& v)
+	{
+		archive(
+			cereal::make_nvp("x", v.x),
+			cereal::make_nvp("y", v.y),
+			cereal::make_nvp("z", v.z),
+			cereal::make_nvp("w", v.w)
+		);
+	}
+
+	template<class Archive>
+	void serialize(Archive& archive, XMFLOAT2& v)
+	{
+		archive(
+			cereal::make_nvp("x", v.x),
+			cereal::make_nvp("y", v.y)
+		);
+	}
+
+	template<class Archive>
+	void serialize(Archive& archive, XMFLOAT3& v)
+	{
+		archive(
+			cereal::make_nvp("x", v.x),
+			cereal::make_nvp("y", v.y),
+			cereal::make_nvp("z", v.z)
+		);
+	}
+
+	template<class Archive>
+	void serialize(Archive& archive, XMFLOAT4& v)
+	{
+		archive(
+			cereal::make_nvp("x", v.x),
+			cereal::make_nvp("y", v.y),
+			cereal::make_nvp("z", v.z),
+			cereal::make_nvp("w", v.w)
+		);
+	}
+
+	template<class Archive>
+	void serialize(Archive& archive, XMFLOAT4X4& m)
+	{
+		archive(
+			cereal::make_nvp("_11", m._11),
+			cereal::make_nvp("_12", m._12),
+			cereal::make_nvp("_13", m._13),
+			cereal::make_nvp("_14", m._14),
+			cereal::make_nvp("_21", m._21),
+			cereal::make_nvp("_22", m._22),
+			cereal::make_nvp("_23", m._23),
+			cereal::make_nvp("_24", m._24),
+			cereal::make_nvp("_31", m._31),
+			cereal::make_nvp("_32", m._32),
+			cereal::make_nvp("_33", m._33),
+			cereal::make_nvp("_34", m._34),
+			cereal::make_nvp("_41", m._41),
+			cereal::make_nvp("_42", m._42),
+			cereal::make_nvp("_43", m._43),
+			cereal::make_nvp("_44", m._44)
+		);
+	}
+}
+
+template<class Archive>
+void ModelResource::Node::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(name),
+		CEREAL_NVP(parentIndex),
+		CEREAL_NVP(position),
+		CEREAL_NVP(rotation),
+		CEREAL_NVP(scale)
+	);
+}
+
+template<class Archive>
+void ModelResource::Material::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(name),
+		CEREAL_NVP(baseTextureFileName),
+		CEREAL_NVP(normalTextureFileName),
+		CEREAL_NVP(emissiveTextureFileName),
+		CEREAL_NVP(occlusionTextureFileName),
+		CEREAL_NVP(metalnessRoughnessTextureFileName),
+		CEREAL_NVP(baseColor),
+		CEREAL_NVP(emissiveColor),
+		CEREAL_NVP(metalness),
+		CEREAL_NVP(roughness),
+		CEREAL_NVP(occlusionStrength),
+		CEREAL_NVP(alphaCutoff),
+		CEREAL_NVP(alphaMode)
+	);
+}
+
+template<class Archive>
+void ModelResource::Vertex::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(position),
+		CEREAL_NVP(boneWeight),
+		CEREAL_NVP(boneIndex),
+		CEREAL_NVP(texcoord),
+		CEREAL_NVP(normal),
+		CEREAL_NVP(tangent)
+	);
+}
+
+template<class Archive>
+void ModelResource::Bone::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(nodeIndex),
+		CEREAL_NVP(offsetTransform)
+	);
+}
+
+template<class Archive>
+void ModelResource::Mesh::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(vertices),
+		CEREAL_NVP(indices),
+		CEREAL_NVP(bones),
+		CEREAL_NVP(nodeIndex),
+		CEREAL_NVP(materialIndex),
+		CEREAL_NVP(vertexFormat)
+	);
+}
+
+template<class Archive>
+void ModelResource::VectorKeyframe::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(seconds),
+		CEREAL_NVP(value)
+	);
+}
+
+template<class Archive>
+void ModelResource::QuaternionKeyframe::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(seconds),
+		CEREAL_NVP(value)
+	);
+}
+
+template<class Archive>
+void ModelResource::NodeAnim::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(positionKeyframes),
+		CEREAL_NVP(rotationKeyframes),
+		CEREAL_NVP(scaleKeyframes)
+	);
+}
+
+template<class Archive>
+void ModelResource::Animation::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(name),
+		CEREAL_NVP(secondsLength),
+		CEREAL_NVP(nodeAnims)
+	);
+}
+
+// NbNς݃ft@C`
+// wb_AZNVe[uAeZNV̔z̏ɕԁB
+// zׂ͂ČŒ蒷̗vf16oCgEɑĊi[A
+// ǂݍݎ̓}bvvfPʂ̕ϊȂŔz񖈂ɈꊇRs[B
+// bVAj[Vstd::vectorŕێ邽߁A}bv𒼐ڎQƂ͂ȂB
+static const uint32_t CookedMagic = 0x434C444D;	// "MDLC"
+static const uint32_t CookedVersion = 3;
+static const uint64_t CookedAlignment = 16;
+
+enum class CookedSectionType : uint32_t
+{
+	Strings,
+	Nodes,
+	Materials,
+	Meshes,
+	Vertices,
+	Indices,
+	Bones,
+	Animations,
+	NodeAnims,
+	VectorKeyframes,
+	QuaternionKeyframes,
+
+	EnumCount
+};
+
+struct CookedHeader
+{
+	uint32_t			magic;
+	uint32_t			version;
+	float				sampleRate;
+	uint32_t			sectionCount;
+};
+
+struct CookedSection
+{
+	uint64_t			offset;		// t@C擪̃ItZbg
+	uint64_t			size;		// oCg
+	uint32_t			count;		// vf
+	uint32_t			stride;		// vfTCY
+};
+
+struct CookedNode
+{
+	uint32_t			name;		// e[ũItZbg
+	int32_t				parentIndex;
+	DirectX::XMFLOAT3	position;
+	DirectX::XMFLOAT4	rotation;
+	DirectX::XMFLOAT3	scale;
+};
+
+struct CookedMaterial
+{
+	uint32_t			name;
+	uint32_t			baseTextureFileName;
+	uint32_t			normalTextureFileName;
+	uint32_t			emissiveTextureFileName;
+	uint32_t			occlusionTextureFileName;
+	uint32_t			metalnessRoughnessTextureFileName;
+	DirectX::XMFLOAT4	baseColor;
+	DirectX::XMFLOAT3	emissiveColor;
+	float				metalness;
+	float				roughness;
+	float				occlusionStrength;
+	float				alphaCutoff;
+	int32_t				alphaMode;
+};
+
+struct CookedMesh
+{
+	uint32_t			vertexStart;
+	uint32_t			vertexCount;
+	uint32_t			indexStart;
+	uint32_t			indexCount;
+	uint32_t			boneStart;
+	uint32_t			boneCount;
+	int32_t				nodeIndex;
+	int32_t				materialIndex;
+	int32_t				vertexFormat;
+};
+
+struct CookedAnimation
+{
+	uint32_t			name;
+	float				secondsLength;
+	uint32_t			nodeAnimStart;
+	uint32_t			nodeAnimCount;
+};
+
+struct CookedNodeAnim
+{
+	uint32_t			positionStart;
+	uint32_t			positionCount;
+	uint32_t			rotationStart;
+	uint32_t			rotationCount;
+	uint32_t			scaleStart;
+	uint32_t			scaleCount;
+};
+
+static_assert(std::is_trivially_copyable<ModelResource::Vertex>::value, "Vertex must be trivially copyable.");
+static_assert(std::is_trivially_copyable<ModelResource::Bone>::value, "Bone must be trivially copyable.");
+static_assert(std::is_trivially_copyable<ModelResource::VectorKeyframe>::value, "VectorKeyframe must be trivially copyable.");
+static_assert(std::is_trivially_copyable<ModelResource::QuaternionKeyframe>::value, "QuaternionKeyframe must be trivially copyable.");
+
+// ǂݍݐp̃}bvht@C
+class MappedFile
+{
+public:
+	MappedFile(const char* filename)
+	{
+		file = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return;
+
+		LARGE_INTEGER fileSize;
+		if (!::GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return;
+
+		mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) return;
+
+		view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr) return;
+
+		size = static_cast<size_t>(fileSize.QuadPart);
+	}
+	~MappedFile()
+	{
+		if (view != nullptr) ::UnmapViewOfFile(view);
+		if (mapping != nullptr) ::CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) ::CloseHandle(file);
+	}
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const uint8_t* GetData() const { return static_cast<const uint8_t*>(view); }
+	size_t GetSize() const { return size; }
+
+private:
+	HANDLE			file = INVALID_HANDLE_VALUE;
+	HANDLE			mapping = nullptr;
+	const void*		view = nullptr;
+	size_t			size = 0;
+};
+
+// NbNς݃t@C̃ZNVz擾i͈͊OvfTCYsvnullptrj
+template<class T>
+static const T* GetCookedSection(const MappedFile& file, const CookedSection* sections, CookedSectionType type, uint32_t& count)
+{
+	const CookedSection& section = sections[static_cast<uint32_t>(type)];
+	count = 0;
+	if (section.stride != sizeof(T)) return nullptr;
+	if (section.size != static_cast<uint64_t>(section.count) * section.stride) return nullptr;
+	if (section.offset % alignof(T) != 0) return nullptr;
+	if (section.offset > file.GetSize() || section.size > file.GetSize() - section.offset) return nullptr;
+	count = section.count;
+	return reinterpret_cast<const T*>(file.GetData() + section.offset);
+}
+
+// RXgN^
+ModelResource::ModelResource(ID3D11Device* device, const char* filename, float sampleRate, FileFormat format)
+	: animationSampleRate(sampleRate)
+{
+	std::filesystem::path filepath(filename);
+	std::filesystem::path dirpath(filepath.parent_path());
+
+	std::filesystem::path extension = filepath.extension();
+
+	std::filesystem::path cookedFilepath(filepath);
+	cookedFilepath.replace_extension(".cooked");
+
+	std::filesystem::path cerealFilepath(filepath);
+	cerealFilepath.replace_extension(".cereal");
+
+	// ǂݍ݌`̎I
+	bool cook = false;
+	if (format == FileFormat::Auto)
+	{
+		// \[XVNbNς݃t@CD悵Aǂ߂Ȃ΍蒼
+		if (IsCookedFileUpToDate(cookedFilepath.string().c_str(), filename) &&
+			LoadCooked(cookedFilepath.string().c_str(), sampleRate))
+		{
+			format = FileFormat::Cooked;
+		}
+		else if (std::filesystem::exists(cerealFilepath))
+		{
+			format = FileFormat::Cereal;
+		}
+		else
+		{
+			format = FileFormat::GLTF;
+			cook = true;
+		}
+	}
+	else if (format == FileFormat::Cooked)
+	{
+		// NbNς݃t@C̓ǂݍ
+		bool loaded = LoadCooked(cookedFilepath.string().c_str(), sampleRate);
+		_ASSERT_EXPR_A(loaded, "Cooked model load failed.");
+	}
+
+	if (format == FileFormat::Cereal)
+	{
+		// Ǝ`̃ft@C̓ǂݍ
+		Deserialize(cerealFilepath.string().c_str());
+	}
+	else if (format == FileFormat::GLTF)
+	{
+		if (extension == ".gltf" || extension == ".glb")
+		{
+			// ėpft@C̓ǂݍ
+			GLTFImporter importer(filename);
+
+			// }eAf[^ǂݎiߍ݃eNX`̓t@Cɏo͂ăt@CŎQƂj
+			importer.LoadMaterials(materials);
+
+			// m[hf[^ǂݎ
+			importer.LoadNodes(nodes);
+
+			// bVf[^ǂݎ
+			importer.LoadMeshes(meshes, nodes, true);
+
+			// Aj[Vf[^ǂݎ
+			importer.LoadAnimations(animations, nodes, sampleRate);
+
+			// NbNς݃t@Cۑ
+			if (cook)
+			{
+				SaveCooked(cookedFilepath.string().c_str(), sampleRate);
+			}
+		}
+		else
+		{
+			_ASSERT_EXPR_A(false, "found not model file");
+		}
+	}
+
+	// Qƃ}eAݒ
+	for (Mesh& mesh : meshes)
+	{
+		mesh.material = &materials.at(mesh.materialIndex);
+	}
+
+	// XLjOpbg\z
+	BuildSkinningPalette();
+
+	// ʎqAj[V\z
+	BuildCompressedAnimations();
+
+	// foCXw̏ꍇGPU\[X쐬ȂiǂݍݎԌvpj
+	if (device == nullptr) return;
+
+	// }eA\z
+	for (Material& material : materials)
+	{
+		if (material.baseMap == nullptr)
+		{
+			if (material.baseTextureFileName.empty())
+			{
+				// _~[eNX`쐬
+				HRESULT hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFFFFFF,
+					material.baseMap.GetAddressOf());
+				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+			}
+			else
+			{
+				// x[XeNX`ǂݍ
+				std::filesystem::path diffuseTexturePath(dirpath / material.baseTextureFileName);
+				HRESULT hr = GpuResourceUtils::LoadTexture(device, diffuseTexturePath.string().c_str(),
+					material.baseMap.GetAddressOf());
+				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+			}
+		}
+
+		if (material.normalMap == nullptr)
+		{
+			if (material.normalTextureFileName.empty())
+			{
+				// @_~[eNX`쐬
+				HRESULT hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFF7F7F,
+					material.normalMap.GetAddressOf());
+				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+			}
+			else
+			{
+				// @eNX`ǂݍ
+				std::filesystem::path texturePath(dirpath / material.normalTextureFileName);
+				HRESULT hr = GpuResourceUtils::LoadTexture(device, texturePath.string().c_str(),
+					material.normalMap.GetAddressOf());
+				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+			}
+		}
+	}
+
+	// ύXȂGPUobt@쐬
+	auto createBuffer = [device](const void* data, size_t size, UINT bindFlags, ID3D11Buffer** buffer)
+	{
+		D3D11_BUFFER_DESC bufferDesc = {};
+		D3D11_SUBRESOURCE_DATA subresourceData = {};
+
+		bufferDesc.ByteWidth = static_cast<UINT>(size);
+		bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		bufferDesc.BindFlags = bindFlags;
+		bufferDesc.CPUAccessFlags = 0;
+		bufferDesc.MiscFlags = 0;
+		bufferDesc.StructureByteStride = 0;
+		subresourceData.pSysMem = data;
+		subresourceData.SysMemPitch = 0;
+		subresourceData.SysMemSlicePitch = 0;
+
+		HRESULT hr = device->CreateBuffer(&bufferDesc, &subresourceData, buffer);
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	};
+
+	// bV\z
+	for (Mesh& mesh : meshes)
+	{
+		// _obt@
+		if (mesh.vertexFormat == VertexFormat::Float)
+		{
+			createBuffer(mesh.vertices.data(), sizeof(Vertex) * mesh.vertices.size(),
+				D3D11_BIND_VERTEX_BUFFER, mesh.vertexBuffer.GetAddressOf());
+		}
+		else
+		{
+			// ʒuƈkʃXg[ō쐬
+			std::vector<DirectX::XMFLOAT3> positions;
+			std::vector<uint8_t> attributes;
+			VertexCompression::Encode(mesh.vertices, mesh.vertexFormat, positions, attributes);
+
+			createBuffer(positions.data(), sizeof(DirectX::XMFLOAT3) * positions.size(),
+				D3D11_BIND_VERTEX_BUFFER, mesh.vertexBuffer.GetAddressOf());
+			createBuffer(attributes.data(), attributes.size(),
+				D3D11_BIND_VERTEX_BUFFER, mesh.attributeBuffer.GetAddressOf());
+		}
+
+		// CfbNXobt@i_16rbgɎ܂ꍇ16rbgɂj
+		if (mesh.vertices.size() <= 0x10000)
+		{
+			std::vector<uint16_t> indices(mesh.indices.begin(), mesh.indices.end());
+			mesh.indexFormat = DXGI_FORMAT_R16_UINT;
+			createBuffer(indices.data(), sizeof(uint16_t) * indices.size(),
+				D3D11_BIND_INDEX_BUFFER, mesh.indexBuffer.GetAddressOf());
+		}
+		else
+		{
+			mesh.indexFormat = DXGI_FORMAT_R32_UINT;
+			createBuffer(mesh.indices.data(), sizeof(uint32_t) * mesh.indices.size(),
+				D3D11_BIND_INDEX_BUFFER, mesh.indexBuffer.GetAddressOf());
+		}
+	}
+}
+
+// XLjOpbg\z
+void ModelResource::BuildSkinningPalette()
+{
+	paletteBones.clear();
+	for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
+	{
+		Mesh& mesh = meshes.at(meshIndex);
+
+		// XL̂ȂbV̓m[h̍sPQƂ
+		std::vector<Bone> bones = mesh.bones;
+		if (bones.empty())
+		{
+			Bone& bone = bones.emplace_back();
+			bone.nodeIndex = mesh.nodeIndex;
+			DirectX::XMStoreFloat4x4(&bone.offsetTransform, DirectX::XMMatrixIdentity());
+		}
+
+		// {[bV΂͈̔͂L
+		mesh.paletteCount = static_cast<int>(bones.size());
+		mesh.paletteOffset = -1;
+		for (size_t i = 0; i < meshIndex; ++i)
+		{
+			const Mesh& other = meshes.at(i);
+			if (other.paletteCount == mesh.paletteCount &&
+				memcmp(&paletteBones.at(other.paletteOffset), bones.data(), sizeof(Bone) * bones.size()) == 0)
+			{
+				mesh.paletteOffset = other.paletteOffset;
+				break;
+			}
+		}
+		if (mesh.paletteOffset < 0)
+		{
+			mesh.paletteOffset = static_cast<int>(paletteBones.size());
+			paletteBones.insert(paletteBones.end(), bones.begin(), bones.end());
+		}
+	}
+}
+
+// ʎqAj[V\z
+void ModelResource::BuildCompressedAnimations()
+{
+	for (size_t animationIndex = compressedAnimations.size(); animationIndex < animations.size(); ++animationIndex)
+	{
+		CompressAnimation(animations.at(animationIndex), animationSampleRate, compressedAnimations.emplace_back());
+	}
+}
+
+// L[t[ԍɕϊł邩
+template<class Keyframe>
+static bool IsOnFrameGrid(const std::vector<Keyframe>& keyframes, float framesPerSecond)
+{
+	for (const Keyframe& keyframe : keyframes)
+	{
+		float frame = keyframe.seconds * framesPerSecond;
+		if (fabsf(std::round(frame) - frame) > 0.01f) return false;
+	}
+	return true;
+}
+
+// gbÑL[i[iAt[ԍ̏ꍇ͐擪̂ݎj
+template<class Keyframe>
+static void CompressKeyframeTimes(const std::vector<Keyframe>& keyframes, float framesPerSecond,
+	ModelResource::CompressedTrack& track, std::vector<uint16_t>& frames)
+{
+	_ASSERT_EXPR_A(keyframes.size() <= UINT16_MAX, "too many keyframes to compress");
+
+	std::vector<uint16_t> keyFrames(keyframes.size());
+	bool uniform = true;
+	for (size_t i = 0; i < keyframes.size(); ++i)
+	{
+		float frame = std::round(keyframes[i].seconds * framesPerSecond);
+		keyFrames[i] = static_cast<uint16_t>(std::clamp(frame, 0.0f, static_cast<float>(UINT16_MAX)));
+		uniform = uniform && (i == 0 || keyFrames[i] == keyFrames[0] + i);
+	}
+
+	track.keyCount = static_cast<uint16_t>(keyframes.size());
+	track.firstFrame = keyFrames.empty() ? 0 : keyFrames[0];
+	if (uniform)
+	{
+		track.frameOffset = ModelResource::CompressedTrack::UniformFrames;
+	}
+	else
+	{
+		track.frameOffset = static_cast<uint32_t>(frames.size());
+		frames.insert(frames.end(), keyFrames.begin(), keyFrames.end());
+	}
+}
+
+// xNggbNl16rbgɗʎq
+static void CompressVectorTrack(const std::vector<ModelResource::VectorKeyframe>& keyframes, float framesPerSecond,
+	ModelResource::CompressedVectorTrack& track, std::vector<uint16_t>& keys, std::vector<uint16_t>& frames)
+{
+	CompressKeyframeTimes(keyframes, framesPerSecond, track, frames);
+	track.keyOffset = static_cast<uint32_t>(keys.size());
+	if (keyframes.empty()) return;
+
+	// l
+	DirectX::XMVECTOR Min = DirectX::XMLoadFloat3(&keyframes.front().value);
+	DirectX::XMVECTOR Max = Min;
+	for (const ModelResource::VectorKeyframe& keyframe : keyframes)
+	{
+		DirectX::XMVECTOR V = DirectX::XMLoadFloat3(&keyframe.value);
+		Min = DirectX::XMVectorMin(Min, V);
+		Max = DirectX::XMVectorMax(Max, V);
+	}
+	DirectX::XMVECTOR Step = DirectX::XMVectorScale(DirectX::XMVectorSubtract(Max, Min), 1.0f / UINT16_MAX);
+	DirectX::XMStoreFloat3(&track.rangeMin, Min);
+	DirectX::XMStoreFloat3(&track.rangeStep, Step);
+
+	// lωȂ0iKڂɌŒ肷
+	DirectX::XMFLOAT3 step = track.rangeStep;
+	const float inverseStep[3] =
+	{
+		step.x > 0 ? 1.0f / step.x : 0.0f,
+		step.y > 0 ? 1.0f / step.y : 0.0f,
+		step.z > 0 ? 1.0f / step.z : 0.0f,
+	};
+	for (const ModelResource::VectorKeyframe& keyframe : keyframes)
+	{
+		const float value[3] = { keyframe.value.x, keyframe.value.y, keyframe.value.z };
+		const float min[3] = { track.rangeMin.x, track.rangeMin.y, track.rangeMin.z };
+		for (int i = 0; i < 3; ++i)
+		{
+			float quantized = std::round((value[i] - min[i]) * inverseStep[i]);
+			keys.emplace_back(static_cast<uint16_t>(std::clamp(quantized, 0.0f, static_cast<float>(UINT16_MAX))));
+		}
+	}
+}
+
+// ]gbN48rbgɗʎqiő听ȂR15rbgAȂ̈ʒuʂQrbgɎj
+static void CompressRotationTrack(const std::vector<ModelResource::QuaternionKeyframe>& keyframes, float framesPerSecond,
+	ModelResource::CompressedTrack& track, std::vector<uint16_t>& keys, std::vector<uint16_t>& frames)
+{
+	CompressKeyframeTimes(keyframes, framesPerSecond, track, frames);
+	track.keyOffset = static_cast<uint32_t>(keys.size());
+
+	// ő听ȊÓ}1/2Ɏ܂
+	const float range = 0.70710678f;
+	const float maxQuantized = 32767.0f;
+	for (const ModelResource::QuaternionKeyframe& keyframe : keyframes)
+	{
+		DirectX::XMFLOAT4 q;
+		DirectX::XMStoreFloat4(&q, DirectX::XMQuaternionNormalize(DirectX::XMLoadFloat4(&keyframe.value)));
+		float component[4] = { q.x, q.y, q.z, q.w };
+
+		// ő听ɂȂ悤ɕ𑵂iq-q͓]j
+		int largest = 0;
+		for (int i = 1; i < 4; ++i)
+		{
+			if (fabsf(component[i]) > fabsf(component[largest])) largest = i;
+		}
+		float sign = component[largest] < 0 ? -1.0f : 1.0f;
+
+		uint64_t packed = static_cast<uint64_t>(largest) << 45;
+		int shift = 30;
+		for (int i = 0; i < 4; ++i)
+		{
+			if (i == largest) continue;
+			float normalized = (component[i] * sign + range) / (range * 2.0f);
+			uint64_t quantized = static_cast<uint64_t>(std::clamp(std::round(normalized * maxQuantized), 0.0f, maxQuantized));
+			packed |= quantized << shift;
+			shift -= 15;
+		}
+		keys.emplace_back(static_cast<uint16_t>(packed));
+		keys.emplace_back(static_cast<uint16_t>(packed >> 16));
+		keys.emplace_back(static_cast<uint16_t>(packed >> 32));
+	}
+}
+
+// Aj[Vʎq
+void ModelResource::CompressAnimation(const Animation& animation, float sampleRate, CompressedAnimation& compressedAnimation)
+{
+	// L[SăTvO[g݂̍ɏĂ΂̃t[ԍgA
+	// ĂȂ΍ĐԂ16rbgŕ݂Ɋۂ߂
+	float endSeconds = animation.secondsLength;
+	bool onGrid = true;
+	for (const NodeAnim& nodeAnim : animation.nodeAnims)
+	{
+		for (const VectorKeyframe& keyframe : nodeAnim.positionKeyframes) endSeconds = (std::max)(endSeconds, keyframe.seconds);
+		for (const QuaternionKeyframe& keyframe : nodeAnim.rotationKeyframes) endSeconds = (std::max)(endSeconds, keyframe.seconds);
+		for (const VectorKeyframe& keyframe : nodeAnim.scaleKeyframes) endSeconds = (std::max)(endSeconds, keyframe.seconds);
+		onGrid = onGrid &&
+			IsOnFrameGrid(nodeAnim.positionKeyframes, sampleRate) &&
+			IsOnFrameGrid(nodeAnim.rotationKeyframes, sampleRate) &&
+			IsOnFrameGrid(nodeAnim.scaleKeyframes, sampleRate);
+	}
+	if (onGrid && endSeconds * sampleRate <= UINT16_MAX)
+	{
+		compressedAnimation.framesPerSecond = sampleRate;
+	}
+	else
+	{
+		compressedAnimation.framesPerSecond = endSeconds > 0 ? UINT16_MAX / endSeconds : sampleRate;
+	}
+
+	compressedAnimation.nodeAnims.clear();
+	compressedAnimation.keys.clear();
+	compressedAnimation.frames.clear();
+
+	// L[16rbgŎĂȂgbNꍇ͗ʎqȂ
+	compressedAnimation.valid = true;
+	for (const NodeAnim& nodeAnim : animation.nodeAnims)
+	{
+		if (nodeAnim.positionKeyframes.size() > UINT16_MAX ||
+			nodeAnim.rotationKeyframes.size() > UINT16_MAX ||
+			nodeAnim.scaleKeyframes.size() > UINT16_MAX)
+		{
+			compressedAnimation.valid = false;
+			return;
+		}
+	}
+
+	compressedAnimation.nodeAnims.resize(animation.nodeAnims.size());
+	for (size_t nodeIndex = 0; nodeIndex < animation.nodeAnims.size(); ++nodeIndex)
+	{
+		const NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
+		CompressedNodeAnim& compressedNodeAnim = compressedAnimation.nodeAnims.at(nodeIndex);
+		CompressVectorTrack(nodeAnim.positionKeyframes, compressedAnimation.framesPerSecond, compressedNodeAnim.position, compressedAnimation.keys, compressedAnimation.frames);
+		CompressRotationTrack(nodeAnim.rotationKeyframes, compressedAnimation.framesPerSecond, compressedNodeAnim.rotation, compressedAnimation.keys, compressedAnimation.frames);
+		CompressVectorTrack(nodeAnim.scaleKeyframes, compressedAnimation.framesPerSecond, compressedNodeAnim.scale, compressedAnimation.keys, compressedAnimation.frames);
+	}
+	compressedAnimation.keys.shrink_to_fit();
+	compressedAnimation.frames.shrink_to_fit();
+}
+
+// ʎqAj[Ṽgpʎ擾
+size_t ModelResource::CompressedAnimation::GetMemorySize() const
+{
+	return sizeof(CompressedAnimation) +
+		sizeof(CompressedNodeAnim) * nodeAnims.size() +
+		sizeof(uint16_t) * (keys.size() + frames.size());
+}
+
+// \[Xǂݍ
+std::shared_ptr<ModelResource> ModelResource::Load(ID3D11Device* device, const char* filename, float sampleRate,
+	const std::vector<std::string>& animationFilenames)
+{
+	// t@CATvO[gAGPU\[X̗LAǉAj[V\[X͋L
+	using Key = std::tuple<std::string, float, bool, std::vector<std::string>>;
+	static std::mutex mutex;
+	static std::map<Key, std::weak_ptr<ModelResource>> resources;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::weak_ptr<ModelResource>& weakResource = resources[Key(filename, sampleRate, device != nullptr, animationFilenames)];
+	std::shared_ptr<ModelResource> resource = weakResource.lock();
+	if (resource == nullptr)
+	{
+		resource = std::make_shared<ModelResource>(device, filename, sampleRate);
+		for (const std::string& animationFilename : animationFilenames)
+		{
+			resource->AppendAnimations(animationFilename.c_str());
+		}
+		weakResource = resource;
+	}
+	return resource;
+}
+
+// Aj[Vǉǂݍ
+void ModelResource::AppendAnimations(const char* filename)
+{
+	std::filesystem::path filepath(filename);
+
+	if (filepath.extension() == ".gltf" ||
+		filepath.extension() == ".glb")
+	{
+		// ėpft@C̓ǂݍ
+		GLTFImporter importer(filename);
+
+		// Aj[Vf[^ǂݎ
+		importer.LoadAnimations(animations, nodes, animationSampleRate);
+
+		// ʎqAj[V\z
+		BuildCompressedAnimations();
+	}
+	else
+	{
+		_ASSERT_EXPR_A(false, "found not model file");
+	}
+}
+
+// Aj[VCfbNX擾
+int ModelResource::GetAnimationIndex(const char* name) const
+{
+	for (size_t animationIndex = 0; animationIndex < animations.size(); ++animationIndex)
+	{
+		if (animations.at(animationIndex).name == name)
+		{
+			return static_cast<int>(animationIndex);
+		}
+	}
+	return -1;
+}
+
+// m[hCfbNX擾
+int ModelResource::GetNodeIndex(const char* name) const
+{
+	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+	{
+		if (nodes.at(nodeIndex).name == name)
+		{
+			return static_cast<int>(nodeIndex);
+		}
+	}
+	return -1;
+}
+
+// _tH[}bg̓̓CAEg擾
+const std::vector<D3D11_INPUT_ELEMENT_DESC>& ModelResource::GetInputElementDescs(VertexFormat format)
+{
+	switch (format)
+	{
+		case VertexFormat::Compressed: return CompressedInputElementDescs;
+		case VertexFormat::CompressedStatic: return CompressedStaticInputElementDescs;
+	}
+	return InputElementDescs;
+}
+
+// _tH[}bg̃Xg[Ƃ̒_TCY擾
+UINT ModelResource::GetVertexStrides(VertexFormat format, UINT strides[2])
+{
+	switch (format)
+	{
+		case VertexFormat::Compressed:
+			strides[0] = sizeof(DirectX::XMFLOAT3);
+			strides[1] = sizeof(VertexCompression::SkinnedAttribute);
+			return 2;
+		case VertexFormat::CompressedStatic:
+			strides[0] = sizeof(DirectX::XMFLOAT3);
+			strides[1] = sizeof(VertexCompression::StaticAttribute);
+			return 2;
+	}
+	strides[0] = sizeof(Vertex);
+	strides[1] = 0;
+	return 1;
+}
+
+// bVɓK_tH[}bgI
+ModelResource::VertexFormat ModelResource::SelectVertexFormat(const Mesh& mesh, bool compress)
+{
+	if (!compress) return VertexFormat::Float;
+
+	// XLjOȂbV̓{[Ȃ
+	if (mesh.bones.empty()) return VertexFormat::CompressedStatic;
+
+	// {[CfbNX8rbgɎ܂Ȃꍇ͈kȂ
+	if (mesh.bones.size() > 256) return VertexFormat::Float;
+
+	return VertexFormat::Compressed;
+}
+
+// VACY
+void ModelResource::Serialize(const char* filename) const
+{
+	std::ofstream ostream(filename, std::ios::binary);
+	if (ostream.is_open())
+	{
+		cereal::BinaryOutputArchive archive(ostream);
+
+		try
+		{
+			archive(
+				CEREAL_NVP(nodes),
+				CEREAL_NVP(materials),
+				CEREAL_NVP(meshes),
+				CEREAL_NVP(animations)
+			);
+		}
+		catch (...)
+		{
+			_ASSERT_EXPR_A(false, "Model serialize failed.");
+		}
+	}
+}
+
+// fVACY
+void ModelResource::Deserialize(const char* filename)
+{
+	std::ifstream istream(filename, std::ios::binary);
+	if (istream.is_open())
+	{
+		cereal::BinaryInputArchive archive(istream);
+
+		try
+		{
+			archive(
+				CEREAL_NVP(nodes),
+				CEREAL_NVP(materials),
+				CEREAL_NVP(meshes),
+				CEREAL_NVP(animations)
+			);
+		}
+		catch (...)
+		{
+			_ASSERT_EXPR_A(false, "Model deserialize failed.");
+		}
+	}
+	else
+	{
+		_ASSERT_EXPR_A(false, "Model File not found.");
+	}
+}
+
+// NbNς݃t@C\[Xt@CV
+bool ModelResource::IsCookedFileUpToDate(const char* cookedFilename, const char* sourceFilename)
+{
+	std::error_code ec;
+	if (!std::filesystem::exists(cookedFilename, ec)) return false;
+	if (!std::filesystem::exists(sourceFilename, ec)) return true;
+
+	std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedFilename, ec);
+	if (ec) return false;
+	std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourceFilename, ec);
+	if (ec) return false;
+
+	return cookedTime >= sourceTime;
+}
+
+// NbNς݃t@Cۑ
+void ModelResource::SaveCooked(const char* filename, float sampleRate) const
+{
+	std::vector<char>					strings;
+	std::vector<CookedNode>				cookedNodes;
+	std::vector<CookedMaterial>			cookedMaterials;
+	std::vector<CookedMesh>				cookedMeshes;
+	std::vector<Vertex>					cookedVertices;
+	std::vector<uint32_t>				cookedIndices;
+	std::vector<Bone>					cookedBones;
+	std::vector<CookedAnimation>		cookedAnimations;
+	std::vector<CookedNodeAnim>			cookedNodeAnims;
+	std::vector<VectorKeyframe>			cookedVectorKeyframes;
+	std::vector<QuaternionKeyframe>		cookedQuaternionKeyframes;
+
+	// e[uɒǉăItZbgԂ
+	auto addString = [&](const std::string& str)
+	{
+		uint32_t offset = static_cast<uint32_t>(strings.size());
+		strings.insert(strings.end(), str.begin(), str.end());
+		strings.emplace_back('\0');
+		return offset;
+	};
+
+	// m[h
+	for (const Node& node : nodes)
+	{
+		CookedNode& cookedNode = cookedNodes.emplace_back();
+		cookedNode.name = addString(node.name);
+		cookedNode.parentIndex = node.parentIndex;
+		cookedNode.position = node.position;
+		cookedNode.rotation = node.rotation;
+		cookedNode.scale = node.scale;
+	}
+
+	// }eA
+	for (const Material& material : materials)
+	{
+		CookedMaterial& cookedMaterial = cookedMaterials.emplace_back();
+		cookedMaterial.name = addString(material.name);
+		cookedMaterial.baseTextureFileName = addString(material.baseTextureFileName);
+		cookedMaterial.normalTextureFileName = addString(material.normalTextureFileName);
+		cookedMaterial.emissiveTextureFileName = addString(material.emissiveTextureFileName);
+		cookedMaterial.occlusionTextureFileName = addString(material.occlusionTextureFileName);
+		cookedMaterial.metalnessRoughnessTextureFileName = addString(material.metalnessRoughnessTextureFileName);
+		cookedMaterial.baseColor = material.baseColor;
+		cookedMaterial.emissiveColor = material.emissiveColor;
+		cookedMaterial.metalness = material.metalness;
+		cookedMaterial.roughness = material.roughness;
+		cookedMaterial.occlusionStrength = material.occlusionStrength;
+		cookedMaterial.alphaCutoff = material.alphaCutoff;
+		cookedMaterial.alphaMode = static_cast<int32_t>(material.alphaMode);
+	}
+
+	// bVi_ACfbNXA{[͑SbVň̔zɂ܂Ƃ߂j
+	for (const Mesh& mesh : meshes)
+	{
+		CookedMesh& cookedMesh = cookedMeshes.emplace_back();
+		cookedMesh.vertexStart = static_cast<uint32_t>(cookedVertices.size());
+		cookedMesh.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		cookedMesh.indexStart = static_cast<uint32_t>(cookedIndices.size());
+		cookedMesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+		cookedMesh.boneStart = static_cast<uint32_t>(cookedBones.size());
+		cookedMesh.boneCount = static_cast<uint32_t>(mesh.bones.size());
+		cookedMesh.nodeIndex = mesh.nodeIndex;
+		cookedMesh.materialIndex = mesh.materialIndex;
+		cookedMesh.vertexFormat = static_cast<int32_t>(mesh.vertexFormat);
+
+		cookedVertices.insert(cookedVertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+		cookedIndices.insert(cookedIndices.end(), mesh.indices.begin(), mesh.indices.end());
+		cookedBones.insert(cookedBones.end(), mesh.bones.begin(), mesh.bones.end());
+	}
+
+	// Aj[ViʒuƃXP[̃L[t[͈̔zɂ܂Ƃ߂j
+	for (const Animation& animation : animations)
+	{
+		CookedAnimation& cookedAnimation = cookedAnimations.emplace_back();
+		cookedAnimation.name = addString(animation.name);
+		cookedAnimation.secondsLength = animation.secondsLength;
+		cookedAnimation.nodeAnimStart = static_cast<uint32_t>(cookedNodeAnims.size());
+		cookedAnimation.nodeAnimCount = static_cast<uint32_t>(animation.nodeAnims.size());
+
+		for (const NodeAnim& nodeAnim : animation.nodeAnims)
+		{
+			CookedNodeAnim& cookedNodeAnim = cookedNodeAnims.emplace_back();
+			cookedNodeAnim.positionStart = static_cast<uint32_t>(cookedVectorKeyframes.size());
+			cookedNodeAnim.positionCount = static_cast<uint32_t>(nodeAnim.positionKeyframes.size());
+			cookedVectorKeyframes.insert(cookedVectorKeyframes.end(), nodeAnim.positionKeyframes.begin(), nodeAnim.positionKeyframes.end());
+
+			cookedNodeAnim.rotationStart = static_cast<uint32_t>(cookedQuaternionKeyframes.size());
+			cookedNodeAnim.rotationCount = static_cast<uint32_t>(nodeAnim.rotationKeyframes.size());
+			cookedQuaternionKeyframes.insert(cookedQuaternionKeyframes.end(), nodeAnim.rotationKeyframes.begin(), nodeAnim.rotationKeyframes.end());
+
+			cookedNodeAnim.scaleStart = static_cast<uint32_t>(cookedVectorKeyframes.size());
+			cookedNodeAnim.scaleCount = static_cast<uint32_t>(nodeAnim.scaleKeyframes.size());
+			cookedVectorKeyframes.insert(cookedVectorKeyframes.end(), nodeAnim.scaleKeyframes.begin(), nodeAnim.scaleKeyframes.end());
+		}
+	}
+
+	// ZNVe[u쐬
+	CookedHeader header = {};
+	header.magic = CookedMagic;
+	header.version = CookedVersion;
+	header.sampleRate = sampleRate;
+	header.sectionCount = static_cast<uint32_t>(CookedSectionType::EnumCount);
+
+	CookedSection sections[static_cast<size_t>(CookedSectionType::EnumCount)] = {};
+	const void* sectionData[static_cast<size_t>(CookedSectionType::EnumCount)] = {};
+	uint64_t offset = sizeof(header) + sizeof(sections);
+
+	auto addSection = [&](CookedSectionType type, const auto& array)
+	{
+		using Element = typename std::decay_t<decltype(array)>::value_type;
+		offset = (offset + CookedAlignment - 1) / CookedAlignment * CookedAlignment;
+
+		CookedSection& section = sections[static_cast<size_t>(type)];
+		section.offset = offset;
+		section.count = static_cast<uint32_t>(array.size());
+		section.stride = static_cast<uint32_t>(sizeof(Element));
+		section.size = static_cast<uint64_t>(section.count) * section.stride;
+		sectionData[static_cast<size_t>(type)] = array.data();
+
+		offset += section.size;
+	};
+	addSection(CookedSectionType::Strings, strings);
+	addSection(CookedSectionType::Nodes, cookedNodes);
+	addSection(CookedSectionType::Materials, cookedMaterials);
+	addSection(CookedSectionType::Meshes, cookedMeshes);
+	addSection(CookedSectionType::Vertices, cookedVertices);
+	addSection(CookedSectionType::Indices, cookedIndices);
+	addSection(CookedSectionType::Bones, cookedBones);
+	addSection(CookedSectionType::Animations, cookedAnimations);
+	addSection(CookedSectionType::NodeAnims, cookedNodeAnims);
+	addSection(CookedSectionType::VectorKeyframes, cookedVectorKeyframes);
+	addSection(CookedSectionType::QuaternionKeyframes, cookedQuaternionKeyframes);
+
+	// o
+	std::ofstream ostream(filename, std::ios::binary);
+	if (!ostream.is_open())
+	{
+		_ASSERT_EXPR_A(false, "Cooked model save failed.");
+		return;
+	}
+	ostream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ostream.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+	for (size_t i = 0; i < static_cast<size_t>(CookedSectionType::EnumCount); ++i)
+	{
+		const CookedSection& section = sections[i];
+
+		// ACg
+		static const char padding[CookedAlignment] = {};
+		uint64_t position = static_cast<uint64_t>(ostream.tellp());
+		ostream.write(padding, static_cast<std::streamsize>(section.offset - position));
+
+		ostream.write(static_cast<const char*>(sectionData[i]), static_cast<std::streamsize>(section.size));
+	}
+}
+
+// NbNς݃t@Cǂݍ
+bool ModelResource::LoadCooked(const char* filename, float sampleRate)
+{
+	MappedFile file(filename);
+	if (file.GetData() == nullptr) return false;
+	if (file.GetSize() < sizeof(CookedHeader) + sizeof(CookedSection) * static_cast<size_t>(CookedSectionType::EnumCount)) return false;
+
+	// wb_mFio[WTvO[gႤꍇ͍蒼j
+	const CookedHeader* header = reinterpret_cast<const CookedHeader*>(file.GetData());
+	if (header->magic != CookedMagic) return false;
+	if (header->version != CookedVersion) return false;
+	if (header->sampleRate != sampleRate) return false;
+	if (header->sectionCount != static_cast<uint32_t>(CookedSectionType::EnumCount)) return false;
+	const CookedSection* sections = reinterpret_cast<const CookedSection*>(header + 1);
+
+	// ZNV擾
+	uint32_t stringCount, nodeCount, materialCount, meshCount, vertexCount, indexCount, boneCount;
+	uint32_t animationCount, nodeAnimCount, vectorKeyframeCount, quaternionKeyframeCount;
+	const char* cookedStrings = GetCookedSection<char>(file, sections, CookedSectionType::Strings, stringCount);
+	const CookedNode* cookedNodes = GetCookedSection<CookedNode>(file, sections, CookedSectionType::Nodes, nodeCount);
+	const CookedMaterial* cookedMaterials = GetCookedSection<CookedMaterial>(file, sections, CookedSectionType::Materials, materialCount);
+	const CookedMesh* cookedMeshes = GetCookedSection<CookedMesh>(file, sections, CookedSectionType::Meshes, meshCount);
+	const Vertex* cookedVertices = GetCookedSection<Vertex>(file, sections, CookedSectionType::Vertices, vertexCount);
+	const uint32_t* cookedIndices = GetCookedSection<uint32_t>(file, sections, CookedSectionType::Indices, indexCount);
+	const Bone* cookedBones = GetCookedSection<Bone>(file, sections, CookedSectionType::Bones, boneCount);
+	const CookedAnimation* cookedAnimations = GetCookedSection<CookedAnimation>(file, sections, CookedSectionType::Animations, animationCount);
+	const CookedNodeAnim* cookedNodeAnims = GetCookedSection<CookedNodeAnim>(file, sections, CookedSectionType::NodeAnims, nodeAnimCount);
+	const VectorKeyframe* cookedVectorKeyframes = GetCookedSection<VectorKeyframe>(file, sections, CookedSectionType::VectorKeyframes, vectorKeyframeCount);
+	const QuaternionKeyframe* cookedQuaternionKeyframes = GetCookedSection<QuaternionKeyframe>(file, sections, CookedSectionType::QuaternionKeyframes, quaternionKeyframeCount);
+	if (cookedStrings == nullptr || cookedNodes == nullptr || cookedMaterials == nullptr ||
+		cookedMeshes == nullptr || cookedVertices == nullptr || cookedIndices == nullptr ||
+		cookedBones == nullptr || cookedAnimations == nullptr || cookedNodeAnims == nullptr ||
+		cookedVectorKeyframes == nullptr || cookedQuaternionKeyframes == nullptr)
+	{
+		return false;
+	}
+	if (stringCount == 0 || cookedStrings[stringCount - 1] != '\0') return false;
+
+	// ͈̓`FbN
+	auto inRange = [](uint32_t start, uint32_t count, uint32_t size)
+	{
+		return start <= size && count <= size - start;
+	};
+	auto getString = [&](uint32_t offset)
+	{
+		return offset < stringCount ? cookedStrings + offset : "";
+	};
+
+	// m[hCfbNX͈̔̓`FbNiꂽt@CÂt@CglTFǂݍݒj
+	auto isValidNodeIndex = [&](int32_t nodeIndex)
+	{
+		return nodeIndex >= 0 && static_cast<uint32_t>(nodeIndex) < nodeCount;
+	};
+	for (uint32_t i = 0; i < boneCount; ++i)
+	{
+		if (!isValidNodeIndex(cookedBones[i].nodeIndex)) return false;
+	}
+
+	// m[h
+	std::vector<Node> loadNodes(nodeCount);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		const CookedNode& cookedNode = cookedNodes[i];
+		if (cookedNode.parentIndex != -1 && !isValidNodeIndex(cookedNode.parentIndex)) return false;
+		if (cookedNode.parentIndex == static_cast<int32_t>(i)) return false;
+
+		Node& node = loadNodes[i];
+		node.name = getString(cookedNode.name);
+		node.parentIndex = cookedNode.parentIndex;
+		node.position = cookedNode.position;
+		node.rotation = cookedNode.rotation;
+		node.scale = cookedNode.scale;
+	}
+
+	// }eA
+	std::vector<Material> loadMaterials(materialCount);
+	for (uint32_t i = 0; i < materialCount; ++i)
+	{
+		const CookedMaterial& cookedMaterial = cookedMaterials[i];
+		Material& material = loadMaterials[i];
+		material.name = getString(cookedMaterial.name);
+		material.baseTextureFileName = getString(cookedMaterial.baseTextureFileName);
+		material.normalTextureFileName = getString(cookedMaterial.normalTextureFileName);
+		material.emissiveTextureFileName = getString(cookedMaterial.emissiveTextureFileName);
+		material.occlusionTextureFileName = getString(cookedMaterial.occlusionTextureFileName);
+		material.metalnessRoughnessTextureFileName = getString(cookedMaterial.metalnessRoughnessTextureFileName);
+		material.baseColor = cookedMaterial.baseColor;
+		material.emissiveColor = cookedMaterial.emissiveColor;
+		material.metalness = cookedMaterial.metalness;
+		material.roughness = cookedMaterial.roughness;
+		material.occlusionStrength = cookedMaterial.occlusionStrength;
+		material.alphaCutoff = cookedMaterial.alphaCutoff;
+		material.alphaMode = static_cast<AlphaMode>(cookedMaterial.alphaMode);
+	}
+
+	// bViz̓}bvꊇŃRs[j
+	std::vector<Mesh> loadMeshes(meshCount);
+	for (uint32_t i = 0; i < meshCount; ++i)
+	{
+		const CookedMesh& cookedMesh = cookedMeshes[i];
+		if (!inRange(cookedMesh.vertexStart, cookedMesh.vertexCount, vertexCount)) return false;
+		if (!inRange(cookedMesh.indexStart, cookedMesh.indexCount, indexCount)) return false;
+		if (!inRange(cookedMesh.boneStart, cookedMesh.boneCount, boneCount)) return false;
+		if (cookedMesh.materialIndex < 0 || static_cast<uint32_t>(cookedMesh.materialIndex) >= materialCount) return false;
+		if (!isValidNodeIndex(cookedMesh.nodeIndex)) return false;
+		if (cookedMesh.vertexFormat < 0 || cookedMesh.vertexFormat >= static_cast<int32_t>(VertexFormat::EnumCount)) return false;
+
+		Mesh& mesh = loadMeshes[i];
+		const Vertex* vertices = cookedVertices + cookedMesh.vertexStart;
+		const uint32_t* indices = cookedIndices + cookedMesh.indexStart;
+		const Bone* bones = cookedBones + cookedMesh.boneStart;
+		mesh.vertices.assign(vertices, vertices + cookedMesh.vertexCount);
+		mesh.indices.assign(indices, indices + cookedMesh.indexCount);
+		mesh.bones.assign(bones, bones + cookedMesh.boneCount);
+		mesh.nodeIndex = cookedMesh.nodeIndex;
+		mesh.materialIndex = cookedMesh.materialIndex;
+		mesh.vertexFormat = static_cast<VertexFormat>(cookedMesh.vertexFormat);
+	}
+
+	// Aj[V
+	std::vector<Animation> loadAnimations(animationCount);
+	for (uint32_t i = 0; i < animationCount; ++i)
+	{
+		const CookedAnimation& cookedAnimation = cookedAnimations[i];
+		if (!inRange(cookedAnimation.nodeAnimStart, cookedAnimation.nodeAnimCount, nodeAnimCount)) return false;
+
+		Animation& animation = loadAnimations[i];
+		animation.name = getString(cookedAnimation.name);
+		animation.secondsLength = cookedAnimation.secondsLength;
+		animation.nodeAnims.resize(cookedAnimation.nodeAnimCount);
+		for (uint32_t j = 0; j < cookedAnimation.nodeAnimCount; ++j)
+		{
+			const CookedNodeAnim& cookedNodeAnim = cookedNodeAnims[cookedAnimation.nodeAnimStart + j];
+			if (!inRange(cookedNodeAnim.positionStart, cookedNodeAnim.positionCount, vectorKeyframeCount)) return false;
+			if (!inRange(cookedNodeAnim.rotationStart, cookedNodeAnim.rotationCount, quaternionKeyframeCount)) return false;
+			if (!inRange(cookedNodeAnim.scaleStart, cookedNodeAnim.scaleCount, vectorKeyframeCount)) return false;
+
+			NodeAnim& nodeAnim = animation.nodeAnims[j];
+			const VectorKeyframe* positionKeyframes = cookedVectorKeyframes + cookedNodeAnim.positionStart;
+			const QuaternionKeyframe* rotationKeyframes = cookedQuaternionKeyframes + cookedNodeAnim.rotationStart;
+			const VectorKeyframe* scaleKeyframes = cookedVectorKeyframes + cookedNodeAnim.scaleStart;
+			nodeAnim.positionKeyframes.assign(positionKeyframes, positionKeyframes + cookedNodeAnim.positionCount);
+			nodeAnim.rotationKeyframes.assign(rotationKeyframes, rotationKeyframes + cookedNodeAnim.rotationCount);
+			nodeAnim.scaleKeyframes.assign(scaleKeyframes, scaleKeyframes + cookedNodeAnim.scaleCount);
+		}
+	}
+
+	nodes = std::move(loadNodes);
+	materials = std::move(loadMaterials);
+	meshes = std::move(loadMeshes);
+	animations = std::move(loadAnimations);
+
+	return true;
+}
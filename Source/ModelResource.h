@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+#include <wrl.h>
+#include <d3d11.h>
+
+// f\[XĩfŋLǂݍݐpf[^j
+class ModelResource
+{
+public:
+	// ǂݍ݌`
+	enum class FileFormat
+	{
+		Auto,		// NbNς  cereal  glTF ̏őIAglTFǂ񂾏ꍇ̓NbN
+		GLTF,
+		Cereal,
+		Cooked
+	};
+
+	// devicenullptȑꍇGPU\[X쐬Ȃ
+	ModelResource(ID3D11Device* device, const char* filename, float sampleRate = 60, FileFormat format = FileFormat::Auto);
+	~ModelResource() = default;
+
+	// _tH[}bgiGPUɓ]钸_̌`j
+	enum class VertexFormat
+	{
+		Float,				// SvffloatiPXg[A80oCgj
+		Compressed,			// ʒufloat{kiQXg[A12{20oCgj
+		CompressedStatic,	// ʒufloat{XLjOȂ̈kiQXg[A12{12oCgj
+
+		EnumCount
+	};
+
+	static const std::vector<D3D11_INPUT_ELEMENT_DESC> InputElementDescs;
+	static const std::vector<D3D11_INPUT_ELEMENT_DESC> CompressedInputElementDescs;
+	static const std::vector<D3D11_INPUT_ELEMENT_DESC> CompressedStaticInputElementDescs;
+
+	// p̃m[h
+	struct Node
+	{
+		std::string			name;
+		int					parentIndex = -1;
+		DirectX::XMFLOAT3	position = { 0, 0, 0 };
+		DirectX::XMFLOAT4	rotation = { 0, 0, 0, 1 };
+		DirectX::XMFLOAT3	scale = { 1, 1, 1 };
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	enum class AlphaMode
+	{
+		Opaque,
+		Mask,
+		Blend
+	};
+
+	struct Material
+	{
+		std::string			name;
+		std::string			baseTextureFileName;
+		std::string			normalTextureFileName;
+		std::string			emissiveTextureFileName;
+		std::string			occlusionTextureFileName;
+		std::string			metalnessRoughnessTextureFileName;
+		DirectX::XMFLOAT4	baseColor = { 1, 1, 1, 1 };
+		DirectX::XMFLOAT3	emissiveColor = { 1, 1, 1 };
+		float				metalness = 0.0f;
+		float				roughness = 0.0f;
+		float				occlusionStrength = 0.0f;
+		float				alphaCutoff = 0.5f;
+		AlphaMode			alphaMode = AlphaMode::Opaque;
+
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	baseMap;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	normalMap;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	emissiveMap;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	occlusionMap;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	metalnessRoughnessMap;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct Vertex
+	{
+		DirectX::XMFLOAT3		position = { 0, 0, 0 };
+		DirectX::XMFLOAT3		normal = { 0, 0, 0 };
+		DirectX::XMFLOAT4		tangent = { 0, 0, 0, 1 };
+		DirectX::XMFLOAT2		texcoord = { 0, 0 };
+		DirectX::XMFLOAT4		boneWeight = { 1, 0, 0, 0 };
+		DirectX::XMUINT4		boneIndex = { 0, 0, 0, 0 };
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct Bone
+	{
+		int						nodeIndex;
+		DirectX::XMFLOAT4X4		offsetTransform;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct Mesh
+	{
+		std::vector<Vertex>		vertices;		// CPU͈kȂ
+		std::vector<uint32_t>	indices;
+		std::vector<Bone>		bones;
+		int			nodeIndex = 0;
+		int			materialIndex = 0;
+		VertexFormat	vertexFormat = VertexFormat::Float;
+		DXGI_FORMAT		indexFormat = DXGI_FORMAT_R32_UINT;
+		Material*	material = nullptr;
+		int			paletteOffset = 0;		// XLjOpbg̎QƔ͈́iǂݍ݌ɍ\zj
+		int			paletteCount = 0;
+		Microsoft::WRL::ComPtr<ID3D11Buffer>	vertexBuffer;		// Float͑SvfAktH[}bg͈ʒu
+		Microsoft::WRL::ComPtr<ID3D11Buffer>	attributeBuffer;	// ktH[}bg̖@AڐAUVA{[
+		Microsoft::WRL::ComPtr<ID3D11Buffer>	indexBuffer;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct VectorKeyframe
+	{
+		float					seconds;
+		DirectX::XMFLOAT3		value;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct QuaternionKeyframe
+	{
+		float					seconds;
+		DirectX::XMFLOAT4		value;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct NodeAnim
+	{
+		std::vector<VectorKeyframe>		positionKeyframes;
+		std::vector<QuaternionKeyframe>	rotationKeyframes;
+		std::vector<VectorKeyframe>		scaleKeyframes;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	struct Animation
+	{
+		std::string					name;
+		float						secondsLength;
+		std::vector<NodeAnim>		nodeAnims;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	// ʎqgbNiL[uint16_t~3AsϓȃgbÑL[̓t[ԍŎj
+	struct CompressedTrack
+	{
+		static const uint32_t	UniformFrames = UINT32_MAX;
+
+		uint32_t				keyOffset = 0;					// CompressedAnimation::keys̐擪
+		uint32_t				frameOffset = UniformFrames;	// CompressedAnimation::frames̐擪iϓTvȌꍇUniformFramesj
+		uint16_t				keyCount = 0;
+		uint16_t				firstFrame = 0;					// 擪L[̃t[ԍ
+	};
+
+	// ʎqxNggbNigbN̒lɑ΂16rbgŗʎqj
+	struct CompressedVectorTrack : CompressedTrack
+	{
+		DirectX::XMFLOAT3		rangeMin = { 0, 0, 0 };
+		DirectX::XMFLOAT3		rangeStep = { 0, 0, 0 };		// ʎqPiK̒l
+	};
+
+	struct CompressedNodeAnim
+	{
+		CompressedVectorTrack	position;
+		CompressedTrack			rotation;						// ő听ȂRismallest threeA48rbgj
+		CompressedVectorTrack	scale;
+	};
+
+	// ʎqAj[ViTvOɕAAnimationƓсj
+	struct CompressedAnimation
+	{
+		float							framesPerSecond = 60;	// t[ԍ̒P
+		bool							valid = true;			// L[16rbgɎ܂ȂgbNꍇfalseĩL[t[ŌvZj
+		std::vector<CompressedNodeAnim>	nodeAnims;
+		std::vector<uint16_t>			keys;
+		std::vector<uint16_t>			frames;
+
+		// gpʎ擾
+		size_t GetMemorySize() const;
+	};
+
+	// _tH[}bg̓̓CAEg擾
+	static const std::vector<D3D11_INPUT_ELEMENT_DESC>& GetInputElementDescs(VertexFormat format);
+
+	// _tH[}bg̃Xg[Ƃ̒_TCY擾iXg[Ԃj
+	static UINT GetVertexStrides(VertexFormat format, UINT strides[2]);
+
+	// bVɓK_tH[}bgI
+	static VertexFormat SelectVertexFormat(const Mesh& mesh, bool compress);
+
+	// \[Xǂݍ݁iœǂݍݍς݂̃\[X͋Lj
+	// animationFilenames̃Aj[V͋LOɒǉ邽߁Aǂݍ݌̃\[X͕ύXȂ
+	// devicenullptȑꍇGPU\[XȂ߁AfoCXw肵ǂݍ݂Ƃ͋LȂ
+	static std::shared_ptr<ModelResource> Load(ID3D11Device* device, const char* filename, float sampleRate = 60,
+		const std::vector<std::string>& animationFilenames = {});
+
+	// }eAf[^擾
+	const std::vector<Material>& GetMaterials() const { return materials; }
+
+	// bVf[^擾
+	const std::vector<Mesh>& GetMeshes() const { return meshes; }
+
+	// Aj[Vf[^擾
+	const std::vector<Animation>& GetAnimations() const { return animations; }
+
+	// m[hf[^擾
+	const std::vector<Node>& GetNodes() const { return nodes; }
+
+	// XLjOpbg̃{[擾iXLQƂ郁bV͓͈͂Lj
+	const std::vector<Bone>& GetPaletteBones() const { return paletteBones; }
+
+	// ʎqAj[Vf[^擾
+	const std::vector<CompressedAnimation>& GetCompressedAnimations() const { return compressedAnimations; }
+
+	// Aj[VCfbNX擾
+	int GetAnimationIndex(const char* name) const;
+
+	// m[hCfbNX擾
+	int GetNodeIndex(const char* name) const;
+
+	// VACY
+	void Serialize(const char* filename) const;
+
+	// NbNς݃t@Cۑ
+	void SaveCooked(const char* filename, float sampleRate) const;
+
+	// NbNς݃t@C\[Xt@CV
+	static bool IsCookedFileUpToDate(const char* cookedFilename, const char* sourceFilename);
+
+private:
+	// fVACY
+	void Deserialize(const char* filename);
+
+	// Aj[Vǉǂݍ݁iLÕ\[Xɂsj
+	void AppendAnimations(const char* filename);
+
+	// NbNς݃t@Cǂݍ
+	bool LoadCooked(const char* filename, float sampleRate);
+
+	// XLjOpbg\z
+	void BuildSkinningPalette();
+
+	// ʎqAj[V\zi\z̃Aj[V̂݁j
+	void BuildCompressedAnimations();
+
+	// Aj[Vʎq
+	static void CompressAnimation(const Animation& animation, float sampleRate, CompressedAnimation& compressedAnimation);
+
+private:
+	std::vector<Material>		materials;
+	std::vector<Mesh>			meshes;
+	std::vector<Node>			nodes;
+	std::vector<Animation>		animations;
+	std::vector<CompressedAnimation>	compressedAnimations;
+	std::vector<Bone>			paletteBones;
+	float						animationSampleRate = 60;		// ʎq̃t[ԍ̒P
+};
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <numeric>
+#include "Misc.h"
+#include "NodeHierarchy.h"
+
+// AtBs̏Ziz`AOut = A * Bj
+static void MultiplyAffine(const DirectX::XMVECTOR* A, const DirectX::XMVECTOR* B, DirectX::XMVECTOR* Out)
+{
+	for (int row = 0; row < 4; ++row)
+	{
+		const DirectX::XMVECTOR* a = &A[row * 3];
+		for (int column = 0; column < 3; ++column)
+		{
+			DirectX::XMVECTOR V = DirectX::XMVectorMultiply(a[0], B[column]);
+			V = DirectX::XMVectorMultiplyAdd(a[1], B[3 + column], V);
+			V = DirectX::XMVectorMultiplyAdd(a[2], B[6 + column], V);
+			if (row == 3)
+			{
+				// sړ͑S񂪂P
+				V = DirectX::XMVectorAdd(V, B[9 + column]);
+			}
+			Out[row * 3 + column] = V;
+		}
+	}
+}
+
+// RXgN^
+NodeHierarchy::NodeHierarchy(const std::vector<ModelResource::Node>& nodes)
+{
+	const int nodeCount = static_cast<int>(nodes.size());
+
+	// [Zoie͎qOɕłOj
+	std::vector<int> depths(nodeCount, 0);
+	for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		int parentIndex = nodes.at(nodeIndex).parentIndex;
+		_ASSERT_EXPR_A(parentIndex < nodeIndex, "parent node must precede its children");
+		depths.at(nodeIndex) = parentIndex >= 0 ? depths.at(parentIndex) + 1 : 0;
+	}
+
+	// [ɕׂƓ[̃m[h݂͌ɓƗČvZł
+	std::vector<int> order(nodeCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return depths[a] < depths[b]; });
+
+	// eqO[vɓꍇ͎̃O[v犄蓖Ă
+	nodeSlots.resize(nodeCount);
+	int slot = 0;
+	for (int nodeIndex : order)
+	{
+		int parentIndex = nodes.at(nodeIndex).parentIndex;
+		int groupStart = slot - slot % LaneCount;
+		if (parentIndex >= 0 && nodeSlots.at(parentIndex) >= groupStart)
+		{
+			slot = groupStart + LaneCount;
+		}
+		nodeSlots.at(nodeIndex) = slot++;
+	}
+	groupCount = (slot + LaneCount - 1) / LaneCount;
+	identitySlot = groupCount * LaneCount;
+
+	// eXbgݒi[gƋ󂫃Xbg͒Pʍseɂj
+	parentSlots.assign(groupCount * LaneCount, identitySlot);
+	for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		int parentIndex = nodes.at(nodeIndex).parentIndex;
+		if (parentIndex >= 0)
+		{
+			parentSlots.at(nodeSlots.at(nodeIndex)) = nodeSlots.at(parentIndex);
+		}
+	}
+
+	// zmہi󂫃Xbg͒Pʎpj
+	for (Stream& stream : positions) stream.assign(groupCount, DirectX::XMVectorZero());
+	for (Stream& stream : rotations) stream.assign(groupCount, DirectX::XMVectorZero());
+	for (Stream& stream : scales) stream.assign(groupCount, DirectX::XMVectorSplatOne());
+	rotations[3].assign(groupCount, DirectX::XMVectorSplatOne());
+	for (Stream& stream : localTransforms) stream.assign(groupCount, DirectX::XMVectorZero());
+	for (Stream& stream : globalTransforms) stream.assign(groupCount + 1, DirectX::XMVectorZero());
+	for (Stream& stream : worldTransforms) stream.assign(groupCount, DirectX::XMVectorZero());
+	Lane(globalTransforms[0], identitySlot) = 1.0f;
+	Lane(globalTransforms[4], identitySlot) = 1.0f;
+	Lane(globalTransforms[8], identitySlot) = 1.0f;
+
+	// pݒ
+	for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		const ModelResource::Node& node = nodes.at(nodeIndex);
+		SetPose(nodeIndex, node.position, node.rotation, node.scale);
+	}
+}
+
+// pݒ
+void NodeHierarchy::SetPose(int nodeIndex, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& rotation, const DirectX::XMFLOAT3& scale)
+{
+	int slot = nodeSlots[nodeIndex];
+	Lane(positions[0], slot) = position.x;
+	Lane(positions[1], slot) = position.y;
+	Lane(positions[2], slot) = position.z;
+	Lane(rotations[0], slot) = rotation.x;
+	Lane(rotations[1], slot) = rotation.y;
+	Lane(rotations[2], slot) = rotation.z;
+	Lane(rotations[3], slot) = rotation.w;
+	Lane(scales[0], slot) = scale.x;
+	Lane(scales[1], slot) = scale.y;
+	Lane(scales[2], slot) = scale.z;
+}
+
+// Sm[h̍svZ
+void NodeHierarchy::Evaluate(const DirectX::XMFLOAT4X4& worldTransform)
+{
+	// [hs͑Sm[hʂȂ̂ŊeS[ɕĂ
+	DirectX::XMVECTOR World[AffineComponentCount];
+	for (int row = 0; row < 4; ++row)
+	{
+		for (int column = 0; column < 3; ++column)
+		{
+			World[row * 3 + column] = DirectX::XMVectorReplicate(worldTransform.m[row][column]);
+		}
+	}
+
+	const DirectX::XMVECTOR One = DirectX::XMVectorSplatOne();
+	for (int group = 0; group < groupCount; ++group)
+	{
+		// ]sZoiXMMatrixRotationQuaternionƓSm[h܂Ƃ߂ČvZj
+		DirectX::XMVECTOR QX = rotations[0][group];
+		DirectX::XMVECTOR QY = rotations[1][group];
+		DirectX::XMVECTOR QZ = rotations[2][group];
+		DirectX::XMVECTOR QW = rotations[3][group];
+		DirectX::XMVECTOR X2 = DirectX::XMVectorAdd(QX, QX);
+		DirectX::XMVECTOR Y2 = DirectX::XMVectorAdd(QY, QY);
+		DirectX::XMVECTOR Z2 = DirectX::XMVectorAdd(QZ, QZ);
+		DirectX::XMVECTOR XX = DirectX::XMVectorMultiply(QX, X2);
+		DirectX::XMVECTOR YY = DirectX::XMVectorMultiply(QY, Y2);
+		DirectX::XMVECTOR ZZ = DirectX::XMVectorMultiply(QZ, Z2);
+		DirectX::XMVECTOR XY = DirectX::XMVectorMultiply(QX, Y2);
+		DirectX::XMVECTOR XZ = DirectX::XMVectorMultiply(QX, Z2);
+		DirectX::XMVECTOR YZ = DirectX::XMVectorMultiply(QY, Z2);
+		DirectX::XMVECTOR WX = DirectX::XMVectorMultiply(QW, X2);
+		DirectX::XMVECTOR WY = DirectX::XMVectorMultiply(QW, Y2);
+		DirectX::XMVECTOR WZ = DirectX::XMVectorMultiply(QW, Z2);
+
+		// [JsZoiS * R * Tj
+		DirectX::XMVECTOR SX = scales[0][group];
+		DirectX::XMVECTOR SY = scales[1][group];
+		DirectX::XMVECTOR SZ = scales[2][group];
+		DirectX::XMVECTOR Local[AffineComponentCount];
+		Local[0] = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(One, DirectX::XMVectorAdd(YY, ZZ)), SX);
+		Local[1] = DirectX::XMVectorMultiply(DirectX::XMVectorAdd(XY, WZ), SX);
+		Local[2] = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(XZ, WY), SX);
+		Local[3] = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(XY, WZ), SY);
+		Local[4] = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(One, DirectX::XMVectorAdd(XX, ZZ)), SY);
+		Local[5] = DirectX::XMVectorMultiply(DirectX::XMVectorAdd(YZ, WX), SY);
+		Local[6] = DirectX::XMVectorMultiply(DirectX::XMVectorAdd(XZ, WY), SZ);
+		Local[7] = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(YZ, WX), SZ);
+		Local[8] = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(One, DirectX::XMVectorAdd(XX, YY)), SZ);
+		Local[9] = positions[0][group];
+		Local[10] = positions[1][group];
+		Local[11] = positions[2][group];
+
+		// ẽO[osW߂ie͑ÕO[vŌvZς݁j
+		const int* parents = &parentSlots[group * LaneCount];
+		DirectX::XMVECTOR Parent[AffineComponentCount];
+		for (int component = 0; component < AffineComponentCount; ++component)
+		{
+			const Stream& stream = globalTransforms[component];
+			Parent[component] = DirectX::XMVectorSet(
+				Lane(stream, parents[0]), Lane(stream, parents[1]),
+				Lane(stream, parents[2]), Lane(stream, parents[3]));
+		}
+
+		// O[osA[hsZo
+		DirectX::XMVECTOR Global[AffineComponentCount];
+		DirectX::XMVECTOR WorldTransform[AffineComponentCount];
+		MultiplyAffine(Local, Parent, Global);
+		MultiplyAffine(Global, World, WorldTransform);
+
+		// vZʂi[
+		for (int component = 0; component < AffineComponentCount; ++component)
+		{
+			localTransforms[component][group] = Local[component];
+			globalTransforms[component][group] = Global[component];
+			worldTransforms[component][group] = WorldTransform[component];
+		}
+	}
+}
+
+// [Js擾
+void NodeHierarchy::GetLocalTransform(int nodeIndex, DirectX::XMFLOAT4X4& transform) const
+{
+	GetTransform(localTransforms, nodeIndex, transform);
+}
+
+// O[os擾
+void NodeHierarchy::GetGlobalTransform(int nodeIndex, DirectX::XMFLOAT4X4& transform) const
+{
+	GetTransform(globalTransforms, nodeIndex, transform);
+}
+
+// [hs擾
+void NodeHierarchy::GetWorldTransform(int nodeIndex, DirectX::XMFLOAT4X4& transform) const
+{
+	GetTransform(worldTransforms, nodeIndex, transform);
+}
+
+// z񂩂4x4so
+void NodeHierarchy::GetTransform(const Stream streams[AffineComponentCount], int nodeIndex, DirectX::XMFLOAT4X4& transform) const
+{
+	int slot = nodeSlots[nodeIndex];
+	for (int row = 0; row < 4; ++row)
+	{
+		transform.m[row][0] = Lane(streams[row * 3 + 0], slot);
+		transform.m[row][1] = Lane(streams[row * 3 + 1], slot);
+		transform.m[row][2] = Lane(streams[row * 3 + 2], slot);
+		transform.m[row][3] = row == 3 ? 1.0f : 0.0f;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "ModelResource.h"
+
+// m[hKwipƍs𐬕̔zŕێASm[hSIMDōsvZj
+class NodeHierarchy
+{
+public:
+	static const int LaneCount = 4;		// XMVECTORPœɌvZm[h
+
+	NodeHierarchy(const std::vector<ModelResource::Node>& nodes);
+	~NodeHierarchy() = default;
+
+	// m[h擾
+	int GetNodeCount() const { return static_cast<int>(nodeSlots.size()); }
+
+	// Xbg擾iO[vE𑵂邽߂̋󂫃Xbg܂ށj
+	int GetSlotCount() const { return groupCount * LaneCount; }
+
+	// pݒ
+	void SetPose(int nodeIndex, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& rotation, const DirectX::XMFLOAT3& scale);
+
+	// Sm[h̍svZ
+	void Evaluate(const DirectX::XMFLOAT4X4& worldTransform);
+
+	// [Js擾
+	void GetLocalTransform(int nodeIndex, DirectX::XMFLOAT4X4& transform) const;
+
+	// O[os擾
+	void GetGlobalTransform(int nodeIndex, DirectX::XMFLOAT4X4& transform) const;
+
+	// [hs擾
+	void GetWorldTransform(int nodeIndex, DirectX::XMFLOAT4X4& transform) const;
+
+private:
+	// zivfPSm[h̓j
+	using Stream = std::vector<DirectX::XMVECTOR>;
+
+	// AtBs̐is̑SSsRj
+	static const int AffineComponentCount = 12;
+
+	// z̎wXbg̒lQ
+	static float& Lane(Stream& stream, int slot) { return reinterpret_cast<float*>(stream.data())[slot]; }
+	static float Lane(const Stream& stream, int slot) { return reinterpret_cast<const float*>(stream.data())[slot]; }
+
+	// z񂩂4x4so
+	void GetTransform(const Stream streams[AffineComponentCount], int nodeIndex, DirectX::XMFLOAT4X4& transform) const;
+
+private:
+	std::vector<int>	nodeSlots;		// m[hCfbNXXbg
+	std::vector<int>	parentSlots;	// XbgẽXbgi[gƋ󂫂͒Pʍs̃Xbgj
+	int					groupCount = 0;
+	int					identitySlot = 0;
+
+	// p
+	Stream				positions[3];
+	Stream				rotations[4];
+	Stream				scales[3];
+
+	// s
+	Stream				localTransforms[AffineComponentCount];
+	Stream				globalTransforms[AffineComponentCount];		// ̃O[v͒Pʍs
+	Stream				worldTransforms[AffineComponentCount];
+};
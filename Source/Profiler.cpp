@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <fstream>
+#include <windows.h>
+#include <imgui.h>
+#include "Profiler.h"
+
+std::atomic<bool> Profiler::enabled{ true };
+
+// RXgN^
+Profiler::Profiler()
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ticksPerSecond = frequency.QuadPart;
+	frameBeginTicks = GetTicks();
+}
+
+// ݎ擾
+int64_t Profiler::GetTicks()
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return counter.QuadPart;
+}
+
+// s̃Xbh̋L^obt@擾
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+	thread_local ThreadBuffer* threadBuffer = nullptr;
+	if (threadBuffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<ThreadBuffer>& buffer = threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+		buffer->name = "Thread " + std::to_string(threadBuffers.size() - 1);
+		buffer->events.resize(EventCapacity);
+		threadBuffer = buffer.get();
+	}
+	return threadBuffer;
+}
+
+// s̃Xbhݒ
+void Profiler::SetThreadName(const char* name)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(mutex);
+	buffer->name = name;
+}
+
+// ԊJn
+int64_t Profiler::BeginScope()
+{
+	GetThreadBuffer()->depth++;
+	return GetTicks();
+}
+
+// ԏI
+void Profiler::EndScope(const char* name, int64_t beginTicks)
+{
+	int64_t endTicks = GetTicks();
+	ThreadBuffer* buffer = GetThreadBuffer();
+	buffer->depth--;
+
+	// ł瑍i߂iǂݍݑ͑܂łQƂj
+	uint64_t count = buffer->count.load(std::memory_order_relaxed);
+	Event& event = buffer->events[count % EventCapacity];
+	event.name = name;
+	event.beginTicks = beginTicks;
+	event.endTicks = endTicks;
+	event.depth = buffer->depth;
+	buffer->count.store(count + 1, std::memory_order_release);
+}
+
+// t[Jn
+void Profiler::BeginFrame()
+{
+	int64_t ticks = GetTicks();
+	if (!paused && IsEnabled())
+	{
+		// Ot[̊ԂɏIԂW߂
+		// ̃Xbhݒ̗vfǂމ\͂邪AقǗ܂ȂɂȂȂ
+		std::lock_guard<std::mutex> lock(mutex);
+		snapshot.beginTicks = frameBeginTicks;
+		snapshot.endTicks = ticks;
+		snapshot.threadNames.resize(threadBuffers.size());
+		snapshot.threadEvents.resize(threadBuffers.size());
+		for (size_t i = 0; i < threadBuffers.size(); ++i)
+		{
+			const ThreadBuffer& buffer = *threadBuffers[i];
+			std::vector<Event>& events = snapshot.threadEvents[i];
+			snapshot.threadNames[i] = buffer.name;
+			events.clear();
+
+			// VkAt[JnOɏIԂőł؂
+			uint64_t count = buffer.count.load(std::memory_order_acquire);
+			uint64_t first = count > EventCapacity ? count - EventCapacity : 0;
+			for (uint64_t index = count; index > first; --index)
+			{
+				const Event& event = buffer.events[(index - 1) % EventCapacity];
+				if (event.endTicks < frameBeginTicks) break;
+				if (event.endTicks <= ticks)
+				{
+					events.emplace_back(event);
+				}
+			}
+			std::reverse(events.begin(), events.end());
+		}
+	}
+	frameBeginTicks = ticks;
+}
+
+// ^CCGUI`
+void Profiler::DrawGUI()
+{
+	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
+	ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + displaySize.y - 260), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(displaySize.x - 240, 250), ImGuiCond_Once);
+	ImGui::SetNextWindowCollapsed(true, ImGuiCond_Once);
+
+	if (ImGui::Begin(u8"vt@C"))
+	{
+		bool enable = IsEnabled();
+		if (ImGui::Checkbox(u8"L", &enable))
+		{
+			SetEnabled(enable);
+		}
+		ImGui::SameLine();
+		ImGui::Checkbox(u8"ꎞ~", &paused);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(120);
+		ImGui::SliderFloat("px/ms", &pixelsPerMillisecond, 5.0f, 400.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+		ImGui::SameLine();
+		if (ImGui::Button(u8"Chromeg[Xo"))
+		{
+			const char* filename = "Profile.json";
+			exportMessage = ExportChromeTrace(filename) ? std::string("Saved ") + filename : std::string("Failed ") + filename;
+		}
+		if (!exportMessage.empty())
+		{
+			ImGui::SameLine();
+			ImGui::Text("%s", exportMessage.c_str());
+		}
+
+		const double millisecondsPerTick = 1000.0 / static_cast<double>(ticksPerSecond);
+		ImGui::Text("Frame : %.3f ms", (snapshot.endTicks - snapshot.beginTicks) * millisecondsPerTick);
+
+		// XbhɋԂ[̒iɕׂĕ`悷
+		ImGui::BeginChild("Timeline", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+		const float labelWidth = 90.0f;
+		const float frameWidth = static_cast<float>((snapshot.endTicks - snapshot.beginTicks) * millisecondsPerTick) * pixelsPerMillisecond;
+		for (size_t threadIndex = 0; threadIndex < snapshot.threadEvents.size(); ++threadIndex)
+		{
+			const std::vector<Event>& events = snapshot.threadEvents[threadIndex];
+			if (events.empty()) continue;
+
+			int maxDepth = 0;
+			for (const Event& event : events)
+			{
+				maxDepth = (std::max)(maxDepth, event.depth);
+			}
+
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			drawList->AddText(origin, IM_COL32(255, 255, 255, 255), snapshot.threadNames[threadIndex].c_str());
+			for (const Event& event : events)
+			{
+				float x0 = origin.x + labelWidth + static_cast<float>((event.beginTicks - snapshot.beginTicks) * millisecondsPerTick) * pixelsPerMillisecond;
+				float x1 = origin.x + labelWidth + static_cast<float>((event.endTicks - snapshot.beginTicks) * millisecondsPerTick) * pixelsPerMillisecond;
+				float y0 = origin.y + event.depth * rowHeight;
+				float y1 = y0 + rowHeight - 1.0f;
+				x1 = (std::max)(x1, x0 + 1.0f);
+
+				// OF߂
+				ImU32 hash = 2166136261u;
+				for (const char* c = event.name; *c != '\0'; ++c)
+				{
+					hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+				}
+				ImU32 color = IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 8) & 0x7F), 80 + ((hash >> 16) & 0x7F), 255);
+				drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), color);
+				if (x1 - x0 > 20.0f)
+				{
+					ImVec4 clipRect(x0, y0, x1, y1);
+					drawList->AddText(nullptr, 0.0f, ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name, nullptr, 0.0f, &clipRect);
+				}
+				if (ImGui::IsMouseHoveringRect(ImVec2(x0, y0), ImVec2(x1, y1)))
+				{
+					ImGui::SetTooltip("%s\n%.3f ms", event.name, (event.endTicks - event.beginTicks) * millisecondsPerTick);
+				}
+			}
+			ImGui::Dummy(ImVec2(labelWidth + frameWidth, (maxDepth + 1) * rowHeight + 4.0f));
+		}
+		ImGui::EndChild();
+	}
+	ImGui::End();
+}
+
+// Chromeg[X`ŏo
+bool Profiler::ExportChromeTrace(const char* filename) const
+{
+	std::ofstream stream(filename);
+	if (!stream) return false;
+
+	// JSONƂďo
+	auto writeString = [&stream](const char* text)
+	{
+		stream << '"';
+		for (const char* c = text; *c != '\0'; ++c)
+		{
+			if (*c == '"' || *c == '\\') stream << '\\';
+			stream << *c;
+		}
+		stream << '"';
+	};
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// SXbhōłÂԂ̊ɂ
+	int64_t baseTicks = INT64_MAX;
+	for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+	{
+		uint64_t count = buffer->count.load(std::memory_order_acquire);
+		uint64_t first = count > EventCapacity ? count - EventCapacity : 0;
+		for (uint64_t index = first; index < count; ++index)
+		{
+			baseTicks = (std::min)(baseTicks, buffer->events[index % EventCapacity].beginTicks);
+		}
+	}
+
+	const double microsecondsPerTick = 1000000.0 / static_cast<double>(ticksPerSecond);
+	stream << "{\"traceEvents\":[\n";
+	bool first = true;
+	for (size_t threadIndex = 0; threadIndex < threadBuffers.size(); ++threadIndex)
+	{
+		const ThreadBuffer& buffer = *threadBuffers[threadIndex];
+
+		// Xbh
+		stream << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << threadIndex << ",\"args\":{\"name\":";
+		writeString(buffer.name.c_str());
+		stream << "}}";
+		first = false;
+
+		// ԁiCxgj
+		uint64_t count = buffer.count.load(std::memory_order_acquire);
+		uint64_t begin = count > EventCapacity ? count - EventCapacity : 0;
+		for (uint64_t index = begin; index < count; ++index)
+		{
+			const Event& event = buffer.events[index % EventCapacity];
+			stream << ",\n{\"ph\":\"X\",\"name\":";
+			writeString(event.name);
+			stream << ",\"pid\":0,\"tid\":" << threadIndex
+				<< ",\"ts\":" << (event.beginTicks - baseTicks) * microsecondsPerTick
+				<< ",\"dur\":" << (event.endTicks - event.beginTicks) * microsecondsPerTick << "}";
+		}
+	}
+	stream << "\n]}\n";
+	return stream.good();
+}
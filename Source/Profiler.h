@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ԌviXR[v𔲂܂łPԂƂċL^Aqɂłj
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+// CPUvt@CiXbh̃Oobt@ɌvԂL^j
+class Profiler
+{
+private:
+	Profiler();
+	~Profiler() = default;
+
+public:
+	// v
+	struct Event
+	{
+		const char*		name = nullptr;		// 񃊃eȂǎ̒
+		int64_t			beginTicks = 0;
+		int64_t			endTicks = 0;
+		int				depth = 0;
+	};
+
+	// ԌvIuWFNgi̓tOPǂނj
+	class Scope
+	{
+	public:
+		explicit Scope(const char* name)
+		{
+			if (Profiler::enabled.load(std::memory_order_relaxed))
+			{
+				this->name = name;
+				beginTicks = Profiler::Instance().BeginScope();
+			}
+		}
+		~Scope()
+		{
+			if (name != nullptr)
+			{
+				Profiler::Instance().EndScope(name, beginTicks);
+			}
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const char*		name = nullptr;
+		int64_t			beginTicks = 0;
+	};
+
+	// CX^X擾
+	static Profiler& Instance()
+	{
+		static Profiler instance;
+		return instance;
+	}
+
+	// Lݒ
+	void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+	// L
+	bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	// t[JniOt[̋Ԃ^CC\pɊm肷j
+	void BeginFrame();
+
+	// s̃Xbhݒ
+	void SetThreadName(const char* name);
+
+	// ^CCGUI`
+	void DrawGUI();
+
+	// Chromeg[X`ichrome://tracingAPerfettojŏo
+	bool ExportChromeTrace(const char* filename) const;
+
+private:
+	static const int EventCapacity = 16384;		// XbhɕێԐ
+
+	// Xbh̋L^obt@i݂͏LXbĥ݁j
+	struct ThreadBuffer
+	{
+		std::string				name;
+		std::vector<Event>		events;
+		std::atomic<uint64_t>	count{ 0 };		// 񂾑iOobt@̈ʒucount % EventCapacityj
+		int						depth = 0;
+	};
+
+	// ^CC\pɊm肵t[
+	struct FrameSnapshot
+	{
+		int64_t							beginTicks = 0;
+		int64_t							endTicks = 0;
+		std::vector<std::string>		threadNames;
+		std::vector<std::vector<Event>>	threadEvents;
+	};
+
+	// ԊJn
+	int64_t BeginScope();
+
+	// ԏI
+	void EndScope(const char* name, int64_t beginTicks);
+
+	// s̃Xbh̋L^obt@擾
+	ThreadBuffer* GetThreadBuffer();
+
+	// ݎ擾
+	static int64_t GetTicks();
+
+private:
+	static std::atomic<bool>					enabled;
+
+	mutable std::mutex							mutex;
+	std::vector<std::unique_ptr<ThreadBuffer>>	threadBuffers;		// XbhIjȂ
+	int64_t										ticksPerSecond = 1;
+	int64_t										frameBeginTicks = 0;
+	FrameSnapshot								snapshot;
+	bool										paused = false;
+	float										pixelsPerMillisecond = 40.0f;
+	std::string									exportMessage;
+};
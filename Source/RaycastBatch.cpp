@@ -0,0 +1,77 @@
+#include <algorithm>
+#include "Misc.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "RaycastBatch.h"
+
+// CS폜
+void RaycastBatch::Clear()
+{
+	starts.clear();
+	ends.clear();
+	hits.clear();
+	results.clear();
+}
+
+// Co^
+int RaycastBatch::AddRay(const DirectX::XMFLOAT3& start, const DirectX::XMFLOAT3& end)
+{
+	starts.emplace_back(start);
+	ends.emplace_back(end);
+	hits.emplace_back();
+	results.emplace_back(0);
+	return static_cast<int>(starts.size()) - 1;
+}
+
+// ʐݒ
+void RaycastBatch::SetHit(int index, const HitResult* hit)
+{
+	results.at(index) = hit != nullptr ? 1 : 0;
+	if (hit != nullptr)
+	{
+		hits.at(index) = *hit;
+	}
+}
+
+// o^CSĔ肷
+void RaycastBatch::Execute(const StaticCollisionMesh& collisionMesh, Mode mode)
+{
+	PROFILE_FUNCTION();
+
+	ExecutePackets(collisionMesh, mode);
+}
+
+// o^CSĔ肷
+void RaycastBatch::Execute(const TriangleBVH& bvh, Mode mode)
+{
+	PROFILE_FUNCTION();
+
+	ExecutePackets(bvh, mode);
+}
+
+// o^CS{̃pPbgɕĔ肷
+template<class Target>
+void RaycastBatch::ExecutePackets(const Target& target, Mode mode)
+{
+	const int rayCount = GetRayCount();
+	const int packetSize = TriangleBlocks::BlockSize;
+	const int packetCount = (rayCount + packetSize - 1) / packetSize;
+	const bool anyHit = mode == Mode::Any;
+
+	// pPbgɏޔ͈͂Ă̂ł̂܂ܕɔł
+	JobSystem::Instance().ParallelFor(packetCount, grainSize, [&](int begin, int end)
+	{
+		for (int packetIndex = begin; packetIndex < end; ++packetIndex)
+		{
+			int first = packetIndex * packetSize;
+			int count = (std::min)(packetSize, rayCount - first);
+
+			bool packetResults[TriangleBlocks::BlockSize];
+			target.RayCastPacket(&starts[first], &ends[first], count, &hits[first], packetResults, anyHit);
+			for (int i = 0; i < count; ++i)
+			{
+				results[first + i] = packetResults[i] ? 1 : 0;
+			}
+		}
+	});
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "StaticCollisionMesh.h"
+
+// CLXgob`ĩC܂Ƃ߂ēo^AS{̃pPbgňxɔ肷j
+// ߂ʒu瓯ɔ΂C͑ēo^ƃpPbgőLł
+class RaycastBatch
+{
+public:
+	using HitResult = StaticCollisionMesh::HitResult;
+
+	// 胂[h
+	enum class Mode
+	{
+		Closest,	// ł߂_߂
+		Any,		// ̗L߂iȂǁj
+	};
+
+	RaycastBatch() = default;
+	~RaycastBatch() = default;
+
+	// CS폜ï͍ėpj
+	void Clear();
+
+	// Co^i߂l̃CfbNXŌʂQƂj
+	int AddRay(const DirectX::XMFLOAT3& start, const DirectX::XMFLOAT3& end);
+
+	// o^CSĔ肷ipPbggrainSize𒴂ꍇ̓WuVXeŕj
+	void Execute(const StaticCollisionMesh& collisionMesh, Mode mode = Mode::Closest);
+	void Execute(const TriangleBVH& bvh, Mode mode = Mode::Closest);
+
+	// C擾
+	int GetRayCount() const { return static_cast<int>(starts.size()); }
+
+	// C擾
+	const DirectX::XMFLOAT3& GetRayStart(int index) const { return starts.at(index); }
+	const DirectX::XMFLOAT3& GetRayEnd(int index) const { return ends.at(index); }
+
+	// ʎ擾
+	bool IsHit(int index) const { return results.at(index) != 0; }
+	const HitResult& GetHit(int index) const { return hits.at(index); }
+
+	// ʐݒi̕@Ŕ肵ʂi[ꍇAȂꍇnullptrj
+	void SetHit(int index, const HitResult* hit);
+
+	// PWuŏpPbg
+	void SetGrainSize(int grainSize) { this->grainSize = grainSize; }
+
+private:
+	// o^CS{̃pPbgɕĔ肷itargetRayCastPacketΏہj
+	template<class Target>
+	void ExecutePackets(const Target& target, Mode mode);
+
+private:
+	std::vector<DirectX::XMFLOAT3>	starts;
+	std::vector<DirectX::XMFLOAT3>	ends;
+	std::vector<HitResult>			hits;
+	std::vector<char>				results;		// vector<bool>̓Xbhɕʗvf֏߂ȂcharŎ
+	int								grainSize = 16;
+};
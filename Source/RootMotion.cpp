@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cmath>
+#include "Misc.h"
+#include "RootMotion.h"
+
+// RXgN^
+RootMotion::RootMotion(const Model* model, int rootMotionNodeIndex,
+	bool bakeTranslationX, bool bakeTranslationY, bool bakeTranslationZ, float sampleRate)
+	: rootMotionNodeIndex(rootMotionNodeIndex)
+	, sampleRate(sampleRate)
+{
+	_ASSERT_EXPR_A(rootMotionNodeIndex >= 0, "root motion node not found");
+
+	// ẽO[osi[g[Vm[h̑c̓Aj[VȂOŏp狁߂j
+	const std::vector<ModelResource::Node>& resourceNodes = model->GetResource()->GetNodes();
+	DirectX::XMMATRIX ParentGlobalTransform = DirectX::XMMatrixIdentity();
+	for (int nodeIndex = resourceNodes.at(rootMotionNodeIndex).parentIndex; nodeIndex >= 0; nodeIndex = resourceNodes.at(nodeIndex).parentIndex)
+	{
+		const ModelResource::Node& node = resourceNodes.at(nodeIndex);
+		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
+		DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
+		DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
+		ParentGlobalTransform = ParentGlobalTransform * S * R * T;
+	}
+	DirectX::XMMATRIX InverseParentGlobalTransform = DirectX::XMMatrixInverse(nullptr, ParentGlobalTransform);
+
+	// ړʂɎgƃm[h̎pɎc
+	const bool bake = bakeTranslationX || bakeTranslationY || bakeTranslationZ;
+	DirectX::XMVECTOR BakeMask = DirectX::XMVectorSelectControl(bakeTranslationX, bakeTranslationY, bakeTranslationZ, 0);
+
+	const std::vector<Model::Animation>& animations = model->GetAnimations();
+	curves.resize(animations.size());
+	for (size_t animationIndex = 0; animationIndex < animations.size(); ++animationIndex)
+	{
+		const Model::Animation& animation = animations.at(animationIndex);
+		Curve& curve = curves.at(animationIndex);
+		curve.secondsLength = animation.secondsLength;
+
+		// ̎Ԃ܂ނ悤ɋϓTvOiJ[\ŏɌvZj
+		const int sampleCount = (std::max)(2, static_cast<int>(std::ceil(animation.secondsLength * sampleRate)) + 1);
+		curve.translations.resize(sampleCount);
+		curve.nodePositions.resize(sampleCount);
+
+		Model::NodePose pose;
+		pose.position = resourceNodes.at(rootMotionNodeIndex).position;
+		Model::NodeAnimCursor cursor;
+		DirectX::XMVECTOR BeginPosition = DirectX::XMVectorZero();
+		DirectX::XMVECTOR BeginGlobalPosition = DirectX::XMVectorZero();
+		for (int sample = 0; sample < sampleCount; ++sample)
+		{
+			float seconds = (std::min)(sample / sampleRate, animation.secondsLength);
+			model->ComputeAnimation(static_cast<int>(animationIndex), rootMotionNodeIndex, seconds, pose, cursor);
+
+			DirectX::XMVECTOR LocalPosition = DirectX::XMLoadFloat3(&pose.position);
+			DirectX::XMVECTOR GlobalPosition = DirectX::XMVector3Transform(LocalPosition, ParentGlobalTransform);
+			if (sample == 0)
+			{
+				BeginPosition = LocalPosition;
+				BeginGlobalPosition = GlobalPosition;
+			}
+
+			// 擪̈ړʁi0j
+			DirectX::XMVECTOR Translation = DirectX::XMVectorSubtract(GlobalPosition, BeginGlobalPosition);
+			Translation = DirectX::XMVectorSelect(Translation, DirectX::XMVectorZero(), BakeMask);
+			DirectX::XMStoreFloat3(&curve.translations[sample], Translation);
+
+			// m[ḧʒuiȂΐ擪̈ʒuɌŒ肵AΔ̐cj
+			DirectX::XMVECTOR NodePosition = BeginPosition;
+			if (bake)
+			{
+				GlobalPosition = DirectX::XMVectorSelect(DirectX::XMVectorZero(), GlobalPosition, BakeMask);
+				NodePosition = DirectX::XMVector3Transform(GlobalPosition, InverseParentGlobalTransform);
+			}
+			DirectX::XMStoreFloat3(&curve.nodePositions[sample], NodePosition);
+		}
+	}
+}
+
+// [g[VvZ
+void RootMotion::Compute(int animationIndex, float oldSeconds, float newSeconds,
+	DirectX::XMFLOAT3& translation, DirectX::XMFLOAT3& rootMotionNodePosition) const
+{
+	const Curve& curve = curves.at(animationIndex);
+
+	// ݐσJ[u̍i[v͖܂łƐ擪𑫂j
+	DirectX::XMVECTOR Old = Sample(curve.translations, curve.secondsLength, oldSeconds);
+	DirectX::XMVECTOR New = Sample(curve.translations, curve.secondsLength, newSeconds);
+	DirectX::XMVECTOR Translation = DirectX::XMVectorSubtract(New, Old);
+	if (oldSeconds > newSeconds)
+	{
+		DirectX::XMVECTOR End = DirectX::XMLoadFloat3(&curve.translations.back());
+		Translation = DirectX::XMVectorAdd(Translation, End);
+	}
+	DirectX::XMStoreFloat3(&translation, Translation);
+	DirectX::XMStoreFloat3(&rootMotionNodePosition, Sample(curve.nodePositions, curve.secondsLength, newSeconds));
+}
+
+// ϓTvOJ[u̕
+DirectX::XMVECTOR RootMotion::Sample(const std::vector<DirectX::XMFLOAT3>& samples, float secondsLength, float seconds) const
+{
+	seconds = std::clamp(seconds, 0.0f, secondsLength);
+
+	const int lastIndex = static_cast<int>(samples.size()) - 1;
+	const int index = (std::min)(static_cast<int>(seconds * sampleRate), lastIndex - 1);
+
+	// ̋Ԃ̓TvOԊuZꍇ
+	const float seconds0 = index / sampleRate;
+	const float seconds1 = (std::min)((index + 1) / sampleRate, secondsLength);
+	const float rate = seconds1 > seconds0 ? (seconds - seconds0) / (seconds1 - seconds0) : 0.0f;
+
+	DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&samples[index]);
+	DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&samples[index + 1]);
+	return DirectX::XMVectorLerp(V0, V1, rate);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "Model.h"
+
+// [g[ViNbvɃ[g[Vm[ḧړʂϓTvOݐσJ[uOvZj
+class RootMotion
+{
+public:
+	// bakeTranslation͈ړʂ甲ăm[h̎pɎci[g[Vm[h̐ẽO[oԁj
+	RootMotion(const Model* model, int rootMotionNodeIndex,
+		bool bakeTranslationX, bool bakeTranslationY, bool bakeTranslationZ, float sampleRate = 60);
+	~RootMotion() = default;
+
+	// [g[Vm[hԍ擾
+	int GetRootMotionNodeIndex() const { return rootMotionNodeIndex; }
+
+	// [g[VvZioldSecondsnewSeconds܂ł̈ړʂƁAړʂ𔲂m[h̃[Jʒu߂j
+	// newSecondsoldSecondsȌꍇ̓[vƂ݂Ȃ
+	void Compute(int animationIndex, float oldSeconds, float newSeconds,
+		DirectX::XMFLOAT3& translation, DirectX::XMFLOAT3& rootMotionNodePosition) const;
+
+private:
+	struct Curve
+	{
+		float							secondsLength = 0;
+		std::vector<DirectX::XMFLOAT3>	translations;		// 擪̗ݐψړʁiẽO[oԁA0j
+		std::vector<DirectX::XMFLOAT3>	nodePositions;		// ړʂ𔲂m[h̃[Jʒu
+	};
+
+	// ϓTvOJ[u̕
+	DirectX::XMVECTOR Sample(const std::vector<DirectX::XMFLOAT3>& samples, float secondsLength, float seconds) const;
+
+private:
+	std::vector<Curve>					curves;
+	int									rootMotionNodeIndex = -1;
+	float								sampleRate = 60;
+};
@@ -0,0 +1,585 @@
+#include <algorithm>
+#include <cstring>
+#include <imgui.h>
+#include "Graphics.h"
+#include "Misc.h"
+#include "NodeHierarchy.h"
+#include "Scene/AnimationBenchmarkScene.h"
+
+// RXgN^
+AnimationBenchmarkScene::AnimationBenchmarkScene()
+{
+	ID3D11Device* device = Graphics::Instance().GetDevice();
+	float screenWidth = Graphics::Instance().GetScreenWidth();
+	float screenHeight = Graphics::Instance().GetScreenHeight();
+
+	// Jݒ
+	camera.SetPerspectiveFov(
+		DirectX::XMConvertToRadians(45),	// p
+		screenWidth / screenHeight,			// ʃAXyNg
+		0.1f,								// jANbv
+		1000.0f								// t@[Nbv
+	);
+	camera.SetLookAt(
+		{ 3, 2, 3 },		// _
+		{ 0, 1, 0 },		// _
+		{ 0, 1, 0 }			// xNg
+	);
+	cameraController.SyncCameraToController(camera);
+
+	// fǂݍ
+	character = std::make_shared<Model>(device, "Data/Model/RPG-Character/RPG-Character.glb");
+	character->GetNodePoses(nodePoses);
+}
+
+// XV
+void AnimationBenchmarkScene::Update(float elapsedTime)
+{
+	// JXV
+	cameraController.Update();
+	cameraController.SyncControllerToCamera(camera);
+
+	// w莞Ԃ̃Aj[V̎p擾
+	character->ComputeAnimation(animationIndex, animationSeconds, nodePoses, animationCursor);
+
+	// Aj[VԍXV
+	const Model::Animation& animation = character->GetAnimations().at(animationIndex);
+	animationSeconds += elapsedTime;
+	if (animationSeconds > animation.secondsLength)
+	{
+		animationSeconds -= animation.secondsLength;
+	}
+
+	// pXV
+	character->SetNodePoses(nodePoses);
+
+	// LN^[gXtH[XV
+	DirectX::XMFLOAT4X4 worldTransform;
+	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
+	character->UpdateTransform(worldTransform);
+}
+
+// `揈
+void AnimationBenchmarkScene::Render(float elapsedTime)
+{
+	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
+	RenderState* renderState = Graphics::Instance().GetRenderState();
+	PrimitiveRenderer* primitiveRenderer = Graphics::Instance().GetPrimitiveRenderer();
+	ModelRenderer* modelRenderer = Graphics::Instance().GetModelRenderer();
+
+	// _[Xe[gݒ
+	dc->OMSetBlendState(renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
+	dc->OMSetDepthStencilState(renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
+	dc->RSSetState(renderState->GetRasterizerState(RasterizerState::SolidCullNone));
+
+	// Obh`
+	primitiveRenderer->DrawGrid(20, 1);
+	primitiveRenderer->Render(dc, camera.GetView(), camera.GetProjection(), D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+
+	// `ReLXgݒ
+	RenderContext rc;
+	rc.deviceContext = dc;
+	rc.renderState = renderState;
+	rc.camera = &camera;
+
+	// f`
+	modelRenderer->Draw(ShaderId::Basic, character);
+	modelRenderer->Render(rc);
+}
+
+// GUI`揈
+void AnimationBenchmarkScene::DrawGUI()
+{
+	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
+	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + 10), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(420, 500), ImGuiCond_Once);
+
+	if (ImGui::Begin(u8"Aj[Vx`}[N"))
+	{
+		// ĐAj[VI
+		const std::vector<Model::Animation>& animations = character->GetAnimations();
+		if (ImGui::BeginCombo("Animation", animations.at(animationIndex).name.c_str()))
+		{
+			for (int i = 0; i < static_cast<int>(animations.size()); ++i)
+			{
+				if (ImGui::Selectable(animations.at(i).name.c_str(), i == animationIndex))
+				{
+					animationIndex = i;
+					animationSeconds = 0;
+				}
+			}
+			ImGui::EndCombo();
+		}
+
+		// ĐɗʎqAj[Vg
+		bool compressed = character->IsCompressedAnimationEnabled();
+		if (ImGui::Checkbox(u8"ʎqAj[V", &compressed))
+		{
+			character->SetCompressedAnimationEnabled(compressed);
+		}
+
+		if (ImGui::CollapsingHeader(u8"L[t[", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::InputInt("LoopCount", &benchmarkLoopCount);
+			benchmarkLoopCount = (std::max)(1, benchmarkLoopCount);
+			if (ImGui::Button(u8"v"))
+			{
+				RunKeyframeBenchmark();
+			}
+
+			// ʕ\iPTṽ~bj
+			if (!keyframeBenchmarkResults.empty())
+			{
+				ImGui::Columns(6);
+				ImGui::Text("Clip"); ImGui::NextColumn();
+				ImGui::Text("Keys"); ImGui::NextColumn();
+				ImGui::Text("Linear"); ImGui::NextColumn();
+				ImGui::Text("Binary"); ImGui::NextColumn();
+				ImGui::Text("Cursor"); ImGui::NextColumn();
+				ImGui::Text("Compressed"); ImGui::NextColumn();
+				ImGui::Separator();
+				size_t rawBytes = 0, compressedBytes = 0;
+				for (const KeyframeBenchmarkResult& result : keyframeBenchmarkResults)
+				{
+					ImGui::Text("%s", result.name.c_str()); ImGui::NextColumn();
+					ImGui::Text("%d", result.keyframeCount); ImGui::NextColumn();
+					ImGui::Text("%.4f", result.linearTime); ImGui::NextColumn();
+					ImGui::Text("%.4f", result.binaryTime); ImGui::NextColumn();
+					ImGui::Text("%.4f", result.cursorTime); ImGui::NextColumn();
+					ImGui::Text("%.4f", result.compressedTime); ImGui::NextColumn();
+					rawBytes += result.rawBytes;
+					compressedBytes += result.compressedBytes;
+				}
+				ImGui::Columns(1);
+
+				// Nbṽgp
+				ImGui::Text("Memory : %.1f KB -> %.1f KB (%.1f%%)", rawBytes / 1024.0f, compressedBytes / 1024.0f,
+					rawBytes > 0 ? 100.0f * compressedBytes / rawBytes : 0.0f);
+			}
+		}
+
+		if (ImGui::CollapsingHeader(u8"KwsvZ", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::InputInt("Instances", &hierarchyInstanceCount);
+			ImGui::InputInt("Loops", &hierarchyLoopCount);
+			hierarchyInstanceCount = (std::max)(1, hierarchyInstanceCount);
+			hierarchyLoopCount = (std::max)(1, hierarchyLoopCount);
+			if (ImGui::Button(u8"v##Hierarchy"))
+			{
+				RunHierarchyBenchmark();
+			}
+
+			// ʕ\iPb̕Sm[hj
+			const HierarchyBenchmarkResult& result = hierarchyBenchmarkResult;
+			if (result.nodeCount > 0)
+			{
+				ImGui::Text("Nodes : %d (Slots : %d)", result.nodeCount, result.slotCount);
+				ImGui::Text("Reference       : %.2f Mnodes/s", result.referenceRate);
+				ImGui::Text("UpdateTransform : %.2f Mnodes/s", result.updateTransformRate);
+				ImGui::Text("Evaluate        : %.2f Mnodes/s", result.evaluateRate);
+			}
+		}
+
+		if (ImGui::CollapsingHeader(u8"XLjOpbg", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::InputInt("Loops##Palette", &paletteLoopCount);
+			paletteLoopCount = (std::max)(1, paletteLoopCount);
+			if (ImGui::Button(u8"v##Palette"))
+			{
+				RunPaletteBenchmark();
+			}
+
+			// ʕ\iPt[̃}CNbƓ]ʁj
+			const PaletteBenchmarkResult& result = paletteBenchmarkResult;
+			if (result.meshCount > 0)
+			{
+				ImGui::Text("Meshes : %d (Palette : %d)", result.meshCount, result.paletteCount);
+				ImGui::Text("PerMesh : %.2f us %d bytes", result.perMeshTime, result.perMeshBytes);
+				ImGui::Text("Palette : %.2f us %d bytes", result.paletteTime, result.paletteBytes);
+			}
+		}
+	}
+	ImGui::End();
+}
+
+// L[t[x`}[N
+void AnimationBenchmarkScene::RunKeyframeBenchmark()
+{
+	const float sampleInterval = 1.0f / 60.0f;
+	const std::vector<Model::Animation>& animations = character->GetAnimations();
+
+	keyframeBenchmarkResults.clear();
+	const bool compressed = character->IsCompressedAnimationEnabled();
+	std::vector<Model::NodePose> linearPoses, binaryPoses, cursorPoses;
+	character->GetNodePoses(linearPoses);
+	character->GetNodePoses(binaryPoses);
+	character->GetNodePoses(cursorPoses);
+
+	Benchmark benchmark;
+	for (int index = 0; index < static_cast<int>(animations.size()); ++index)
+	{
+		const Model::Animation& animation = animations.at(index);
+
+		KeyframeBenchmarkResult& result = keyframeBenchmarkResults.emplace_back();
+		result.name = animation.name;
+		result.rawBytes = sizeof(Model::Animation) + sizeof(Model::NodeAnim) * animation.nodeAnims.size();
+		for (const Model::NodeAnim& nodeAnim : animation.nodeAnims)
+		{
+			result.keyframeCount += static_cast<int>(nodeAnim.positionKeyframes.size());
+			result.keyframeCount += static_cast<int>(nodeAnim.rotationKeyframes.size());
+			result.keyframeCount += static_cast<int>(nodeAnim.scaleKeyframes.size());
+			result.rawBytes += sizeof(Model::VectorKeyframe) * (nodeAnim.positionKeyframes.size() + nodeAnim.scaleKeyframes.size());
+			result.rawBytes += sizeof(Model::QuaternionKeyframe) * nodeAnim.rotationKeyframes.size();
+		}
+		result.compressedBytes = character->GetResource()->GetCompressedAnimations().at(index).GetMemorySize();
+
+		// 60HzŐ擪疖܂ōĐƂ̃Tv
+		const int sampleCount = static_cast<int>(animation.secondsLength / sampleInterval) + 1;
+		const float totalSamples = static_cast<float>(sampleCount * benchmarkLoopCount);
+
+		// S
+		benchmark.begin();
+		for (int loop = 0; loop < benchmarkLoopCount; ++loop)
+		{
+			for (int sample = 0; sample < sampleCount; ++sample)
+			{
+				ComputeAnimationLinear(character.get(), index, sample * sampleInterval, linearPoses);
+			}
+		}
+		result.linearTime = benchmark.end() * 1000.0f / totalSamples;
+
+		// 񕪒TĩL[t[j
+		character->SetCompressedAnimationEnabled(false);
+		benchmark.begin();
+		for (int loop = 0; loop < benchmarkLoopCount; ++loop)
+		{
+			for (int sample = 0; sample < sampleCount; ++sample)
+			{
+				character->ComputeAnimation(index, sample * sampleInterval, binaryPoses);
+			}
+		}
+		result.binaryTime = benchmark.end() * 1000.0f / totalSamples;
+
+		// J[\
+		Model::AnimationCursor cursor;
+		benchmark.begin();
+		for (int loop = 0; loop < benchmarkLoopCount; ++loop)
+		{
+			for (int sample = 0; sample < sampleCount; ++sample)
+			{
+				character->ComputeAnimation(index, sample * sampleInterval, cursorPoses, cursor);
+			}
+		}
+		result.cursorTime = benchmark.end() * 1000.0f / totalSamples;
+
+		// ʎq{J[\
+		Model::AnimationCursor compressedCursor;
+		std::vector<Model::NodePose> compressedPoses = cursorPoses;
+		character->SetCompressedAnimationEnabled(true);
+		benchmark.begin();
+		for (int loop = 0; loop < benchmarkLoopCount; ++loop)
+		{
+			for (int sample = 0; sample < sampleCount; ++sample)
+			{
+				character->ComputeAnimation(index, sample * sampleInterval, compressedPoses, compressedCursor);
+			}
+		}
+		result.compressedTime = benchmark.end() * 1000.0f / totalSamples;
+		character->SetCompressedAnimationEnabled(compressed);
+
+#if defined(_DEBUG)
+		// SƓpĂ邩mF
+		character->SetCompressedAnimationEnabled(false);
+		for (int sample = 0; sample < sampleCount; ++sample)
+		{
+			float time = sample * sampleInterval;
+			ComputeAnimationLinear(character.get(), index, time, linearPoses);
+			character->ComputeAnimation(index, time, cursorPoses, cursor);
+			character->SetCompressedAnimationEnabled(true);
+			character->ComputeAnimation(index, time, compressedPoses, compressedCursor);
+			character->SetCompressedAnimationEnabled(false);
+			for (size_t i = 0; i < linearPoses.size(); ++i)
+			{
+				const Model::NodePose& a = linearPoses.at(i);
+				const Model::NodePose& b = cursorPoses.at(i);
+				DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(1.0e-4f);
+				_ASSERT_EXPR(DirectX::XMVector3NearEqual(DirectX::XMLoadFloat3(&a.position), DirectX::XMLoadFloat3(&b.position), Epsilon), L"keyframe cursor position mismatch");
+				_ASSERT_EXPR(DirectX::XMVector4NearEqual(DirectX::XMLoadFloat4(&a.rotation), DirectX::XMLoadFloat4(&b.rotation), Epsilon), L"keyframe cursor rotation mismatch");
+				_ASSERT_EXPR(DirectX::XMVector3NearEqual(DirectX::XMLoadFloat3(&a.scale), DirectX::XMLoadFloat3(&b.scale), Epsilon), L"keyframe cursor scale mismatch");
+
+				// ʎq덷͈̔͂Ɏ܂Ă邩i]͕]Ăꍇj
+				const Model::NodePose& c = compressedPoses.at(i);
+				DirectX::XMVECTOR CompressedEpsilon = DirectX::XMVectorReplicate(1.0e-3f);
+				float dot = DirectX::XMVectorGetX(DirectX::XMVector4Dot(DirectX::XMLoadFloat4(&a.rotation), DirectX::XMLoadFloat4(&c.rotation)));
+				_ASSERT_EXPR(DirectX::XMVector3NearEqual(DirectX::XMLoadFloat3(&a.position), DirectX::XMLoadFloat3(&c.position), CompressedEpsilon), L"compressed animation position mismatch");
+				_ASSERT_EXPR(fabsf(dot) > 1.0f - 1.0e-5f, L"compressed animation rotation mismatch");
+				_ASSERT_EXPR(DirectX::XMVector3NearEqual(DirectX::XMLoadFloat3(&a.scale), DirectX::XMLoadFloat3(&c.scale), CompressedEpsilon), L"compressed animation scale mismatch");
+			}
+		}
+		character->SetCompressedAnimationEnabled(compressed);
+#endif
+	}
+}
+
+// KwsvZx`}[N
+void AnimationBenchmarkScene::RunHierarchyBenchmark()
+{
+	ID3D11Device* device = Graphics::Instance().GetDevice();
+	std::shared_ptr<ModelResource> resource = ModelResource::Load(device, "Data/Model/unitychan/unitychan.glb");
+
+	// CX^X쐬
+	std::vector<std::unique_ptr<Model>> models;
+	std::vector<NodeHierarchy> hierarchies;
+	models.reserve(hierarchyInstanceCount);
+	hierarchies.reserve(hierarchyInstanceCount);
+	for (int i = 0; i < hierarchyInstanceCount; ++i)
+	{
+		models.emplace_back(std::make_unique<Model>(resource));
+		hierarchies.emplace_back(resource->GetNodes());
+	}
+
+	// Sm[hvZ邽ߏpƈقȂQ̎p݂ɐݒ肷
+	std::vector<Model::NodePose> nodePoses[2];
+	models.front()->GetNodePoses(nodePoses[0]);
+	models.front()->GetNodePoses(nodePoses[1]);
+	int animationIndex = resource->GetAnimationIndex("Idle");
+	if (animationIndex >= 0)
+	{
+		models.front()->ComputeAnimation(animationIndex, 0.25f, nodePoses[0]);
+		models.front()->ComputeAnimation(animationIndex, 0.75f, nodePoses[1]);
+	}
+
+	DirectX::XMFLOAT4X4 worldTransform;
+	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
+
+	HierarchyBenchmarkResult& result = hierarchyBenchmarkResult;
+	result.nodeCount = hierarchies.front().GetNodeCount();
+	result.slotCount = hierarchies.front().GetSlotCount();
+	const float totalNodes = static_cast<float>(result.nodeCount) * hierarchyInstanceCount * hierarchyLoopCount;
+
+	// e|C^
+	Benchmark benchmark;
+	benchmark.begin();
+	for (int loop = 0; loop < hierarchyLoopCount; ++loop)
+	{
+		for (std::unique_ptr<Model>& model : models)
+		{
+			model->SetNodePoses(nodePoses[loop & 1]);
+			UpdateTransformReference(model.get(), worldTransform);
+		}
+	}
+	result.referenceRate = totalNodes / benchmark.end() / 1000000.0f;
+
+	// Model::UpdateTransformiύXoƍs̏߂܂ށj
+	benchmark.begin();
+	for (int loop = 0; loop < hierarchyLoopCount; ++loop)
+	{
+		for (std::unique_ptr<Model>& model : models)
+		{
+			model->SetNodePoses(nodePoses[loop & 1]);
+			model->UpdateTransform(worldTransform);
+		}
+	}
+	result.updateTransformRate = totalNodes / benchmark.end() / 1000000.0f;
+
+	// NodeHierarchy::EvaluateiSIMDvẐ݁j
+	benchmark.begin();
+	for (int loop = 0; loop < hierarchyLoopCount; ++loop)
+	{
+		for (NodeHierarchy& hierarchy : hierarchies)
+		{
+			hierarchy.Evaluate(worldTransform);
+		}
+	}
+	result.evaluateRate = totalNodes / benchmark.end() / 1000000.0f;
+
+#if defined(_DEBUG)
+	// e|C^ł̌vZƓs񂪓Ă邩mF
+	Model& model = *models.front();
+	std::vector<Model::Node> expectedNodes;
+	model.SetNodePoses(nodePoses[1]);
+	UpdateTransformReference(&model, worldTransform);
+	expectedNodes = model.GetNodes();
+	model.SetNodePoses(nodePoses[0]);
+	model.UpdateTransform(worldTransform);
+	model.SetNodePoses(nodePoses[1]);
+	model.UpdateTransform(worldTransform);
+	for (size_t i = 0; i < expectedNodes.size(); ++i)
+	{
+		DirectX::XMMATRIX A = DirectX::XMLoadFloat4x4(&expectedNodes.at(i).worldTransform);
+		DirectX::XMMATRIX B = DirectX::XMLoadFloat4x4(&model.GetNodes().at(i).worldTransform);
+		DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(1.0e-3f);
+		for (int row = 0; row < 4; ++row)
+		{
+			_ASSERT_EXPR(DirectX::XMVector4NearEqual(A.r[row], B.r[row], Epsilon), L"node hierarchy transform mismatch");
+		}
+	}
+#endif
+}
+
+// XLjOpbgx`}[N
+void AnimationBenchmarkScene::RunPaletteBenchmark()
+{
+	const std::vector<Model::Mesh>& meshes = character->GetMeshes();
+	const std::vector<Model::Node>& nodes = character->GetNodes();
+
+	PaletteBenchmarkResult& result = paletteBenchmarkResult;
+	result.meshCount = static_cast<int>(meshes.size());
+	result.paletteCount = static_cast<int>(character->GetResource()->GetPaletteBones().size());
+
+	// 萔obt@̑ɏރobt@
+	const int maxBoneCount = 256;
+	std::vector<DirectX::XMFLOAT4X4> boneTransforms(maxBoneCount);
+
+	// bVɌvZĒ萔obt@Ŝށi]̏j
+	Benchmark benchmark;
+	benchmark.begin();
+	for (int loop = 0; loop < paletteLoopCount; ++loop)
+	{
+		for (const Model::Mesh& mesh : meshes)
+		{
+			std::fill(boneTransforms.begin(), boneTransforms.end(), DirectX::XMFLOAT4X4());
+			if (mesh.bones.size() > 0)
+			{
+				for (size_t i = 0; i < mesh.bones.size(); ++i)
+				{
+					const Model::Bone& bone = mesh.bones.at(i);
+					DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&nodes.at(bone.nodeIndex).worldTransform);
+					DirectX::XMMATRIX OffsetTransform = DirectX::XMLoadFloat4x4(&bone.offsetTransform);
+					DirectX::XMStoreFloat4x4(&boneTransforms.at(i), OffsetTransform * WorldTransform);
+				}
+			}
+			else
+			{
+				boneTransforms.at(0) = nodes.at(mesh.nodeIndex).worldTransform;
+			}
+		}
+	}
+	result.perMeshTime = benchmark.end() * 1000000.0f / paletteLoopCount;
+	result.perMeshBytes = static_cast<int>(sizeof(DirectX::XMFLOAT4X4) * maxBoneCount * meshes.size());
+
+	// pbgPvZAbVQƂ͈͂
+	std::vector<DirectX::XMFLOAT4X4> palette;
+	result.paletteBytes = 0;
+	benchmark.begin();
+	for (int loop = 0; loop < paletteLoopCount; ++loop)
+	{
+		character->ComputeSkinningPalette(palette);
+
+		const DirectX::XMFLOAT4X4* uploaded = nullptr;
+		for (const Model::Mesh& mesh : meshes)
+		{
+			const DirectX::XMFLOAT4X4* source = palette.data() + mesh.paletteOffset;
+			if (source == uploaded) continue;
+			memcpy(boneTransforms.data(), source, sizeof(DirectX::XMFLOAT4X4) * mesh.paletteCount);
+			uploaded = source;
+			if (loop == 0)
+			{
+				result.paletteBytes += static_cast<int>(sizeof(DirectX::XMFLOAT4X4) * mesh.paletteCount);
+			}
+		}
+	}
+	result.paletteTime = benchmark.end() * 1000000.0f / paletteLoopCount;
+
+#if defined(_DEBUG)
+	// bVɌvZsƃpbg̍s񂪈v邩mF
+	for (const Model::Mesh& mesh : meshes)
+	{
+		for (int i = 0; i < mesh.paletteCount; ++i)
+		{
+			DirectX::XMMATRIX Expected;
+			if (mesh.bones.size() > 0)
+			{
+				const Model::Bone& bone = mesh.bones.at(i);
+				DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&nodes.at(bone.nodeIndex).worldTransform);
+				DirectX::XMMATRIX OffsetTransform = DirectX::XMLoadFloat4x4(&bone.offsetTransform);
+				Expected = OffsetTransform * WorldTransform;
+			}
+			else
+			{
+				Expected = DirectX::XMLoadFloat4x4(&nodes.at(mesh.nodeIndex).worldTransform);
+			}
+			DirectX::XMMATRIX Actual = DirectX::XMLoadFloat4x4(&palette.at(mesh.paletteOffset + i));
+			DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(1.0e-4f);
+			for (int row = 0; row < 4; ++row)
+			{
+				_ASSERT_EXPR(DirectX::XMVector4NearEqual(Expected.r[row], Actual.r[row], Epsilon), L"skinning palette mismatch");
+			}
+		}
+	}
+#endif
+}
+
+// SL[t[𑖍Aj[VvZirpj
+void AnimationBenchmarkScene::ComputeAnimationLinear(const Model* model, int animationIndex, float time, std::vector<Model::NodePose>& nodePoses)
+{
+	const Model::Animation& animation = model->GetAnimations().at(animationIndex);
+	for (size_t nodeIndex = 0; nodeIndex < nodePoses.size(); ++nodeIndex)
+	{
+		const Model::NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
+		Model::NodePose& nodePose = nodePoses.at(nodeIndex);
+
+		// ʒu
+		for (size_t index = 0; index + 1 < nodeAnim.positionKeyframes.size(); ++index)
+		{
+			const Model::VectorKeyframe& keyframe0 = nodeAnim.positionKeyframes.at(index);
+			const Model::VectorKeyframe& keyframe1 = nodeAnim.positionKeyframes.at(index + 1);
+			if (time >= keyframe0.seconds && time <= keyframe1.seconds)
+			{
+				float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
+				DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
+				DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
+				DirectX::XMStoreFloat3(&nodePose.position, DirectX::XMVectorLerp(V0, V1, rate));
+			}
+		}
+		// ]
+		for (size_t index = 0; index + 1 < nodeAnim.rotationKeyframes.size(); ++index)
+		{
+			const Model::QuaternionKeyframe& keyframe0 = nodeAnim.rotationKeyframes.at(index);
+			const Model::QuaternionKeyframe& keyframe1 = nodeAnim.rotationKeyframes.at(index + 1);
+			if (time >= keyframe0.seconds && time <= keyframe1.seconds)
+			{
+				float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
+				DirectX::XMVECTOR Q0 = DirectX::XMLoadFloat4(&keyframe0.value);
+				DirectX::XMVECTOR Q1 = DirectX::XMLoadFloat4(&keyframe1.value);
+				DirectX::XMStoreFloat4(&nodePose.rotation, DirectX::XMQuaternionSlerp(Q0, Q1, rate));
+			}
+		}
+		// XP[
+		for (size_t index = 0; index + 1 < nodeAnim.scaleKeyframes.size(); ++index)
+		{
+			const Model::VectorKeyframe& keyframe0 = nodeAnim.scaleKeyframes.at(index);
+			const Model::VectorKeyframe& keyframe1 = nodeAnim.scaleKeyframes.at(index + 1);
+			if (time >= keyframe0.seconds && time <= keyframe1.seconds)
+			{
+				float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
+				DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
+				DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
+				DirectX::XMStoreFloat3(&nodePose.scale, DirectX::XMVectorLerp(V0, V1, rate));
+			}
+		}
+	}
+}
+
+// e|C^ǂĂPm[hssvZirpj
+void AnimationBenchmarkScene::UpdateTransformReference(Model* model, const DirectX::XMFLOAT4X4& worldTransform)
+{
+	DirectX::XMMATRIX ParentWorldTransform = DirectX::XMLoadFloat4x4(&worldTransform);
+	for (Model::Node& node : model->GetNodes())
+	{
+		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
+		DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
+		DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
+		DirectX::XMMATRIX LocalTransform = S * R * T;
+
+		DirectX::XMMATRIX ParentGlobalTransform = node.parent != nullptr
+			? DirectX::XMLoadFloat4x4(&node.parent->globalTransform)
+			: DirectX::XMMatrixIdentity();
+		DirectX::XMMATRIX GlobalTransform = LocalTransform * ParentGlobalTransform;
+		DirectX::XMMATRIX WorldTransform = GlobalTransform * ParentWorldTransform;
+
+		DirectX::XMStoreFloat4x4(&node.localTransform, LocalTransform);
+		DirectX::XMStoreFloat4x4(&node.globalTransform, GlobalTransform);
+		DirectX::XMStoreFloat4x4(&node.worldTransform, WorldTransform);
+	}
+}
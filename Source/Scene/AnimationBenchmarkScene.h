@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "Scene.h"
+#include "Camera.h"
+#include "FreeCameraController.h"
+#include "Model.h"
+
+// Aj[Vx`}[NV[
+class AnimationBenchmarkScene : public Scene
+{
+public:
+	AnimationBenchmarkScene();
+	~AnimationBenchmarkScene() override = default;
+
+	// XV
+	void Update(float elapsedTime) override;
+
+	// `揈
+	void Render(float elapsedTime) override;
+
+	// GUI`揈
+	void DrawGUI() override;
+
+private:
+	// L[t[x`}[N
+	void RunKeyframeBenchmark();
+
+	// KwsvZx`}[N
+	void RunHierarchyBenchmark();
+
+	// XLjOpbgx`}[N
+	void RunPaletteBenchmark();
+
+	// SL[t[𑖍Aj[VvZirpj
+	static void ComputeAnimationLinear(const Model* model, int animationIndex, float time, std::vector<Model::NodePose>& nodePoses);
+
+	// e|C^ǂĂPm[hssvZirpj
+	static void UpdateTransformReference(Model* model, const DirectX::XMFLOAT4X4& worldTransform);
+
+private:
+	struct KeyframeBenchmarkResult
+	{
+		std::string		name;
+		int				keyframeCount = 0;
+		float			linearTime = 0;		// Si~b^Tvj
+		float			binaryTime = 0;		// 񕪒Ti~b^Tvj
+		float			cursorTime = 0;		// J[\i~b^Tvj
+		float			compressedTime = 0;	// ʎq{J[\i~b^Tvj
+		size_t			rawBytes = 0;		// L[t[̃gp
+		size_t			compressedBytes = 0;	// ʎqAj[Ṽgp
+	};
+
+	struct HierarchyBenchmarkResult
+	{
+		int				nodeCount = 0;
+		int				slotCount = 0;
+		float			referenceRate = 0;			// e|C^iSm[h^bj
+		float			updateTransformRate = 0;	// Model::UpdateTransformiSm[h^bj
+		float			evaluateRate = 0;			// NodeHierarchy::EvaluateiSm[h^bj
+	};
+
+	struct PaletteBenchmarkResult
+	{
+		int				meshCount = 0;
+		int				paletteCount = 0;
+		float			perMeshTime = 0;		// bVɌvZi}CNb^t[j
+		float			paletteTime = 0;		// pbgi}CNb^t[j
+		int				perMeshBytes = 0;		// bVɌvZi]oCg^t[j
+		int				paletteBytes = 0;		// pbgi]oCg^t[j
+	};
+
+	Camera								camera;
+	FreeCameraController				cameraController;
+	std::shared_ptr<Model>				character;
+	std::vector<Model::NodePose>		nodePoses;
+	Model::AnimationCursor				animationCursor;
+	int									animationIndex = 0;
+	float								animationSeconds = 0;
+
+	int									benchmarkLoopCount = 10;
+	std::vector<KeyframeBenchmarkResult>	keyframeBenchmarkResults;
+
+	int									hierarchyInstanceCount = 1000;
+	int									hierarchyLoopCount = 10;
+	HierarchyBenchmarkResult			hierarchyBenchmarkResult;
+
+	int									paletteLoopCount = 1000;
+	PaletteBenchmarkResult				paletteBenchmarkResult;
+};
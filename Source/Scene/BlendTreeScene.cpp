@@ -0,0 +1,200 @@
+#include <imgui.h>
+#include "Graphics.h"
+#include "Misc.h"
+#include "Scene/BlendTreeScene.h"
+
+// RXgN^
+BlendTreeScene::BlendTreeScene()
+{
+	ID3D11Device* device = Graphics::Instance().GetDevice();
+	float screenWidth = Graphics::Instance().GetScreenWidth();
+	float screenHeight = Graphics::Instance().GetScreenHeight();
+
+	// Jݒ
+	camera.SetPerspectiveFov(
+		DirectX::XMConvertToRadians(45),	// p
+		screenWidth / screenHeight,			// ʃAXyNg
+		0.1f,								// jANbv
+		1000.0f								// t@[Nbv
+	);
+	camera.SetLookAt(
+		{ 3, 2, 3 },		// _
+		{ 0, 1, 0 },		// _
+		{ 0, 1, 0 }			// xNg
+	);
+	cameraController.SyncCameraToController(camera);
+
+	// fǂݍ
+	character = std::make_shared<Model>(device, "Data/Model/unitychan/unitychan.glb");
+	character->GetNodePoses(nodePoses);
+
+	idleAnimationIndex = character->GetAnimationIndex("Idle");
+	runAnimationIndex = character->GetAnimationIndex("RunForwardInPlace");
+	upperBodyAnimationIndex = character->GetAnimationIndex("Combo1");
+	additiveAnimationIndex = character->GetAnimationIndex("JumpPeak");
+	upperBodyRootNodeIndex = character->GetNodeIndex("Character1_Spine1");
+
+	// C[\ziǉɉd˂j
+	blendTree.AddLayer(AnimationBlendTree::BlendMode::Override, 2);
+	blendTree.AddLayer(AnimationBlendTree::BlendMode::Override, 1);
+	blendTree.AddLayer(AnimationBlendTree::BlendMode::Additive, 1);
+	blendTree.SetBoneMask(UpperBodyLayer, character.get(), upperBodyRootNodeIndex);
+}
+
+// XV
+void BlendTreeScene::Update(float elapsedTime)
+{
+	// JXV
+	cameraController.Update();
+	cameraController.SyncControllerToCamera(camera);
+
+	const std::vector<Model::Animation>& animations = character->GetAnimations();
+
+	// ړFҋ@Ƒ𑬓xŏdݕtAĐʒu𑵂đ̎킹
+	{
+		float idleLength = animations.at(idleAnimationIndex).secondsLength;
+		float runLength = animations.at(runAnimationIndex).secondsLength;
+		blendTree.SetClip(LocomotionLayer, 0, idleAnimationIndex, locomotionPhase * idleLength, 1.0f - speed);
+		blendTree.SetClip(LocomotionLayer, 1, runAnimationIndex, locomotionPhase * runLength, speed);
+
+		// ͏d݂ŕԂɂ
+		float length = idleLength + (runLength - idleLength) * speed;
+		locomotionPhase += elapsedTime / length;
+		locomotionPhase -= static_cast<int>(locomotionPhase);
+	}
+
+	// 㔼g
+	if (upperBodyAnimationIndex >= 0)
+	{
+		blendTree.GetLayer(UpperBodyLayer).weight = upperBodyWeight;
+		blendTree.SetClip(UpperBodyLayer, 0, upperBodyAnimationIndex, upperBodySeconds, 1.0f);
+
+		float length = animations.at(upperBodyAnimationIndex).secondsLength;
+		upperBodySeconds += elapsedTime;
+		if (upperBodySeconds > length) upperBodySeconds -= length;
+	}
+
+	// Z
+	if (additiveAnimationIndex >= 0)
+	{
+		blendTree.GetLayer(AdditiveLayer).weight = additiveWeight;
+		blendTree.SetClip(AdditiveLayer, 0, additiveAnimationIndex, additiveSeconds, 1.0f);
+
+		float length = animations.at(additiveAnimationIndex).secondsLength;
+		additiveSeconds += elapsedTime;
+		if (additiveSeconds > length) additiveSeconds -= length;
+	}
+
+	// uhc[vZ
+	Benchmark benchmark;
+	benchmark.begin();
+	blendTree.Evaluate(character.get(), nodePoses);
+	evaluateTime = benchmark.end() * 1000000.0f;
+
+	// pXV
+	character->SetNodePoses(nodePoses);
+
+	// LN^[gXtH[XV
+	DirectX::XMFLOAT4X4 worldTransform;
+	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
+	character->UpdateTransform(worldTransform);
+}
+
+// `揈
+void BlendTreeScene::Render(float elapsedTime)
+{
+	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
+	RenderState* renderState = Graphics::Instance().GetRenderState();
+	PrimitiveRenderer* primitiveRenderer = Graphics::Instance().GetPrimitiveRenderer();
+	ModelRenderer* modelRenderer = Graphics::Instance().GetModelRenderer();
+
+	// _[Xe[gݒ
+	dc->OMSetBlendState(renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
+	dc->OMSetDepthStencilState(renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
+	dc->RSSetState(renderState->GetRasterizerState(RasterizerState::SolidCullNone));
+
+	// Obh`
+	primitiveRenderer->DrawGrid(20, 1);
+	primitiveRenderer->Render(dc, camera.GetView(), camera.GetProjection(), D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+
+	// `ReLXgݒ
+	RenderContext rc;
+	rc.deviceContext = dc;
+	rc.renderState = renderState;
+	rc.camera = &camera;
+
+	// f`
+	modelRenderer->Draw(ShaderId::Basic, character);
+	modelRenderer->Render(rc);
+}
+
+// GUI`揈
+void BlendTreeScene::DrawGUI()
+{
+	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
+	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + 10), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(320, 300), ImGuiCond_Once);
+
+	if (ImGui::Begin(u8"uhc["))
+	{
+		if (ImGui::CollapsingHeader(u8"ړ", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::SliderFloat("Speed", &speed, 0.0f, 1.0f);
+		}
+		if (ImGui::CollapsingHeader(u8"㔼g", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			if (AnimationComboGUI("Animation##UpperBody", upperBodyAnimationIndex))
+			{
+				upperBodySeconds = 0;
+			}
+			ImGui::SliderFloat("Weight##UpperBody", &upperBodyWeight, 0.0f, 1.0f);
+		}
+		if (ImGui::CollapsingHeader(u8"Z", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			if (AnimationComboGUI("Animation##Additive", additiveAnimationIndex))
+			{
+				additiveSeconds = 0;
+			}
+			ImGui::SliderFloat("Weight##Additive", &additiveWeight, 0.0f, 1.0f);
+		}
+
+		// vZm[hi{[}XNÕm[hƃEFCg0̃Nbv͌vZȂj
+		int sampleCount = 0;
+		for (int layerIndex = 0; layerIndex < blendTree.GetLayerCount(); ++layerIndex)
+		{
+			const AnimationBlendTree::Layer& layer = blendTree.GetLayer(layerIndex);
+			if (layer.weight <= 0.0f) continue;
+
+			int nodeCount = layer.nodeIndices.empty() ? static_cast<int>(nodePoses.size()) : static_cast<int>(layer.nodeIndices.size());
+			for (const AnimationBlendTree::Clip& clip : layer.clips)
+			{
+				if (clip.animationIndex >= 0 && clip.weight > 0.0f) sampleCount += nodeCount;
+			}
+		}
+		ImGui::Separator();
+		ImGui::Text("Samples : %d nodes", sampleCount);
+		ImGui::Text("Evaluate : %.1f us", evaluateTime);
+	}
+	ImGui::End();
+}
+
+// Aj[VIGUI
+bool BlendTreeScene::AnimationComboGUI(const char* label, int& animationIndex) const
+{
+	const std::vector<Model::Animation>& animations = character->GetAnimations();
+	const char* preview = animationIndex >= 0 ? animations.at(animationIndex).name.c_str() : "";
+	bool changed = false;
+	if (ImGui::BeginCombo(label, preview))
+	{
+		for (int i = 0; i < static_cast<int>(animations.size()); ++i)
+		{
+			if (ImGui::Selectable(animations.at(i).name.c_str(), i == animationIndex))
+			{
+				animationIndex = i;
+				changed = true;
+			}
+		}
+		ImGui::EndCombo();
+	}
+	return changed;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include "Scene.h"
+#include "Camera.h"
+#include "FreeCameraController.h"
+#include "Model.h"
+#include "AnimationBlendTree.h"
+
+// uhc[V[
+class BlendTreeScene : public Scene
+{
+public:
+	BlendTreeScene();
+	~BlendTreeScene() override = default;
+
+	// XV
+	void Update(float elapsedTime) override;
+
+	// `揈
+	void Render(float elapsedTime) override;
+
+	// GUI`揈
+	void DrawGUI() override;
+
+private:
+	// Aj[VIGUI
+	bool AnimationComboGUI(const char* label, int& animationIndex) const;
+
+private:
+	enum Layer
+	{
+		LocomotionLayer,		// ҋ@Ƒ𑬓xŃuh
+		UpperBodyLayer,			// 㔼ĝݍUŏ㏑
+		AdditiveLayer,			// SgɍZ
+	};
+
+	Camera								camera;
+	FreeCameraController				cameraController;
+	std::shared_ptr<Model>				character;
+	std::vector<Model::NodePose>		nodePoses;
+	AnimationBlendTree					blendTree;
+
+	int									idleAnimationIndex = -1;
+	int									runAnimationIndex = -1;
+	int									upperBodyAnimationIndex = -1;
+	int									additiveAnimationIndex = -1;
+	int									upperBodyRootNodeIndex = -1;
+
+	float								locomotionPhase = 0;		// ҋ@Ƒ̍Đʒui0`1œj
+	float								upperBodySeconds = 0;
+	float								additiveSeconds = 0;
+	float								speed = 0.5f;
+	float								upperBodyWeight = 1.0f;
+	float								additiveWeight = 0.0f;
+	float								evaluateTime = 0;			// uhc[vZԁi}CNbj
+};
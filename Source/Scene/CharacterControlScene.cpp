@@ -1,9 +1,12 @@
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <imgui.h>
 #include <ImGuizmo.h>
 #include <DirectXCollision.h>
 #include "Graphics.h"
+#include "Input.h"
+#include "Profiler.h"
 #include "TransformUtils.h"
 #include "Scene/CharacterControlScene.h"
 
@@ -29,6 +32,8 @@ CharacterControlScene::CharacterControlScene()
 // XV
 void CharacterControlScene::Update(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	elapsedTime *= timeScale;
 
 	// ͍XV
@@ -45,6 +50,9 @@ void CharacterControlScene::Update(float elapsedTime)
 		UpdateThirdPersonCamera(elapsedTime);
 	}
 
+	// Xe[WXV
+	UpdateStage();
+
 	// {[XV
 	UpdateBalls(elapsedTime);
 
@@ -55,6 +63,8 @@ void CharacterControlScene::Update(float elapsedTime)
 // `揈
 void CharacterControlScene::Render(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	elapsedTime *= timeScale;
 
 	float elapsedFrame = ConvertToGameFrame(elapsedTime);
@@ -233,9 +243,20 @@ void CharacterControlScene::Render(float elapsedTime)
 		}
 		if (unitychan.visibleCharacterCollision)
 		{
-			DirectX::XMFLOAT3 position = unitychan.position;
-			position.y += unitychan.radius;
-			shapeRenderer->DrawSphere(position, unitychan.radius, { 0, 1, 1, 1 });
+			if (unitychan.useCharacterController)
+			{
+				float cylinderHeight = (std::max)(unitychan.height - unitychan.radius * 2.0f, 0.0f);
+				DirectX::XMFLOAT4X4 capsuleTransform;
+				DirectX::XMStoreFloat4x4(&capsuleTransform, DirectX::XMMatrixTranslation(
+					unitychan.position.x, unitychan.position.y + unitychan.radius + cylinderHeight * 0.5f, unitychan.position.z));
+				shapeRenderer->DrawCapsule(capsuleTransform, unitychan.radius, cylinderHeight, { 0, 1, 1, 1 });
+			}
+			else
+			{
+				DirectX::XMFLOAT3 position = unitychan.position;
+				position.y += unitychan.radius;
+				shapeRenderer->DrawSphere(position, unitychan.radius, { 0, 1, 1, 1 });
+			}
 		}
 	}
 
@@ -264,6 +285,12 @@ void CharacterControlScene::DrawGUI()
 					cameraController.SyncCameraToController(camera);
 				}
 			}
+			ImGui::Checkbox("UseStageBVH", &stage.useBVH);
+			ImGui::Checkbox("UseStageCollisionMesh", &stage.useCollisionMesh);
+			ImGui::Text("StageCollisionMesh: Triangles=%d Chunks=%d Builds=%d",
+				static_cast<int>(stage.collisionMesh.GetTriangles().size()),
+				static_cast<int>(stage.collisionMesh.GetChunks().size()),
+				stage.collisionMesh.GetBuildCount());
 		}
 		if (ImGui::CollapsingHeader(u8"J", ImGuiTreeNodeFlags_DefaultOpen))
 		{
@@ -339,6 +366,7 @@ void CharacterControlScene::DrawGUI()
 			ImGui::DragFloat("Acceleration", &unitychan.acceleration, 0.01f, 0.0f);
 			ImGui::DragFloat("GroundAdjust", &unitychan.groundAdjust, 0.01f, 0.0f);
 			ImGui::DragFloat("SlopeLimit", &unitychan.slopeLimit, 1.0f, 0, 90);
+			ImGui::Checkbox("UseCharacterController", &unitychan.useCharacterController);
 			ImGui::DragFloat("MaxPhysicsBoneVelocity", &unitychan.maxPhysicsBoneVelocity, 0.01f, 0.0f, 3.0f);
 
 			ImGui::Separator();
@@ -351,6 +379,7 @@ void CharacterControlScene::DrawGUI()
 			ImGui::InputFloat("SlopeAngle", &slope);
 			ImGui::DragFloat3("GroundNormal", &unitychan.groundNormal.x);
 			ImGui::Checkbox("OnGround", &unitychan.onGround);
+			ImGui::DragInt("LOD", &unitychan.lod.level);
 
 			ImGui::Separator();
 			bool visiblePhysicsBone	= unitychan.visibleLeftHairTailBones
@@ -388,7 +417,7 @@ void CharacterControlScene::DrawGUI()
 						for (PhysicsBone& bone : bones)
 						{
 							ImGui::PushID(&bone);
-							ImGui::Text(bone.node->name.c_str()); ImGui::NextColumn();
+							ImGui::Text(bone.node->name); ImGui::NextColumn();
 							ImGui::DragFloat("", &bone.collisionRadius, 0.01f, 0, 1.0f); ImGui::NextColumn();
 							ImGui::PopID();
 						}
@@ -435,7 +464,7 @@ void CharacterControlScene::DrawGUI()
 
 						for (CollisionBone& bone : bones)
 						{
-							ImGui::Text(bone.node->name.c_str()); ImGui::NextColumn();
+							ImGui::Text(bone.node->name); ImGui::NextColumn();
 							ImGui::PushID(&bone.radius);
 							ImGui::DragFloat("", &bone.radius, 0.01f, 0, 1.0f); ImGui::NextColumn();
 							ImGui::PopID();
@@ -476,7 +505,7 @@ void CharacterControlScene::DrawGUI()
 					}
 
 					// c[m[h\
-					bool opened = ImGui::TreeNodeEx(node, nodeFlags, node->name.c_str());
+					bool opened = ImGui::TreeNodeEx(node, nodeFlags, node->name);
 
 					// tH[JXꂽm[hI
 					if (ImGui::IsItemFocused())
@@ -487,7 +516,10 @@ void CharacterControlScene::DrawGUI()
 					if (selectionNode == node)
 					{
 						// ʒu
-						ImGui::DragFloat3("Position", &selectionNode->position.x, 0.1f);
+						if (ImGui::DragFloat3("Position", &selectionNode->position.x, 0.1f))
+						{
+							unitychan.model->MarkDirty(selectionNode);
+						}
 
 						// ]
 						DirectX::XMFLOAT3 angle;
@@ -502,10 +534,14 @@ void CharacterControlScene::DrawGUI()
 							angle.z = DirectX::XMConvertToRadians(angle.z);
 							DirectX::XMVECTOR Rotation = DirectX::XMQuaternionRotationRollPitchYaw(angle.x, angle.y, angle.z);
 							DirectX::XMStoreFloat4(&selectionNode->rotation, Rotation);
+							unitychan.model->MarkDirty(selectionNode);
 						}
 
 						// XP[
-						ImGui::DragFloat3("Scale", &selectionNode->scale.x, 0.01f);
+						if (ImGui::DragFloat3("Scale", &selectionNode->scale.x, 0.01f))
+						{
+							unitychan.model->MarkDirty(selectionNode);
+						}
 					}
 
 					// JĂꍇAqKws
@@ -557,17 +593,19 @@ void CharacterControlScene::DrawGUI()
 // ͍XV
 void CharacterControlScene::UpdateInput()
 {
+	PROFILE_FUNCTION();
+
 	// XeBbN
 	{
 		float axisX = 0, axisY = 0;
-		if (GetAsyncKeyState('W') & 0x8000) axisY =  1.0f;
-		if (GetAsyncKeyState('A') & 0x8000) axisX = -1.0f;
-		if (GetAsyncKeyState('S') & 0x8000) axisY = -1.0f;
-		if (GetAsyncKeyState('D') & 0x8000) axisX =  1.0f;
-		if (GetAsyncKeyState(VK_UP)    & 0x8000) axisY =  1.0f;
-		if (GetAsyncKeyState(VK_LEFT)  & 0x8000) axisX = -1.0f;
-		if (GetAsyncKeyState(VK_DOWN)  & 0x8000) axisY = -1.0f;
-		if (GetAsyncKeyState(VK_RIGHT) & 0x8000) axisX =  1.0f;
+		if (Input::Instance().IsKeyPressed('W')) axisY =  1.0f;
+		if (Input::Instance().IsKeyPressed('A')) axisX = -1.0f;
+		if (Input::Instance().IsKeyPressed('S')) axisY = -1.0f;
+		if (Input::Instance().IsKeyPressed('D')) axisX =  1.0f;
+		if (Input::Instance().IsKeyPressed(VK_UP)) axisY =  1.0f;
+		if (Input::Instance().IsKeyPressed(VK_LEFT)) axisX = -1.0f;
+		if (Input::Instance().IsKeyPressed(VK_DOWN)) axisY = -1.0f;
+		if (Input::Instance().IsKeyPressed(VK_RIGHT)) axisX =  1.0f;
 		float axisLength = sqrtf(axisX * axisX + axisY * axisY);
 		if (axisLength > 1.0f)
 		{
@@ -582,10 +620,10 @@ void CharacterControlScene::UpdateInput()
 	// EXeBbN
 	{
 		float axisX = 0, axisY = 0;
-		if (GetAsyncKeyState('I') & 0x8000) axisY = 1.0f;
-		if (GetAsyncKeyState('J') & 0x8000) axisX = -1.0f;
-		if (GetAsyncKeyState('K') & 0x8000) axisY = -1.0f;
-		if (GetAsyncKeyState('L') & 0x8000) axisX = 1.0f;
+		if (Input::Instance().IsKeyPressed('I')) axisY = 1.0f;
+		if (Input::Instance().IsKeyPressed('J')) axisX = -1.0f;
+		if (Input::Instance().IsKeyPressed('K')) axisY = -1.0f;
+		if (Input::Instance().IsKeyPressed('L')) axisX = 1.0f;
 		float axisLength = sqrtf(axisX * axisX + axisY * axisY);
 		if (axisLength > 1.0f)
 		{
@@ -601,8 +639,8 @@ void CharacterControlScene::UpdateInput()
 	// L[
 	{
 		uint32_t inputKey = 0;
-		if (GetAsyncKeyState(VK_SPACE) & 0x8000) inputKey |= UnityChan::KeyJump;
-		if (GetAsyncKeyState('Z') & 0x8000) inputKey |= UnityChan::KeyAttack;
+		if (Input::Instance().IsKeyPressed(VK_SPACE)) inputKey |= UnityChan::KeyJump;
+		if (Input::Instance().IsKeyPressed('Z')) inputKey |= UnityChan::KeyAttack;
 
 		unitychan.inputKeyOld = unitychan.inputKeyNew;
 		unitychan.inputKeyNew = inputKey;
@@ -639,6 +677,8 @@ void CharacterControlScene::SetupCamera()
 // Ol̎_JXV
 void CharacterControlScene::UpdateThirdPersonCamera(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	thirdPersonCamera.focus = unitychan.position;
 	thirdPersonCamera.focus.y += 1.1f;
 
@@ -680,7 +720,7 @@ void CharacterControlScene::UpdateThirdPersonCamera(float elapsedTime)
 
 	// RW
 	HitResult hit;
-	if (RayIntersectModel(cameraFocus, cameraEye, stage.model.get(), hit))
+	if (RayIntersectStage(cameraFocus, cameraEye, hit))
 	{
 		cameraEye = hit.position;
 	}
@@ -693,6 +733,23 @@ void CharacterControlScene::SetupStage(ID3D11Device* device)
 {
 	// fǂݍ
 	stage.model = std::make_shared<Model>(device, "Data/Model/Greybox/Greybox.glb", 1.0f);
+
+	// Փ˔p̃bVBVH\z
+	stage.model->UpdateTransform(stage.transform);
+	stage.collisionMesh.Build(stage.model.get());
+	stage.bvh.Build(stage.model.get());
+	stage.collisionWorld.SetBVH(&stage.bvh);
+}
+
+// Xe[WXV
+void CharacterControlScene::UpdateStage()
+{
+	// Xe[W̍s񂪕ςꍇՓ˔p̃f[^蒼
+	stage.model->UpdateTransform(stage.transform);
+	if (stage.collisionMesh.Update(stage.model.get()))
+	{
+		stage.bvh.Build(stage.model.get());
+	}
 }
 
 // {[ZbgAbv
@@ -708,10 +765,12 @@ void CharacterControlScene::SetupBalls(ID3D11Device* device)
 		{ {  8.0f, 4.0f, 18.0f } },
 		{ { 10.0f, 5.0f, 14.0f } },
 	};
+	// SẴ{[œf\[XL
+	std::shared_ptr<ModelResource> resource = ModelResource::Load(device, "Data/Model/Shape/Sphere.glb", 0.3f);
 	for (const BallParam& param : params)
 	{
 		Ball& ball = balls.emplace_back();
-		ball.model = std::make_unique<Model>(device, "Data/Model/Shape/Sphere.glb", 0.3f);
+		ball.model = std::make_shared<Model>(resource);
 		ball.position = param.position;
 	}
 }
@@ -719,6 +778,8 @@ void CharacterControlScene::SetupBalls(ID3D11Device* device)
 // {[sXV
 void CharacterControlScene::UpdateBalls(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	for (Ball& ball : balls)
 	{
 		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(ball.scale, ball.scale, ball.scale);
@@ -736,7 +797,9 @@ void CharacterControlScene::SetupUnityChan(ID3D11Device* device)
 	unitychan.model = std::make_shared<Model>(device, "Data/Model/unitychan/unitychan.glb");
 	unitychan.model->GetNodePoses(unitychan.nodePoses);
 	unitychan.model->GetNodePoses(unitychan.cacheNodePoses);
+	unitychan.blendTree.AddLayer(AnimationBlendTree::BlendMode::Override, 1);
 	unitychan.rootMotionNodeIndex = unitychan.model->GetNodeIndex("Character1_Hips");
+	unitychan.rootMotion = std::make_unique<RootMotion>(unitychan.model.get(), unitychan.rootMotionNodeIndex, false, true, false);
 	unitychan.hipsNodeIndex = unitychan.model->GetNodeIndex("Character1_Hips");
 	unitychan.position = { 15, 0.5f, 15 };
 	PlayUnityChanAnimation("Idle", 0, true, 0);
@@ -748,7 +811,7 @@ void CharacterControlScene::SetupUnityChan(ID3D11Device* device)
 	{
 		for (Model::Node& node : unitychan.model->GetNodes())
 		{
-			if (node.name == name)
+			if (strcmp(node.name, name) == 0)
 			{
 				return &node;
 			}
@@ -909,6 +972,16 @@ void CharacterControlScene::SetupUnityChan(ID3D11Device* device)
 // jeBXV
 void CharacterControlScene::UpdateUnityChan(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
+	// LODXViJ̋ŗĥIKȗj
+	{
+		DirectX::XMVECTOR Eye = DirectX::XMLoadFloat3(&camera.GetEye());
+		DirectX::XMVECTOR Position = DirectX::XMLoadFloat3(&unitychan.position);
+		animationLOD.UpdateLevel(unitychan.lod, DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(Position, Eye))));
+	}
+	const AnimationLOD::Level& lodLevel = animationLOD.GetLevel(unitychan.lod.level);
+
 	// Aj[VXV
 	UpdateUnityChanAnimation(elapsedTime);
 
@@ -928,18 +1001,26 @@ void CharacterControlScene::UpdateUnityChan(float elapsedTime)
 	UpdateUnityChanEffect();
 
 	// bNAbgXV
-	UpdateUnityChanLookAt(elapsedTime);
+	if (lodLevel.ik)
+	{
+		UpdateUnityChanLookAt(elapsedTime);
+	}
 
 	// IK{[XV
 	UpdateUnityChanIKBones();
 
 	// {[XV
-	UpdateUnityChanPhysicsBones(elapsedTime);
+	if (lodLevel.physicsBones)
+	{
+		UpdateUnityChanPhysicsBones(elapsedTime);
+	}
 }
 
 // jeBAj[VXV
 void CharacterControlScene::UpdateUnityChanAnimation(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	// w莞Ԃ̃Aj[V
 	if (unitychan.animationIndex >= 0)
 	{
@@ -961,16 +1042,15 @@ void CharacterControlScene::UpdateUnityChanAnimation(float elapsedTime)
 		}
 
 		// Aj[VvZ
-		unitychan.model->ComputeAnimation(unitychan.animationIndex, unitychan.animationSeconds, unitychan.nodePoses);
+		unitychan.blendTree.SetClip(0, 0, unitychan.animationIndex, unitychan.animationSeconds, 1.0f);
+		unitychan.blendTree.Evaluate(unitychan.model.get(), unitychan.nodePoses);
 
 		// [g[VvZ
 		if (unitychan.computeRootMotion)
 		{
-			ComputeRootMotion(unitychan.model.get(), unitychan.rootMotionNodeIndex,
-				unitychan.animationIndex, unitychan.oldAnimationSeconds, unitychan.animationSeconds,
+			unitychan.rootMotion->Compute(unitychan.animationIndex, unitychan.oldAnimationSeconds, unitychan.animationSeconds,
 				unitychan.rootMotionTranslation,
-				unitychan.nodePoses.at(unitychan.rootMotionNodeIndex).position,
-				false, true, false);
+				unitychan.nodePoses.at(unitychan.rootMotionNodeIndex).position);
 		}
 		else
 		{
@@ -1005,20 +1085,7 @@ void CharacterControlScene::UpdateUnityChanAnimation(float elapsedTime)
 				const Model::NodePose& cache = unitychan.cacheNodePoses.at(i);
 				Model::NodePose& pose = unitychan.nodePoses.at(i);
 
-				DirectX::XMVECTOR S0 = DirectX::XMLoadFloat3(&cache.scale);
-				DirectX::XMVECTOR S1 = DirectX::XMLoadFloat3(&pose.scale);
-				DirectX::XMVECTOR R0 = DirectX::XMLoadFloat4(&cache.rotation);
-				DirectX::XMVECTOR R1 = DirectX::XMLoadFloat4(&pose.rotation);
-				DirectX::XMVECTOR T0 = DirectX::XMLoadFloat3(&cache.position);
-				DirectX::XMVECTOR T1 = DirectX::XMLoadFloat3(&pose.position);
-
-				DirectX::XMVECTOR S = DirectX::XMVectorLerp(S0, S1, blendRate);
-				DirectX::XMVECTOR R = DirectX::XMQuaternionSlerp(R0, R1, blendRate);
-				DirectX::XMVECTOR T = DirectX::XMVectorLerp(T0, T1, blendRate);
-
-				DirectX::XMStoreFloat3(&pose.scale, S);
-				DirectX::XMStoreFloat4(&pose.rotation, R);
-				DirectX::XMStoreFloat3(&pose.position, T);
+				AnimationBlendTree::BlendPose(cache, pose, blendRate, pose);
 			}
 			// uhԍXV
 			unitychan.animationBlendSeconds += elapsedTime;
@@ -1036,6 +1103,8 @@ void CharacterControlScene::UpdateUnityChanAnimation(float elapsedTime)
 // jeBXe[g}VXV
 void CharacterControlScene::UpdateUnityChanStateMachine(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	// Xe[g؂ւ
 	if (unitychan.state != unitychan.nextState)
 	{
@@ -1052,6 +1121,8 @@ void CharacterControlScene::UpdateUnityChanStateMachine(float elapsedTime)
 // jeBxVeBXV
 void CharacterControlScene::UpdateUnityChanVelocity(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	float elapsedFrame = ConvertToGameFrame(elapsedTime);
 
 	// d͏
@@ -1110,8 +1181,45 @@ void CharacterControlScene::UpdateUnityChanVelocity(float elapsedTime)
 // jeBʒuXV
 void CharacterControlScene::UpdateUnityChanPosition(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	float elapsedFrame = ConvertToGameFrame(elapsedTime);
 
+	// LN^[Rg[[ŃJvZړ
+	if (unitychan.useCharacterController)
+	{
+		CharacterController::Settings settings = unitychan.controller.GetSettings();
+		settings.radius = unitychan.radius;
+		settings.height = (std::max)(unitychan.height, unitychan.radius * 2.0f);
+		settings.slopeLimit = unitychan.slopeLimit;
+		settings.groundSnapDistance = unitychan.groundAdjust * elapsedFrame;
+		unitychan.controller.SetSettings(settings);
+		unitychan.controller.SetPosition(unitychan.position);
+
+		unsigned int collisionFlags = unitychan.controller.Move(stage.collisionWorld, unitychan.deltaMove);
+		unitychan.position = unitychan.controller.GetPosition();
+		unitychan.deltaMove = { 0, 0, 0 };
+
+		// ㏸͐ڒnȂ
+		unitychan.onGround = unitychan.controller.IsGrounded() && unitychan.velocity.y <= 0;
+		if (unitychan.onGround)
+		{
+			unitychan.velocity.y = 0;
+			unitychan.groundNormal = unitychan.controller.GetGroundNormal();
+		}
+		else
+		{
+			unitychan.groundNormal = { 0, 1, 0 };
+		}
+
+		// Vɓꍇ͏㏸~߂
+		if ((collisionFlags & CharacterController::CollisionAbove) != 0 && unitychan.velocity.y > 0)
+		{
+			unitychan.velocity.y = 0;
+		}
+		return;
+	}
+
 	// ړ
 	{
 		// CLXgŕǔȂ悤ɂ
@@ -1132,7 +1240,7 @@ void CharacterControlScene::UpdateUnityChanPosition(float elapsedTime)
 			rayStart.z + vec.z * range + unitychan.deltaMove.z
 		};
 		HitResult hit;
-		if (RayIntersectModel(rayStart, rayEnd, stage.model.get(), hit))
+		if (RayIntersectStage(rayStart, rayEnd, hit))
 		{
 			unitychan.position.x = hit.position.x + hit.normal.x * range;
 			unitychan.position.y = hit.position.y + hit.normal.y * range - unitychan.radius;
@@ -1161,7 +1269,7 @@ void CharacterControlScene::UpdateUnityChanPosition(float elapsedTime)
 		int n = 2;
 		for (int i = 0; i < n; ++i)
 		{
-			if (SphereIntersectModel(position, unitychan.radius, stage.model.get(), unitychan.hits))
+			if (SphereIntersectStage(position, unitychan.radius, unitychan.hits))
 			{
 				// ׂĂ̏Փˌʂ𕽋ωl̗p
 				DirectX::XMFLOAT3 hitPosition = { 0, 0, 0 };
@@ -1222,6 +1330,8 @@ void CharacterControlScene::UpdateUnityChanPosition(float elapsedTime)
 // jeBsXV
 void CharacterControlScene::UpdateUnityChanTransform()
 {
+	PROFILE_FUNCTION();
+
 	DirectX::XMMATRIX Rotation = DirectX::XMMatrixRotationRollPitchYaw(unitychan.angle.x, unitychan.angle.y, unitychan.angle.z);
 	DirectX::XMMATRIX Translation = DirectX::XMMatrixTranslation(unitychan.position.x, unitychan.position.y, unitychan.position.z);
 	DirectX::XMStoreFloat4x4(&unitychan.transform, Rotation * Translation);
@@ -1253,12 +1363,16 @@ void CharacterControlScene::UpdateUnityChanTransform()
 // jeBGtFNgXV
 void CharacterControlScene::UpdateUnityChanEffect()
 {
+	PROFILE_FUNCTION();
+
 	UnityChanStaffTrail();
 }
 
 // jeB񃋃bNAbgXV
 void CharacterControlScene::UpdateUnityChanLookAt(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	// ^[QbgWZoiftHg͑O100[gj
 	DirectX::XMMATRIX RootWorldTransform = DirectX::XMLoadFloat4x4(&unitychan.transform);
 	DirectX::XMVECTOR RootWorldForward = RootWorldTransform.r[2];
@@ -1314,7 +1428,7 @@ void CharacterControlScene::UpdateUnityChanLookAt(float elapsedTime)
 				LocalRotation = DirectX::XMQuaternionMultiply(LocalRotationAxis, LocalRotation);
 				DirectX::XMStoreFloat4(&unitychan.lookAtBone.node->rotation, LocalRotation);
 
-				ComputeWorldTransform(unitychan.lookAtBone.node);
+				unitychan.model->UpdateSubtree(unitychan.lookAtBone.node);
 			}
 		}
 	}
@@ -1323,9 +1437,11 @@ void CharacterControlScene::UpdateUnityChanLookAt(float elapsedTime)
 // jeBIK{[XV
 void CharacterControlScene::UpdateUnityChanIKBones()
 {
-	// IK
+	PROFILE_FUNCTION();
+
+	// IKiLODŖȏꍇ͍̕␳߂sj
 	bool processedFootIK = false;
-	if (unitychan.applyFootIK)
+	if (unitychan.applyFootIK && animationLOD.GetLevel(unitychan.lod.level).ik)
 	{
 		float maxOffset = 0.25f;	// ő啝
 		// nʂɌăCLXg
@@ -1338,32 +1454,41 @@ void CharacterControlScene::UpdateUnityChanIKBones()
 		rayEnd.y = unitychan.position.y - maxOffset;
 		rayEnd.z = unitychan.position.z;
 
-		HitResult hit;
-		if (RayIntersectModel(rayStart, rayEnd, stage.model.get(), hit))
-		{
-			float floorPositionY = hit.position.y;
+		raycastBatch.Clear();
+		int groundRayIndex = raycastBatch.AddRay(rayStart, rayEnd);
 
-			// nʂɌăCLXg
-			auto raycastLegs = [this](FootIKBone& bone, float heightOffset)
-			{
-				const float footHeightLength = 0.1f;
-
-				bone.anklePosition.x = bone.footNode->worldTransform._41;
-				bone.anklePosition.y = bone.footNode->worldTransform._42;
-				bone.anklePosition.z = bone.footNode->worldTransform._43;
+		// nʂɌẴCꏏɔ肷
+		auto addLegRay = [this](const FootIKBone& bone, float heightOffset)
+		{
+			const DirectX::XMFLOAT4X4& footTransform = bone.footNode->worldTransform;
+			DirectX::XMFLOAT3 legRayStart = { footTransform._41, footTransform._42 + heightOffset, footTransform._43 };
+			DirectX::XMFLOAT3 legRayEnd = { legRayStart.x, legRayStart.y - 100.0f, legRayStart.z };
+			return raycastBatch.AddRay(legRayStart, legRayEnd);
+		};
+		int leftLegRayIndex = addLegRay(unitychan.leftFootIKBone, 0.1f);
+		int rightLegRayIndex = addLegRay(unitychan.rightFootIKBone, 0.1f);
+		RayIntersectStage(raycastBatch);
 
-				bone.rayStart.x = bone.anklePosition.x;
-				bone.rayStart.y = bone.anklePosition.y + heightOffset;
-				bone.rayStart.z = bone.anklePosition.z;
+		if (raycastBatch.IsHit(groundRayIndex))
+		{
+			float floorPositionY = raycastBatch.GetHit(groundRayIndex).position.y;
 
-				bone.rayEnd.x = bone.rayStart.x;
-				bone.rayEnd.y = bone.rayStart.y - 100.0f;
-				bone.rayEnd.z = bone.rayStart.z;
+			// nʂɌăCLXg
+			auto raycastLegs = [this](FootIKBone& bone, int rayIndex)
+			{
+				bone.rayStart = raycastBatch.GetRayStart(rayIndex);
+				bone.rayEnd = raycastBatch.GetRayEnd(rayIndex);
+				bone.anklePosition = { bone.footNode->worldTransform._41, bone.footNode->worldTransform._42, bone.footNode->worldTransform._43 };
 
-				bone.hit = RayIntersectModel(bone.rayStart, bone.rayEnd, stage.model.get(), bone.hitResult);
+				bone.hit = raycastBatch.IsHit(rayIndex);
+				if (bone.hit)
+				{
+					bone.hitResult.position = raycastBatch.GetHit(rayIndex).position;
+					bone.hitResult.normal = raycastBatch.GetHit(rayIndex).normal;
+				}
 			};
-			raycastLegs(unitychan.leftFootIKBone, 0.1f);
-			raycastLegs(unitychan.rightFootIKBone, 0.1f);
+			raycastLegs(unitychan.leftFootIKBone, leftLegRayIndex);
+			raycastLegs(unitychan.rightFootIKBone, rightLegRayIndex);
 
 			// ̍ŏIIȈʒuvZ
 			auto computeAnkleTarget = [](FootIKBone& bone, float footHeight)
@@ -1435,10 +1560,11 @@ void CharacterControlScene::UpdateUnityChanIKBones()
 			DirectX::XMVECTOR HipWorldPosition = DirectX::XMVectorAdd(HipWorldTransform.r[3], HipsOffset);
 			DirectX::XMVECTOR HipLocalPosition = DirectX::XMVector3Transform(HipWorldPosition, InverseHipParentWorldTransform);
 			DirectX::XMStoreFloat3(&hipNode.position, HipLocalPosition);
-			ComputeWorldTransform(&hipNode);
+			unitychan.model->UpdateSubtree(unitychan.hipsNodeIndex);
 
 			// IK
-			auto computeFootIK = [](FootIKBone& bone)
+			Model* model = unitychan.model.get();
+			auto computeFootIK = [model](FootIKBone& bone)
 			{
 				if (!bone.hit) return;
 
@@ -1449,7 +1575,7 @@ void CharacterControlScene::UpdateUnityChanIKBones()
 				DirectX::XMStoreFloat3(&poleWorldPosition, PoleWorldPosition);
 
 				// IK
-				ComputeTwoBoneIK(bone.thighNode, bone.legNode, bone.footNode, bone.ankleTarget, poleWorldPosition);
+				ComputeTwoBoneIK(model, bone.thighNode, bone.legNode, bone.footNode, bone.ankleTarget, poleWorldPosition);
 
 				// ̉]nʂɍ킹
 				DirectX::XMMATRIX Leg = DirectX::XMLoadFloat4x4(&bone.legNode->worldTransform);
@@ -1476,7 +1602,7 @@ void CharacterControlScene::UpdateUnityChanIKBones()
 				DirectX::XMStoreFloat4(&bone.footNode->rotation, FootLocalRotation);
 
 				// [hsvZ
-				ComputeWorldTransform(bone.footNode);
+				model->UpdateSubtree(bone.footNode);
 
 			};
 			computeFootIK(unitychan.leftFootIKBone);
@@ -1496,18 +1622,20 @@ void CharacterControlScene::UpdateUnityChanIKBones()
 // jeB񕨗{[XV
 void CharacterControlScene::UpdateUnityChanPhysicsBones(float elapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	DirectX::XMFLOAT3 force = fieldForce;
 	force.y -= gravity;
 	force.x *= elapsedTime;
 	force.y *= elapsedTime;
 	force.z *= elapsedTime;
 
-	ComputePhysicsBones(unitychan.leftHairTailBones, unitychan.upperBodyCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
-	ComputePhysicsBones(unitychan.rightHairTailBones, unitychan.upperBodyCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
-	ComputePhysicsBones(unitychan.leftSkirtFrontBones, unitychan.leftLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
-	ComputePhysicsBones(unitychan.leftSkirtBackBones, unitychan.leftLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
-	ComputePhysicsBones(unitychan.rightSkirtFrontBones, unitychan.rightLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
-	ComputePhysicsBones(unitychan.rightSkirtBackBones, unitychan.rightLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
+	ComputePhysicsBones(unitychan.model.get(), unitychan.leftHairTailBones, unitychan.upperBodyCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
+	ComputePhysicsBones(unitychan.model.get(), unitychan.rightHairTailBones, unitychan.upperBodyCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
+	ComputePhysicsBones(unitychan.model.get(), unitychan.leftSkirtFrontBones, unitychan.leftLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
+	ComputePhysicsBones(unitychan.model.get(), unitychan.leftSkirtBackBones, unitychan.leftLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
+	ComputePhysicsBones(unitychan.model.get(), unitychan.rightSkirtFrontBones, unitychan.rightLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
+	ComputePhysicsBones(unitychan.model.get(), unitychan.rightSkirtBackBones, unitychan.rightLegCollisionBones, force, unitychan.maxPhysicsBoneVelocity);
 }
 
 // jeBAj[VĐ
@@ -1903,7 +2031,7 @@ void CharacterControlScene::UnityChanAirControl(float elapsedTime)
 			rayEnd.z = unitychan.position.z;
 
 			HitResult hit;
-			if (RayIntersectModel(rayStart, rayEnd, stage.model.get(), hit))
+			if (RayIntersectStage(rayStart, rayEnd, hit))
 			{
 				ChangeUnityChanState(UnityChan::State::Landing);
 			}
@@ -1981,108 +2109,9 @@ void CharacterControlScene::UnityChanStaffTrail()
 	DirectX::XMStoreFloat3(&unitychan.trailPositions[1][0], Tip);
 }
 
-// [g[V
-void CharacterControlScene::ComputeRootMotion(
-	const Model* model,
-	int rootMotionNodeIndex,
-	int animationIndex,
-	float oldAnimationSeconds,
-	float newAnimationSeconds,
-	DirectX::XMFLOAT3& translation,
-	DirectX::XMFLOAT3& rootMotionNodePosition,
-	bool bakeTranslationX,
-	bool bakeTranslationY,
-	bool bakeTranslationZ)
-{
-	// AOÃ[g[Vm[h̎p擾
-	Model::NodePose beginPose, oldPose, newPose;
-	model->ComputeAnimation(animationIndex, rootMotionNodeIndex, 0, beginPose);
-	model->ComputeAnimation(animationIndex, rootMotionNodeIndex, oldAnimationSeconds, oldPose);
-	model->ComputeAnimation(animationIndex, rootMotionNodeIndex, newAnimationSeconds, newPose);
-
-	// [JړlZo
-	DirectX::XMFLOAT3 localTranslation;
-	if (oldAnimationSeconds > newAnimationSeconds)
-	{
-		// [v
-		const Model::Animation& animation = model->GetAnimations().at(animationIndex);
-		Model::NodePose endPose;
-		model->ComputeAnimation(animationIndex, rootMotionNodeIndex, animation.secondsLength, endPose);
-
-		localTranslation.x = (endPose.position.x - oldPose.position.x) + (newPose.position.x - beginPose.position.x);
-		localTranslation.y = (endPose.position.y - oldPose.position.y) + (newPose.position.y - beginPose.position.y);
-		localTranslation.z = (endPose.position.z - oldPose.position.z) + (newPose.position.z - beginPose.position.z);
-	}
-	else
-	{
-		// ʏ폈
-		localTranslation.x = newPose.position.x - oldPose.position.x;
-		localTranslation.y = newPose.position.y - oldPose.position.y;
-		localTranslation.z = newPose.position.z - oldPose.position.z;
-	}
-
-	// O[oړlZo
-	const Model::Node& rootMotionNode = model->GetNodes().at(rootMotionNodeIndex);
-	DirectX::XMVECTOR LocalTranslation = DirectX::XMLoadFloat3(&localTranslation);
-	DirectX::XMMATRIX ParentGlobalTransform = DirectX::XMLoadFloat4x4(&rootMotionNode.parent->globalTransform);
-	DirectX::XMVECTOR GlobalTranslation = DirectX::XMVector3TransformNormal(LocalTranslation, ParentGlobalTransform);
-	DirectX::XMStoreFloat3(&translation, GlobalTranslation);
-
-	if (bakeTranslationX || bakeTranslationY || bakeTranslationZ)
-	{
-		// ړl𔲂
-		if (bakeTranslationX) translation.x = 0;
-		if (bakeTranslationY) translation.y = 0;
-		if (bakeTranslationZ) translation.z = 0;
-	
-		// ̎p̃[hʒuZo
-		DirectX::XMVECTOR LocalPosition = DirectX::XMLoadFloat3(&newPose.position);
-		DirectX::XMVECTOR GlobalPosition = DirectX::XMVector3Transform(LocalPosition, ParentGlobalTransform);
-
-		// XZ폜
-		if (bakeTranslationY && bakeTranslationZ)
-		{
-			GlobalPosition = DirectX::XMVectorSetX(GlobalPosition, 0);
-		}
-		else if (bakeTranslationX && bakeTranslationZ)
-		{
-			GlobalPosition = DirectX::XMVectorSetY(GlobalPosition, 0);
-		}
-		else if (bakeTranslationX && bakeTranslationY)
-		{
-			GlobalPosition = DirectX::XMVectorSetZ(GlobalPosition, 0);
-		}
-		else if (bakeTranslationX)
-		{
-			GlobalPosition = DirectX::XMVectorSetY(GlobalPosition, 0);
-			GlobalPosition = DirectX::XMVectorSetZ(GlobalPosition, 0);
-		}
-		else if (bakeTranslationY)
-		{
-			GlobalPosition = DirectX::XMVectorSetX(GlobalPosition, 0);
-			GlobalPosition = DirectX::XMVectorSetZ(GlobalPosition, 0);
-		}
-		else if (bakeTranslationZ)
-		{
-			GlobalPosition = DirectX::XMVectorSetX(GlobalPosition, 0);
-			GlobalPosition = DirectX::XMVectorSetY(GlobalPosition, 0);
-		}
-
-		// [Jԕϊ
-		DirectX::XMMATRIX InverseParentGlobalTransform = DirectX::XMMatrixInverse(nullptr, ParentGlobalTransform);
-		LocalPosition = DirectX::XMVector3Transform(GlobalPosition, InverseParentGlobalTransform);
-		// [g[Vm[ḧʒuݒ
-		DirectX::XMStoreFloat3(&rootMotionNodePosition, LocalPosition);
-	}
-	else
-	{
-		// [g[Vm[ḧʒüʒuɂ
-		rootMotionNodePosition = beginPose.position;
-	}
-}
-
 // {[vZ
 void CharacterControlScene::ComputePhysicsBones(
+	Model* model,
 	std::vector<PhysicsBone>& bones,
 	const std::vector<CollisionBone>& collisionBones,
 	const DirectX::XMFLOAT3& force,
@@ -2198,16 +2227,17 @@ void CharacterControlScene::ComputePhysicsBones(
 			ChildWorldTransform = DirectX::XMMatrixMultiply(ChildLocalTransform, WorldTransform);
 			DirectX::XMStoreFloat4x4(&child.worldTransform, ChildWorldTransform);
 		}
-		// m[hɔf
+		// m[hɔfi[JsƃO[os͎̃gXtH[XVōČvZj
 		bone.node->worldTransform = bone.worldTransform;
 		bone.node->rotation = bone.localRotation;
 		child.node->worldTransform = child.worldTransform;
+		model->MarkDirty(bone.node);
 	}
 
 }
 
 // TwoBoneIKvZ
-void CharacterControlScene::ComputeTwoBoneIK(Model::Node* rootBone, Model::Node* midBone, Model::Node* tipBone, const DirectX::XMFLOAT3& targetPosition, const DirectX::XMFLOAT3& polePosition)
+void CharacterControlScene::ComputeTwoBoneIK(Model* model, Model::Node* rootBone, Model::Node* midBone, Model::Node* tipBone, const DirectX::XMFLOAT3& targetPosition, const DirectX::XMFLOAT3& polePosition)
 {
 	// ^[QbgW擾
 	DirectX::XMVECTOR TargetWorldPosition = DirectX::XMLoadFloat3(&targetPosition);
@@ -2300,7 +2330,7 @@ void CharacterControlScene::ComputeTwoBoneIK(Model::Node* rootBone, Model::Node*
 
 	}
 	// [hsvZ
-	ComputeWorldTransform(rootBone);
+	model->UpdateSubtree(rootBone);
 
 	// ԃ{[Ɛ[{[̃[hW擾
 	MidWorldTransform = DirectX::XMLoadFloat4x4(&midBone->worldTransform);
@@ -2315,7 +2345,7 @@ void CharacterControlScene::ComputeTwoBoneIK(Model::Node* rootBone, Model::Node*
 	DirectX::XMVECTOR MidTargetDirection = DirectX::XMVector3Normalize(MidTargetVec);
 
 	rotateBone(midBone, MidTipDirection, MidTargetDirection);
-	ComputeWorldTransform(midBone);
+	model->UpdateSubtree(midBone);
 }
 
 // RW
@@ -2339,22 +2369,6 @@ void CharacterControlScene::ComputeCollisionBones(const std::vector<CollisionBon
 	}
 }
 
-// wm[hȉ̃[hsvZ
-void CharacterControlScene::ComputeWorldTransform(Model::Node* node)
-{
-	DirectX::XMMATRIX LocalRotationTransform = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node->rotation));
-	DirectX::XMMATRIX LocalPositionTransform = DirectX::XMMatrixTranslation(node->position.x, node->position.y, node->position.z);
-	DirectX::XMMATRIX LocalTransform = DirectX::XMMatrixMultiply(LocalRotationTransform, LocalPositionTransform);
-	DirectX::XMMATRIX ParentWorldTransform = DirectX::XMLoadFloat4x4(&node->parent->worldTransform);
-	DirectX::XMMATRIX WorldTransform = DirectX::XMMatrixMultiply(LocalTransform, ParentWorldTransform);
-	DirectX::XMStoreFloat4x4(&node->worldTransform, WorldTransform);
-
-	for (Model::Node* child : node->children)
-	{
-		ComputeWorldTransform(child);
-	}
-}
-
 // ƎOp`Ƃ̌𔻒肷
 bool CharacterControlScene::SphereIntersectTriangle(
 	const DirectX::XMFLOAT3& sphereCenter,
@@ -2492,7 +2506,7 @@ bool CharacterControlScene::SphereIntersectModel(
 	//	if (!sphere.Intersects(mesh.worldBounds)) continue;
 
 		// bṼXP[Oɂď𕪊򂷂
-		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&mesh.node->worldTransform);
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&model->GetNodes().at(mesh.nodeIndex).worldTransform);
 		float lengthSqAxisX = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(WorldTransform.r[0]));
 		float lengthSqAxisY = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(WorldTransform.r[1]));
 		float lengthSqAxisZ = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(WorldTransform.r[2]));
@@ -2613,7 +2627,7 @@ bool CharacterControlScene::RayIntersectModel(
 		//if (!mesh.worldBounds.Intersects(WorldRayStart, WorldRayDirection, length)) continue;
 
 		// C̃[Jԕϊ
-		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&mesh.node->worldTransform);
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&model->GetNodes().at(mesh.nodeIndex).worldTransform);
 		DirectX::XMMATRIX InverseWorldTransform = DirectX::XMMatrixInverse(nullptr, WorldTransform);
 		DirectX::XMVECTOR LocalRayStart = DirectX::XMVector3Transform(WorldRayStart, InverseWorldTransform);
 		DirectX::XMVECTOR LocalRayVec = DirectX::XMVector3TransformNormal(WorldRayVec, InverseWorldTransform);
@@ -2672,3 +2686,193 @@ bool CharacterControlScene::RayIntersectModel(
 	}
 	return hit;
 }
+
+// BVHƂ̌𔻒肷
+bool CharacterControlScene::SphereIntersectModel(
+	const DirectX::XMFLOAT3& sphereCenter,
+	const float sphereRadius,
+	const TriangleBVH& bvh,
+	std::vector<HitResult>& hits)
+{
+	hits.clear();
+
+	thread_local std::vector<int> triangleIndices;
+	DirectX::XMFLOAT3 center = sphereCenter;
+	bvh.QuerySphere(center, sphereRadius, triangleIndices);
+
+	// ƓԂŋƎOp`̏Փˏ
+	for (size_t i = 0; i < triangleIndices.size(); ++i)
+	{
+		const int triangleIndex = triangleIndices[i];
+		const TriangleBVH::Triangle& triangle = bvh.GetTriangle(triangleIndex);
+
+		DirectX::XMFLOAT3 hitPosition, hitNormal;
+		if (SphereIntersectTriangle(
+			center, sphereRadius,
+			triangle.positions[0], triangle.positions[1], triangle.positions[2],
+			hitPosition, hitNormal))
+		{
+			HitResult& hit = hits.emplace_back();
+			hit.position = hitPosition;
+			hit.normal = hitNormal;
+			center = hit.position;
+
+			// oꂽʒuŌWA̎Op`̎Op`瑱
+			bvh.QuerySphere(center, sphereRadius, triangleIndices);
+			i = static_cast<size_t>(std::upper_bound(triangleIndices.begin(), triangleIndices.end(), triangleIndex) - triangleIndices.begin()) - 1;
+		}
+	}
+
+	return hits.size() > 0;
+}
+
+// CBVHƂ̌𔻒肷
+bool CharacterControlScene::RayIntersectModel(
+	const DirectX::XMFLOAT3& rayStart,
+	const DirectX::XMFLOAT3& rayEnd,
+	const TriangleBVH& bvh,
+	HitResult& hitResult)
+{
+	TriangleBVH::HitResult hit;
+	if (bvh.RayCast(rayStart, rayEnd, hit))
+	{
+		hitResult.position = hit.position;
+		hitResult.normal = hit.normal;
+		return true;
+	}
+	return false;
+}
+
+// ƐÓIՓ˔胁bVƂ̌𔻒肷
+bool CharacterControlScene::SphereIntersectModel(
+	const DirectX::XMFLOAT3& sphereCenter,
+	const float sphereRadius,
+	const StaticCollisionMesh& collisionMesh,
+	std::vector<HitResult>& hits)
+{
+	hits.clear();
+
+	// AABBŃbVƃ`Ni荞ށio邽тɍ蒼j
+	DirectX::XMFLOAT3 queryMin = { sphereCenter.x - sphereRadius, sphereCenter.y - sphereRadius, sphereCenter.z - sphereRadius };
+	DirectX::XMFLOAT3 queryMax = { sphereCenter.x + sphereRadius, sphereCenter.y + sphereRadius, sphereCenter.z + sphereRadius };
+
+	// ƓԂŋƎOp`̏Փˏ
+	const std::vector<StaticCollisionMesh::Chunk>& chunks = collisionMesh.GetChunks();
+	const std::vector<StaticCollisionMesh::Triangle>& triangles = collisionMesh.GetTriangles();
+	DirectX::XMFLOAT3 center = sphereCenter;
+	for (const StaticCollisionMesh::Mesh& mesh : collisionMesh.GetMeshes())
+	{
+		if (!StaticCollisionMesh::IntersectBounds(queryMin, queryMax, mesh.boundsMin, mesh.boundsMax)) continue;
+
+		for (int chunkIndex = mesh.chunkStart; chunkIndex < mesh.chunkStart + mesh.chunkCount; ++chunkIndex)
+		{
+			const StaticCollisionMesh::Chunk& chunk = chunks[chunkIndex];
+			if (!StaticCollisionMesh::IntersectBounds(queryMin, queryMax, chunk.boundsMin, chunk.boundsMax)) continue;
+
+			for (int triangleIndex = chunk.triangleStart; triangleIndex < chunk.triangleStart + chunk.triangleCount; ++triangleIndex)
+			{
+				const StaticCollisionMesh::Triangle& triangle = triangles[triangleIndex];
+
+				DirectX::XMFLOAT3 hitPosition, hitNormal;
+				if (SphereIntersectTriangle(
+					center, sphereRadius,
+					triangle.position, triangle.GetPositionB(), triangle.GetPositionC(),
+					hitPosition, hitNormal))
+				{
+					HitResult& hit = hits.emplace_back();
+					hit.position = hitPosition;
+					hit.normal = hitNormal;
+					center = hit.position;
+
+					// ȍ~̃bVƃ`N͉oꂽʒuōi荞
+					queryMin = { center.x - sphereRadius, center.y - sphereRadius, center.z - sphereRadius };
+					queryMax = { center.x + sphereRadius, center.y + sphereRadius, center.z + sphereRadius };
+				}
+			}
+		}
+	}
+
+	return hits.size() > 0;
+}
+
+// CƐÓIՓ˔胁bVƂ̌𔻒肷
+bool CharacterControlScene::RayIntersectModel(
+	const DirectX::XMFLOAT3& rayStart,
+	const DirectX::XMFLOAT3& rayEnd,
+	const StaticCollisionMesh& collisionMesh,
+	HitResult& hitResult)
+{
+	StaticCollisionMesh::HitResult hit;
+	if (collisionMesh.RayCast(rayStart, rayEnd, hit))
+	{
+		hitResult.position = hit.position;
+		hitResult.normal = hit.normal;
+		return true;
+	}
+	return false;
+}
+
+// CƃXe[WƂ̌𔻒肷
+bool CharacterControlScene::RayIntersectStage(
+	const DirectX::XMFLOAT3& rayStart,
+	const DirectX::XMFLOAT3& rayEnd,
+	HitResult& hit) const
+{
+	if (stage.useBVH)
+	{
+		return RayIntersectModel(rayStart, rayEnd, stage.bvh, hit);
+	}
+	if (stage.useCollisionMesh)
+	{
+		return RayIntersectModel(rayStart, rayEnd, stage.collisionMesh, hit);
+	}
+	return RayIntersectModel(rayStart, rayEnd, stage.model.get(), hit);
+}
+
+// Cob`ƃXe[WƂ̌𔻒肷
+void CharacterControlScene::RayIntersectStage(RaycastBatch& batch) const
+{
+	// BVHƐÓIՓ˔胁bV̓pPbgł܂Ƃ߂Ĕ肵AȊO͂P{肷
+	if (stage.useBVH)
+	{
+		batch.Execute(stage.bvh);
+		return;
+	}
+	if (stage.useCollisionMesh)
+	{
+		batch.Execute(stage.collisionMesh);
+		return;
+	}
+	for (int i = 0; i < batch.GetRayCount(); ++i)
+	{
+		HitResult hit;
+		if (RayIntersectStage(batch.GetRayStart(i), batch.GetRayEnd(i), hit))
+		{
+			RaycastBatch::HitResult result;
+			result.position = hit.position;
+			result.normal = hit.normal;
+			batch.SetHit(i, &result);
+		}
+		else
+		{
+			batch.SetHit(i, nullptr);
+		}
+	}
+}
+
+// ƃXe[WƂ̌𔻒肷
+bool CharacterControlScene::SphereIntersectStage(
+	const DirectX::XMFLOAT3& sphereCenter,
+	const float sphereRadius,
+	std::vector<HitResult>& hits) const
+{
+	if (stage.useBVH)
+	{
+		return SphereIntersectModel(sphereCenter, sphereRadius, stage.bvh, hits);
+	}
+	if (stage.useCollisionMesh)
+	{
+		return SphereIntersectModel(sphereCenter, sphereRadius, stage.collisionMesh, hits);
+	}
+	return SphereIntersectModel(sphereCenter, sphereRadius, stage.model.get(), hits);
+}
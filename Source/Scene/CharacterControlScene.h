@@ -6,6 +6,14 @@
 #include "FreeCameraController.h"
 #include "Light.h"
 #include "Model.h"
+#include "AnimationBlendTree.h"
+#include "AnimationLOD.h"
+#include "CharacterController.h"
+#include "RootMotion.h"
+#include "RaycastBatch.h"
+#include "StaticCollisionMesh.h"
+#include "TriangleBVH.h"
+#include "TriangleBVHCollisionWorld.h"
 
 // LN^[V[
 class CharacterControlScene : public Scene
@@ -24,6 +32,10 @@ public:
 	void DrawGUI() override;
 
 private:
+	// Փ˔֐vEƍ
+	friend class MicroBenchmark;
+	friend class CollisionTest;
+
 	struct HitResult
 	{
 		DirectX::XMFLOAT3	position;
@@ -118,6 +130,7 @@ private:
 		DirectX::XMFLOAT3					angle;
 		DirectX::XMFLOAT4X4					transform;
 		float								radius = 0.4f;
+		float								height = 1.4f;
 
 		// ͊֘A
 		float								inputAxisX = 0;
@@ -139,10 +152,13 @@ private:
 		bool								animationPlaying = false;
 		bool								computeRootMotion = false;
 		int									rootMotionNodeIndex = -1;
+		std::unique_ptr<RootMotion>			rootMotion;
 		DirectX::XMFLOAT3					rootMotionTranslation = { 0, 0, 0 };
 
 		std::vector<Model::NodePose>		nodePoses;
 		std::vector<Model::NodePose>		cacheNodePoses;
+		AnimationBlendTree					blendTree;
+		AnimationLOD::Instance				lod;
 
 		// ړ֘A
 		DirectX::XMFLOAT3					velocity = { 0, 0, 0 };
@@ -160,6 +176,8 @@ private:
 		float								groundAdjust = 0.1f;
 		bool								onGround = false;
 		std::vector<HitResult>				hits;
+		CharacterController					controller;
+		bool								useCharacterController = false;
 		
 		// U֘A
 		bool								combo = false;
@@ -201,6 +219,12 @@ private:
 	struct Stage
 	{
 		std::shared_ptr<Model>				model;
+		DirectX::XMFLOAT4X4					transform = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		StaticCollisionMesh					collisionMesh;
+		TriangleBVH							bvh;
+		TriangleBVHCollisionWorld			collisionWorld;
+		bool								useBVH = true;
+		bool								useCollisionMesh = true;
 	};
 
 	struct Ball
@@ -222,6 +246,9 @@ private:
 	// Xe[WZbgAbv
 	void SetupStage(ID3D11Device* device);
 
+	// Xe[WXV
+	void UpdateStage();
+
 	// {[ZbgAbv
 	void SetupBalls(ID3D11Device* device);
 
@@ -291,21 +318,9 @@ private:
 	// jeBX^btg[XV
 	void UnityChanStaffTrail();
 
-	// [g[V
-	static void ComputeRootMotion(
-		const Model* model,
-		int rootMotionNodeIndex,
-		int animationIndex,
-		float oldAnimationSeconds,
-		float newAnimationSeconds,
-		DirectX::XMFLOAT3& translation,
-		DirectX::XMFLOAT3& rootMotionNodePosition,
-		bool bakeTranslationX,
-		bool bakeTranslationY,
-		bool bakeTranslationZ);
-
 	// {[vZ
 	static void ComputePhysicsBones(
+		Model* model,
 		std::vector<PhysicsBone>& bones,
 		const std::vector<CollisionBone>& collisionBones,
 		const DirectX::XMFLOAT3& force,
@@ -313,6 +328,7 @@ private:
 
 	// TwoBoneIKvZ
 	static void ComputeTwoBoneIK(
+		Model* model,
 		Model::Node* rootBone,
 		Model::Node* midBone,
 		Model::Node* tipBone,
@@ -325,9 +341,6 @@ private:
 		DirectX::XMVECTOR& Position,
 		float radius);
 
-	// wm[hȉ̃[hsvZ
-	static void ComputeWorldTransform(Model::Node* node);
-
 	// ƎOp`Ƃ̌𔻒肷
 	static bool SphereIntersectTriangle(
 		const DirectX::XMFLOAT3& sphereCenter,
@@ -345,6 +358,20 @@ private:
 		const Model* model,
 		std::vector<HitResult>& hits);
 
+	// BVHƂ̌𔻒肷
+	static bool SphereIntersectModel(
+		const DirectX::XMFLOAT3& sphereCenter,
+		const float sphereRadius,
+		const TriangleBVH& bvh,
+		std::vector<HitResult>& hits);
+
+	// ƐÓIՓ˔胁bVƂ̌𔻒肷
+	static bool SphereIntersectModel(
+		const DirectX::XMFLOAT3& sphereCenter,
+		const float sphereRadius,
+		const StaticCollisionMesh& collisionMesh,
+		std::vector<HitResult>& hits);
+
 	// CƃfƂ̌𔻒肷
 	static bool RayIntersectModel(
 		const DirectX::XMFLOAT3& rayStart,
@@ -352,6 +379,35 @@ private:
 		const Model* model,
 		HitResult& hit);
 
+	// CBVHƂ̌𔻒肷
+	static bool RayIntersectModel(
+		const DirectX::XMFLOAT3& rayStart,
+		const DirectX::XMFLOAT3& rayEnd,
+		const TriangleBVH& bvh,
+		HitResult& hit);
+
+	// CƐÓIՓ˔胁bVƂ̌𔻒肷
+	static bool RayIntersectModel(
+		const DirectX::XMFLOAT3& rayStart,
+		const DirectX::XMFLOAT3& rayEnd,
+		const StaticCollisionMesh& collisionMesh,
+		HitResult& hit);
+
+	// CƃXe[WƂ̌𔻒肷
+	bool RayIntersectStage(
+		const DirectX::XMFLOAT3& rayStart,
+		const DirectX::XMFLOAT3& rayEnd,
+		HitResult& hit) const;
+
+	// Cob`ƃXe[WƂ̌𔻒肷io^SẴČʂob`Ɋi[j
+	void RayIntersectStage(RaycastBatch& batch) const;
+
+	// ƃXe[WƂ̌𔻒肷
+	bool SphereIntersectStage(
+		const DirectX::XMFLOAT3& sphereCenter,
+		const float sphereRadius,
+		std::vector<HitResult>& hits) const;
+
 	// bQ[t[ɕϊ
 	static float ConvertToGameFrame(float seconds) { return seconds * 60.0f; }
 
@@ -360,7 +416,9 @@ private:
 	FreeCameraController					cameraController;
 	LightManager							lightManager;
 	UnityChan								unitychan;
+	AnimationLOD							animationLOD;
 	Stage									stage;
+	RaycastBatch							raycastBatch;
 	std::vector<Ball>						balls;
 	ThirdPersonCamera						thirdPersonCamera;
 
@@ -1,5 +1,6 @@
 #include <imgui.h>
 #include "Graphics.h"
+#include "Input.h"
 #include "Scene/ConfirmCommandScene.h"
 
 // RXgN^
@@ -34,12 +35,12 @@ ConfirmCommandScene::ConfirmCommandScene()
 void ConfirmCommandScene::Update(float elapsedTime)
 {
 	// L[͏擾
-	bool up = GetAsyncKeyState('W') & 0x8000;
-	bool left = GetAsyncKeyState('A') & 0x8000;
-	bool down = GetAsyncKeyState('S') & 0x8000;
-	bool right = GetAsyncKeyState('D') & 0x8000;
-	bool punch = GetAsyncKeyState('P') & 0x8000;
-	bool kick = GetAsyncKeyState('K') & 0x8000;
+	bool up = Input::Instance().IsKeyPressed('W');
+	bool left = Input::Instance().IsKeyPressed('A');
+	bool down = Input::Instance().IsKeyPressed('S');
+	bool right = Input::Instance().IsKeyPressed('D');
+	bool punch = Input::Instance().IsKeyPressed('P');
+	bool kick = Input::Instance().IsKeyPressed('K');
 
 	InputKey key = 0;
 	key |= (!up && down && left && !right) ? KEY_1 : NOT_1;
@@ -69,7 +70,7 @@ void ConfirmCommandScene::Update(float elapsedTime)
 	// w莞Ԃ̃Aj[V
 	if (animationIndex >= 0)
 	{
-		character->ComputeAnimation(animationIndex, animationSeconds, nodePoses);
+		character->ComputeAnimation(animationIndex, animationSeconds, nodePoses, animationCursor);
 
 		// ԍXV
 		const Model::Animation& animation = character->GetAnimations().at(animationIndex);
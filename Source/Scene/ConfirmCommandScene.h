@@ -70,6 +70,7 @@ private:
 	std::unique_ptr<Sprite>				sprite;
 	std::shared_ptr<Model>				character;
 	std::vector<Model::NodePose>		nodePoses;
+	Model::AnimationCursor				animationCursor;
 	int									animationIndex = -1;
 	float								animationSeconds = 0;
 
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <imgui.h>
+#include "Graphics.h"
+#include "Misc.h"
+#include "Scene/CrowdAnimationScene.h"
+
+// RXgN^
+CrowdAnimationScene::CrowdAnimationScene()
+{
+	ID3D11Device* device = Graphics::Instance().GetDevice();
+	float screenWidth = Graphics::Instance().GetScreenWidth();
+	float screenHeight = Graphics::Instance().GetScreenHeight();
+
+	// Jݒ
+	camera.SetPerspectiveFov(
+		DirectX::XMConvertToRadians(45),	// p
+		screenWidth / screenHeight,			// ʃAXyNg
+		0.1f,								// jANbv
+		1000.0f								// t@[Nbv
+	);
+	camera.SetLookAt(
+		{ 0, 8, -12 },		// _
+		{ 0, 0, 10 },		// _
+		{ 0, 1, 0 }			// xNg
+	);
+	cameraController.SyncCameraToController(camera);
+
+	// fǂݍ݁iSCX^XŃ\[XLj
+	resource = ModelResource::Load(device, "Data/Model/RPG-Character/RPG-Character.glb");
+	CreateInstances();
+}
+
+// CX^X쐬
+void CrowdAnimationScene::CreateInstances()
+{
+	const int animationCount = static_cast<int>(resource->GetAnimations().size());
+	const int columnCount = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(instanceCount))));
+
+	// NbvƍĐʒu͌ꂽgݍ킹Iԁigݍ킹̃CX^X͎pLłj
+	std::mt19937 random(0);
+	std::uniform_int_distribution<int> randomClip(0, (std::max)(0, (std::min)(clipCount, animationCount) - 1));
+	std::uniform_int_distribution<int> randomPhase(0, (std::max)(0, phaseCount - 1));
+
+	instances.resize(instanceCount);
+	animationSystem.Clear();
+	for (int i = 0; i < instanceCount; ++i)
+	{
+		Instance& instance = instances.at(i);
+		if (instance.model == nullptr)
+		{
+			instance.model = std::make_shared<Model>(resource);
+			instance.model->SetCompressedAnimationEnabled(true);
+			instance.model->GetNodePoses(instance.nodePoses);
+		}
+		instance.lod.frameOffset = i;
+		instance.position.x = (i % columnCount - columnCount * 0.5f) * 2.0f;
+		instance.position.z = (i / columnCount) * 2.0f;
+		instance.animationIndex = animationCount > 0 ? randomClip(random) : -1;
+		instance.timeOffset = instance.animationIndex >= 0
+			? resource->GetAnimations().at(instance.animationIndex).secondsLength * randomPhase(random) / phaseCount
+			: 0.0f;
+		animationSystem.AddInstance(instance.model.get());
+	}
+}
+
+// XV
+void CrowdAnimationScene::Update(float elapsedTime)
+{
+	// JXV
+	cameraController.Update();
+	cameraController.SyncControllerToCamera(camera);
+
+	animationSeconds += elapsedTime;
+
+	Benchmark benchmark;
+	benchmark.begin();
+
+	// CX^X̍ĐԂƃJ̋
+	DirectX::XMVECTOR Eye = DirectX::XMLoadFloat3(&camera.GetEye());
+	for (Instance& instance : instances)
+	{
+		if (instance.animationIndex >= 0)
+		{
+			const Model::Animation& animation = resource->GetAnimations().at(instance.animationIndex);
+			instance.time = fmodf(animationSeconds + instance.timeOffset, animation.secondsLength);
+		}
+		DirectX::XMVECTOR Position = DirectX::XMLoadFloat3(&instance.position);
+		instance.distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(Position, Eye)));
+	}
+
+	if (useAnimationSystem)
+	{
+		// Xe[WɑSCX^XvZ
+		for (size_t i = 0; i < instances.size(); ++i)
+		{
+			const Instance& instance = instances.at(i);
+			AnimationSystem::Instance& systemInstance = animationSystem.GetInstance(static_cast<int>(i));
+			systemInstance.animationIndex = instance.animationIndex;
+			systemInstance.time = instance.time;
+			systemInstance.distance = instance.distance;
+			DirectX::XMStoreFloat4x4(&systemInstance.worldTransform, DirectX::XMMatrixTranslation(instance.position.x, instance.position.y, instance.position.z));
+		}
+		animationSystem.SetLOD(useLOD ? &animationLOD : nullptr);
+		animationSystem.SetPoseCache(usePoseCache ? &poseCache : nullptr, useQuantize);
+		animationSystem.Update(elapsedTime);
+	}
+	else
+	{
+		UpdateInstances(elapsedTime);
+	}
+
+	updateTime = benchmark.end() * 1000.0f;
+}
+
+// CX^XP̂XV
+void CrowdAnimationScene::UpdateInstances(float elapsedTime)
+{
+	poseCache.BeginFrame();
+	animationLOD.BeginFrame();
+	for (Instance& instance : instances)
+	{
+		Model* model = instance.model.get();
+		if (instance.animationIndex >= 0)
+		{
+			const float time = instance.time;
+			const float distance = instance.distance;
+
+			if (useLOD)
+			{
+				// ōXVpxƌvZm[h炷iTvO̓LbVƕpłj
+				animationLOD.UpdateLevel(instance.lod, distance);
+				animationLOD.ComputeAnimation(instance.lod, model, instance.animationIndex, time, elapsedTime,
+					instance.nodePoses, usePoseCache ? &poseCache : nullptr);
+				model->SetNodePoses(instance.nodePoses);
+			}
+			else if (usePoseCache)
+			{
+				// CX^XقǑeԂɊۂ߂ċL
+				int quantizeStep = useQuantize ? poseCache.ComputeQuantizeStep(distance) : 0;
+				AnimationPoseCache::PoseSpan pose = poseCache.GetPose(model, instance.animationIndex, time, quantizeStep);
+				model->SetNodePoses(pose.data, pose.size);
+
+#if defined(_DEBUG)
+				// ʎqȂꍇ͌ʂɌvZpƈv邩mF
+				if (quantizeStep == 0 && &instance == &instances.front())
+				{
+					model->ComputeAnimation(instance.animationIndex, time, instance.nodePoses, instance.cursor);
+					DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(1.0e-4f);
+					for (size_t i = 0; i < pose.size; ++i)
+					{
+						_ASSERT_EXPR(DirectX::XMVector3NearEqual(DirectX::XMLoadFloat3(&pose[i].position), DirectX::XMLoadFloat3(&instance.nodePoses[i].position), Epsilon), L"cached pose position mismatch");
+						_ASSERT_EXPR(DirectX::XMVector4NearEqual(DirectX::XMLoadFloat4(&pose[i].rotation), DirectX::XMLoadFloat4(&instance.nodePoses[i].rotation), Epsilon), L"cached pose rotation mismatch");
+					}
+				}
+#endif
+			}
+			else
+			{
+				model->ComputeAnimation(instance.animationIndex, time, instance.nodePoses, instance.cursor);
+				model->SetNodePoses(instance.nodePoses);
+			}
+		}
+
+		// gXtH[XV
+		DirectX::XMFLOAT4X4 worldTransform;
+		DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixTranslation(instance.position.x, instance.position.y, instance.position.z));
+		model->UpdateTransform(worldTransform);
+	}
+}
+
+// `揈
+void CrowdAnimationScene::Render(float elapsedTime)
+{
+	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
+	RenderState* renderState = Graphics::Instance().GetRenderState();
+	PrimitiveRenderer* primitiveRenderer = Graphics::Instance().GetPrimitiveRenderer();
+	ModelRenderer* modelRenderer = Graphics::Instance().GetModelRenderer();
+
+	// _[Xe[gݒ
+	dc->OMSetBlendState(renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
+	dc->OMSetDepthStencilState(renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
+	dc->RSSetState(renderState->GetRasterizerState(RasterizerState::SolidCullNone));
+
+	// Obh`
+	primitiveRenderer->DrawGrid(40, 1);
+	primitiveRenderer->Render(dc, camera.GetView(), camera.GetProjection(), D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+
+	// `ReLXgݒ
+	RenderContext rc;
+	rc.deviceContext = dc;
+	rc.renderState = renderState;
+	rc.camera = &camera;
+
+	// f`iXVł̓XLjOpbgvZς݂Ȃ̂ŕ`掞ɌvZȂj
+	for (size_t i = 0; i < instances.size(); ++i)
+	{
+		const Instance& instance = instances.at(i);
+		const std::vector<DirectX::XMFLOAT4X4>& palette = animationSystem.GetInstance(static_cast<int>(i)).palette;
+		if (useAnimationSystem && !palette.empty())
+		{
+			modelRenderer->Draw(ShaderId::Basic, instance.model, palette.data());
+		}
+		else
+		{
+			modelRenderer->Draw(ShaderId::Basic, instance.model);
+		}
+	}
+	modelRenderer->Render(rc);
+}
+
+// GUI`揈
+void CrowdAnimationScene::DrawGUI()
+{
+	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
+	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + 10), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(320, 360), ImGuiCond_Once);
+
+	if (ImGui::Begin(u8"QOAj[V"))
+	{
+		// CX^X\
+		bool changed = false;
+		changed |= ImGui::SliderInt("Instances", &instanceCount, 1, 1000);
+		changed |= ImGui::SliderInt("Clips", &clipCount, 1, 8);
+		changed |= ImGui::SliderInt("Phases", &phaseCount, 1, 16);
+		if (changed)
+		{
+			CreateInstances();
+		}
+
+		ImGui::Checkbox(u8"XV", &useAnimationSystem);
+		ImGui::Checkbox(u8"Aj[VLOD", &useLOD);
+		ImGui::Checkbox(u8"pLbV", &usePoseCache);
+		if (useAnimationSystem && useLOD)
+		{
+			ImGui::TextDisabled(u8"iXVłLODƎpLbV͕pȂj");
+		}
+		if (usePoseCache && !useLOD)
+		{
+			ImGui::Checkbox(u8"ŎԂʎq", &useQuantize);
+			if (useQuantize)
+			{
+				AnimationPoseCache::QuantizePolicy policy = poseCache.GetQuantizePolicy();
+				ImGui::DragFloat("NearDistance", &policy.nearDistance, 0.1f, 0.0f, 100.0f);
+				ImGui::DragFloat("DoubleDistance", &policy.doubleDistance, 0.1f, 1.0f, 100.0f);
+				int maxStepShift = 0;
+				while ((2 << maxStepShift) <= policy.maxStep) ++maxStepShift;
+				if (ImGui::SliderInt("MaxStep (2^n)", &maxStepShift, 0, 4))
+				{
+					policy.maxStep = 1 << maxStepShift;
+				}
+				poseCache.SetQuantizePolicy(policy);
+			}
+		}
+
+		// x̃CX^X
+		if (useLOD && ImGui::CollapsingHeader("LOD", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			int levelCounts[8] = {};
+			for (int i = 0; i < static_cast<int>(instances.size()); ++i)
+			{
+				int level = useAnimationSystem ? animationSystem.GetInstance(i).lod.level : instances.at(i).lod.level;
+				++levelCounts[(std::min)(level, 7)];
+			}
+			for (int level = 0; level < animationLOD.GetLevelCount() && level < 8; ++level)
+			{
+				const AnimationLOD::Level& settings = animationLOD.GetLevel(level);
+				ImGui::Text("LOD%d (%.0fm) : %d  1/%d skip%d%s%s%s", level, settings.distance, levelCounts[level],
+					settings.updateInterval, settings.skipLeafDepth,
+					settings.interpolate ? " lerp" : "", settings.physicsBones ? " phys" : "", settings.ik ? " ik" : "");
+			}
+		}
+
+		// vZʁiLbVgȂꍇ͗vƓvZALOD͊Ԉvj
+		ImGui::Separator();
+		if (usePoseCache && !(useAnimationSystem && useLOD))
+		{
+			ImGui::Text("Samples : %d / %d", poseCache.GetSampleCount(), poseCache.GetRequestCount());
+		}
+		else if (!useLOD)
+		{
+			ImGui::Text("Samples : %d / %d", static_cast<int>(instances.size()), static_cast<int>(instances.size()));
+		}
+		ImGui::Text("Update : %.3f ms", updateTime);
+		if (useAnimationSystem)
+		{
+			// Xe[W̌vZ
+			ImGui::Text("  Sample    : %.3f ms", animationSystem.GetStageTime(AnimationSystem::Stage::Sample));
+			ImGui::Text("  Blend     : %.3f ms", animationSystem.GetStageTime(AnimationSystem::Stage::Blend));
+			ImGui::Text("  Hierarchy : %.3f ms", animationSystem.GetStageTime(AnimationSystem::Stage::Hierarchy));
+			ImGui::Text("  Palette   : %.3f ms", animationSystem.GetStageTime(AnimationSystem::Stage::Palette));
+		}
+	}
+	ImGui::End();
+}
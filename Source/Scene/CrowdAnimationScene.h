@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Scene.h"
+#include "Camera.h"
+#include "FreeCameraController.h"
+#include "Model.h"
+#include "AnimationPoseCache.h"
+#include "AnimationLOD.h"
+#include "AnimationSystem.h"
+
+// QOAj[VV[
+class CrowdAnimationScene : public Scene
+{
+public:
+	CrowdAnimationScene();
+	~CrowdAnimationScene() override = default;
+
+	// XV
+	void Update(float elapsedTime) override;
+
+	// `揈
+	void Render(float elapsedTime) override;
+
+	// GUI`揈
+	void DrawGUI() override;
+
+private:
+	// CX^X쐬
+	void CreateInstances();
+
+	// CX^XP̂XV
+	void UpdateInstances(float elapsedTime);
+
+private:
+	struct Instance
+	{
+		std::shared_ptr<Model>			model;
+		std::vector<Model::NodePose>	nodePoses;		// LbVgȂꍇ̎p
+		Model::AnimationCursor			cursor;
+		AnimationLOD::Instance			lod;
+		DirectX::XMFLOAT3				position = { 0, 0, 0 };
+		int								animationIndex = 0;
+		float							timeOffset = 0;
+		float							time = 0;
+		float							distance = 0;			// J̋
+	};
+
+	Camera								camera;
+	FreeCameraController				cameraController;
+	std::shared_ptr<ModelResource>		resource;
+	std::vector<Instance>				instances;
+	AnimationPoseCache					poseCache;
+	AnimationLOD						animationLOD;
+	AnimationSystem						animationSystem;
+	float								animationSeconds = 0;
+
+	int									instanceCount = 200;
+	int									clipCount = 3;			// ĐNbv̎
+	int									phaseCount = 4;			// Đʒû炵̎
+	bool								usePoseCache = true;
+	bool								useQuantize = true;
+	bool								useLOD = true;
+	bool								useAnimationSystem = true;
+	float								updateTime = 0;			// Aj[VXVԁi~bj
+};
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <imgui.h>
+#include "Graphics.h"
+#include "Misc.h"
+#include "JobSystem.h"
+#include "Model.h"
+#include "AnimationSystem.h"
+#include "TriangleBVH.h"
+#include "Scene/JobSystemScene.h"
+
+// RXgN^
+JobSystemScene::JobSystemScene()
+{
+	float screenWidth = Graphics::Instance().GetScreenWidth();
+	float screenHeight = Graphics::Instance().GetScreenHeight();
+
+	// Jݒ
+	camera.SetPerspectiveFov(
+		DirectX::XMConvertToRadians(45),	// p
+		screenWidth / screenHeight,			// ʃAXyNg
+		0.1f,								// jANbv
+		1000.0f								// t@[Nbv
+	);
+	camera.SetLookAt(
+		{ 3, 2, 3 },		// _
+		{ 0, 1, 0 },		// _
+		{ 0, 1, 0 }			// xNg
+	);
+	cameraController.SyncCameraToController(camera);
+}
+
+// XV
+void JobSystemScene::Update(float elapsedTime)
+{
+	// JXV
+	cameraController.Update();
+	cameraController.SyncControllerToCamera(camera);
+}
+
+// `揈
+void JobSystemScene::Render(float elapsedTime)
+{
+	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
+	RenderState* renderState = Graphics::Instance().GetRenderState();
+	PrimitiveRenderer* primitiveRenderer = Graphics::Instance().GetPrimitiveRenderer();
+
+	// _[Xe[gݒ
+	dc->OMSetBlendState(renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
+	dc->OMSetDepthStencilState(renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
+	dc->RSSetState(renderState->GetRasterizerState(RasterizerState::SolidCullNone));
+
+	// Obh`
+	primitiveRenderer->DrawGrid(20, 1);
+	primitiveRenderer->Render(dc, camera.GetView(), camera.GetProjection(), D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+}
+
+// GUI`揈
+void JobSystemScene::DrawGUI()
+{
+	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
+	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + 10), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_Once);
+
+	if (ImGui::Begin(u8"WuVXe"))
+	{
+		ImGui::TextWrapped(u8"GPU\[X쐬ɁAAj[VƃCLXgXbhςČv܂BPipeline̓TvOXLjOpbg܂łXe[WɕvZ܂B");
+		ImGui::Text("Threads : %d", JobSystem::Instance().GetThreadCount());
+
+		ImGui::InputInt("Instances", &instanceCount);
+		ImGui::InputInt("Raycasts", &raycastCount);
+		ImGui::InputInt("LoopCount", &loopCount);
+		instanceCount = (std::max)(1, instanceCount);
+		raycastCount = (std::max)(1, raycastCount);
+		loopCount = (std::max)(1, loopCount);
+		if (ImGui::Button(u8"v"))
+		{
+			RunStressTest();
+		}
+
+		// ʕ\iP[ṽ~bƂPXbhɑ΂鑬xj
+		if (!stressTestResults.empty())
+		{
+			const StressTestResult& base = stressTestResults.front();
+			ImGui::Columns(7);
+			ImGui::Text("Threads"); ImGui::NextColumn();
+			ImGui::Text("Animation"); ImGui::NextColumn();
+			ImGui::Text("Speedup"); ImGui::NextColumn();
+			ImGui::Text("Pipeline"); ImGui::NextColumn();
+			ImGui::Text("Speedup"); ImGui::NextColumn();
+			ImGui::Text("Raycast"); ImGui::NextColumn();
+			ImGui::Text("Speedup"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (const StressTestResult& result : stressTestResults)
+			{
+				ImGui::Text("%d", result.threadCount); ImGui::NextColumn();
+				ImGui::Text("%.3f", result.animationTime); ImGui::NextColumn();
+				ImGui::Text("x%.2f", base.animationTime / result.animationTime); ImGui::NextColumn();
+				ImGui::Text("%.3f", result.pipelineTime); ImGui::NextColumn();
+				ImGui::Text("x%.2f", base.pipelineTime / result.pipelineTime); ImGui::NextColumn();
+				ImGui::Text("%.3f", result.raycastTime); ImGui::NextColumn();
+				ImGui::Text("x%.2f", base.raycastTime / result.raycastTime); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+		}
+	}
+	ImGui::End();
+}
+
+// XbhςȂ瓯v
+void JobSystemScene::RunStressTest()
+{
+	JobSystem& jobSystem = JobSystem::Instance();
+
+	// GPU\[X쐬ɓǂݍ
+	std::shared_ptr<ModelResource> characterResource = std::make_shared<ModelResource>(nullptr, "Data/Model/RPG-Character/RPG-Character.glb");
+	std::shared_ptr<ModelResource> stageResource = std::make_shared<ModelResource>(nullptr, "Data/Model/Stage/ExampleStage.glb");
+
+	// Aj[VCX^X
+	struct Instance
+	{
+		std::unique_ptr<Model>			model;
+		std::vector<Model::NodePose>	nodePoses;
+		Model::AnimationCursor			cursor;
+	};
+	std::vector<Instance> instances(instanceCount);
+	for (Instance& instance : instances)
+	{
+		instance.model = std::make_unique<Model>(characterResource);
+		instance.model->GetNodePoses(instance.nodePoses);
+	}
+	const int animationIndex = 0;
+	const float animationLength = characterResource->GetAnimations().empty() ? 0.0f : characterResource->GetAnimations().at(animationIndex).secondsLength;
+
+	// Xe[WɕvZAj[VpCvCifgAXLjOpbg܂ŌvZj
+	AnimationSystem animationSystem;
+	for (Instance& instance : instances)
+	{
+		animationSystem.AddInstance(instance.model.get());
+	}
+
+	// Xe[WŜɐ^ォ΂C
+	Model stage(stageResource);
+	TriangleBVH bvh;
+	bvh.Build(&stage);
+	if (bvh.GetNodes().empty()) return;
+	const TriangleBVH::Node& root = bvh.GetNodes().front();
+	const int rayDivision = static_cast<int>(sqrtf(static_cast<float>(raycastCount))) + 1;
+	std::vector<float> rayDistances(raycastCount);
+
+	// CX^XɎԂ炵ăAj[V
+	auto animate = [&](int loop, int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			Instance& instance = instances[i];
+			if (animationLength > 0.0f)
+			{
+				float time = fmodf(i * 0.037f + loop * (1.0f / 60.0f), animationLength);
+				instance.model->ComputeAnimation(animationIndex, time, instance.nodePoses, instance.cursor);
+				instance.model->SetNodePoses(instance.nodePoses);
+			}
+			DirectX::XMFLOAT4X4 worldTransform;
+			DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixTranslation(static_cast<float>(i), 0, 0));
+			instance.model->UpdateTransform(worldTransform);
+		}
+	};
+
+	// iqɃCLXgċL^
+	auto raycast = [&](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			float x = root.boundsMin.x + (root.boundsMax.x - root.boundsMin.x) * (i % rayDivision) / rayDivision;
+			float z = root.boundsMin.z + (root.boundsMax.z - root.boundsMin.z) * (i / rayDivision) / rayDivision;
+			DirectX::XMFLOAT3 start = { x, root.boundsMax.y + 1.0f, z };
+			DirectX::XMFLOAT3 end = { x, root.boundsMin.y - 1.0f, z };
+			TriangleBVH::HitResult hit;
+			rayDistances[i] = bvh.RayCast(start, end, hit) ? hit.distance : -1.0f;
+		}
+	};
+
+	// pCvC̓͐ݒ
+	auto setupPipeline = [&](int loop)
+	{
+		for (int i = 0; i < instanceCount; ++i)
+		{
+			AnimationSystem::Instance& instance = animationSystem.GetInstance(i);
+			instance.animationIndex = animationLength > 0.0f ? animationIndex : -1;
+			instance.time = animationLength > 0.0f ? fmodf(i * 0.037f + loop * (1.0f / 60.0f), animationLength) : 0.0f;
+			DirectX::XMStoreFloat4x4(&instance.worldTransform, DirectX::XMMatrixTranslation(static_cast<float>(i), 0, 0));
+		}
+	};
+
+	// PXbh_RA܂Ōv
+	const int maxThreadCount = (std::max)(1, static_cast<int>(std::thread::hardware_concurrency()));
+	std::vector<float> expectedDistances;
+	std::vector<DirectX::XMFLOAT4X4> expectedTransforms;
+	stressTestResults.clear();
+	Benchmark benchmark;
+	for (int threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+	{
+		jobSystem.Initialize(threadCount);
+
+		StressTestResult& result = stressTestResults.emplace_back();
+		result.threadCount = threadCount;
+
+		// Aj[V
+		benchmark.begin();
+		for (int loop = 0; loop < loopCount; ++loop)
+		{
+			jobSystem.ParallelFor(instanceCount, 8, [&](int begin, int end) { animate(loop, begin, end); });
+		}
+		result.animationTime = benchmark.end() * 1000.0f / loopCount;
+
+		// CLXg
+		benchmark.begin();
+		for (int loop = 0; loop < loopCount; ++loop)
+		{
+			jobSystem.ParallelFor(raycastCount, 256, raycast);
+		}
+		result.raycastTime = benchmark.end() * 1000.0f / loopCount;
+
+#if defined(_DEBUG)
+		// Xbhɂ炸PXbhƓʂɂȂ邩mF
+		if (threadCount == 1)
+		{
+			expectedDistances = rayDistances;
+			for (const Instance& instance : instances)
+			{
+				expectedTransforms.emplace_back(instance.model->GetNodes().back().worldTransform);
+			}
+		}
+		else
+		{
+			_ASSERT_EXPR(rayDistances == expectedDistances, L"parallel raycast result mismatch");
+			for (size_t i = 0; i < instances.size(); ++i)
+			{
+				const DirectX::XMFLOAT4X4& actual = instances.at(i).model->GetNodes().back().worldTransform;
+				_ASSERT_EXPR(memcmp(&actual, &expectedTransforms.at(i), sizeof(actual)) == 0, L"parallel animation result mismatch");
+			}
+		}
+
+		// SCfbNX傤ǂP񂸂邩mF
+		std::vector<std::atomic<int>> visits(1000);
+		jobSystem.ParallelFor(static_cast<int>(visits.size()), 7, [&](int begin, int end)
+		{
+			for (int i = begin; i < end; ++i) visits[i]++;
+		});
+		for (const std::atomic<int>& visit : visits)
+		{
+			_ASSERT_EXPR(visit == 1, L"parallel for visited index count mismatch");
+		}
+#endif
+
+		// Aj[VpCvC
+		benchmark.begin();
+		for (int loop = 0; loop < loopCount; ++loop)
+		{
+			setupPipeline(loop);
+			animationSystem.Update(1.0f / 60.0f);
+		}
+		result.pipelineTime = benchmark.end() * 1000.0f / loopCount;
+	}
+
+	// ̃Xbhɖ߂
+	jobSystem.Initialize();
+}
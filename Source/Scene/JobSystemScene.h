@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include "Scene.h"
+#include "Camera.h"
+#include "FreeCameraController.h"
+
+// WuVXeV[
+class JobSystemScene : public Scene
+{
+public:
+	JobSystemScene();
+	~JobSystemScene() override = default;
+
+	// XV
+	void Update(float elapsedTime) override;
+
+	// `揈
+	void Render(float elapsedTime) override;
+
+	// GUI`揈
+	void DrawGUI() override;
+
+private:
+	// XbhςȂ瓯v
+	void RunStressTest();
+
+private:
+	struct StressTestResult
+	{
+		int				threadCount = 0;
+		float			animationTime = 0;		// Aj[Vi~b^[vj
+		float			pipelineTime = 0;		// Aj[VpCvCi~b^[vj
+		float			raycastTime = 0;		// CLXgi~b^[vj
+	};
+
+	Camera								camera;
+	FreeCameraController				cameraController;
+	int									instanceCount = 500;
+	int									raycastCount = 100000;
+	int									loopCount = 5;
+	std::vector<StressTestResult>		stressTestResults;
+};
@@ -1,4 +1,3 @@
-#include <functional>
 #include <imgui.h>
 #include <ImGuizmo.h>
 #include "Graphics.h"
@@ -27,7 +26,13 @@ LookAtScene::LookAtScene()
 
 	// fǂݍ
 	character = std::make_shared<Model>(device, "Data/Model/unitychan/unitychan.glb");
-	character->GetNodePoses(nodePoses);
+
+	// Aj[VVXeɓo^ỉ]͊KwsvŽɍsj
+	animationHandle = animationSystem.AddInstance(character.get());
+	animationSystem.GetInstance(animationHandle).postProcess = [this](AnimationSystem::Instance& instance)
+	{
+		ComputeLookAt(instance.model);
+	};
 
 	// m[h擾
 	int headNodeIndex = character->GetNodeIndex("Character1_Head");
@@ -56,9 +61,12 @@ void LookAtScene::Update(float elapsedTime)
 	cameraController.SyncControllerToCamera(camera);
 
 	const int animationIndex = character->GetAnimationIndex("Idle");
-	
-	// w莞Ԃ̃Aj[V̎p擾
-	character->ComputeAnimation(animationIndex, animationSeconds, nodePoses);
+
+	// w莞Ԃ̃Aj[V̎pgXtH[ƃbNAbg܂łvZ
+	AnimationSystem::Instance& instance = animationSystem.GetInstance(animationHandle);
+	instance.animationIndex = animationIndex;
+	instance.time = animationSeconds;
+	animationSystem.Update(elapsedTime);
 
 	// Aj[VԍXV
 	const Model::Animation& animation = character->GetAnimations().at(animationIndex);
@@ -67,40 +75,14 @@ void LookAtScene::Update(float elapsedTime)
 	{
 		animationSeconds -= animation.secondsLength;
 	}
+}
 
-	// pXV
-	character->SetNodePoses(nodePoses);
-
-	// LN^[gXtH[XV
-	DirectX::XMFLOAT4X4 worldTransform;
-	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
-	character->UpdateTransform(worldTransform);
-
-	// [hsXV֐
-	std::function<void(Model::Node&)> updateWorldTransforms = [&](Model::Node& node)
-	{
-		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
-		DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
-		DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
-		DirectX::XMMATRIX LocalTransform = S * R * T;
-		DirectX::XMMATRIX ParentGlobalTransform = node.parent != nullptr
-			? DirectX::XMLoadFloat4x4(&node.parent->globalTransform)
-			: DirectX::XMMatrixIdentity();
-		DirectX::XMMATRIX GlobalTransform = LocalTransform * ParentGlobalTransform;
-		DirectX::XMMATRIX WorldTransform = GlobalTransform * DirectX::XMLoadFloat4x4(&worldTransform);
-		DirectX::XMStoreFloat4x4(&node.localTransform, LocalTransform);
-		DirectX::XMStoreFloat4x4(&node.globalTransform, GlobalTransform);
-		DirectX::XMStoreFloat4x4(&node.worldTransform, WorldTransform);
-
-		for (Model::Node* child : node.children)
-		{
-			updateWorldTransforms(*child);
-		}
-	};
-
+// bNAbg
+void LookAtScene::ComputeLookAt(Model* model)
+{
 	// m[h擾
-	int headNodeIndex = character->GetNodeIndex("Character1_Head");
-	Model::Node& headNode = character->GetNodes().at(headNodeIndex);
+	int headNodeIndex = model->GetNodeIndex("Character1_Head");
+	Model::Node& headNode = model->GetNodes().at(headNodeIndex);
 
 	// TOODA:^[Qbgʒu𐳖ʂɑ悤ɉ]
 	{
@@ -129,7 +111,7 @@ void LookAtScene::Update(float elapsedTime)
 				DirectX::XMStoreFloat4(&headNode.rotation, LocalRotation);
 
 				// gȉ̃m[h[hϊ
-				updateWorldTransforms(headNode);
+				model->UpdateSubtree(headNodeIndex);
 			}
 		}
 	}
@@ -179,7 +161,7 @@ void LookAtScene::Render(float elapsedTime)
 	rc.camera = &camera;
 
 	// f`
-	modelRenderer->Draw(ShaderId::Basic, character);
+	modelRenderer->Draw(ShaderId::Basic, character, animationSystem.GetInstance(animationHandle).palette.data());
 	modelRenderer->Render(rc);
 }
 
@@ -6,6 +6,7 @@
 #include "Light.h"
 #include "Model.h"
 #include "FreeCameraController.h"
+#include "AnimationSystem.h"
 
 // bNAbgV[
 class LookAtScene : public Scene
@@ -23,11 +24,16 @@ public:
 	// GUI`揈
 	void DrawGUI() override;
 
+private:
+	// bNAbgiKwsvŽɌĂ΂j
+	void ComputeLookAt(Model* model);
+
 private:
 	Camera								camera;
 	FreeCameraController				cameraController;
 	std::shared_ptr<Model>				character;
-	std::vector<Model::NodePose>		nodePoses;
+	AnimationSystem						animationSystem;
+	int									animationHandle = -1;
 	DirectX::XMFLOAT3					headLocalForward = { 0, 0, 1 };
 	DirectX::XMFLOAT3					targetPosition = { 0, 0, 0 };
 	float								animationSeconds = 0;
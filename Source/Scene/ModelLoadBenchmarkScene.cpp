@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <imgui.h>
+#include "Graphics.h"
+#include "Misc.h"
+#include "ModelResource.h"
+#include "Scene/ModelLoadBenchmarkScene.h"
+
+// RXgN^
+ModelLoadBenchmarkScene::ModelLoadBenchmarkScene()
+{
+	float screenWidth = Graphics::Instance().GetScreenWidth();
+	float screenHeight = Graphics::Instance().GetScreenHeight();
+
+	// Jݒ
+	camera.SetPerspectiveFov(
+		DirectX::XMConvertToRadians(45),	// p
+		screenWidth / screenHeight,			// ʃAXyNg
+		0.1f,								// jANbv
+		1000.0f								// t@[Nbv
+	);
+	camera.SetLookAt(
+		{ 3, 2, 3 },		// _
+		{ 0, 1, 0 },		// _
+		{ 0, 1, 0 }			// xNg
+	);
+	cameraController.SyncCameraToController(camera);
+
+	// ft@C
+	std::error_code ec;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator("Data/Model", ec))
+	{
+		std::filesystem::path extension = entry.path().extension();
+		if (extension == ".glb" || extension == ".gltf")
+		{
+			filenames.emplace_back(entry.path().generic_string());
+		}
+	}
+	std::sort(filenames.begin(), filenames.end());
+}
+
+// XV
+void ModelLoadBenchmarkScene::Update(float elapsedTime)
+{
+	// JXV
+	cameraController.Update();
+	cameraController.SyncControllerToCamera(camera);
+}
+
+// `揈
+void ModelLoadBenchmarkScene::Render(float elapsedTime)
+{
+	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
+	RenderState* renderState = Graphics::Instance().GetRenderState();
+	PrimitiveRenderer* primitiveRenderer = Graphics::Instance().GetPrimitiveRenderer();
+
+	// _[Xe[gݒ
+	dc->OMSetBlendState(renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
+	dc->OMSetDepthStencilState(renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
+	dc->RSSetState(renderState->GetRasterizerState(RasterizerState::SolidCullNone));
+
+	// Obh`
+	primitiveRenderer->DrawGrid(20, 1);
+	primitiveRenderer->Render(dc, camera.GetView(), camera.GetProjection(), D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+}
+
+// GUI`揈
+void ModelLoadBenchmarkScene::DrawGUI()
+{
+	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
+	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + 10), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(560, 400), ImGuiCond_Once);
+
+	if (ImGui::Begin(u8"fǂݍ݃x`}[N"))
+	{
+		ImGui::TextWrapped(u8"GPU\[X쐬ǂݍݎԂr܂B");
+
+		ImGui::InputInt("LoopCount", &benchmarkLoopCount);
+		benchmarkLoopCount = (std::max)(1, benchmarkLoopCount);
+		if (ImGui::Button(u8"v"))
+		{
+			RunLoadBenchmark();
+		}
+
+		// ʕ\iP񂠂̃~bƃt@CTCYj
+		if (!loadBenchmarkResults.empty())
+		{
+			ImGui::Columns(4);
+			ImGui::Text("File"); ImGui::NextColumn();
+			ImGui::Text("glTF"); ImGui::NextColumn();
+			ImGui::Text("cereal"); ImGui::NextColumn();
+			ImGui::Text("Cooked"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (const LoadBenchmarkResult& result : loadBenchmarkResults)
+			{
+				ImGui::Text("%s", result.name.c_str()); ImGui::NextColumn();
+				ImGui::Text("%.2fms (%lluKB)", result.gltfTime, static_cast<unsigned long long>(result.gltfSize / 1024)); ImGui::NextColumn();
+				ImGui::Text("%.2fms (%lluKB)", result.cerealTime, static_cast<unsigned long long>(result.cerealSize / 1024)); ImGui::NextColumn();
+				ImGui::Text("%.2fms (%lluKB)", result.cookedTime, static_cast<unsigned long long>(result.cookedSize / 1024)); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+
+			// _kʁiGPUɓ]钸_ƃCfbNX̃TCYAő덷j
+			ImGui::Separator();
+			ImGui::Text(u8"_k");
+			ImGui::Columns(6);
+			ImGui::Text("File"); ImGui::NextColumn();
+			ImGui::Text("Size"); ImGui::NextColumn();
+			ImGui::Text("Normal"); ImGui::NextColumn();
+			ImGui::Text("Tangent"); ImGui::NextColumn();
+			ImGui::Text("UV"); ImGui::NextColumn();
+			ImGui::Text("Weight"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (const LoadBenchmarkResult& result : loadBenchmarkResults)
+			{
+				ImGui::Text("%s", result.name.c_str()); ImGui::NextColumn();
+				ImGui::Text("%zuKB -> %zuKB", result.floatVertexBytes / 1024, result.compressedVertexBytes / 1024); ImGui::NextColumn();
+				ImGui::Text("%.4fdeg", result.compressionError.normalDegrees); ImGui::NextColumn();
+				ImGui::Text("%.4fdeg", result.compressionError.tangentDegrees); ImGui::NextColumn();
+				ImGui::Text("%.6f", result.compressionError.texcoord); ImGui::NextColumn();
+				ImGui::Text("%.6f", result.compressionError.boneWeight); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+		}
+	}
+	ImGui::End();
+}
+
+// ǂݍݎԌv
+void ModelLoadBenchmarkScene::RunLoadBenchmark()
+{
+	// rp̃t@C͈ꎞfBNgɏo͂iDataȉ̓ǂݍ݌`̑IɉeȂj
+	std::filesystem::path outputDirPath = std::filesystem::temp_directory_path() / "ModelLoadBenchmark";
+	std::filesystem::create_directories(outputDirPath);
+
+	loadBenchmarkResults.clear();
+
+	Benchmark benchmark;
+	for (const std::string& filename : filenames)
+	{
+		std::filesystem::path filepath(filename);
+
+		LoadBenchmarkResult& result = loadBenchmarkResults.emplace_back();
+		result.name = filepath.filename().string();
+
+		// rpt@C쐬
+		std::filesystem::path cerealFilepath = outputDirPath / filepath.filename();
+		std::filesystem::path cookedFilepath = outputDirPath / filepath.filename();
+		cerealFilepath.replace_extension(".cereal");
+		cookedFilepath.replace_extension(".cooked");
+		{
+			ModelResource resource(nullptr, filename.c_str(), 60, ModelResource::FileFormat::GLTF);
+			resource.Serialize(cerealFilepath.string().c_str());
+			resource.SaveCooked(cookedFilepath.string().c_str(), 60);
+
+			// _ǩʂƌ덷
+			for (const ModelResource::Mesh& mesh : resource.GetMeshes())
+			{
+				UINT strides[2] = {};
+				UINT streamCount = ModelResource::GetVertexStrides(mesh.vertexFormat, strides);
+				size_t indexSize = mesh.vertices.size() <= 0x10000 ? sizeof(uint16_t) : sizeof(uint32_t);
+				result.floatVertexBytes += sizeof(ModelResource::Vertex) * mesh.vertices.size() + sizeof(uint32_t) * mesh.indices.size();
+				result.compressedVertexBytes += (strides[0] + (streamCount > 1 ? strides[1] : 0)) * mesh.vertices.size() + indexSize * mesh.indices.size();
+
+				VertexCompression::Error error = VertexCompression::MeasureError(mesh.vertices, mesh.vertexFormat);
+				result.compressionError.normalDegrees = (std::max)(result.compressionError.normalDegrees, error.normalDegrees);
+				result.compressionError.tangentDegrees = (std::max)(result.compressionError.tangentDegrees, error.tangentDegrees);
+				result.compressionError.texcoord = (std::max)(result.compressionError.texcoord, error.texcoord);
+				result.compressionError.boneWeight = (std::max)(result.compressionError.boneWeight, error.boneWeight);
+			}
+			const VertexCompression::Error& tolerance = VertexCompression::ErrorTolerance;
+			_ASSERT_EXPR_A(result.compressionError.normalDegrees <= tolerance.normalDegrees, "normal compression error exceeded");
+			_ASSERT_EXPR_A(result.compressionError.tangentDegrees <= tolerance.tangentDegrees, "tangent compression error exceeded");
+			_ASSERT_EXPR_A(result.compressionError.texcoord <= tolerance.texcoord, "texcoord compression error exceeded");
+			_ASSERT_EXPR_A(result.compressionError.boneWeight <= tolerance.boneWeight, "bone weight compression error exceeded");
+		}
+		result.gltfSize = std::filesystem::file_size(filepath);
+		result.cerealSize = std::filesystem::file_size(cerealFilepath);
+		result.cookedSize = std::filesystem::file_size(cookedFilepath);
+
+		// e`œǂݍ
+		auto measure = [&](const char* loadFilename, ModelResource::FileFormat format)
+		{
+			benchmark.begin();
+			for (int loop = 0; loop < benchmarkLoopCount; ++loop)
+			{
+				ModelResource resource(nullptr, loadFilename, 60, format);
+			}
+			return benchmark.end() * 1000.0f / static_cast<float>(benchmarkLoopCount);
+		};
+		result.gltfTime = measure(filename.c_str(), ModelResource::FileFormat::GLTF);
+		result.cerealTime = measure(cerealFilepath.string().c_str(), ModelResource::FileFormat::Cereal);
+		result.cookedTime = measure(cookedFilepath.string().c_str(), ModelResource::FileFormat::Cooked);
+
+#if defined(_DEBUG)
+		// NbNς݃t@CglTFƓf[^ǂ߂Ă邩mF
+		{
+			ModelResource gltfResource(nullptr, filename.c_str(), 60, ModelResource::FileFormat::GLTF);
+			ModelResource cookedResource(nullptr, cookedFilepath.string().c_str(), 60, ModelResource::FileFormat::Cooked);
+			_ASSERT_EXPR_A(gltfResource.GetNodes().size() == cookedResource.GetNodes().size(), "cooked node count mismatch");
+			_ASSERT_EXPR_A(gltfResource.GetMeshes().size() == cookedResource.GetMeshes().size(), "cooked mesh count mismatch");
+			_ASSERT_EXPR_A(gltfResource.GetAnimations().size() == cookedResource.GetAnimations().size(), "cooked animation count mismatch");
+			for (size_t i = 0; i < gltfResource.GetMeshes().size(); ++i)
+			{
+				const ModelResource::Mesh& a = gltfResource.GetMeshes().at(i);
+				const ModelResource::Mesh& b = cookedResource.GetMeshes().at(i);
+				_ASSERT_EXPR_A(a.vertices.size() == b.vertices.size() &&
+					memcmp(a.vertices.data(), b.vertices.data(), sizeof(ModelResource::Vertex) * a.vertices.size()) == 0, "cooked vertex mismatch");
+				_ASSERT_EXPR_A(a.indices == b.indices, "cooked index mismatch");
+			}
+		}
+#endif
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Scene.h"
+#include "Camera.h"
+#include "FreeCameraController.h"
+#include "VertexCompression.h"
+
+// fǂݍ݃x`}[NV[
+class ModelLoadBenchmarkScene : public Scene
+{
+public:
+	ModelLoadBenchmarkScene();
+	~ModelLoadBenchmarkScene() override = default;
+
+	// XV
+	void Update(float elapsedTime) override;
+
+	// `揈
+	void Render(float elapsedTime) override;
+
+	// GUI`揈
+	void DrawGUI() override;
+
+private:
+	// ǂݍݎԌv
+	void RunLoadBenchmark();
+
+private:
+	struct LoadBenchmarkResult
+	{
+		std::string		name;
+		float			gltfTime = 0;		// glTFi~bj
+		float			cerealTime = 0;		// cereali~bj
+		float			cookedTime = 0;		// NbNς݁i~bj
+		uintmax_t		gltfSize = 0;		// t@CTCYioCgj
+		uintmax_t		cerealSize = 0;
+		uintmax_t		cookedSize = 0;
+		size_t			floatVertexBytes = 0;			// 񈳏kGPU_ACfbNXTCY
+		size_t			compressedVertexBytes = 0;		// kGPU_ACfbNXTCY
+		VertexCompression::Error	compressionError;	// k덷
+	};
+
+	Camera								camera;
+	FreeCameraController				cameraController;
+	std::vector<std::string>			filenames;
+	int									benchmarkLoopCount = 5;
+	std::vector<LoadBenchmarkResult>	loadBenchmarkResults;
+};
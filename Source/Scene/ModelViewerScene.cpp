@@ -44,12 +44,14 @@ void ModelViewerScene::Update(float elapsedTime)
 
 	if (model != nullptr)
 	{
-		// Aj[VXV
+		// Aj[VXVi~͎pɍsƃpbgXVj
+		AnimationSystem::Instance& instance = animationSystem.GetInstance(animationHandle);
+		instance.animationIndex = animationPlaying ? currentAnimationIndex : -1;
+		instance.time = currentAnimationSeconds;
+		animationSystem.Update(elapsedTime);
+
 		if (animationPlaying && currentAnimationIndex >= 0)
 		{
-			model->ComputeAnimation(currentAnimationIndex, currentAnimationSeconds, nodePoses);
-			model->SetNodePoses(nodePoses);
-
 			// ԍXV
 			const Model::Animation& animation = model->GetAnimations().at(currentAnimationIndex);
 			currentAnimationSeconds += elapsedTime * animationSpeed;
@@ -65,11 +67,6 @@ void ModelViewerScene::Update(float elapsedTime)
 				}
 			}
 		}
-
-		// gXtH[XV
-		DirectX::XMFLOAT4X4 worldTransform;
-		DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
-		model->UpdateTransform(worldTransform);
 	}
 
 }
@@ -97,7 +94,8 @@ void ModelViewerScene::Render(float elapsedTime)
 	if (model != nullptr)
 	{
 		// f`
-		modelRenderer->Draw(static_cast<ShaderId>(shaderId), model);
+		const std::vector<DirectX::XMFLOAT4X4>& palette = animationSystem.GetInstance(animationHandle).palette;
+		modelRenderer->Draw(static_cast<ShaderId>(shaderId), model, palette.empty() ? nullptr : palette.data());
 		modelRenderer->Render(rc);
 
 		// _[Xe[gݒ
@@ -160,6 +158,8 @@ void ModelViewerScene::DrawMenuGUI()
 				{
 					ID3D11Device* device = Graphics::Instance().GetDevice();
 					model = std::make_shared<Model>(device, filename, animationSamplingRate);
+					animationSystem.Clear();
+					animationHandle = animationSystem.AddInstance(model.get());
 					animationSpeed = 1.0f;
 					currentAnimationSeconds = 0.0f;
 					currentAnimationIndex = -1;
@@ -204,7 +204,7 @@ void ModelViewerScene::DrawHierarchyGUI()
 			}
 
 			// c[m[h\
-			bool opened = ImGui::TreeNodeEx(node, nodeFlags, node->name.c_str());
+			bool opened = ImGui::TreeNodeEx(node, nodeFlags, node->name);
 
 			// tH[JXꂽm[hI
 			if (ImGui::IsItemFocused())
@@ -247,6 +247,7 @@ void ModelViewerScene::DrawPropertyGUI()
 				// ʒu
 				if (ImGui::DragFloat3("Local Position", &selectionNode->position.x, 0.1f))
 				{
+					model->MarkDirty(selectionNode);
 					animationPlaying = false;
 				}
 				// ʒu
@@ -270,6 +271,7 @@ void ModelViewerScene::DrawPropertyGUI()
 					{
 						selectionNode->position = globalPosition;
 					}
+					model->MarkDirty(selectionNode);
 					animationPlaying = false;
 				}
 
@@ -286,6 +288,7 @@ void ModelViewerScene::DrawPropertyGUI()
 					angle.z = DirectX::XMConvertToRadians(angle.z);
 					DirectX::XMVECTOR Rotation = DirectX::XMQuaternionRotationRollPitchYaw(angle.x, angle.y, angle.z);
 					DirectX::XMStoreFloat4(&selectionNode->rotation, Rotation);
+					model->MarkDirty(selectionNode);
 				}
 
 				TransformUtils::MatrixToRollPitchYaw(selectionNode->globalTransform, angle.x, angle.y, angle.z);
@@ -314,12 +317,14 @@ void ModelViewerScene::DrawPropertyGUI()
 					{
 						DirectX::XMStoreFloat4(&selectionNode->rotation, GlobalRotation);
 					}
+					model->MarkDirty(selectionNode);
 					animationPlaying = false;
 				}
 
 				// XP[
 				if (ImGui::DragFloat3("Local Scale", &selectionNode->scale.x, 0.01f))
 				{
+					model->MarkDirty(selectionNode);
 					animationPlaying = false;
 				}
 
@@ -6,6 +6,7 @@
 #include "FreeCameraController.h"
 #include "Model.h"
 #include "Light.h"
+#include "AnimationSystem.h"
 
 // fr[AV[
 class ModelViewerScene : public Scene
@@ -45,7 +46,8 @@ private:
 	LightManager						lightManager;
 	std::shared_ptr<Model>				model;
 	Model::Node*						selectionNode = nullptr;
-	std::vector<Model::NodePose>		nodePoses;
+	AnimationSystem						animationSystem;
+	int									animationHandle = -1;
 	bool								animationPlaying = false;
 	bool								animationLoop = false;
 	float								animationSamplingRate = 60;
@@ -1,5 +1,6 @@
 #include <imgui.h>
 #include "Graphics.h"
+#include "Input.h"
 #include "Scene/RootMotionScene.h"
 
 // RXgN^
@@ -25,6 +26,9 @@ RootMotionScene::RootMotionScene()
 	// fǂݍ
 	character = std::make_shared<Model>(device, "Data/Model/RPG-Character/RPG-Character.glb");
 	character->GetNodePoses(nodePoses);
+
+	// [g[V\z
+	rootMotion = std::make_unique<RootMotion>(character.get(), character->GetNodeIndex("B_Pelvis"), false, bakeTranslationY, false);
 }
 
 // XV
@@ -35,19 +39,19 @@ void RootMotionScene::Update(float elapsedTime)
 	{
 		// s
 		int newAnimationIndex = animationIndex;
-		if (GetAsyncKeyState(VK_UP) & 0x8000)
+		if (Input::Instance().IsKeyPressed(VK_UP))
 		{
 			newAnimationIndex = character->GetAnimationIndex("Walk_F");
 		}
-		else if (GetAsyncKeyState(VK_DOWN) & 0x8000)
+		else if (Input::Instance().IsKeyPressed(VK_DOWN))
 		{
 			newAnimationIndex = character->GetAnimationIndex("Walk_B");
 		}
-		else if (GetAsyncKeyState(VK_RIGHT) & 0x8000)
+		else if (Input::Instance().IsKeyPressed(VK_RIGHT))
 		{
 			newAnimationIndex = character->GetAnimationIndex("Walk_R");
 		}
-		else if (GetAsyncKeyState(VK_LEFT) & 0x8000)
+		else if (Input::Instance().IsKeyPressed(VK_LEFT))
 		{
 			newAnimationIndex = character->GetAnimationIndex("Walk_L");
 		}
@@ -64,22 +68,22 @@ void RootMotionScene::Update(float elapsedTime)
 	else
 	{
 		// [O
-		if (GetAsyncKeyState(VK_UP) & 0x01)
+		if (Input::Instance().IsKeyTriggered(VK_UP))
 		{
 			animationIndex = character->GetAnimationIndex("Evade_F");
 			animationSeconds = oldAnimationSeconds = 0;
 		}
-		if (GetAsyncKeyState(VK_DOWN) & 0x01)
+		if (Input::Instance().IsKeyTriggered(VK_DOWN))
 		{
 			animationIndex = character->GetAnimationIndex("Evade_B");
 			animationSeconds = oldAnimationSeconds = 0;
 		}
-		if (GetAsyncKeyState(VK_RIGHT) & 0x01)
+		if (Input::Instance().IsKeyTriggered(VK_RIGHT))
 		{
 			animationIndex = character->GetAnimationIndex("Evade_R");
 			animationSeconds = oldAnimationSeconds = 0;
 		}
-		if (GetAsyncKeyState(VK_LEFT) & 0x01)
+		if (Input::Instance().IsKeyTriggered(VK_LEFT))
 		{
 			animationIndex = character->GetAnimationIndex("Evade_L");
 			animationSeconds = oldAnimationSeconds = 0;
@@ -92,71 +96,17 @@ void RootMotionScene::Update(float elapsedTime)
 		const Model::Animation& animation = character->GetAnimations().at(animationIndex);
 
 		// w莞Ԃ̃Aj[V̎p擾
-		character->ComputeAnimation(animationIndex, animationSeconds, nodePoses);
+		character->ComputeAnimation(animationIndex, animationSeconds, nodePoses, animationCursor);
 
-		// TODO@:[g[VsALN^[ړ
+		// [g[ViOvZݐσJ[uړʂ߂j
 		{
-			// [g[Vm[hԍ擾
-			const int rootMotionNodeIndex = character->GetNodeIndex("B_Pelvis");
-
-			// AOÃ[g[Vm[h̎p擾
-			Model::NodePose beginPose, oldPose, newPose;
-			character->ComputeAnimation(animationIndex, rootMotionNodeIndex, 0, beginPose);
-			character->ComputeAnimation(animationIndex, rootMotionNodeIndex, oldAnimationSeconds, oldPose);
-			character->ComputeAnimation(animationIndex, rootMotionNodeIndex, animationSeconds, newPose);
-
-			// TODOA:[vAj[VɑΉ
-			DirectX::XMFLOAT3 localTranslation;
-			if (oldAnimationSeconds > animationSeconds)
-			{
-				// [v
-				Model::NodePose endPose;
-				character->ComputeAnimation(animationIndex, rootMotionNodeIndex, animation.secondsLength, endPose);
-
-				// [JړlZo
-				localTranslation.x = (endPose.position.x - oldPose.position.x) + (newPose.position.x - beginPose.position.x);
-				localTranslation.y = (endPose.position.y - oldPose.position.y) + (newPose.position.y - beginPose.position.y);
-				localTranslation.z = (endPose.position.z - oldPose.position.z) + (newPose.position.z - beginPose.position.z);
-			}
-			else
-			{
-				// [JړlZo
-				localTranslation.x = newPose.position.x - oldPose.position.x;
-				localTranslation.y = newPose.position.y - oldPose.position.y;
-				localTranslation.z = newPose.position.z - oldPose.position.z;
-			}
-
-			// O[oړlZo
-			Model::Node& rootMotionNode = character->GetNodes().at(rootMotionNodeIndex);
-			DirectX::XMVECTOR LocalTranslation = DirectX::XMLoadFloat3(&localTranslation);
-			DirectX::XMMATRIX ParentGlobalTransform = DirectX::XMLoadFloat4x4(&rootMotionNode.parent->globalTransform);
-			DirectX::XMVECTOR GlobalTranslation = DirectX::XMVector3TransformNormal(LocalTranslation, ParentGlobalTransform);
-
-			// TODOB:[g[VYړ͓KpȂ悤ɂ
-			if (bakeTranslationY)
-			{
-				// Ÿړl𔲂
-				GlobalTranslation = DirectX::XMVectorSetY(GlobalTranslation, 0);
-
-				// ̎p̃O[oʒuZo
-				DirectX::XMVECTOR LocalPosition = DirectX::XMLoadFloat3(&newPose.position);
-				DirectX::XMVECTOR GlobalPosition = DirectX::XMVector3Transform(LocalPosition, ParentGlobalTransform);
-				// XZ폜
-				GlobalPosition = DirectX::XMVectorSetX(GlobalPosition, 0);
-				GlobalPosition = DirectX::XMVectorSetZ(GlobalPosition, 0);
-				// [Jԕϊ
-				DirectX::XMMATRIX InverseParentGlobalTransform = DirectX::XMMatrixInverse(nullptr, ParentGlobalTransform);
-				LocalPosition = DirectX::XMVector3Transform(GlobalPosition, InverseParentGlobalTransform);
-				// [g[Vm[ḧʒuݒ
-				DirectX::XMStoreFloat3(&nodePoses[rootMotionNodeIndex].position, LocalPosition);
-			}
-			else
-			{
-				// [g[Vm[h̎pɂ
-				nodePoses[rootMotionNodeIndex].position = beginPose.position;
-			}
+			const int rootMotionNodeIndex = rootMotion->GetRootMotionNodeIndex();
+			DirectX::XMFLOAT3 globalTranslation;
+			rootMotion->Compute(animationIndex, oldAnimationSeconds, animationSeconds,
+				globalTranslation, nodePoses[rootMotionNodeIndex].position);
 
 			// [hړlZo
+			DirectX::XMVECTOR GlobalTranslation = DirectX::XMLoadFloat3(&globalTranslation);
 			DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&worldTransform);
 			DirectX::XMVECTOR WorldTranslation = DirectX::XMVector3TransformNormal(GlobalTranslation, WorldTransform);
 			DirectX::XMFLOAT3 worldTranslation;
@@ -241,7 +191,11 @@ void RootMotionScene::DrawGUI()
 		ImGui::Text(u8"FL[");
 
 		ImGui::Checkbox(u8"[v", &animationLoop);
-		ImGui::Checkbox(u8"Yړ", &bakeTranslationY);
+		if (ImGui::Checkbox(u8"Yړ", &bakeTranslationY))
+		{
+			// ς烋[g[V蒼
+			rootMotion = std::make_unique<RootMotion>(character.get(), rootMotion->GetRootMotionNodeIndex(), false, bakeTranslationY, false);
+		}
 
 		ImGui::DragFloat3("Position", &position.x, 0.1f);
 
@@ -5,6 +5,7 @@
 #include "Camera.h"
 #include "Light.h"
 #include "Model.h"
+#include "RootMotion.h"
 
 // [g[VV[
 class RootMotionScene : public Scene
@@ -31,6 +32,8 @@ private:
 	DirectX::XMFLOAT3					scale = { 1, 1, 1 };
 	DirectX::XMFLOAT4X4					worldTransform = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
 	std::vector<Model::NodePose>		nodePoses;
+	Model::AnimationCursor				animationCursor;
+	std::unique_ptr<RootMotion>			rootMotion;
 	int									animationIndex = -1;
 	float								animationSeconds = 0;
 	float								oldAnimationSeconds = 0;
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <imgui.h>
 #include <ImGuizmo.h>
 #include "Graphics.h"
+#include "Input.h"
+#include "Misc.h"
 #include "Scene/SpaceDivisionRaycastScene.h"
 
 // RXgN^
@@ -34,7 +37,7 @@ SpaceDivisionRaycastScene::SpaceDivisionRaycastScene()
 	// _f[^[hԕϊAOp`f[^쐬
 	for (const Model::Mesh& mesh : stage->GetMeshes())
 	{
-		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&mesh.node->worldTransform);
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&stage->GetNodes().at(mesh.nodeIndex).worldTransform);
 		for (size_t i = 0; i < mesh.indices.size(); i += 3)
 		{
 			// _f[^[hԕϊ
@@ -111,6 +114,35 @@ SpaceDivisionRaycastScene::SpaceDivisionRaycastScene()
 			}
 		}
 	}
+
+	// BVH\z
+	{
+		std::vector<TriangleBVH::Triangle> triangles;
+		triangles.reserve(collisionMesh.triangles.size());
+		for (const CollisionMesh::Triangle& triangle : collisionMesh.triangles)
+		{
+			TriangleBVH::Triangle& bvhTriangle = triangles.emplace_back();
+			bvhTriangle.positions[0] = triangle.positions[0];
+			bvhTriangle.positions[1] = triangle.positions[1];
+			bvhTriangle.positions[2] = triangle.positions[2];
+			bvhTriangle.normal = triangle.normal;
+		}
+		bvh.Build(triangles);
+
+		// Obh\z
+		grid.Build(triangles, 2.0f);
+	}
+
+	// SIMDpɂSOp`̃ubNɋl߂
+	for (size_t i = 0; i < collisionMesh.triangles.size(); ++i)
+	{
+		const CollisionMesh::Triangle& triangle = collisionMesh.triangles.at(i);
+		DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&triangle.positions[0]);
+		DirectX::XMFLOAT3 edge1, edge2;
+		DirectX::XMStoreFloat3(&edge1, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&triangle.positions[1]), A));
+		DirectX::XMStoreFloat3(&edge2, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&triangle.positions[2]), A));
+		blocks.AddTriangle(triangle.positions[0], edge1, edge2, static_cast<int>(i));
+	}
 }
 
 // XV
@@ -123,19 +155,19 @@ void SpaceDivisionRaycastScene::Update(float elapsedTime)
 	// IuWFNgړ
 	const float speed = 5.0f * elapsedTime;
 	DirectX::XMFLOAT3 vec = { 0, 0, 0 };
-	if (GetAsyncKeyState(VK_UP) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_UP))
 	{
 		vec.z += speed;
 	}
-	if (GetAsyncKeyState(VK_DOWN) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_DOWN))
 	{
 		vec.z -= speed;
 	}
-	if (GetAsyncKeyState(VK_RIGHT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_RIGHT))
 	{
 		vec.x += speed;
 	}
-	if (GetAsyncKeyState(VK_LEFT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_LEFT))
 	{
 		vec.x -= speed;
 	}
@@ -154,22 +186,32 @@ void SpaceDivisionRaycastScene::Update(float elapsedTime)
 	float distance = 100.0f;
 	DirectX::XMFLOAT3 start = { characterPosition.x, characterPosition.y + 1.0f, characterPosition.z };
 	DirectX::XMFLOAT3 end = { characterPosition.x, characterPosition.y + -1.0f, characterPosition.z };
-	DirectX::XMFLOAT3 hitPosition, hitNormal;
-	timer.Tick();
-	if (Raycast(start, end, hitPosition, hitNormal))
+
+	// SŌvAI𒆂̌̕ʂg
+	for (int mode = 0; mode < RaycastModeCount; ++mode)
 	{
-		characterPosition.y = hitPosition.y;
+		DirectX::XMFLOAT3 hitPosition, hitNormal;
+		timer.Tick();
+		bool hit = Raycast(static_cast<RaycastMode>(mode), start, end, hitPosition, hitNormal);
+		timer.Tick();
+		totalTimes[mode] += timer.TimeInterval();
+
+		if (hit && static_cast<RaycastMode>(mode) == raycastMode)
+		{
+			characterPosition.y = hitPosition.y;
+		}
 	}
-	timer.Tick();
 
 	// Ԍv
-	totalTime += timer.TimeInterval();
 	frames++;
 	if (frames == 60)
 	{
-		averageTime = totalTime / frames;
+		for (int mode = 0; mode < RaycastModeCount; ++mode)
+		{
+			averageTimes[mode] = totalTimes[mode] / frames;
+			totalTimes[mode] = 0;
+		}
 		frames = 0;
-		totalTime = 0;
 	}
 }
 
@@ -248,18 +290,36 @@ void SpaceDivisionRaycastScene::DrawGUI()
 {
 	ImVec2 pos = ImGui::GetMainViewport()->GetWorkPos();
 	ImGui::SetNextWindowPos(ImVec2(pos.x + 10, pos.y + 10), ImGuiCond_Once);
-	ImGui::SetNextWindowSize(ImVec2(300, 100), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(360, 180), ImGuiCond_Once);
 
 	if (ImGui::Begin(u8"ԕCLXg"))
 	{
-		ImGui::Checkbox(u8"ԕ", &spaceDivision);
-		ImGui::InputFloat(u8"", &averageTime, 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		int mode = static_cast<int>(raycastMode);
+		ImGui::RadioButton(u8"", &mode, static_cast<int>(RaycastMode::BruteForce));
+		ImGui::SameLine();
+		ImGui::RadioButton(u8"ԕ", &mode, static_cast<int>(RaycastMode::SpaceDivision));
+		ImGui::SameLine();
+		ImGui::RadioButton(u8"BVH", &mode, static_cast<int>(RaycastMode::BVH));
+		ImGui::SameLine();
+		ImGui::RadioButton(u8"Obh", &mode, static_cast<int>(RaycastMode::Grid));
+		ImGui::SameLine();
+		ImGui::RadioButton(u8"SIMD", &mode, static_cast<int>(RaycastMode::SIMD));
+		raycastMode = static_cast<RaycastMode>(mode);
+
+		// ԁiSׂĕ\j
+		ImGui::InputFloat(u8" ", &averageTimes[static_cast<int>(RaycastMode::BruteForce)], 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		ImGui::InputFloat(u8" ԕ", &averageTimes[static_cast<int>(RaycastMode::SpaceDivision)], 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		ImGui::InputFloat(u8" BVH", &averageTimes[static_cast<int>(RaycastMode::BVH)], 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		ImGui::InputFloat(u8" Obh", &averageTimes[static_cast<int>(RaycastMode::Grid)], 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		ImGui::InputFloat(u8" SIMD", &averageTimes[static_cast<int>(RaycastMode::SIMD)], 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		ImGui::Text("Grid : %d cells %d refs", grid.GetCellCount(), grid.GetCellTriangleCount());
 	}
 	ImGui::End();
 }
 
 // CLXg
 bool SpaceDivisionRaycastScene::Raycast(
+	RaycastMode mode,
 	const DirectX::XMFLOAT3& start,
 	const DirectX::XMFLOAT3& end,
 	DirectX::XMFLOAT3& hitPosition,
@@ -273,7 +333,7 @@ bool SpaceDivisionRaycastScene::Raycast(
 	float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
 
 	// ԕAʂɃCLXg
-	if (!spaceDivision)
+	if (mode == RaycastMode::BruteForce)
 	{
 		for (const CollisionMesh::Triangle& triangle : collisionMesh.triangles)
 		{
@@ -291,6 +351,40 @@ bool SpaceDivisionRaycastScene::Raycast(
 			}
 		}
 	}
+	// BVHgACLXgɏ
+	else if (mode == RaycastMode::BVH)
+	{
+		TriangleBVH::HitResult result;
+		if (bvh.RayCast(start, end, result))
+		{
+			distance = result.distance;
+			hitNormal = result.normal;
+			hit = true;
+		}
+	}
+	// ψObhCʉ߂Z
+	else if (mode == RaycastMode::Grid)
+	{
+		TriangleGrid::HitResult result;
+		if (grid.RayCast(start, end, result))
+		{
+			distance = result.distance;
+			hitNormal = result.normal;
+			hit = true;
+		}
+	}
+	// SOp`SIMDł܂Ƃ߂Ĕ肷
+	else if (mode == RaycastMode::SIMD)
+	{
+		DirectX::XMFLOAT3 direction;
+		DirectX::XMStoreFloat3(&direction, Direction);
+		int triangleIndex = blocks.IntersectRay(start, direction, 0, blocks.GetBlockCount(), distance);
+		if (triangleIndex >= 0)
+		{
+			hitNormal = collisionMesh.triangles.at(triangleIndex).normal;
+			hit = true;
+		}
+	}
 	// TODOAFԕf[^gACLXgSɏ
 	else
 	{
@@ -7,6 +7,9 @@
 #include "FreeCameraController.h"
 #include "HighResolutionTimer.h"
 #include "Model.h"
+#include "TriangleBVH.h"
+#include "TriangleBlocks.h"
+#include "TriangleGrid.h"
 
 // ԕCLXgV[
 class SpaceDivisionRaycastScene : public Scene
@@ -25,8 +28,20 @@ public:
 	void DrawGUI() override;
 
 private:
+	enum class RaycastMode
+	{
+		BruteForce,
+		SpaceDivision,
+		BVH,
+		Grid,
+		SIMD,
+
+		EnumCount
+	};
+
 	// CLXg
 	bool Raycast(
+		RaycastMode mode,
 		const DirectX::XMFLOAT3& start,
 		const DirectX::XMFLOAT3& end,
 		DirectX::XMFLOAT3& hitPosition,
@@ -58,9 +73,15 @@ private:
 	std::shared_ptr<Model>				character;
 	DirectX::XMFLOAT3					characterPosition;
 	CollisionMesh						collisionMesh;
-	bool								spaceDivision = false;
+	TriangleBVH							bvh;
+	TriangleGrid						grid;
+	TriangleBlocks						blocks;
+	RaycastMode							raycastMode = RaycastMode::BruteForce;
+
+	static const int RaycastModeCount = static_cast<int>(RaycastMode::EnumCount);
 
-	float	totalTime = 0;
-	float	averageTime = 0;
+	// S𖈃t[vĕׂĕ\
+	float	totalTimes[RaycastModeCount] = {};
+	float	averageTimes[RaycastModeCount] = {};
 	int		frames = 0;
 };
@@ -3,6 +3,9 @@
 #include <ImGuizmo.h>
 #include <SphereCast.h>
 #include "Graphics.h"
+#include "Input.h"
+#include "JobSystem.h"
+#include "Misc.h"
 #include "Scene/SphereCastMoveScene.h"
 
 // RXgN^
@@ -36,7 +39,7 @@ SphereCastMoveScene::SphereCastMoveScene()
 	// _f[^[hԕϊAOp`f[^쐬
 	for (const Model::Mesh& mesh : stage->GetMeshes())
 	{
-		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&mesh.node->worldTransform);
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&stage->GetNodes().at(mesh.nodeIndex).worldTransform);
 		for (size_t i = 0; i < mesh.indices.size(); i += 3)
 		{
 			// _f[^[hԕϊ
@@ -67,6 +70,30 @@ SphereCastMoveScene::SphereCastMoveScene()
 			DirectX::XMStoreFloat3(&triangle.normal, N);
 		}
 	}
+
+	// XtBALXǧi荞ނ߂BVH\z
+	{
+		std::vector<TriangleBVH::Triangle> triangles;
+		triangles.reserve(collisionMesh.triangles.size());
+		for (const CollisionMesh::Triangle& triangle : collisionMesh.triangles)
+		{
+			TriangleBVH::Triangle& bvhTriangle = triangles.emplace_back();
+			bvhTriangle.positions[0] = triangle.positions[0];
+			bvhTriangle.positions[1] = triangle.positions[1];
+			bvhTriangle.positions[2] = triangle.positions[2];
+			bvhTriangle.normal = triangle.normal;
+		}
+		bvh.Build(triangles);
+	}
+
+	// LN^[Rg[[ݒ
+	collisionWorld.SetBVH(&bvh);
+	controller.SetSettings(MakeControllerSettings());
+	controller.SetPosition(position);
+
+#if defined(_DEBUG)
+	VerifySphereCast();
+#endif
 }
 
 // XV
@@ -79,19 +106,19 @@ void SphereCastMoveScene::Update(float elapsedTime)
 	// IuWFNgړ
 	const float speed = 5.0f * elapsedTime;
 	DirectX::XMFLOAT3 vec = { 0, 0, 0 };
-	if (GetAsyncKeyState(VK_UP) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_UP))
 	{
 		vec.z += speed;
 	}
-	if (GetAsyncKeyState(VK_DOWN) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_DOWN))
 	{
 		vec.z -= speed;
 	}
-	if (GetAsyncKeyState(VK_RIGHT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_RIGHT))
 	{
 		vec.x += speed;
 	}
-	if (GetAsyncKeyState(VK_LEFT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_LEFT))
 	{
 		vec.x -= speed;
 	}
@@ -117,9 +144,26 @@ void SphereCastMoveScene::Update(float elapsedTime)
 	// ړ
 	DirectX::XMFLOAT3 moveXZ = { move.x, 0, move.z };
 	DirectX::XMFLOAT3 moveY = { 0, move.y, 0 };
-	MoveAndSlide(moveXZ, false);
-	MoveAndSlide(moveY, true);
-	//MoveAndSlide(move, false);
+	timer.Tick();
+	if (useCharacterController)
+	{
+		// LN^[Rg[[ňړiȉzƒnʂւ̋zsj
+		controller.SetSettings(MakeControllerSettings());
+		controller.SetPosition(position);
+		controller.Move(collisionWorld, move);
+		position = controller.GetPosition();
+	}
+	else
+	{
+		MoveAndSlide(moveXZ, false);
+		MoveAndSlide(moveY, true);
+		//MoveAndSlide(move, false);
+	}
+	timer.Tick();
+	moveTime = timer.TimeInterval();
+
+	// QOXV
+	UpdateCrowd(elapsedTime);
 }
 
 // `揈
@@ -147,9 +191,20 @@ void SphereCastMoveScene::Render(float elapsedTime)
 	DirectX::XMMATRIX CapsuleTransform = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
 	DirectX::XMFLOAT4X4 capsuleTransform;
 	DirectX::XMStoreFloat4x4(&capsuleTransform, CapsuleTransform);
-	capsuleTransform._42 += radius + stepOffset * 0.5f;
-	shapeRenderer->DrawCapsule(capsuleTransform, radius, stepOffset, capsuleColor);
-	shapeRenderer->DrawCapsule(capsuleTransform, radius + skinWidth, stepOffset, { 1,0,0,1 });
+	float capsuleHeight = useCharacterController ? (std::max)(height - radius * 2.0f, 0.0f) : stepOffset;
+	capsuleTransform._42 += radius + capsuleHeight * 0.5f;
+	shapeRenderer->DrawCapsule(capsuleTransform, radius, capsuleHeight, capsuleColor);
+	shapeRenderer->DrawCapsule(capsuleTransform, radius + skinWidth, capsuleHeight, { 1,0,0,1 });
+
+	// QÕJvZ`
+	const float crowdHeight = (std::max)(height - radius * 2.0f, 0.0f);
+	for (const CharacterController& member : crowd)
+	{
+		const DirectX::XMFLOAT3& memberPosition = member.GetPosition();
+		DirectX::XMFLOAT4X4 memberTransform;
+		DirectX::XMStoreFloat4x4(&memberTransform, DirectX::XMMatrixTranslation(memberPosition.x, memberPosition.y + radius + crowdHeight * 0.5f, memberPosition.z));
+		shapeRenderer->DrawCapsule(memberTransform, radius, crowdHeight, { 0, 0, 1, 1 });
+	}
 	shapeRenderer->Render(dc, camera.GetView(), camera.GetProjection());
 
 	// _[Xe[gݒ
@@ -181,6 +236,14 @@ void SphereCastMoveScene::DrawGUI()
 		ImGui::DragFloat(u8"SkinWidth", &skinWidth, 0.01f, 0.01f, 0);
 		ImGui::DragFloat(u8"StepOffset", &stepOffset, 0.01f, 0.01f, 0);
 		ImGui::DragFloat(u8"SlopeLimit", &slopeLimit, 1);
+		ImGui::DragFloat(u8"Height", &height, 0.01f, 0.01f, 0);
+		ImGui::Checkbox(u8"UseBVH", &useBVH);
+		ImGui::Checkbox(u8"UseCharacterController", &useCharacterController);
+		bool grounded = controller.IsGrounded();
+		ImGui::Checkbox(u8"Grounded", &grounded);
+		ImGui::InputFloat(u8"", &moveTime, 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
+		ImGui::SliderInt(u8"CrowdCount", &crowdCount, 0, 256);
+		ImGui::InputFloat(u8"QO", &crowdTime, 0, 0, "%.7f", ImGuiInputTextFlags_ReadOnly);
 	}
 	ImGui::End();
 }
@@ -194,6 +257,18 @@ bool SphereCastMoveScene::SphereCast(
 	DirectX::XMFLOAT3& hitPosition,
 	DirectX::XMFLOAT3& hitNormal)
 {
+	// BVHŃLXgoH̋߂̎Op`肷
+	if (useBVH)
+	{
+		TriangleBVH::HitResult result;
+		if (!bvh.SphereCast(origin, direction, radius, distance, result)) return false;
+
+		distance = result.distance;
+		hitPosition = result.position;
+		hitNormal = result.normal;
+		return true;
+	}
+
 	bool hit = false;
 	DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&origin);
 	DirectX::XMVECTOR Direction = DirectX::XMLoadFloat3(&direction);
@@ -305,3 +380,116 @@ void SphereCastMoveScene::MoveAndSlide(const DirectX::XMFLOAT3& move, bool verti
 
 	DirectX::XMStoreFloat3(&position, Position);
 }
+
+// LN^[Rg[[ݒ쐬
+CharacterController::Settings SphereCastMoveScene::MakeControllerSettings() const
+{
+	CharacterController::Settings settings;
+	settings.radius = radius;
+	settings.height = (std::max)(height, radius * 2.0f);
+	settings.skinWidth = skinWidth;
+	settings.stepOffset = stepOffset;
+	settings.slopeLimit = slopeLimit;
+	return settings;
+}
+
+// QOXV
+void SphereCastMoveScene::UpdateCrowd(float elapsedTime)
+{
+	// lςꍇ̓LN^[̎͂Ɋiqɕג
+	if (static_cast<int>(crowd.size()) != crowdCount)
+	{
+		crowd.resize(crowdCount);
+		const int columns = static_cast<int>(ceilf(sqrtf(static_cast<float>(crowdCount))));
+		const float spacing = radius * 3.0f;
+		for (int i = 0; i < crowdCount; ++i)
+		{
+			float x = (i % columns - (columns - 1) * 0.5f) * spacing;
+			float z = (i / columns - (columns - 1) * 0.5f) * spacing;
+			crowd[i].SetPosition({ position.x + x, position.y + 1.0f, position.z + z });
+		}
+	}
+	if (crowd.empty())
+	{
+		crowdTime = 0;
+		return;
+	}
+
+	const CharacterController::Settings settings = MakeControllerSettings();
+	const float speed = 3.0f * elapsedTime;
+	const float gravity = 3.0f * elapsedTime;
+	crowdAngle += DirectX::XMConvertToRadians(30.0f) * elapsedTime;
+
+	timer.Tick();
+	// eRg[[͎g̏Ԃ̂ŕɈړł
+	JobSystem::Instance().ParallelFor(static_cast<int>(crowd.size()), 8, [&](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			float angle = crowdAngle + static_cast<float>(i) * 0.7f;
+			DirectX::XMFLOAT3 move = { sinf(angle) * speed, -gravity, cosf(angle) * speed };
+			crowd[i].SetSettings(settings);
+			crowd[i].Move(collisionWorld, move);
+		}
+	});
+	timer.Tick();
+	crowdTime = timer.TimeInterval();
+}
+
+// BVHƑ̃XtBALXgʂƍ
+void SphereCastMoveScene::VerifySphereCast() const
+{
+	if (collisionMesh.triangles.empty()) return;
+
+	// Xe[WŜAABB
+	const TriangleBVH::Node& root = bvh.GetNodes().front();
+	const DirectX::XMFLOAT3& volumeMin = root.boundsMin;
+	const DirectX::XMFLOAT3& volumeMax = root.boundsMax;
+
+	// iq̈ʒu牺Ǝ΂߉ɃLXgďƍ
+	const int division = 16;
+	const float castRadius = 0.5f;
+	const float castDistance = 3.0f;
+	const DirectX::XMFLOAT3 directions[] = { { 0, -1, 0 }, { 0.6f, -0.8f, 0 }, { 0, 0, 1 } };
+	for (int z = 0; z <= division; ++z)
+	{
+		for (int x = 0; x <= division; ++x)
+		{
+			DirectX::XMFLOAT3 origin =
+			{
+				volumeMin.x + (volumeMax.x - volumeMin.x) * x / division,
+				volumeMin.y + castRadius,
+				volumeMin.z + (volumeMax.z - volumeMin.z) * z / division
+			};
+			for (const DirectX::XMFLOAT3& direction : directions)
+			{
+				// 
+				DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&origin);
+				DirectX::XMVECTOR End = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(DirectX::XMLoadFloat3(&direction), castDistance));
+				float bruteForceDistance = castDistance;
+				bool bruteForceHit = false;
+				for (const CollisionMesh::Triangle& triangle : collisionMesh.triangles)
+				{
+					DirectX::XMVECTOR Positions[3] =
+					{
+						DirectX::XMLoadFloat3(&triangle.positions[0]),
+						DirectX::XMLoadFloat3(&triangle.positions[1]),
+						DirectX::XMLoadFloat3(&triangle.positions[2])
+					};
+					SphereCastResult result;
+					if (IntersectSphereCastVsTriangle(Start, End, castRadius, Positions, &result) && result.distance < bruteForceDistance)
+					{
+						bruteForceDistance = result.distance;
+						bruteForceHit = true;
+					}
+				}
+
+				TriangleBVH::HitResult result;
+				bool bvhHit = bvh.SphereCast(origin, direction, castRadius, castDistance, result);
+
+				_ASSERT_EXPR(bruteForceHit == bvhHit, L"BVH sphere cast hit mismatch");
+				_ASSERT_EXPR(!bvhHit || fabsf(bruteForceDistance - result.distance) < 1.0e-4f, L"BVH sphere cast distance mismatch");
+			}
+		}
+	}
+}
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <DirectXCollision.h>
 #include "Scene.h"
 #include "Camera.h"
 #include "FreeCameraController.h"
 #include "HighResolutionTimer.h"
 #include "Model.h"
+#include "TriangleBVH.h"
+#include "TriangleBVHCollisionWorld.h"
+#include "CharacterController.h"
 
 // XtBALXgړV[
 class SphereCastMoveScene : public Scene
@@ -39,6 +43,15 @@ private:
 		const DirectX::XMFLOAT3& move,
 		bool vertical);
 
+	// LN^[Rg[[ݒ쐬
+	CharacterController::Settings MakeControllerSettings() const;
+
+	// QOXV
+	void UpdateCrowd(float elapsedTime);
+
+	// BVHƑ̃XtBALXgʂƍ
+	void VerifySphereCast() const;
+
 private:
 	struct CollisionMesh
 	{
@@ -61,5 +74,16 @@ private:
 	float								skinWidth = 0.01f;
 	float								stepOffset = 0.1f;
 	float								slopeLimit = 45.0f;
+	float								height = 1.8f;
 	CollisionMesh						collisionMesh;
+	TriangleBVH							bvh;
+	bool								useBVH = true;
+	float								moveTime = 0;		// ړ̏ԁibj
+	TriangleBVHCollisionWorld			collisionWorld;
+	CharacterController					controller;
+	bool								useCharacterController = false;	// ͏]̈ړAGUIŃLN^[Rg[[ɐ؂ւ
+	std::vector<CharacterController>	crowd;
+	int									crowdCount = 0;
+	float								crowdAngle = 0;
+	float								crowdTime = 0;		// QÖړԁibj
 };
@@ -1,6 +1,7 @@
 #include <imgui.h>
 #include <ImGuizmo.h>
 #include "Graphics.h"
+#include "Input.h"
 #include "Scene/SphereVsTriangleCollisionScene.h"
 
 // RXgN^
@@ -38,27 +39,27 @@ void SphereVsTriangleCollisionScene::Update(float elapsedTime)
 	// IuWFNgړ
 	const float speed = 2.0f * elapsedTime;
 	DirectX::XMFLOAT3 vec = { 0, 0, 0 };
-	if (GetAsyncKeyState(VK_UP) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_UP))
 	{
 		vec.z += speed;
 	}
-	if (GetAsyncKeyState(VK_DOWN) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_DOWN))
 	{
 		vec.z -= speed;
 	}
-	if (GetAsyncKeyState(VK_RIGHT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_RIGHT))
 	{
 		vec.x += speed;
 	}
-	if (GetAsyncKeyState(VK_LEFT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_LEFT))
 	{
 		vec.x -= speed;
 	}
-	if (GetAsyncKeyState('Z') & 0x8000)
+	if (Input::Instance().IsKeyPressed('Z'))
 	{
 		vec.y += speed;
 	}
-	if (GetAsyncKeyState('X') & 0x8000)
+	if (Input::Instance().IsKeyPressed('X'))
 	{
 		vec.y -= speed;
 	}
@@ -34,7 +34,7 @@ void SwordTrailScene::Update(float elapsedTime)
 	const int animationIndex = character->GetAnimationIndex("Slash");
 	
 	// w莞Ԃ̃Aj[V̎p擾
-	character->ComputeAnimation(animationIndex, animationSeconds, nodePoses);
+	character->ComputeAnimation(animationIndex, animationSeconds, nodePoses, animationCursor);
 
 	// Aj[VԍXV
 	const Model::Animation& animation = character->GetAnimations().at(animationIndex);
@@ -28,6 +28,7 @@ private:
 	std::shared_ptr<Model>				character;
 	std::shared_ptr<Model>				weapon;
 	std::vector<Model::NodePose>		nodePoses;
+	Model::AnimationCursor				animationCursor;
 	float								animationSeconds = 0;
 	bool								spline = false;
 
@@ -2,6 +2,7 @@
 #include <imgui.h>
 #include <ImGuizmo.h>
 #include "Graphics.h"
+#include "Input.h"
 #include "Scene/TwoBoneIKScene.h"
 
 // RXgN^
@@ -84,7 +85,7 @@ void TwoBoneIKScene::Update(float elapsedTime)
 	// |[^[QbgMYœ
 	const DirectX::XMFLOAT4X4& view = camera.GetView();
 	const DirectX::XMFLOAT4X4& projection = camera.GetProjection();
-	if (GetAsyncKeyState(VK_SPACE) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_SPACE))
 	{
 		DirectX::XMMATRIX PoleWorldTransform = DirectX::XMLoadFloat4x4(&poleWorldTransform);
 		ImGuizmo::Manipulate(
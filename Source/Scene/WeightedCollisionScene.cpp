@@ -1,6 +1,7 @@
 #include <imgui.h>
 #include <ImGuizmo.h>
 #include "Graphics.h"
+#include "Input.h"
 #include "Scene/WeightedCollisionScene.h"
 
 // RXgN^
@@ -43,35 +44,35 @@ void WeightedCollisionScene::Update(float elapsedTime)
 	// IuWFNgړ
 	const float speed = 1.0f * elapsedTime;
 	DirectX::XMFLOAT3 vec[2] = {};
-	if (GetAsyncKeyState('W') & 0x8000)
+	if (Input::Instance().IsKeyPressed('W'))
 	{
 		vec[0].z += speed;
 	}
-	if (GetAsyncKeyState('S') & 0x8000)
+	if (Input::Instance().IsKeyPressed('S'))
 	{
 		vec[0].z -= speed;
 	}
-	if (GetAsyncKeyState('D') & 0x8000)
+	if (Input::Instance().IsKeyPressed('D'))
 	{
 		vec[0].x += speed;
 	}
-	if (GetAsyncKeyState('A') & 0x8000)
+	if (Input::Instance().IsKeyPressed('A'))
 	{
 		vec[0].x -= speed;
 	}
-	if (GetAsyncKeyState(VK_UP) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_UP))
 	{
 		vec[1].z += speed;
 	}
-	if (GetAsyncKeyState(VK_DOWN) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_DOWN))
 	{
 		vec[1].z -= speed;
 	}
-	if (GetAsyncKeyState(VK_RIGHT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_RIGHT))
 	{
 		vec[1].x += speed;
 	}
-	if (GetAsyncKeyState(VK_LEFT) & 0x8000)
+	if (Input::Instance().IsKeyPressed(VK_LEFT))
 	{
 		vec[1].x -= speed;
 	}
@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include "Misc.h"
+#include "StaticCollisionMesh.h"
+
+// AABB_Ŋg
+static void ExpandBounds(DirectX::XMFLOAT3& boundsMin, DirectX::XMFLOAT3& boundsMax, const DirectX::XMFLOAT3& p)
+{
+	boundsMin = { (std::min)(boundsMin.x, p.x), (std::min)(boundsMin.y, p.y), (std::min)(boundsMin.z, p.z) };
+	boundsMax = { (std::max)(boundsMax.x, p.x), (std::max)(boundsMax.y, p.y), (std::max)(boundsMax.z, p.z) };
+}
+
+// f\z
+void StaticCollisionMesh::Build(const Model* model)
+{
+	triangles.clear();
+	chunks.clear();
+	meshes.clear();
+	blocks.Clear();
+	++buildCount;
+
+	for (const Model::Mesh& modelMesh : model->GetMeshes())
+	{
+		Mesh& mesh = meshes.emplace_back();
+		mesh.worldTransform = model->GetNodes().at(modelMesh.nodeIndex).worldTransform;
+		mesh.boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+		mesh.boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		mesh.chunkStart = static_cast<int>(chunks.size());
+
+		// _̓bVɈx[hԕϊ
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&mesh.worldTransform);
+		std::vector<DirectX::XMFLOAT3> positions(modelMesh.vertices.size());
+		for (size_t i = 0; i < modelMesh.vertices.size(); ++i)
+		{
+			DirectX::XMVECTOR Position = DirectX::XMLoadFloat3(&modelMesh.vertices[i].position);
+			DirectX::XMStoreFloat3(&positions[i], DirectX::XMVector3Transform(Position, WorldTransform));
+		}
+
+		size_t meshTriangleStart = triangles.size();
+		for (size_t i = 0; i + 2 < modelMesh.indices.size(); i += 3)
+		{
+			const DirectX::XMFLOAT3& a = positions.at(modelMesh.indices[i + 0]);
+			const DirectX::XMFLOAT3& b = positions.at(modelMesh.indices[i + 1]);
+			const DirectX::XMFLOAT3& c = positions.at(modelMesh.indices[i + 2]);
+
+			// ӂƖ@xNgZo
+			DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&a);
+			DirectX::XMVECTOR Edge1 = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&b), A);
+			DirectX::XMVECTOR Edge2 = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&c), A);
+			DirectX::XMVECTOR N = DirectX::XMVector3Cross(Edge1, Edge2);
+			if (DirectX::XMVector3Equal(N, DirectX::XMVectorZero()))
+			{
+				// ʂ\łȂꍇ͏O
+				continue;
+			}
+
+			Triangle& triangle = triangles.emplace_back();
+			triangle.position = a;
+			DirectX::XMStoreFloat3(&triangle.edge1, Edge1);
+			DirectX::XMStoreFloat3(&triangle.edge2, Edge2);
+			DirectX::XMStoreFloat3(&triangle.normal, DirectX::XMVector3Normalize(N));
+		}
+
+		// bV̎Op`萔`Nɂ܂Ƃ߂
+		int meshTriangleCount = static_cast<int>(triangles.size() - meshTriangleStart);
+		for (int start = 0; start < meshTriangleCount; start += ChunkTriangles)
+		{
+			Chunk& chunk = chunks.emplace_back();
+			chunk.triangleStart = static_cast<int>(meshTriangleStart) + start;
+			chunk.triangleCount = (std::min)(ChunkTriangles, meshTriangleCount - start);
+			chunk.boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+			chunk.boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			chunk.blockStart = blocks.GetBlockCount();
+			for (int i = 0; i < chunk.triangleCount; ++i)
+			{
+				const Triangle& triangle = triangles[chunk.triangleStart + i];
+				ExpandBounds(chunk.boundsMin, chunk.boundsMax, triangle.position);
+				ExpandBounds(chunk.boundsMin, chunk.boundsMax, triangle.GetPositionB());
+				ExpandBounds(chunk.boundsMin, chunk.boundsMax, triangle.GetPositionC());
+				blocks.AddTriangle(triangle.position, triangle.edge1, triangle.edge2, chunk.triangleStart + i);
+			}
+			blocks.Flush();
+			chunk.blockCount = blocks.GetBlockCount() - chunk.blockStart;
+			ExpandBounds(mesh.boundsMin, mesh.boundsMax, chunk.boundsMin);
+			ExpandBounds(mesh.boundsMin, mesh.boundsMax, chunk.boundsMax);
+		}
+		mesh.chunkCount = static_cast<int>(chunks.size()) - mesh.chunkStart;
+	}
+}
+
+// bṼ[hs񂪕ςĂ΍č\z
+bool StaticCollisionMesh::Update(const Model* model)
+{
+	const std::vector<Model::Mesh>& modelMeshes = model->GetMeshes();
+	bool dirty = buildCount == 0 || modelMeshes.size() != meshes.size();
+	for (size_t i = 0; !dirty && i < meshes.size(); ++i)
+	{
+		const DirectX::XMFLOAT4X4& worldTransform = model->GetNodes().at(modelMeshes[i].nodeIndex).worldTransform;
+		dirty = memcmp(&meshes[i].worldTransform, &worldTransform, sizeof(worldTransform)) != 0;
+	}
+	if (!dirty) return false;
+
+	Build(model);
+	return true;
+}
+
+// CAABB̌iXu@j
+static bool IntersectRayAABB(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& invDirection,
+	float maxDistance,
+	const DirectX::XMFLOAT3& boundsMin,
+	const DirectX::XMFLOAT3& boundsMax)
+{
+	float tx1 = (boundsMin.x - start.x) * invDirection.x;
+	float tx2 = (boundsMax.x - start.x) * invDirection.x;
+	float tmin = (std::min)(tx1, tx2);
+	float tmax = (std::max)(tx1, tx2);
+	float ty1 = (boundsMin.y - start.y) * invDirection.y;
+	float ty2 = (boundsMax.y - start.y) * invDirection.y;
+	tmin = (std::max)(tmin, (std::min)(ty1, ty2));
+	tmax = (std::min)(tmax, (std::max)(ty1, ty2));
+	float tz1 = (boundsMin.z - start.z) * invDirection.z;
+	float tz2 = (boundsMax.z - start.z) * invDirection.z;
+	tmin = (std::max)(tmin, (std::min)(tz1, tz2));
+	tmax = (std::min)(tmax, (std::max)(tz1, tz2));
+
+	return tmax >= tmin && tmax >= 0.0f && tmin <= maxDistance;
+}
+
+// CLXgił߂_߂j
+bool StaticCollisionMesh::RayCast(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& end,
+	HitResult& hit) const
+{
+	DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&start);
+	DirectX::XMVECTOR End = DirectX::XMLoadFloat3(&end);
+	DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(End, Start);
+	DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(Vec);
+	float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+
+	// 0ZINFƂȂXu@ł̂܂܈
+	DirectX::XMFLOAT3 direction;
+	DirectX::XMStoreFloat3(&direction, Direction);
+	DirectX::XMFLOAT3 invDirection = { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	int nearestTriangleIndex = -1;
+	for (const Mesh& mesh : meshes)
+	{
+		// bV`N̏AABBōi荞
+		if (!IntersectRayAABB(start, invDirection, distance, mesh.boundsMin, mesh.boundsMax)) continue;
+
+		for (int chunkIndex = mesh.chunkStart; chunkIndex < mesh.chunkStart + mesh.chunkCount; ++chunkIndex)
+		{
+			const Chunk& chunk = chunks[chunkIndex];
+			if (!IntersectRayAABB(start, invDirection, distance, chunk.boundsMin, chunk.boundsMax)) continue;
+
+			int triangleIndex = blocks.IntersectRay(start, direction, chunk.blockStart, chunk.blockCount, distance);
+			if (triangleIndex >= 0)
+			{
+				nearestTriangleIndex = triangleIndex;
+			}
+		}
+	}
+
+	if (nearestTriangleIndex < 0) return false;
+
+	DirectX::XMVECTOR HitPosition = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(Direction, distance));
+	DirectX::XMStoreFloat3(&hit.position, HitPosition);
+	hit.normal = triangles[nearestTriangleIndex].normal;
+	hit.distance = distance;
+	hit.triangleIndex = nearestTriangleIndex;
+	return true;
+}
+
+// őS{̃C܂Ƃ߂ăCLXg
+void StaticCollisionMesh::RayCastPacket(
+	const DirectX::XMFLOAT3 starts[],
+	const DirectX::XMFLOAT3 ends[],
+	int count,
+	HitResult hits[],
+	bool results[],
+	bool anyHit) const
+{
+	_ASSERT_EXPR(count >= 0 && count <= TriangleBlocks::BlockSize, L"packet ray count out of range");
+
+	DirectX::XMFLOAT3 directions[TriangleBlocks::BlockSize];
+	DirectX::XMFLOAT3 invDirections[TriangleBlocks::BlockSize];
+	float distances[TriangleBlocks::BlockSize] = {};
+	int triangleIndices[TriangleBlocks::BlockSize] = { -1, -1, -1, -1 };
+	for (int i = 0; i < count; ++i)
+	{
+		DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&ends[i]), DirectX::XMLoadFloat3(&starts[i]));
+		DirectX::XMStoreFloat3(&directions[i], DirectX::XMVector3Normalize(Vec));
+		distances[i] = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+		invDirections[i] = { 1.0f / directions[i].x, 1.0f / directions[i].y, 1.0f / directions[i].z };
+	}
+	TriangleBlocks::RayPacket packet;
+	TriangleBlocks::MakePacket(starts, directions, count, packet);
+
+	// ꂩ̃CAABBƌ΃pPbgŜŃ`N𔻒肷
+	// ̗L߂ꍇ͌ς݂̃CASČł؂
+	auto intersectAnyRay = [&](const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (anyHit && triangleIndices[i] >= 0) continue;
+			if (IntersectRayAABB(starts[i], invDirections[i], distances[i], boundsMin, boundsMax)) return true;
+		}
+		return false;
+	};
+	for (const Mesh& mesh : meshes)
+	{
+		if (!intersectAnyRay(mesh.boundsMin, mesh.boundsMax)) continue;
+
+		for (int chunkIndex = mesh.chunkStart; chunkIndex < mesh.chunkStart + mesh.chunkCount; ++chunkIndex)
+		{
+			const Chunk& chunk = chunks[chunkIndex];
+			if (!intersectAnyRay(chunk.boundsMin, chunk.boundsMax)) continue;
+
+			blocks.IntersectPacket(packet, chunk.blockStart, chunk.blockCount, distances, triangleIndices, anyHit);
+		}
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		results[i] = triangleIndices[i] >= 0;
+		if (!results[i]) continue;
+
+		HitResult& hit = hits[i];
+		DirectX::XMVECTOR HitPosition = DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&starts[i]), DirectX::XMVectorScale(DirectX::XMLoadFloat3(&directions[i]), distances[i]));
+		DirectX::XMStoreFloat3(&hit.position, HitPosition);
+		hit.normal = triangles[triangleIndices[i]].normal;
+		hit.distance = distances[i];
+		hit.triangleIndex = triangleIndices[i];
+	}
+}
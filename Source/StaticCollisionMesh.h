@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "Model.h"
+#include "TriangleBVH.h"
+#include "TriangleBlocks.h"
+
+// ÓIՓ˔胁bVif̃bV[hԂ̎Op`ɕϊĕێAϊs񂪕ςꍇč\zj
+class StaticCollisionMesh
+{
+public:
+	using HitResult = TriangleBVH::HitResult;
+
+	// Op`iŎgӂƖ@\zɋ߂Ăj
+	struct Triangle
+	{
+		DirectX::XMFLOAT3	position;		// _A
+		DirectX::XMFLOAT3	edge1;			// _B - _A
+		DirectX::XMFLOAT3	edge2;			// _C - _A
+		DirectX::XMFLOAT3	normal;			// Kς݂̖ʖ@
+
+		DirectX::XMFLOAT3 GetPositionB() const { return { position.x + edge1.x, position.y + edge1.y, position.z + edge1.z }; }
+		DirectX::XMFLOAT3 GetPositionC() const { return { position.x + edge2.x, position.y + edge2.y, position.z + edge2.z }; }
+	};
+
+	// 萔̎Op`܂Ƃ߂`Nip̃ubN`Nɋ؂j
+	struct Chunk
+	{
+		DirectX::XMFLOAT3	boundsMin;
+		int					triangleStart;
+		DirectX::XMFLOAT3	boundsMax;
+		int					triangleCount;
+		int					blockStart;
+		int					blockCount;
+	};
+
+	// bVi\z̃m[h̃[hsێĕύXoj
+	struct Mesh
+	{
+		DirectX::XMFLOAT3	boundsMin;
+		int					chunkStart;
+		DirectX::XMFLOAT3	boundsMax;
+		int					chunkCount;
+		DirectX::XMFLOAT4X4	worldTransform;
+	};
+
+	StaticCollisionMesh() = default;
+	~StaticCollisionMesh() = default;
+
+	// f\z
+	void Build(const Model* model);
+
+	// bṼ[hs񂪕ςĂ΍č\zič\zꍇtrueԂj
+	bool Update(const Model* model);
+
+	// CLXgił߂_߂j
+	bool RayCast(
+		const DirectX::XMFLOAT3& start,
+		const DirectX::XMFLOAT3& end,
+		HitResult& hit) const;
+
+	// őS{̃C܂Ƃ߂ăCLXgiIKȂǋ߂ʒu瓯ɔ΂CACɕԂj
+	// anyHittruȅꍇ͍ł߂_Ƃ͌炸AC画ł؂
+	void RayCastPacket(
+		const DirectX::XMFLOAT3 starts[],
+		const DirectX::XMFLOAT3 ends[],
+		int count,
+		HitResult hits[],
+		bool results[],
+		bool anyHit = false) const;
+
+	// Op`Xg擾ibVAbV̓CfbNXj
+	const std::vector<Triangle>& GetTriangles() const { return triangles; }
+
+	// `NXg擾
+	const std::vector<Chunk>& GetChunks() const { return chunks; }
+
+	// bVXg擾
+	const std::vector<Mesh>& GetMeshes() const { return meshes; }
+
+	// \z񐔎擾
+	int GetBuildCount() const { return buildCount; }
+
+	// AABBm̌
+	static bool IntersectBounds(
+		const DirectX::XMFLOAT3& aMin, const DirectX::XMFLOAT3& aMax,
+		const DirectX::XMFLOAT3& bMin, const DirectX::XMFLOAT3& bMax)
+	{
+		return aMin.x <= bMax.x && aMax.x >= bMin.x
+			&& aMin.y <= bMax.y && aMax.y >= bMin.y
+			&& aMin.z <= bMax.z && aMax.z >= bMin.z;
+	}
+
+private:
+	static const int	ChunkTriangles = 32;
+
+	std::vector<Triangle>	triangles;
+	std::vector<Chunk>		chunks;
+	std::vector<Mesh>		meshes;
+	TriangleBlocks			blocks;
+	int						buildCount = 0;
+};
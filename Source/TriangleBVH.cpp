@@ -0,0 +1,639 @@
+#include <algorithm>
+#include <cfloat>
+#include <SphereCast.h>
+#include "Misc.h"
+#include "TriangleBVH.h"
+
+// f̃bV[hԂ̎Op`ɕϊč\z
+void TriangleBVH::Build(const Model* model)
+{
+	std::vector<Triangle> sourceTriangles;
+	for (const Model::Mesh& mesh : model->GetMeshes())
+	{
+		DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&model->GetNodes().at(mesh.nodeIndex).worldTransform);
+		for (size_t i = 0; i < mesh.indices.size(); i += 3)
+		{
+			// _f[^[hԕϊ
+			uint32_t a = mesh.indices.at(i + 0);
+			uint32_t b = mesh.indices.at(i + 1);
+			uint32_t c = mesh.indices.at(i + 2);
+			DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&mesh.vertices.at(a).position);
+			DirectX::XMVECTOR B = DirectX::XMLoadFloat3(&mesh.vertices.at(b).position);
+			DirectX::XMVECTOR C = DirectX::XMLoadFloat3(&mesh.vertices.at(c).position);
+			A = DirectX::XMVector3Transform(A, WorldTransform);
+			B = DirectX::XMVector3Transform(B, WorldTransform);
+			C = DirectX::XMVector3Transform(C, WorldTransform);
+
+			// @xNgZo
+			DirectX::XMVECTOR N = DirectX::XMVector3Cross(DirectX::XMVectorSubtract(B, A), DirectX::XMVectorSubtract(C, A));
+			if (DirectX::XMVector3Equal(N, DirectX::XMVectorZero()))
+			{
+				// ʂ\łȂꍇ͏O
+				continue;
+			}
+			N = DirectX::XMVector3Normalize(N);
+
+			// Op`f[^i[
+			Triangle& triangle = sourceTriangles.emplace_back();
+			DirectX::XMStoreFloat3(&triangle.positions[0], A);
+			DirectX::XMStoreFloat3(&triangle.positions[1], B);
+			DirectX::XMStoreFloat3(&triangle.positions[2], C);
+			DirectX::XMStoreFloat3(&triangle.normal, N);
+		}
+	}
+	Build(sourceTriangles);
+}
+
+// Op`Xg\z
+void TriangleBVH::Build(const std::vector<Triangle>& sourceTriangles)
+{
+	triangles = sourceTriangles;
+	triangleIndices.clear();
+	nodes.clear();
+	leafBlocks.Clear();
+	nodeBlockStarts.clear();
+	if (triangles.empty()) return;
+
+	// \zpɎOp`AABBƏdSZo
+	std::vector<BuildTriangle> buildTriangles(triangles.size());
+	triangleIndices.resize(triangles.size());
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		const Triangle& triangle = triangles.at(i);
+		DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&triangle.positions[0]);
+		DirectX::XMVECTOR B = DirectX::XMLoadFloat3(&triangle.positions[1]);
+		DirectX::XMVECTOR C = DirectX::XMLoadFloat3(&triangle.positions[2]);
+		DirectX::XMVECTOR Min = DirectX::XMVectorMin(DirectX::XMVectorMin(A, B), C);
+		DirectX::XMVECTOR Max = DirectX::XMVectorMax(DirectX::XMVectorMax(A, B), C);
+		DirectX::XMVECTOR Centroid = DirectX::XMVectorScale(DirectX::XMVectorAdd(DirectX::XMVectorAdd(A, B), C), 1.0f / 3.0f);
+
+		BuildTriangle& buildTriangle = buildTriangles.at(i);
+		DirectX::XMStoreFloat3(&buildTriangle.boundsMin, Min);
+		DirectX::XMStoreFloat3(&buildTriangle.boundsMax, Max);
+		DirectX::XMStoreFloat3(&buildTriangle.centroid, Centroid);
+
+		triangleIndices.at(i) = static_cast<int>(i);
+	}
+
+	// [gm[h쐬
+	nodes.reserve(triangles.size() * 2);
+	Node& root = nodes.emplace_back();
+	root.offset = 0;
+	root.count = static_cast<int>(triangles.size());
+	UpdateNodeBounds(root, buildTriangles);
+
+	// ċAIɕ
+	Subdivide(0, 0, buildTriangles);
+	nodes.shrink_to_fit();
+
+	// t̎Op`tɃubN֋l߂
+	nodeBlockStarts.assign(nodes.size(), -1);
+	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+	{
+		const Node& node = nodes[nodeIndex];
+		if (node.count == 0) continue;
+
+		nodeBlockStarts[nodeIndex] = leafBlocks.GetBlockCount();
+		for (int i = 0; i < node.count; ++i)
+		{
+			int triangleIndex = triangleIndices[node.offset + i];
+			const Triangle& triangle = triangles[triangleIndex];
+			DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&triangle.positions[0]);
+			DirectX::XMFLOAT3 edge1, edge2;
+			DirectX::XMStoreFloat3(&edge1, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&triangle.positions[1]), A));
+			DirectX::XMStoreFloat3(&edge2, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&triangle.positions[2]), A));
+			leafBlocks.AddTriangle(triangle.positions[0], edge1, edge2, triangleIndex);
+		}
+		leafBlocks.Flush();
+	}
+}
+
+// m[hAABBXV
+void TriangleBVH::UpdateNodeBounds(Node& node, const std::vector<BuildTriangle>& buildTriangles) const
+{
+	DirectX::XMVECTOR Min = DirectX::XMVectorReplicate(FLT_MAX);
+	DirectX::XMVECTOR Max = DirectX::XMVectorReplicate(-FLT_MAX);
+	for (int i = 0; i < node.count; ++i)
+	{
+		const BuildTriangle& buildTriangle = buildTriangles.at(triangleIndices.at(node.offset + i));
+		Min = DirectX::XMVectorMin(Min, DirectX::XMLoadFloat3(&buildTriangle.boundsMin));
+		Max = DirectX::XMVectorMax(Max, DirectX::XMLoadFloat3(&buildTriangle.boundsMax));
+	}
+	DirectX::XMStoreFloat3(&node.boundsMin, Min);
+	DirectX::XMStoreFloat3(&node.boundsMax, Max);
+}
+
+// m[hċAIɕ
+void TriangleBVH::Subdivide(int nodeIndex, int depth, std::vector<BuildTriangle>& buildTriangles)
+{
+	// ̃X^bNɎ܂Ȃ[ł͕tƂ
+	// [d̎}𑖍鎞̓X^bNɑčZ킪ődcAqQςނd+2ɂȂ邽
+	if (depth >= MaxStackDepth - 1) return;
+
+	// AABB̕\ʐς̔߂iSAH̔rɂ̂ݎĝŌW͏ȗj
+	auto halfArea = [](const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max)
+	{
+		float x = max.x - min.x;
+		float y = max.y - min.y;
+		float z = max.z - min.z;
+		return x * y + y * z + z * x;
+	};
+
+	const int offset = nodes.at(nodeIndex).offset;
+	const int count = nodes.at(nodeIndex).count;
+	if (count <= MaxLeafTriangles) return;
+
+	// dSAABBZo
+	DirectX::XMFLOAT3 centroidMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+	DirectX::XMFLOAT3 centroidMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (int i = 0; i < count; ++i)
+	{
+		const DirectX::XMFLOAT3& c = buildTriangles.at(triangleIndices.at(offset + i)).centroid;
+		centroidMin.x = (std::min)(centroidMin.x, c.x);
+		centroidMin.y = (std::min)(centroidMin.y, c.y);
+		centroidMin.z = (std::min)(centroidMin.z, c.z);
+		centroidMax.x = (std::max)(centroidMax.x, c.x);
+		centroidMax.y = (std::max)(centroidMax.y, c.y);
+		centroidMax.z = (std::max)(centroidMax.z, c.z);
+	}
+
+	// erɕSAHRXgŏƂȂ镪ʒuT
+	struct Bin
+	{
+		DirectX::XMFLOAT3	boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+		DirectX::XMFLOAT3	boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		int					count = 0;
+	};
+	auto grow = [](DirectX::XMFLOAT3& min, DirectX::XMFLOAT3& max, const DirectX::XMFLOAT3& bmin, const DirectX::XMFLOAT3& bmax)
+	{
+		min.x = (std::min)(min.x, bmin.x); min.y = (std::min)(min.y, bmin.y); min.z = (std::min)(min.z, bmin.z);
+		max.x = (std::max)(max.x, bmax.x); max.y = (std::max)(max.y, bmax.y); max.z = (std::max)(max.z, bmax.z);
+	};
+
+	int bestAxis = -1;
+	int bestSplit = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float axisMin = (&centroidMin.x)[axis];
+		float axisMax = (&centroidMax.x)[axis];
+		if (axisMin == axisMax) continue;
+
+		Bin bins[BinCount];
+		float scale = BinCount / (axisMax - axisMin);
+		for (int i = 0; i < count; ++i)
+		{
+			const BuildTriangle& buildTriangle = buildTriangles.at(triangleIndices.at(offset + i));
+			int binIndex = (std::min)(BinCount - 1, static_cast<int>(((&buildTriangle.centroid.x)[axis] - axisMin) * scale));
+			Bin& bin = bins[binIndex];
+			bin.count++;
+			grow(bin.boundsMin, bin.boundsMax, buildTriangle.boundsMin, buildTriangle.boundsMax);
+		}
+
+		// EݐςĊeʒũRXg߂
+		float leftArea[BinCount - 1], rightArea[BinCount - 1];
+		int leftCount[BinCount - 1], rightCount[BinCount - 1];
+		Bin left, right;
+		for (int i = 0; i < BinCount - 1; ++i)
+		{
+			left.count += bins[i].count;
+			grow(left.boundsMin, left.boundsMax, bins[i].boundsMin, bins[i].boundsMax);
+			leftCount[i] = left.count;
+			leftArea[i] = left.count > 0 ? halfArea(left.boundsMin, left.boundsMax) : 0.0f;
+
+			const Bin& bin = bins[BinCount - 1 - i];
+			right.count += bin.count;
+			grow(right.boundsMin, right.boundsMax, bin.boundsMin, bin.boundsMax);
+			rightCount[BinCount - 2 - i] = right.count;
+			rightArea[BinCount - 2 - i] = right.count > 0 ? halfArea(right.boundsMin, right.boundsMax) : 0.0f;
+		}
+		for (int i = 0; i < BinCount - 1; ++i)
+		{
+			if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+			float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = i;
+			}
+		}
+	}
+
+	// Ȃꍇ͗tƂ
+	const Node& node = nodes.at(nodeIndex);
+	float leafCost = count * halfArea(node.boundsMin, node.boundsMax);
+	if (bestAxis < 0 || bestCost >= leafCost) return;
+
+	// ʒuŎOp`U蕪
+	float axisMin = (&centroidMin.x)[bestAxis];
+	float scale = BinCount / ((&centroidMax.x)[bestAxis] - axisMin);
+	int* first = triangleIndices.data() + offset;
+	int* last = first + count;
+	int* middle = std::partition(first, last, [&](int triangleIndex)
+	{
+		float c = (&buildTriangles.at(triangleIndex).centroid.x)[bestAxis];
+		int binIndex = (std::min)(BinCount - 1, static_cast<int>((c - axisMin) * scale));
+		return binIndex <= bestSplit;
+	});
+	int leftCount = static_cast<int>(middle - first);
+	if (leftCount == 0 || leftCount == count) return;
+
+	// qm[h쐬i̎q͒ɔzuAE̎q͍̕؂̌ɔzuj
+	int leftIndex = static_cast<int>(nodes.size());
+	{
+		Node& left = nodes.emplace_back();
+		left.offset = offset;
+		left.count = leftCount;
+		UpdateNodeBounds(left, buildTriangles);
+	}
+	Subdivide(leftIndex, depth + 1, buildTriangles);
+
+	int rightIndex = static_cast<int>(nodes.size());
+	{
+		Node& right = nodes.emplace_back();
+		right.offset = offset + leftCount;
+		right.count = count - leftCount;
+		UpdateNodeBounds(right, buildTriangles);
+	}
+	Subdivide(rightIndex, depth + 1, buildTriangles);
+
+	// }m[hɕύX
+	Node& parent = nodes.at(nodeIndex);
+	parent.offset = rightIndex;
+	parent.count = 0;
+}
+
+// CAABB̌iXu@j
+static bool IntersectRayAABB(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& invDirection,
+	float maxDistance,
+	const DirectX::XMFLOAT3& boundsMin,
+	const DirectX::XMFLOAT3& boundsMax,
+	float& entryDistance)
+{
+	float tx1 = (boundsMin.x - start.x) * invDirection.x;
+	float tx2 = (boundsMax.x - start.x) * invDirection.x;
+	float tmin = (std::min)(tx1, tx2);
+	float tmax = (std::max)(tx1, tx2);
+	float ty1 = (boundsMin.y - start.y) * invDirection.y;
+	float ty2 = (boundsMax.y - start.y) * invDirection.y;
+	tmin = (std::max)(tmin, (std::min)(ty1, ty2));
+	tmax = (std::min)(tmax, (std::max)(ty1, ty2));
+	float tz1 = (boundsMin.z - start.z) * invDirection.z;
+	float tz2 = (boundsMax.z - start.z) * invDirection.z;
+	tmin = (std::max)(tmin, (std::min)(tz1, tz2));
+	tmax = (std::min)(tmax, (std::max)(tz1, tz2));
+
+	entryDistance = tmin;
+	return tmax >= tmin && tmax >= 0.0f && tmin <= maxDistance;
+}
+
+// CLXgił߂_߂j
+bool TriangleBVH::RayCast(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& end,
+	HitResult& hit) const
+{
+	if (nodes.empty()) return false;
+
+	DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&start);
+	DirectX::XMVECTOR End = DirectX::XMLoadFloat3(&end);
+	DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(End, Start);
+	DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(Vec);
+	float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+
+	// 0ZINFƂȂXu@ł̂܂܈
+	DirectX::XMFLOAT3 direction;
+	DirectX::XMStoreFloat3(&direction, Direction);
+	DirectX::XMFLOAT3 invDirection = { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	int nearestTriangleIndex = -1;
+	int stack[MaxStackDepth];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const int nodeIndex = stack[--stackSize];
+		const Node& node = nodes[nodeIndex];
+		float entry;
+		if (!IntersectRayAABB(start, invDirection, distance, node.boundsMin, node.boundsMax, entry)) continue;
+
+		if (node.count > 0)
+		{
+			// tm[h̎Op`ƂSOp`SIMDŌ
+			int blockCount = (node.count + TriangleBlocks::BlockSize - 1) / TriangleBlocks::BlockSize;
+			int triangleIndex = leafBlocks.IntersectRay(start, direction, nodeBlockStarts[nodeIndex], blockCount, distance);
+			if (triangleIndex >= 0)
+			{
+				nearestTriangleIndex = triangleIndex;
+			}
+			continue;
+		}
+
+		// ߂qm[hɏ邽߁Aς
+		int leftIndex = nodeIndex + 1;
+		int rightIndex = node.offset;
+		float leftEntry, rightEntry;
+		bool hitLeft = IntersectRayAABB(start, invDirection, distance, nodes[leftIndex].boundsMin, nodes[leftIndex].boundsMax, leftEntry);
+		bool hitRight = IntersectRayAABB(start, invDirection, distance, nodes[rightIndex].boundsMin, nodes[rightIndex].boundsMax, rightEntry);
+		_ASSERT_EXPR(stackSize + 2 <= MaxStackDepth, L"BVH stack overflow");
+		if (hitLeft && hitRight)
+		{
+			if (leftEntry <= rightEntry)
+			{
+				stack[stackSize++] = rightIndex;
+				stack[stackSize++] = leftIndex;
+			}
+			else
+			{
+				stack[stackSize++] = leftIndex;
+				stack[stackSize++] = rightIndex;
+			}
+		}
+		else if (hitLeft)
+		{
+			stack[stackSize++] = leftIndex;
+		}
+		else if (hitRight)
+		{
+			stack[stackSize++] = rightIndex;
+		}
+	}
+
+	if (nearestTriangleIndex < 0) return false;
+
+	DirectX::XMVECTOR HitPosition = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(Direction, distance));
+	DirectX::XMStoreFloat3(&hit.position, HitPosition);
+	hit.normal = triangles[nearestTriangleIndex].normal;
+	hit.distance = distance;
+	hit.triangleIndex = nearestTriangleIndex;
+	return true;
+}
+
+// őS{̃C܂Ƃ߂ăCLXg
+void TriangleBVH::RayCastPacket(
+	const DirectX::XMFLOAT3 starts[],
+	const DirectX::XMFLOAT3 ends[],
+	int count,
+	HitResult hits[],
+	bool results[],
+	bool anyHit) const
+{
+	_ASSERT_EXPR(count >= 0 && count <= TriangleBlocks::BlockSize, L"packet ray count out of range");
+
+	DirectX::XMFLOAT3 directions[TriangleBlocks::BlockSize];
+	DirectX::XMFLOAT3 invDirections[TriangleBlocks::BlockSize];
+	float distances[TriangleBlocks::BlockSize] = {};
+	int triangleIndices[TriangleBlocks::BlockSize] = { -1, -1, -1, -1 };
+	for (int i = 0; i < count; ++i)
+	{
+		DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&ends[i]), DirectX::XMLoadFloat3(&starts[i]));
+		DirectX::XMStoreFloat3(&directions[i], DirectX::XMVector3Normalize(Vec));
+		distances[i] = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+		invDirections[i] = { 1.0f / directions[i].x, 1.0f / directions[i].y, 1.0f / directions[i].z };
+	}
+	TriangleBlocks::RayPacket packet;
+	TriangleBlocks::MakePacket(starts, directions, count, packet);
+
+	// ꂩ̃CAABBƌ΃pPbgŜŎqm[h֐iށientry͌C̍ł߂ij
+	// ̗L߂ꍇ͌ς݂̃C
+	auto intersectAnyRay = [&](const Node& node, float& entry)
+	{
+		bool result = false;
+		entry = FLT_MAX;
+		for (int i = 0; i < count; ++i)
+		{
+			if (anyHit && triangleIndices[i] >= 0) continue;
+			float rayEntry;
+			if (IntersectRayAABB(starts[i], invDirections[i], distances[i], node.boundsMin, node.boundsMax, rayEntry))
+			{
+				entry = (std::min)(entry, rayEntry);
+				result = true;
+			}
+		}
+		return result;
+	};
+
+	int stack[MaxStackDepth];
+	int stackSize = 0;
+	if (!nodes.empty()) stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const int nodeIndex = stack[--stackSize];
+		const Node& node = nodes[nodeIndex];
+		float entry;
+		if (!intersectAnyRay(node, entry)) continue;
+
+		if (node.count > 0)
+		{
+			// tm[h̎Op`ƂS{̃CSIMDŌ
+			int blockCount = (node.count + TriangleBlocks::BlockSize - 1) / TriangleBlocks::BlockSize;
+			leafBlocks.IntersectPacket(packet, nodeBlockStarts[nodeIndex], blockCount, distances, triangleIndices, anyHit);
+
+			// ̗L߂ꍇ͑SẴCł؂
+			if (anyHit && std::all_of(triangleIndices, triangleIndices + count, [](int index) { return index >= 0; })) break;
+			continue;
+		}
+
+		// ߂qm[hɏ邽߁Aς
+		int leftIndex = nodeIndex + 1;
+		int rightIndex = node.offset;
+		float leftEntry, rightEntry;
+		bool hitLeft = intersectAnyRay(nodes[leftIndex], leftEntry);
+		bool hitRight = intersectAnyRay(nodes[rightIndex], rightEntry);
+		_ASSERT_EXPR(stackSize + 2 <= MaxStackDepth, L"BVH stack overflow");
+		if (hitLeft && hitRight)
+		{
+			if (leftEntry <= rightEntry)
+			{
+				stack[stackSize++] = rightIndex;
+				stack[stackSize++] = leftIndex;
+			}
+			else
+			{
+				stack[stackSize++] = leftIndex;
+				stack[stackSize++] = rightIndex;
+			}
+		}
+		else if (hitLeft)
+		{
+			stack[stackSize++] = leftIndex;
+		}
+		else if (hitRight)
+		{
+			stack[stackSize++] = rightIndex;
+		}
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		results[i] = triangleIndices[i] >= 0;
+		if (!results[i]) continue;
+
+		HitResult& hit = hits[i];
+		DirectX::XMVECTOR HitPosition = DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&starts[i]), DirectX::XMVectorScale(DirectX::XMLoadFloat3(&directions[i]), distances[i]));
+		DirectX::XMStoreFloat3(&hit.position, HitPosition);
+		hit.normal = triangles[triangleIndices[i]].normal;
+		hit.distance = distances[i];
+		hit.triangleIndex = triangleIndices[i];
+	}
+}
+
+// AABBm͈̔͂Ńm[h𑖍
+void TriangleBVH::QueryBounds(
+	const DirectX::XMFLOAT3& boundsMin,
+	const DirectX::XMFLOAT3& boundsMax,
+	const DirectX::XMFLOAT3* sphereCenter,
+	float sphereRadius,
+	std::vector<int>& result) const
+{
+	result.clear();
+	if (nodes.empty()) return;
+
+	// AABB̍ŒẐQ߂
+	auto sphereDistanceSq = [&](const Node& node)
+	{
+		float distanceSq = 0.0f;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float c = (&sphereCenter->x)[axis];
+			float v = (std::max)((&node.boundsMin.x)[axis], (std::min)(c, (&node.boundsMax.x)[axis]));
+			distanceSq += (c - v) * (c - v);
+		}
+		return distanceSq;
+	};
+	const float radiusSq = sphereRadius * sphereRadius;
+
+	int stack[MaxStackDepth];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		int nodeIndex = stack[--stackSize];
+		const Node& node = nodes[nodeIndex];
+		if (node.boundsMin.x > boundsMax.x || node.boundsMax.x < boundsMin.x) continue;
+		if (node.boundsMin.y > boundsMax.y || node.boundsMax.y < boundsMin.y) continue;
+		if (node.boundsMin.z > boundsMax.z || node.boundsMax.z < boundsMin.z) continue;
+		if (sphereCenter != nullptr && sphereDistanceSq(node) > radiusSq) continue;
+
+		if (node.count > 0)
+		{
+			result.insert(result.end(), triangleIndices.begin() + node.offset, triangleIndices.begin() + node.offset + node.count);
+			continue;
+		}
+		_ASSERT_EXPR(stackSize + 2 <= MaxStackDepth, L"BVH stack overflow");
+		stack[stackSize++] = node.offset;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+
+	// ƓԂŏł悤ɍ\z̏Ԃɕבւ
+	std::sort(result.begin(), result.end());
+}
+
+// ƌ\̂Op`W
+void TriangleBVH::QuerySphere(
+	const DirectX::XMFLOAT3& center,
+	float radius,
+	std::vector<int>& result) const
+{
+	DirectX::XMFLOAT3 boundsMin = { center.x - radius, center.y - radius, center.z - radius };
+	DirectX::XMFLOAT3 boundsMax = { center.x + radius, center.y + radius, center.z + radius };
+	QueryBounds(boundsMin, boundsMax, &center, radius, result);
+}
+
+// AABBƌ\̂Op`W
+void TriangleBVH::QueryAABB(
+	const DirectX::XMFLOAT3& boundsMin,
+	const DirectX::XMFLOAT3& boundsMax,
+	std::vector<int>& result) const
+{
+	QueryBounds(boundsMin, boundsMax, nullptr, 0.0f, result);
+}
+
+// XtBALXgił߂_߂j
+bool TriangleBVH::SphereCast(
+	const DirectX::XMFLOAT3& origin,
+	const DirectX::XMFLOAT3& direction,
+	float radius,
+	float distance,
+	HitResult& hit) const
+{
+	if (nodes.empty()) return false;
+
+	DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&origin);
+	DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction));
+	DirectX::XMVECTOR End = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(Direction, distance));
+
+	DirectX::XMFLOAT3 dir, end;
+	DirectX::XMStoreFloat3(&dir, Direction);
+	DirectX::XMStoreFloat3(&end, End);
+	DirectX::XMFLOAT3 invDirection = { 1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z };
+
+	// ̔ac܂AABBƃCŔ肷
+	auto expandedIntersect = [&](const Node& node, float maxDistance)
+	{
+		DirectX::XMFLOAT3 boundsMin = { node.boundsMin.x - radius, node.boundsMin.y - radius, node.boundsMin.z - radius };
+		DirectX::XMFLOAT3 boundsMax = { node.boundsMax.x + radius, node.boundsMax.y + radius, node.boundsMax.z + radius };
+		float entry;
+		return IntersectRayAABB(origin, invDirection, maxDistance, boundsMin, boundsMax, entry);
+	};
+
+	float nearestDistance = distance;
+	bool result = false;
+	int stack[MaxStackDepth];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		int nodeIndex = stack[--stackSize];
+		const Node& node = nodes[nodeIndex];
+		if (!expandedIntersect(node, nearestDistance)) continue;
+
+		if (node.count > 0)
+		{
+			// SOp`SIMDŌiAcOp`ɔ肷
+			int blockStart = nodeBlockStarts[nodeIndex];
+			int blockCount = (node.count + TriangleBlocks::BlockSize - 1) / TriangleBlocks::BlockSize;
+			for (int blockIndex = blockStart; blockIndex < blockStart + blockCount; ++blockIndex)
+			{
+				unsigned int mask = leafBlocks.FilterSphereCast(origin, end, radius, blockIndex);
+				for (int lane = 0; mask != 0; ++lane, mask >>= 1)
+				{
+					if ((mask & 1) == 0) continue;
+
+					int triangleIndex = leafBlocks.GetBlock(blockIndex).triangleIndices[lane];
+					const Triangle& triangle = triangles[triangleIndex];
+					DirectX::XMVECTOR Positions[3] =
+					{
+						DirectX::XMLoadFloat3(&triangle.positions[0]),
+						DirectX::XMLoadFloat3(&triangle.positions[1]),
+						DirectX::XMLoadFloat3(&triangle.positions[2]),
+					};
+
+					SphereCastResult sphereCastResult;
+					if (IntersectSphereCastVsTriangle(Start, End, radius, Positions, &sphereCastResult))
+					{
+						if (sphereCastResult.distance < nearestDistance)
+						{
+							// ʒu͏Փˎ̋̒SƂ
+							nearestDistance = sphereCastResult.distance;
+							DirectX::XMVECTOR HitPosition = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(Direction, nearestDistance));
+							DirectX::XMStoreFloat3(&hit.position, HitPosition);
+							DirectX::XMStoreFloat3(&hit.normal, sphereCastResult.normal);
+							hit.distance = sphereCastResult.distance;
+							hit.triangleIndex = triangleIndex;
+							result = true;
+						}
+					}
+				}
+			}
+			continue;
+		}
+		_ASSERT_EXPR(stackSize + 2 <= MaxStackDepth, L"BVH stack overflow");
+		stack[stackSize++] = node.offset;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+	return result;
+}
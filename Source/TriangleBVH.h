@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "Model.h"
+#include "TriangleBlocks.h"
+
+// Op`BVHioEfBO{[Kwj
+class TriangleBVH
+{
+public:
+	struct Triangle
+	{
+		DirectX::XMFLOAT3	positions[3];
+		DirectX::XMFLOAT3	normal;
+	};
+
+	// m[h͐[D揇ɔz񉻂A̎q͏ɒɔzu
+	struct Node
+	{
+		DirectX::XMFLOAT3	boundsMin;
+		int					offset;		// t:擪Op`CfbNX@}:E̎qm[hCfbNX
+		DirectX::XMFLOAT3	boundsMax;
+		int					count;		// t:Op`@}:0
+	};
+
+	struct HitResult
+	{
+		DirectX::XMFLOAT3	position;
+		DirectX::XMFLOAT3	normal;
+		float				distance = 0.0f;
+		int					triangleIndex = -1;
+	};
+
+	TriangleBVH() = default;
+	~TriangleBVH() = default;
+
+	// f̃bV[hԂ̎Op`ɕϊč\z
+	void Build(const Model* model);
+
+	// Op`Xg\z
+	void Build(const std::vector<Triangle>& sourceTriangles);
+
+	// CLXgił߂_߂j
+	bool RayCast(
+		const DirectX::XMFLOAT3& start,
+		const DirectX::XMFLOAT3& end,
+		HitResult& hit) const;
+
+	// őS{̃C܂Ƃ߂ăCLXgim[h͂ꂩ̃C΃pPbgŜőACɕԂj
+	// anyHittruȅꍇ͍ł߂_Ƃ͌炸AC画ł؂
+	void RayCastPacket(
+		const DirectX::XMFLOAT3 starts[],
+		const DirectX::XMFLOAT3 ends[],
+		int count,
+		HitResult hits[],
+		bool results[],
+		bool anyHit = false) const;
+
+	// ƌ\̂Op`Wi\z̎Op`ŕԁj
+	void QuerySphere(
+		const DirectX::XMFLOAT3& center,
+		float radius,
+		std::vector<int>& triangleIndices) const;
+
+	// AABBƌ\̂Op`Wi\z̎Op`ŕԁj
+	void QueryAABB(
+		const DirectX::XMFLOAT3& boundsMin,
+		const DirectX::XMFLOAT3& boundsMax,
+		std::vector<int>& triangleIndices) const;
+
+	// XtBALXgił߂_߂At̎Op`SIMDŌiĂ画肷j
+	bool SphereCast(
+		const DirectX::XMFLOAT3& origin,
+		const DirectX::XMFLOAT3& direction,
+		float radius,
+		float distance,
+		HitResult& hit) const;
+
+	// Op`擾iCfbNX͍\z̎Op`j
+	const Triangle& GetTriangle(int triangleIndex) const { return triangles.at(triangleIndex); }
+
+	// Op`擾
+	int GetTriangleCount() const { return static_cast<int>(triangles.size()); }
+
+	// m[hXg擾
+	const std::vector<Node>& GetNodes() const { return nodes; }
+
+private:
+	struct BuildTriangle
+	{
+		DirectX::XMFLOAT3	boundsMin;
+		DirectX::XMFLOAT3	boundsMax;
+		DirectX::XMFLOAT3	centroid;
+	};
+
+	// m[hċAIɕidepth̓[g0Ƃ[j
+	void Subdivide(int nodeIndex, int depth, std::vector<BuildTriangle>& buildTriangles);
+
+	// m[hAABBXV
+	void UpdateNodeBounds(Node& node, const std::vector<BuildTriangle>& buildTriangles) const;
+
+	// AABBm͈̔͂Ńm[h𑖍
+	void QueryBounds(
+		const DirectX::XMFLOAT3& boundsMin,
+		const DirectX::XMFLOAT3& boundsMax,
+		const DirectX::XMFLOAT3* sphereCenter,
+		float sphereRadius,
+		std::vector<int>& triangleIndices) const;
+
+private:
+	static const int	MaxLeafTriangles = 4;
+	static const int	BinCount = 12;
+	static const int	MaxStackDepth = 64;
+
+	std::vector<Triangle>	triangles;			// \z̎Op`
+	std::vector<int>		triangleIndices;	// t̕я  \z̎Op`CfbNX
+	std::vector<Node>		nodes;
+	TriangleBlocks			leafBlocks;			// tɋ؂Op`ubN
+	std::vector<int>		nodeBlockStarts;	// m[h  t̐擪ubNCfbNXi}-1j
+};
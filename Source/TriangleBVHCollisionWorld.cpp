@@ -0,0 +1,87 @@
+#include <vector>
+#include <SphereCast.h>
+#include "TriangleBVHCollisionWorld.h"
+
+// XtBALXg
+bool TriangleBVHCollisionWorld::SphereCast(
+	const DirectX::XMFLOAT3& origin,
+	const DirectX::XMFLOAT3& direction,
+	float radius,
+	float distance,
+	HitResult& hit) const
+{
+	if (bvh == nullptr) return false;
+
+	TriangleBVH::HitResult result;
+	if (!bvh->SphereCast(origin, direction, radius, distance, result)) return false;
+
+	hit.position = result.position;
+	hit.normal = result.normal;
+	hit.distance = result.distance;
+	return true;
+}
+
+// ƐڐGĂOp`W
+int TriangleBVHCollisionWorld::OverlapSphere(
+	const DirectX::XMFLOAT3& center,
+	float radius,
+	Contact contacts[],
+	int maxContacts) const
+{
+	if (bvh == nullptr || maxContacts <= 0) return 0;
+
+	// ̎W̓XbhɎg񂵁AĂяoɊmۂȂ悤ɂ
+	thread_local std::vector<int> triangleIndices;
+	bvh->QuerySphere(center, radius, triangleIndices);
+
+	DirectX::XMVECTOR Center = DirectX::XMLoadFloat3(&center);
+	int contactCount = 0;
+	for (int triangleIndex : triangleIndices)
+	{
+		const TriangleBVH::Triangle& triangle = bvh->GetTriangle(triangleIndex);
+		DirectX::XMVECTOR Positions[3] =
+		{
+			DirectX::XMLoadFloat3(&triangle.positions[0]),
+			DirectX::XMLoadFloat3(&triangle.positions[1]),
+			DirectX::XMLoadFloat3(&triangle.positions[2]),
+		};
+
+		// ̒SOp`̍ŋߓ_܂ł̋aȂڐGĂ
+		DirectX::XMVECTOR NearPosition;
+		GetClosestPos_PointTriangle(Center, Positions, NearPosition);
+		DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(Center, NearPosition);
+		float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+		if (distance >= radius) continue;
+
+		// i[悪܂Ăꍇ͍ł󂢐ڐG[Ƃu
+		// ߂荞͍݉ł[ڐG牟o߁A[ڐG肱ڂȂ悤ɂ
+		float depth = radius - distance;
+		int contactIndex = contactCount;
+		if (contactCount < maxContacts)
+		{
+			contactCount++;
+		}
+		else
+		{
+			contactIndex = 0;
+			for (int i = 1; i < contactCount; ++i)
+			{
+				if (contacts[i].depth < contacts[contactIndex].depth) contactIndex = i;
+			}
+			if (depth <= contacts[contactIndex].depth) continue;
+		}
+
+		Contact& contact = contacts[contactIndex];
+		if (distance > 0.0001f)
+		{
+			DirectX::XMStoreFloat3(&contact.normal, DirectX::XMVectorScale(Vec, 1.0f / distance));
+		}
+		else
+		{
+			// Sʏɂꍇ͖ʖ@̌ɉo
+			contact.normal = triangle.normal;
+		}
+		contact.depth = depth;
+	}
+	return contactCount;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CollisionWorld.h"
+#include "TriangleBVH.h"
+
+// Op`BVH𔻒ɎgՓ˔胏[h
+class TriangleBVHCollisionWorld : public CollisionWorld
+{
+public:
+	TriangleBVHCollisionWorld() = default;
+	~TriangleBVHCollisionWorld() override = default;
+
+	// 肷BVHݒiBVH͍č\zĂ̂QƂj
+	void SetBVH(const TriangleBVH* bvh) { this->bvh = bvh; }
+
+	// XtBALXg
+	bool SphereCast(
+		const DirectX::XMFLOAT3& origin,
+		const DirectX::XMFLOAT3& direction,
+		float radius,
+		float distance,
+		HitResult& hit) const override;
+
+	// ƐڐGĂOp`W
+	int OverlapSphere(
+		const DirectX::XMFLOAT3& center,
+		float radius,
+		Contact contacts[],
+		int maxContacts) const override;
+
+private:
+	const TriangleBVH*	bvh = nullptr;
+};
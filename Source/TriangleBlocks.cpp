@@ -0,0 +1,314 @@
+#include <algorithm>
+#include "Misc.h"
+#include "TriangleBlocks.h"
+
+// sƂ݂Ȃs񎮂臒liDirectX::TriangleTests::IntersectsƑj
+static const float RayEpsilon = 1e-20f;
+
+// Op`ǉ
+void TriangleBlocks::AddTriangle(
+	const DirectX::XMFLOAT3& position,
+	const DirectX::XMFLOAT3& edge1,
+	const DirectX::XMFLOAT3& edge2,
+	int triangleIndex)
+{
+	if (fillCount == BlockSize)
+	{
+		// 󂫂͕ӂOɂčs񎮂OɂȂ悤ɂĂ
+		Block& block = blocks.emplace_back();
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			block.v0[axis] = { 0, 0, 0, 0 };
+			block.e1[axis] = { 0, 0, 0, 0 };
+			block.e2[axis] = { 0, 0, 0, 0 };
+		}
+		for (int& index : block.triangleIndices) index = -1;
+		fillCount = 0;
+	}
+
+	Block& block = blocks.back();
+	const float* v0 = &position.x;
+	const float* e1 = &edge1.x;
+	const float* e2 = &edge2.x;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		(&block.v0[axis].x)[fillCount] = v0[axis];
+		(&block.e1[axis].x)[fillCount] = e1[axis];
+		(&block.e2[axis].x)[fillCount] = e2[axis];
+	}
+	block.triangleIndices[fillCount] = triangleIndex;
+	++fillCount;
+}
+
+// CƔ͈͓̃ubN̍ŋߌ߂iMoller-Trumbore@Aʁj
+int TriangleBlocks::IntersectRay(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& direction,
+	int blockStart,
+	int blockCount,
+	float& distance) const
+{
+	_ASSERT_EXPR(blockStart >= 0 && blockStart + blockCount <= GetBlockCount(), L"block range out of bounds");
+
+	// C͑S[ɕĂSOp`Ɠɔ肷
+	const DirectX::XMVECTOR Ox = DirectX::XMVectorReplicate(start.x);
+	const DirectX::XMVECTOR Oy = DirectX::XMVectorReplicate(start.y);
+	const DirectX::XMVECTOR Oz = DirectX::XMVectorReplicate(start.z);
+	const DirectX::XMVECTOR Dx = DirectX::XMVectorReplicate(direction.x);
+	const DirectX::XMVECTOR Dy = DirectX::XMVectorReplicate(direction.y);
+	const DirectX::XMVECTOR Dz = DirectX::XMVectorReplicate(direction.z);
+	const DirectX::XMVECTOR Zero = DirectX::XMVectorZero();
+	const DirectX::XMVECTOR One = DirectX::XMVectorSplatOne();
+	const DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(RayEpsilon);
+
+	int nearestTriangleIndex = -1;
+	DirectX::XMVECTOR Distance = DirectX::XMVectorReplicate(distance);
+	for (int blockIndex = blockStart; blockIndex < blockStart + blockCount; ++blockIndex)
+	{
+		const Block& block = blocks[blockIndex];
+		DirectX::XMVECTOR E1x = DirectX::XMLoadFloat4A(&block.e1[0]);
+		DirectX::XMVECTOR E1y = DirectX::XMLoadFloat4A(&block.e1[1]);
+		DirectX::XMVECTOR E1z = DirectX::XMLoadFloat4A(&block.e1[2]);
+		DirectX::XMVECTOR E2x = DirectX::XMLoadFloat4A(&block.e2[0]);
+		DirectX::XMVECTOR E2y = DirectX::XMLoadFloat4A(&block.e2[1]);
+		DirectX::XMVECTOR E2z = DirectX::XMLoadFloat4A(&block.e2[2]);
+
+		// p = direction ~ edge2
+		DirectX::XMVECTOR Px = DirectX::XMVectorNegativeMultiplySubtract(Dz, E2y, DirectX::XMVectorMultiply(Dy, E2z));
+		DirectX::XMVECTOR Py = DirectX::XMVectorNegativeMultiplySubtract(Dx, E2z, DirectX::XMVectorMultiply(Dz, E2x));
+		DirectX::XMVECTOR Pz = DirectX::XMVectorNegativeMultiplySubtract(Dy, E2x, DirectX::XMVectorMultiply(Dx, E2y));
+		DirectX::XMVECTOR Det = DirectX::XMVectorMultiplyAdd(E1z, Pz, DirectX::XMVectorMultiplyAdd(E1y, Py, DirectX::XMVectorMultiply(E1x, Px)));
+		DirectX::XMVECTOR Valid = DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorAbs(Det), Epsilon);
+		if (DirectX::XMVector4EqualInt(Valid, DirectX::XMVectorFalseInt())) continue;
+		DirectX::XMVECTOR InvDet = DirectX::XMVectorReciprocal(Det);
+
+		// s = start - v0
+		DirectX::XMVECTOR Sx = DirectX::XMVectorSubtract(Ox, DirectX::XMLoadFloat4A(&block.v0[0]));
+		DirectX::XMVECTOR Sy = DirectX::XMVectorSubtract(Oy, DirectX::XMLoadFloat4A(&block.v0[1]));
+		DirectX::XMVECTOR Sz = DirectX::XMVectorSubtract(Oz, DirectX::XMLoadFloat4A(&block.v0[2]));
+		DirectX::XMVECTOR U = DirectX::XMVectorMultiply(DirectX::XMVectorMultiplyAdd(Sz, Pz, DirectX::XMVectorMultiplyAdd(Sy, Py, DirectX::XMVectorMultiply(Sx, Px))), InvDet);
+
+		// q = s ~ edge1
+		DirectX::XMVECTOR Qx = DirectX::XMVectorNegativeMultiplySubtract(Sz, E1y, DirectX::XMVectorMultiply(Sy, E1z));
+		DirectX::XMVECTOR Qy = DirectX::XMVectorNegativeMultiplySubtract(Sx, E1z, DirectX::XMVectorMultiply(Sz, E1x));
+		DirectX::XMVECTOR Qz = DirectX::XMVectorNegativeMultiplySubtract(Sy, E1x, DirectX::XMVectorMultiply(Sx, E1y));
+		DirectX::XMVECTOR V = DirectX::XMVectorMultiply(DirectX::XMVectorMultiplyAdd(Dz, Qz, DirectX::XMVectorMultiplyAdd(Dy, Qy, DirectX::XMVectorMultiply(Dx, Qx))), InvDet);
+		DirectX::XMVECTOR T = DirectX::XMVectorMultiply(DirectX::XMVectorMultiplyAdd(E2z, Qz, DirectX::XMVectorMultiplyAdd(E2y, Qy, DirectX::XMVectorMultiply(E2x, Qx))), InvDet);
+
+		// dSWƋ͈͔̔
+		Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorGreaterOrEqual(U, Zero));
+		Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorGreaterOrEqual(V, Zero));
+		Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorLessOrEqual(DirectX::XMVectorAdd(U, V), One));
+		Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorGreaterOrEqual(T, Zero));
+		Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorLess(T, Distance));
+		if (DirectX::XMVector4EqualInt(Valid, DirectX::XMVectorFalseInt())) continue;
+
+		// [ł߂̂I
+		DirectX::XMFLOAT4A t;
+		DirectX::XMUINT4 valid;
+		DirectX::XMStoreFloat4A(&t, T);
+		DirectX::XMStoreUInt4(&valid, Valid);
+		for (int lane = 0; lane < BlockSize; ++lane)
+		{
+			if ((&valid.x)[lane] != 0 && (&t.x)[lane] < distance)
+			{
+				distance = (&t.x)[lane];
+				nearestTriangleIndex = block.triangleIndices[lane];
+			}
+		}
+		Distance = DirectX::XMVectorReplicate(distance);
+	}
+	return nearestTriangleIndex;
+}
+
+// S{̃CƔ͈͓̃ubN̍ŋߌCɋ߂
+void TriangleBlocks::IntersectPacket(
+	const RayPacket& packet,
+	int blockStart,
+	int blockCount,
+	float distances[BlockSize],
+	int triangleIndices[BlockSize],
+	bool anyHit) const
+{
+	_ASSERT_EXPR(blockStart >= 0 && blockStart + blockCount <= GetBlockCount(), L"block range out of bounds");
+
+	// S{̃C[ɕׁAOp`S[ɕĔ肷
+	const DirectX::XMVECTOR Ox = DirectX::XMLoadFloat4A(&packet.origin[0]);
+	const DirectX::XMVECTOR Oy = DirectX::XMLoadFloat4A(&packet.origin[1]);
+	const DirectX::XMVECTOR Oz = DirectX::XMLoadFloat4A(&packet.origin[2]);
+	const DirectX::XMVECTOR Dx = DirectX::XMLoadFloat4A(&packet.direction[0]);
+	const DirectX::XMVECTOR Dy = DirectX::XMLoadFloat4A(&packet.direction[1]);
+	const DirectX::XMVECTOR Dz = DirectX::XMLoadFloat4A(&packet.direction[2]);
+	const DirectX::XMVECTOR Zero = DirectX::XMVectorZero();
+	const DirectX::XMVECTOR One = DirectX::XMVectorSplatOne();
+	const DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(RayEpsilon);
+
+	DirectX::XMVECTOR Distance = DirectX::XMVectorSet(distances[0], distances[1], distances[2], distances[3]);
+	DirectX::XMVECTOR Index = DirectX::XMVectorSetInt(
+		static_cast<uint32_t>(triangleIndices[0]), static_cast<uint32_t>(triangleIndices[1]),
+		static_cast<uint32_t>(triangleIndices[2]), static_cast<uint32_t>(triangleIndices[3]));
+
+	// ̗L߂ꍇ͖̃C肷
+	DirectX::XMVECTOR Active = DirectX::XMVectorTrueInt();
+	if (anyHit)
+	{
+		Active = DirectX::XMVectorAndInt(
+			DirectX::XMVectorEqualInt(Index, DirectX::XMVectorReplicateInt(static_cast<uint32_t>(-1))),
+			DirectX::XMVectorGreater(Distance, Zero));
+	}
+	for (int blockIndex = blockStart; blockIndex < blockStart + blockCount; ++blockIndex)
+	{
+		if (DirectX::XMVector4EqualInt(Active, DirectX::XMVectorFalseInt())) break;
+
+		const Block& block = blocks[blockIndex];
+		for (int lane = 0; lane < BlockSize; ++lane)
+		{
+			int triangleIndex = block.triangleIndices[lane];
+			if (triangleIndex < 0) break;
+
+			DirectX::XMVECTOR E1x = DirectX::XMVectorReplicate((&block.e1[0].x)[lane]);
+			DirectX::XMVECTOR E1y = DirectX::XMVectorReplicate((&block.e1[1].x)[lane]);
+			DirectX::XMVECTOR E1z = DirectX::XMVectorReplicate((&block.e1[2].x)[lane]);
+			DirectX::XMVECTOR E2x = DirectX::XMVectorReplicate((&block.e2[0].x)[lane]);
+			DirectX::XMVECTOR E2y = DirectX::XMVectorReplicate((&block.e2[1].x)[lane]);
+			DirectX::XMVECTOR E2z = DirectX::XMVectorReplicate((&block.e2[2].x)[lane]);
+
+			// p = direction ~ edge2
+			DirectX::XMVECTOR Px = DirectX::XMVectorNegativeMultiplySubtract(Dz, E2y, DirectX::XMVectorMultiply(Dy, E2z));
+			DirectX::XMVECTOR Py = DirectX::XMVectorNegativeMultiplySubtract(Dx, E2z, DirectX::XMVectorMultiply(Dz, E2x));
+			DirectX::XMVECTOR Pz = DirectX::XMVectorNegativeMultiplySubtract(Dy, E2x, DirectX::XMVectorMultiply(Dx, E2y));
+			DirectX::XMVECTOR Det = DirectX::XMVectorMultiplyAdd(E1z, Pz, DirectX::XMVectorMultiplyAdd(E1y, Py, DirectX::XMVectorMultiply(E1x, Px)));
+			DirectX::XMVECTOR Valid = DirectX::XMVectorGreaterOrEqual(DirectX::XMVectorAbs(Det), Epsilon);
+			if (DirectX::XMVector4EqualInt(Valid, DirectX::XMVectorFalseInt())) continue;
+			DirectX::XMVECTOR InvDet = DirectX::XMVectorReciprocal(Det);
+
+			// s = start - v0
+			DirectX::XMVECTOR Sx = DirectX::XMVectorSubtract(Ox, DirectX::XMVectorReplicate((&block.v0[0].x)[lane]));
+			DirectX::XMVECTOR Sy = DirectX::XMVectorSubtract(Oy, DirectX::XMVectorReplicate((&block.v0[1].x)[lane]));
+			DirectX::XMVECTOR Sz = DirectX::XMVectorSubtract(Oz, DirectX::XMVectorReplicate((&block.v0[2].x)[lane]));
+			DirectX::XMVECTOR U = DirectX::XMVectorMultiply(DirectX::XMVectorMultiplyAdd(Sz, Pz, DirectX::XMVectorMultiplyAdd(Sy, Py, DirectX::XMVectorMultiply(Sx, Px))), InvDet);
+
+			// q = s ~ edge1
+			DirectX::XMVECTOR Qx = DirectX::XMVectorNegativeMultiplySubtract(Sz, E1y, DirectX::XMVectorMultiply(Sy, E1z));
+			DirectX::XMVECTOR Qy = DirectX::XMVectorNegativeMultiplySubtract(Sx, E1z, DirectX::XMVectorMultiply(Sz, E1x));
+			DirectX::XMVECTOR Qz = DirectX::XMVectorNegativeMultiplySubtract(Sy, E1x, DirectX::XMVectorMultiply(Sx, E1y));
+			DirectX::XMVECTOR V = DirectX::XMVectorMultiply(DirectX::XMVectorMultiplyAdd(Dz, Qz, DirectX::XMVectorMultiplyAdd(Dy, Qy, DirectX::XMVectorMultiply(Dx, Qx))), InvDet);
+			DirectX::XMVECTOR T = DirectX::XMVectorMultiply(DirectX::XMVectorMultiplyAdd(E2z, Qz, DirectX::XMVectorMultiplyAdd(E2y, Qy, DirectX::XMVectorMultiply(E2x, Qx))), InvDet);
+
+			// dSWƋ͈͔̔
+			Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorGreaterOrEqual(U, Zero));
+			Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorGreaterOrEqual(V, Zero));
+			Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorLessOrEqual(DirectX::XMVectorAdd(U, V), One));
+			Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorGreaterOrEqual(T, Zero));
+			Valid = DirectX::XMVectorAndInt(Valid, DirectX::XMVectorLess(T, Distance));
+			Valid = DirectX::XMVectorAndInt(Valid, Active);
+
+			// CŋߌXV
+			Distance = DirectX::XMVectorSelect(Distance, T, Valid);
+			Index = DirectX::XMVectorSelect(Index, DirectX::XMVectorReplicateInt(static_cast<uint32_t>(triangleIndex)), Valid);
+			if (anyHit)
+			{
+				Active = DirectX::XMVectorAndCInt(Active, Valid);
+				if (DirectX::XMVector4EqualInt(Active, DirectX::XMVectorFalseInt())) break;
+			}
+		}
+	}
+
+	DirectX::XMFLOAT4A distance;
+	DirectX::XMINT4 index;
+	DirectX::XMStoreFloat4A(&distance, Distance);
+	DirectX::XMStoreSInt4(&index, Index);
+	for (int lane = 0; lane < BlockSize; ++lane)
+	{
+		distances[lane] = (&distance.x)[lane];
+		triangleIndices[lane] = (&index.x)[lane];
+	}
+}
+
+// XtBALXgƌ\̂Op`ubNI
+unsigned int TriangleBlocks::FilterSphereCast(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& end,
+	float radius,
+	int blockIndex) const
+{
+	const Block& block = blocks.at(blockIndex);
+	DirectX::XMVECTOR V0x = DirectX::XMLoadFloat4A(&block.v0[0]);
+	DirectX::XMVECTOR V0y = DirectX::XMLoadFloat4A(&block.v0[1]);
+	DirectX::XMVECTOR V0z = DirectX::XMLoadFloat4A(&block.v0[2]);
+	DirectX::XMVECTOR E1x = DirectX::XMLoadFloat4A(&block.e1[0]);
+	DirectX::XMVECTOR E1y = DirectX::XMLoadFloat4A(&block.e1[1]);
+	DirectX::XMVECTOR E1z = DirectX::XMLoadFloat4A(&block.e1[2]);
+	DirectX::XMVECTOR E2x = DirectX::XMLoadFloat4A(&block.e2[0]);
+	DirectX::XMVECTOR E2y = DirectX::XMLoadFloat4A(&block.e2[1]);
+	DirectX::XMVECTOR E2z = DirectX::XMLoadFloat4A(&block.e2[2]);
+
+	// Op`AABBƃLXǵ͈in_ƏI_𔼌ac܂AABBǰ
+	auto overlapAxis = [radius](DirectX::FXMVECTOR V0, DirectX::FXMVECTOR E1, DirectX::FXMVECTOR E2, float s, float e)
+	{
+		DirectX::XMVECTOR B = DirectX::XMVectorAdd(V0, E1);
+		DirectX::XMVECTOR C = DirectX::XMVectorAdd(V0, E2);
+		DirectX::XMVECTOR Min = DirectX::XMVectorMin(V0, DirectX::XMVectorMin(B, C));
+		DirectX::XMVECTOR Max = DirectX::XMVectorMax(V0, DirectX::XMVectorMax(B, C));
+		DirectX::XMVECTOR SweptMin = DirectX::XMVectorReplicate((std::min)(s, e) - radius);
+		DirectX::XMVECTOR SweptMax = DirectX::XMVectorReplicate((std::max)(s, e) + radius);
+		return DirectX::XMVectorAndInt(DirectX::XMVectorLessOrEqual(Min, SweptMax), DirectX::XMVectorGreaterOrEqual(Max, SweptMin));
+	};
+	DirectX::XMVECTOR Valid = overlapAxis(V0x, E1x, E2x, start.x, end.x);
+	Valid = DirectX::XMVectorAndInt(Valid, overlapAxis(V0y, E1y, E2y, start.y, end.y));
+	Valid = DirectX::XMVectorAndInt(Valid, overlapAxis(V0z, E1z, E2z, start.z, end.z));
+
+	// n_ƏI_ʂ甼a藣ēɂΌoHŕʂɓ͂Ȃ
+	DirectX::XMVECTOR Nx = DirectX::XMVectorNegativeMultiplySubtract(E1z, E2y, DirectX::XMVectorMultiply(E1y, E2z));
+	DirectX::XMVECTOR Ny = DirectX::XMVectorNegativeMultiplySubtract(E1x, E2z, DirectX::XMVectorMultiply(E1z, E2x));
+	DirectX::XMVECTOR Nz = DirectX::XMVectorNegativeMultiplySubtract(E1y, E2x, DirectX::XMVectorMultiply(E1x, E2y));
+	auto planeDistance = [&](const DirectX::XMFLOAT3& p)
+	{
+		DirectX::XMVECTOR Dx = DirectX::XMVectorSubtract(DirectX::XMVectorReplicate(p.x), V0x);
+		DirectX::XMVECTOR Dy = DirectX::XMVectorSubtract(DirectX::XMVectorReplicate(p.y), V0y);
+		DirectX::XMVECTOR Dz = DirectX::XMVectorSubtract(DirectX::XMVectorReplicate(p.z), V0z);
+		return DirectX::XMVectorMultiplyAdd(Nz, Dz, DirectX::XMVectorMultiplyAdd(Ny, Dy, DirectX::XMVectorMultiply(Nx, Dx)));
+	};
+	DirectX::XMVECTOR StartDistance = planeDistance(start);
+	DirectX::XMVECTOR EndDistance = planeDistance(end);
+	DirectX::XMVECTOR NormalLength = DirectX::XMVectorSqrt(DirectX::XMVectorMultiplyAdd(Nz, Nz, DirectX::XMVectorMultiplyAdd(Ny, Ny, DirectX::XMVectorMultiply(Nx, Nx))));
+	DirectX::XMVECTOR Limit = DirectX::XMVectorScale(NormalLength, radius);
+	DirectX::XMVECTOR NegativeLimit = DirectX::XMVectorNegate(Limit);
+	DirectX::XMVECTOR Front = DirectX::XMVectorAndInt(DirectX::XMVectorGreater(StartDistance, Limit), DirectX::XMVectorGreater(EndDistance, Limit));
+	DirectX::XMVECTOR Back = DirectX::XMVectorAndInt(DirectX::XMVectorLess(StartDistance, NegativeLimit), DirectX::XMVectorLess(EndDistance, NegativeLimit));
+	Valid = DirectX::XMVectorAndCInt(Valid, DirectX::XMVectorOrInt(Front, Back));
+
+	DirectX::XMUINT4 valid;
+	DirectX::XMStoreUInt4(&valid, Valid);
+	unsigned int mask = 0;
+	for (int lane = 0; lane < BlockSize; ++lane)
+	{
+		if ((&valid.x)[lane] != 0 && block.triangleIndices[lane] >= 0)
+		{
+			mask |= 1u << lane;
+		}
+	}
+	return mask;
+}
+
+// pPbg쐬
+void TriangleBlocks::MakePacket(
+	const DirectX::XMFLOAT3 starts[],
+	const DirectX::XMFLOAT3 directions[],
+	int count,
+	RayPacket& packet)
+{
+	_ASSERT_EXPR(count >= 0 && count <= BlockSize, L"packet ray count out of range");
+
+	for (int lane = 0; lane < BlockSize; ++lane)
+	{
+		DirectX::XMFLOAT3 start = lane < count ? starts[lane] : DirectX::XMFLOAT3(0, 0, 0);
+		DirectX::XMFLOAT3 direction = lane < count ? directions[lane] : DirectX::XMFLOAT3(0, 0, 0);
+		(&packet.origin[0].x)[lane] = start.x;
+		(&packet.origin[1].x)[lane] = start.y;
+		(&packet.origin[2].x)[lane] = start.z;
+		(&packet.direction[0].x)[lane] = direction.x;
+		(&packet.direction[1].x)[lane] = direction.y;
+		(&packet.direction[2].x)[lane] = direction.z;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+
+// Op`ubNiSOp`_ƕӂ̔zŕێACƂ̌SIMDł܂Ƃ߂Ĕ肷j
+class TriangleBlocks
+{
+public:
+	static const int BlockSize = 4;
+
+	// SOp`̒_AƂQӁix,y,zɂSOp`ׂj
+	struct Block
+	{
+		DirectX::XMFLOAT4A	v0[3];
+		DirectX::XMFLOAT4A	e1[3];
+		DirectX::XMFLOAT4A	e2[3];
+		int					triangleIndices[BlockSize];		// 󂫂-1
+	};
+
+	// S{̃Cix,y,zɂS{ׂA͐Kς݁j
+	struct RayPacket
+	{
+		DirectX::XMFLOAT4A	origin[3];
+		DirectX::XMFLOAT4A	direction[3];
+	};
+
+	TriangleBlocks() = default;
+	~TriangleBlocks() = default;
+
+	// S폜
+	void Clear() { blocks.clear(); fillCount = BlockSize; }
+
+	// Op`ǉĩ݂ubN̋󂫂ɋl߂j
+	void AddTriangle(
+		const DirectX::XMFLOAT3& position,
+		const DirectX::XMFLOAT3& edge1,
+		const DirectX::XMFLOAT3& edge2,
+		int triangleIndex);
+
+	// ݂̃ubNiɒǉOp`͐VubNn܂j
+	void Flush() { fillCount = BlockSize; }
+
+	// ubN擾
+	int GetBlockCount() const { return static_cast<int>(blocks.size()); }
+
+	// ubN擾
+	const Block& GetBlock(int blockIndex) const { return blocks.at(blockIndex); }
+
+	// CƔ͈͓̃ubN̍ŋߌ߂iOp`CfbNXԂA-1j
+	// distance͔肷ő勗ŁAꍇ͌ɍXV
+	int IntersectRay(
+		const DirectX::XMFLOAT3& start,
+		const DirectX::XMFLOAT3& direction,
+		int blockStart,
+		int blockCount,
+		float& distance) const;
+
+	// S{̃CƔ͈͓̃ubN̍ŋߌCɋ߂
+	// distancestriangleIndices̓Č݂̍ŋߌŁA߂΍XV
+	// anyHittruȅꍇ͌ς݁itriangleIndicesOȏj̃C𔻒肹ASẴCł؂
+	// Oȉ̃CipPbg̋󂫁j͌Ȃ̂ŁAanyHit̑ł؂ł͌ς݂Ƃ݂Ȃ
+	void IntersectPacket(
+		const RayPacket& packet,
+		int blockStart,
+		int blockCount,
+		float distances[BlockSize],
+		int triangleIndices[BlockSize],
+		bool anyHit = false) const;
+
+	// XtBALXgƌ\̂Op`ubNIԁi[̃rbgԂj
+	// Op`AABBƃLXg͈͂AABBAOp`̕ʂƃLXgoH̋ŏOAcOp`͌ɔ肷邱
+	unsigned int FilterSphereCast(
+		const DirectX::XMFLOAT3& start,
+		const DirectX::XMFLOAT3& end,
+		float radius,
+		int blockIndex) const;
+
+	// pPbg쐬icount{̃C͕OɂČȂ悤ɂj
+	static void MakePacket(
+		const DirectX::XMFLOAT3 starts[],
+		const DirectX::XMFLOAT3 directions[],
+		int count,
+		RayPacket& packet);
+
+private:
+	std::vector<Block>	blocks;
+	int					fillCount = BlockSize;	// Ō̃ubNɋl߂Op`
+};
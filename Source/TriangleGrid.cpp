@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "Misc.h"
+#include "TriangleGrid.h"
+
+// Op`Xg\z
+void TriangleGrid::Build(const std::vector<Triangle>& sourceTriangles, float cellSize)
+{
+	triangles = sourceTriangles;
+	cellStarts.clear();
+	cellTriangleIndices.clear();
+	cellBlocks.Clear();
+	cellBlockStarts.clear();
+	division[0] = division[1] = division[2] = 0;
+	if (triangles.empty()) return;
+
+	// Op`ŜAABB
+	DirectX::XMVECTOR VolumeMin = DirectX::XMVectorReplicate(FLT_MAX);
+	DirectX::XMVECTOR VolumeMax = DirectX::XMVectorReplicate(-FLT_MAX);
+	for (const Triangle& triangle : triangles)
+	{
+		for (const DirectX::XMFLOAT3& position : triangle.positions)
+		{
+			DirectX::XMVECTOR P = DirectX::XMLoadFloat3(&position);
+			VolumeMin = DirectX::XMVectorMin(VolumeMin, P);
+			VolumeMax = DirectX::XMVectorMax(VolumeMax, P);
+		}
+	}
+	DirectX::XMFLOAT3 volumeMin, volumeMax;
+	DirectX::XMStoreFloat3(&volumeMin, VolumeMin);
+	DirectX::XMStoreFloat3(&volumeMax, VolumeMax);
+
+	// Zoi鎲̓ZTCYLj
+	const float size[3] = { volumeMax.x - volumeMin.x, volumeMax.y - volumeMin.y, volumeMax.z - volumeMin.z };
+	const float maxSize = (std::max)({ size[0], size[1], size[2] });
+	this->cellSize = (std::max)(cellSize, maxSize / MaxDivision);
+	boundsMin[0] = volumeMin.x;
+	boundsMin[1] = volumeMin.y;
+	boundsMin[2] = volumeMin.z;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		division[axis] = (std::max)(1, static_cast<int>(std::ceil(size[axis] / this->cellSize)));
+		division[axis] = (std::min)(division[axis], MaxDivision);
+	}
+
+	// Op`AABBdȂZ͈
+	struct CellRange
+	{
+		int		min[3];
+		int		max[3];
+	};
+	std::vector<CellRange> cellRanges(triangles.size());
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		const Triangle& triangle = triangles.at(i);
+		CellRange& range = cellRanges.at(i);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float a = (&triangle.positions[0].x)[axis];
+			float b = (&triangle.positions[1].x)[axis];
+			float c = (&triangle.positions[2].x)[axis];
+			float min = (std::min)({ a, b, c }) - boundsMin[axis];
+			float max = (std::max)({ a, b, c }) - boundsMin[axis];
+			range.min[axis] = std::clamp(static_cast<int>(std::floor(min / this->cellSize)), 0, division[axis] - 1);
+			range.max[axis] = std::clamp(static_cast<int>(std::floor(max / this->cellSize)), 0, division[axis] - 1);
+		}
+	}
+
+	// Z̎Op`𐔂Đ擪ʒu߂
+	cellStarts.assign(GetCellCount() + 1, 0);
+	for (const CellRange& range : cellRanges)
+	{
+		for (int z = range.min[2]; z <= range.max[2]; ++z)
+		{
+			for (int y = range.min[1]; y <= range.max[1]; ++y)
+			{
+				for (int x = range.min[0]; x <= range.max[0]; ++x)
+				{
+					cellStarts[GetCellIndex(x, y, z) + 1]++;
+				}
+			}
+		}
+	}
+	for (size_t i = 1; i < cellStarts.size(); ++i)
+	{
+		cellStarts[i] += cellStarts[i - 1];
+	}
+
+	// ZɎOp`CfbNXi[
+	cellTriangleIndices.resize(cellStarts.back());
+	std::vector<int> cellCursors(cellStarts.begin(), cellStarts.end() - 1);
+	for (size_t i = 0; i < cellRanges.size(); ++i)
+	{
+		const CellRange& range = cellRanges.at(i);
+		for (int z = range.min[2]; z <= range.max[2]; ++z)
+		{
+			for (int y = range.min[1]; y <= range.max[1]; ++y)
+			{
+				for (int x = range.min[0]; x <= range.max[0]; ++x)
+				{
+					cellTriangleIndices[cellCursors[GetCellIndex(x, y, z)]++] = static_cast<int>(i);
+				}
+			}
+		}
+	}
+
+	// Z̎Op`ZɃubN֋l߂
+	cellBlockStarts.resize(GetCellCount() + 1);
+	for (int cellIndex = 0; cellIndex < GetCellCount(); ++cellIndex)
+	{
+		cellBlockStarts[cellIndex] = cellBlocks.GetBlockCount();
+		for (int i = cellStarts[cellIndex]; i < cellStarts[cellIndex + 1]; ++i)
+		{
+			int triangleIndex = cellTriangleIndices[i];
+			const Triangle& triangle = triangles[triangleIndex];
+			DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&triangle.positions[0]);
+			DirectX::XMFLOAT3 edge1, edge2;
+			DirectX::XMStoreFloat3(&edge1, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&triangle.positions[1]), A));
+			DirectX::XMStoreFloat3(&edge2, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&triangle.positions[2]), A));
+			cellBlocks.AddTriangle(triangle.positions[0], edge1, edge2, triangleIndex);
+		}
+		cellBlocks.Flush();
+	}
+	cellBlockStarts.back() = cellBlocks.GetBlockCount();
+}
+
+// CLXg
+bool TriangleGrid::RayCast(
+	const DirectX::XMFLOAT3& start,
+	const DirectX::XMFLOAT3& end,
+	HitResult& hit) const
+{
+	if (triangles.empty()) return false;
+
+	DirectX::XMVECTOR Start = DirectX::XMLoadFloat3(&start);
+	DirectX::XMVECTOR End = DirectX::XMLoadFloat3(&end);
+	DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(End, Start);
+	DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(Vec);
+	float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(Vec));
+
+	DirectX::XMFLOAT3 direction;
+	DirectX::XMStoreFloat3(&direction, Direction);
+	const float origin[3] = { start.x, start.y, start.z };
+	const float dir[3] = { direction.x, direction.y, direction.z };
+
+	// ObhŜAABBƂ̌Ԃ߂iXu@j
+	float enter = 0.0f;
+	float exit = distance;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float min = boundsMin[axis];
+		float max = boundsMin[axis] + division[axis] * cellSize;
+		if (dir[axis] == 0.0f)
+		{
+			if (origin[axis] < min || origin[axis] > max) return false;
+			continue;
+		}
+		float invDir = 1.0f / dir[axis];
+		float t0 = (min - origin[axis]) * invDir;
+		float t1 = (max - origin[axis]) * invDir;
+		if (t0 > t1) std::swap(t0, t1);
+		enter = (std::max)(enter, t0);
+		exit = (std::min)(exit, t1);
+		if (enter > exit) return false;
+	}
+
+	// JnZƎ̃ZE܂ł̋߂
+	int cell[3];
+	int step[3];
+	float next[3];
+	float delta[3];
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float position = origin[axis] + dir[axis] * enter;
+		cell[axis] = std::clamp(static_cast<int>(std::floor((position - boundsMin[axis]) / cellSize)), 0, division[axis] - 1);
+		if (dir[axis] > 0.0f)
+		{
+			step[axis] = 1;
+			next[axis] = (boundsMin[axis] + (cell[axis] + 1) * cellSize - origin[axis]) / dir[axis];
+			delta[axis] = cellSize / dir[axis];
+		}
+		else if (dir[axis] < 0.0f)
+		{
+			step[axis] = -1;
+			next[axis] = (boundsMin[axis] + cell[axis] * cellSize - origin[axis]) / dir[axis];
+			delta[axis] = -cellSize / dir[axis];
+		}
+		else
+		{
+			step[axis] = 0;
+			next[axis] = FLT_MAX;
+			delta[axis] = FLT_MAX;
+		}
+	}
+
+	// Cʉ߂Z߂ɑ
+	int nearestTriangleIndex = -1;
+	for (;;)
+	{
+		// Z̎Op`ƂSOp`SIMDŌ
+		const int cellIndex = GetCellIndex(cell[0], cell[1], cell[2]);
+		const int blockStart = cellBlockStarts[cellIndex];
+		const int blockCount = cellBlockStarts[cellIndex + 1] - blockStart;
+		if (blockCount > 0)
+		{
+			int triangleIndex = cellBlocks.IntersectRay(start, direction, blockStart, blockCount, distance);
+			if (triangleIndex >= 0)
+			{
+				nearestTriangleIndex = triangleIndex;
+			}
+		}
+
+		// _̃Zɂ΁Aȍ~̃Zɂ߂_͂Ȃ
+		int axis = 0;
+		if (next[1] < next[axis]) axis = 1;
+		if (next[2] < next[axis]) axis = 2;
+		float cellExit = (std::min)(next[axis], exit);
+		if (nearestTriangleIndex >= 0 && distance <= cellExit) break;
+		if (cellExit >= exit) break;
+
+		// ̃Z֐i
+		cell[axis] += step[axis];
+		if (cell[axis] < 0 || cell[axis] >= division[axis]) break;
+		next[axis] += delta[axis];
+	}
+
+	if (nearestTriangleIndex < 0) return false;
+
+	DirectX::XMVECTOR HitPosition = DirectX::XMVectorAdd(Start, DirectX::XMVectorScale(Direction, distance));
+	DirectX::XMStoreFloat3(&hit.position, HitPosition);
+	hit.normal = triangles[nearestTriangleIndex].normal;
+	hit.distance = distance;
+	hit.triangleIndex = nearestTriangleIndex;
+	return true;
+}
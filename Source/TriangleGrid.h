@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "TriangleBVH.h"
+#include "TriangleBlocks.h"
+
+// Op`̋ψObhiC͒ʉ߂Z3D-DDAőj
+class TriangleGrid
+{
+public:
+	using Triangle = TriangleBVH::Triangle;
+	using HitResult = TriangleBVH::HitResult;
+
+	TriangleGrid() = default;
+	~TriangleGrid() = default;
+
+	// Op`Xg\ziOp`AABBdȂZɓo^j
+	void Build(const std::vector<Triangle>& sourceTriangles, float cellSize);
+
+	// CLXgił߂_߂j
+	bool RayCast(
+		const DirectX::XMFLOAT3& start,
+		const DirectX::XMFLOAT3& end,
+		HitResult& hit) const;
+
+	// Op`擾
+	int GetTriangleCount() const { return static_cast<int>(triangles.size()); }
+
+	// Z擾
+	int GetCellCount() const { return division[0] * division[1] * division[2]; }
+
+	// Zɓo^ꂽOp`̍v擾
+	int GetCellTriangleCount() const { return static_cast<int>(cellTriangleIndices.size()); }
+
+private:
+	// ZCfbNX擾
+	int GetCellIndex(int x, int y, int z) const { return (z * division[1] + y) * division[0] + x; }
+
+private:
+	static const int	MaxDivision = 256;		// ̍ő啪
+
+	std::vector<Triangle>	triangles;
+	std::vector<int>		cellStarts;				// Z̐擪ʒuiZ{PA͑j
+	std::vector<int>		cellTriangleIndices;	// ZɕׂOp`CfbNX
+	TriangleBlocks			cellBlocks;				// Zɋ؂Op`ubNiZɏdȂOp`͊eZɕj
+	std::vector<int>		cellBlockStarts;		// Z̐擪ubNiZ{PA͑j
+	float					boundsMin[3] = { 0, 0, 0 };
+	float					cellSize = 1.0f;
+	int						division[3] = { 0, 0, 0 };
+};
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <DirectXPackedVector.h>
+#include "Misc.h"
+#include "VertexCompression.h"
+
+static_assert(sizeof(VertexCompression::SkinnedAttribute) == 20, "SkinnedAttribute size mismatch.");
+static_assert(sizeof(VertexCompression::StaticAttribute) == 12, "StaticAttribute size mismatch.");
+
+// k덷̋el
+const VertexCompression::Error VertexCompression::ErrorTolerance =
+{
+	0.05f,				// 16rbgʑ
+	0.3f,				// 10rbgʑ
+	1.0f / 1024.0f,		// x̉
+	1.0f / 255.0f,		// 8rbg
+};
+
+// [-1,1]  SNORM16
+static int16_t FloatToSnorm16(float v)
+{
+	v = (std::max)(-1.0f, (std::min)(1.0f, v));
+	return static_cast<int16_t>(std::lround(v * 32767.0f));
+}
+
+// SNORM16  [-1,1]
+static float Snorm16ToFloat(int16_t v)
+{
+	return (std::max)(-1.0f, static_cast<float>(v) / 32767.0f);
+}
+
+// [-1,1]  UNORM10
+static uint32_t FloatToUnorm10(float v)
+{
+	v = (std::max)(-1.0f, (std::min)(1.0f, v));
+	return static_cast<uint32_t>(std::lround((v * 0.5f + 0.5f) * 1023.0f));
+}
+
+// UNORM10  [-1,1]
+static float Unorm10ToFloat(uint32_t v)
+{
+	return static_cast<float>(v & 0x3FF) / 1023.0f * 2.0f - 1.0f;
+}
+
+// PʃxNg𔪖ʑ̃GR[h
+DirectX::XMFLOAT2 VertexCompression::EncodeOctahedral(const DirectX::XMFLOAT3& v)
+{
+	float length = fabsf(v.x) + fabsf(v.y) + fabsf(v.z);
+	if (length <= 0.0f) return { 0, 0 };
+
+	DirectX::XMFLOAT2 e = { v.x / length, v.y / length };
+	if (v.z < 0.0f)
+	{
+		// ͐܂Ԃ
+		DirectX::XMFLOAT2 f = { (1.0f - fabsf(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f),
+								(1.0f - fabsf(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f) };
+		e = f;
+	}
+	return e;
+}
+
+// ʑ̃GR[hPʃxNgɓWJ
+DirectX::XMFLOAT3 VertexCompression::DecodeOctahedral(const DirectX::XMFLOAT2& e)
+{
+	DirectX::XMFLOAT3 v = { e.x, e.y, 1.0f - fabsf(e.x) - fabsf(e.y) };
+	float t = (std::max)(-v.z, 0.0f);
+	v.x += v.x >= 0.0f ? -t : t;
+	v.y += v.y >= 0.0f ? -t : t;
+
+	DirectX::XMStoreFloat3(&v, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&v)));
+	return v;
+}
+
+// @k
+void VertexCompression::EncodeNormal(const DirectX::XMFLOAT3& normal, int16_t encoded[2])
+{
+	DirectX::XMFLOAT2 e = EncodeOctahedral(normal);
+	encoded[0] = FloatToSnorm16(e.x);
+	encoded[1] = FloatToSnorm16(e.y);
+}
+
+// @WJ
+DirectX::XMFLOAT3 VertexCompression::DecodeNormal(const int16_t encoded[2])
+{
+	return DecodeOctahedral({ Snorm16ToFloat(encoded[0]), Snorm16ToFloat(encoded[1]) });
+}
+
+// ڐk
+uint32_t VertexCompression::EncodeTangent(const DirectX::XMFLOAT4& tangent)
+{
+	DirectX::XMFLOAT2 e = EncodeOctahedral({ tangent.x, tangent.y, tangent.z });
+	uint32_t handedness = tangent.w < 0.0f ? 0 : 3;
+	return FloatToUnorm10(e.x) | (FloatToUnorm10(e.y) << 10) | (handedness << 30);
+}
+
+// ڐWJ
+DirectX::XMFLOAT4 VertexCompression::DecodeTangent(uint32_t encoded)
+{
+	DirectX::XMFLOAT3 t = DecodeOctahedral({ Unorm10ToFloat(encoded), Unorm10ToFloat(encoded >> 10) });
+	return { t.x, t.y, t.z, (encoded >> 30) != 0 ? 1.0f : -1.0f };
+}
+
+// UVk
+void VertexCompression::EncodeTexcoord(const DirectX::XMFLOAT2& texcoord, uint16_t encoded[2])
+{
+	encoded[0] = DirectX::PackedVector::XMConvertFloatToHalf(texcoord.x);
+	encoded[1] = DirectX::PackedVector::XMConvertFloatToHalf(texcoord.y);
+}
+
+// UVWJ
+DirectX::XMFLOAT2 VertexCompression::DecodeTexcoord(const uint16_t encoded[2])
+{
+	return {
+		DirectX::PackedVector::XMConvertHalfToFloat(encoded[0]),
+		DirectX::PackedVector::XMConvertHalfToFloat(encoded[1])
+	};
+}
+
+// {[EFCgk
+void VertexCompression::EncodeBoneWeight(const DirectX::XMFLOAT4& boneWeight, uint8_t encoded[4])
+{
+	float weights[4] = { boneWeight.x, boneWeight.y, boneWeight.z, boneWeight.w };
+	float total = weights[0] + weights[1] + weights[2] + weights[3];
+	if (total <= 0.0f)
+	{
+		encoded[0] = 255;
+		encoded[1] = encoded[2] = encoded[3] = 0;
+		return;
+	}
+
+	// ؂̂Ăc͒[̑傫ɔzčv255ɑ
+	int sum = 0;
+	int quantized[4];
+	float remainders[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		float scaled = weights[i] / total * 255.0f;
+		quantized[i] = static_cast<int>(floorf(scaled));
+		remainders[i] = scaled - static_cast<float>(quantized[i]);
+		sum += quantized[i];
+	}
+	for (; sum < 255; ++sum)
+	{
+		int largest = 0;
+		for (int i = 1; i < 4; ++i)
+		{
+			if (remainders[i] > remainders[largest]) largest = i;
+		}
+		++quantized[largest];
+		remainders[largest] = -1.0f;
+	}
+
+	for (int i = 0; i < 4; ++i)
+	{
+		encoded[i] = static_cast<uint8_t>((std::max)(0, (std::min)(255, quantized[i])));
+	}
+}
+
+// {[EFCgWJ
+DirectX::XMFLOAT4 VertexCompression::DecodeBoneWeight(const uint8_t encoded[4])
+{
+	return {
+		encoded[0] / 255.0f,
+		encoded[1] / 255.0f,
+		encoded[2] / 255.0f,
+		encoded[3] / 255.0f
+	};
+}
+
+// _zʒuXg[ƑXg[Ɉk
+void VertexCompression::Encode(
+	const std::vector<ModelResource::Vertex>& vertices,
+	ModelResource::VertexFormat format,
+	std::vector<DirectX::XMFLOAT3>& positions,
+	std::vector<uint8_t>& attributes)
+{
+	_ASSERT_EXPR_A(format != ModelResource::VertexFormat::Float, "Float format is not compressed.");
+
+	positions.resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		positions[i] = vertices[i].position;
+	}
+
+	if (format == ModelResource::VertexFormat::Compressed)
+	{
+		attributes.resize(sizeof(SkinnedAttribute) * vertices.size());
+		SkinnedAttribute* attribute = reinterpret_cast<SkinnedAttribute*>(attributes.data());
+		for (const ModelResource::Vertex& vertex : vertices)
+		{
+			EncodeNormal(vertex.normal, attribute->normal);
+			attribute->tangent = EncodeTangent(vertex.tangent);
+			EncodeTexcoord(vertex.texcoord, attribute->texcoord);
+			EncodeBoneWeight(vertex.boneWeight, attribute->boneWeight);
+			attribute->boneIndex[0] = static_cast<uint8_t>(vertex.boneIndex.x);
+			attribute->boneIndex[1] = static_cast<uint8_t>(vertex.boneIndex.y);
+			attribute->boneIndex[2] = static_cast<uint8_t>(vertex.boneIndex.z);
+			attribute->boneIndex[3] = static_cast<uint8_t>(vertex.boneIndex.w);
+			++attribute;
+		}
+	}
+	else
+	{
+		attributes.resize(sizeof(StaticAttribute) * vertices.size());
+		StaticAttribute* attribute = reinterpret_cast<StaticAttribute*>(attributes.data());
+		for (const ModelResource::Vertex& vertex : vertices)
+		{
+			EncodeNormal(vertex.normal, attribute->normal);
+			attribute->tangent = EncodeTangent(vertex.tangent);
+			EncodeTexcoord(vertex.texcoord, attribute->texcoord);
+			++attribute;
+		}
+	}
+}
+
+// kXg[𒸓_zɓWJ
+void VertexCompression::Decode(
+	const std::vector<DirectX::XMFLOAT3>& positions,
+	const std::vector<uint8_t>& attributes,
+	ModelResource::VertexFormat format,
+	std::vector<ModelResource::Vertex>& vertices)
+{
+	vertices.resize(positions.size());
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		ModelResource::Vertex& vertex = vertices[i];
+		vertex.position = positions[i];
+
+		if (format == ModelResource::VertexFormat::Compressed)
+		{
+			const SkinnedAttribute& attribute = reinterpret_cast<const SkinnedAttribute*>(attributes.data())[i];
+			vertex.normal = DecodeNormal(attribute.normal);
+			vertex.tangent = DecodeTangent(attribute.tangent);
+			vertex.texcoord = DecodeTexcoord(attribute.texcoord);
+			vertex.boneWeight = DecodeBoneWeight(attribute.boneWeight);
+			vertex.boneIndex = { attribute.boneIndex[0], attribute.boneIndex[1], attribute.boneIndex[2], attribute.boneIndex[3] };
+		}
+		else
+		{
+			const StaticAttribute& attribute = reinterpret_cast<const StaticAttribute*>(attributes.data())[i];
+			vertex.normal = DecodeNormal(attribute.normal);
+			vertex.tangent = DecodeTangent(attribute.tangent);
+			vertex.texcoord = DecodeTexcoord(attribute.texcoord);
+			vertex.boneWeight = { 1, 0, 0, 0 };
+			vertex.boneIndex = { 0, 0, 0, 0 };
+		}
+	}
+}
+
+// kWJʂƌ̒_̌덷v
+VertexCompression::Error VertexCompression::MeasureError(const std::vector<ModelResource::Vertex>& vertices, ModelResource::VertexFormat format)
+{
+	Error error;
+	if (format == ModelResource::VertexFormat::Float) return error;
+
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<uint8_t> attributes;
+	std::vector<ModelResource::Vertex> decoded;
+	Encode(vertices, format, positions, attributes);
+	Decode(positions, attributes, format, decoded);
+
+	// PʃxNgm̊pxixjAÕxNg͑ΏۊO
+	auto angleDegrees = [](const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b)
+	{
+		DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&a);
+		if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(A)) < 1e-8f) return 0.0f;
+		A = DirectX::XMVector3Normalize(A);
+		DirectX::XMVECTOR B = DirectX::XMLoadFloat3(&b);
+		float angle = DirectX::XMVectorGetX(DirectX::XMVector3AngleBetweenNormals(A, B));
+		return DirectX::XMConvertToDegrees(angle);
+	};
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const ModelResource::Vertex& a = vertices[i];
+		const ModelResource::Vertex& b = decoded[i];
+
+		error.normalDegrees = (std::max)(error.normalDegrees, angleDegrees(a.normal, b.normal));
+		error.tangentDegrees = (std::max)(error.tangentDegrees,
+			angleDegrees({ a.tangent.x, a.tangent.y, a.tangent.z }, { b.tangent.x, b.tangent.y, b.tangent.z }));
+
+		// UV͒l̑傫ɑ΂鑊Ό덷
+		error.texcoord = (std::max)(error.texcoord, fabsf(a.texcoord.x - b.texcoord.x) / (std::max)(1.0f, fabsf(a.texcoord.x)));
+		error.texcoord = (std::max)(error.texcoord, fabsf(a.texcoord.y - b.texcoord.y) / (std::max)(1.0f, fabsf(a.texcoord.y)));
+
+		if (format == ModelResource::VertexFormat::Compressed)
+		{
+			// ̃EFCg͍vPɐKĔr
+			float total = a.boneWeight.x + a.boneWeight.y + a.boneWeight.z + a.boneWeight.w;
+			if (total > 0.0f)
+			{
+				error.boneWeight = (std::max)(error.boneWeight, fabsf(a.boneWeight.x / total - b.boneWeight.x));
+				error.boneWeight = (std::max)(error.boneWeight, fabsf(a.boneWeight.y / total - b.boneWeight.y));
+				error.boneWeight = (std::max)(error.boneWeight, fabsf(a.boneWeight.z / total - b.boneWeight.z));
+				error.boneWeight = (std::max)(error.boneWeight, fabsf(a.boneWeight.w / total - b.boneWeight.w));
+			}
+		}
+	}
+	return error;
+}
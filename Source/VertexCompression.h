@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "ModelResource.h"
+
+// _k[eBeB
+class VertexCompression
+{
+public:
+	// kiXLjOA20oCgj
+	struct SkinnedAttribute
+	{
+		int16_t			normal[2];			// ʑ̃GR[hiR16G16_SNORMj
+		uint32_t		tangent;			// ʑ̃GR[h{]@̌iR10G10B10A2_UNORMj
+		uint16_t		texcoord[2];		// xiR16G16_FLOATj
+		uint8_t			boneWeight[4];		// R8G8B8A8_UNORM
+		uint8_t			boneIndex[4];		// R8G8B8A8_UINT
+	};
+
+	// kiXLjOȂA12oCgj
+	struct StaticAttribute
+	{
+		int16_t			normal[2];
+		uint32_t		tangent;
+		uint16_t		texcoord[2];
+	};
+
+	// k덷
+	struct Error
+	{
+		float			normalDegrees = 0;		// @̍őpx덷ixj
+		float			tangentDegrees = 0;		// ڐ̍őpx덷ixj
+		float			texcoord = 0;			// UV̍ő告Ό덷
+		float			boneWeight = 0;			// {[EFCg̍ő덷
+	};
+
+	// _zʒuXg[ƑXg[Ɉk
+	static void Encode(
+		const std::vector<ModelResource::Vertex>& vertices,
+		ModelResource::VertexFormat format,
+		std::vector<DirectX::XMFLOAT3>& positions,
+		std::vector<uint8_t>& attributes);
+
+	// kXg[𒸓_zɓWJ
+	static void Decode(
+		const std::vector<DirectX::XMFLOAT3>& positions,
+		const std::vector<uint8_t>& attributes,
+		ModelResource::VertexFormat format,
+		std::vector<ModelResource::Vertex>& vertices);
+
+	// kWJʂƌ̒_̌덷v
+	static Error MeasureError(const std::vector<ModelResource::Vertex>& vertices, ModelResource::VertexFormat format);
+
+	// k덷̋el
+	static const Error ErrorTolerance;
+
+	// PʃxNg𔪖ʑ̃GR[hi[-1,1]̂Qj
+	static DirectX::XMFLOAT2 EncodeOctahedral(const DirectX::XMFLOAT3& v);
+
+	// ʑ̃GR[hPʃxNgɓWJ
+	static DirectX::XMFLOAT3 DecodeOctahedral(const DirectX::XMFLOAT2& e);
+
+	// @k
+	static void EncodeNormal(const DirectX::XMFLOAT3& normal, int16_t encoded[2]);
+	static DirectX::XMFLOAT3 DecodeNormal(const int16_t encoded[2]);
+
+	// ڐkiw͏]@̌j
+	static uint32_t EncodeTangent(const DirectX::XMFLOAT4& tangent);
+	static DirectX::XMFLOAT4 DecodeTangent(uint32_t encoded);
+
+	// UVk
+	static void EncodeTexcoord(const DirectX::XMFLOAT2& texcoord, uint16_t encoded[2]);
+	static DirectX::XMFLOAT2 DecodeTexcoord(const uint16_t encoded[2]);
+
+	// {[EFCgkiv255ɂȂ悤Ɋۂ߂j
+	static void EncodeBoneWeight(const DirectX::XMFLOAT4& boneWeight, uint8_t encoded[4]);
+	static DirectX::XMFLOAT4 DecodeBoneWeight(const uint8_t encoded[4]);
+};